@@ -0,0 +1,173 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Replays a capture written by the server (IPC.startCapture) against a running
+// obs64 with the same order and timing, and reports the latency of each kind
+// of call and the CPU time the server spent on the replay.
+//
+//   osn-replay <capture file> <socket name> [speed]
+//
+// A speed of 2 replays twice as fast, 0 sends every call as soon as the
+// previous one returned. The ids in the arguments are the ones the server
+// handed out during the capture, so the capture should start right after
+// connecting and the server should be started fresh for the replay.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include "call-capture.hpp"
+#include "ipc-client.hpp"
+#include "osn-error.hpp"
+
+struct Latencies {
+	std::vector<double> replay_ms;
+	double captured_ms = 0.0;
+	uint32_t failed = 0;
+};
+
+static double Percentile(std::vector<double> &samples, double rank)
+{
+	if (samples.empty())
+		return 0.0;
+	auto nth = samples.begin() + size_t(rank * (samples.size() - 1));
+	std::nth_element(samples.begin(), nth, samples.end());
+	return *nth;
+}
+
+static bool IsOk(const std::vector<ipc::value> &response)
+{
+	return response.size() > 0 && response[0].type == ipc::type::UInt64 && (ErrorCode)response[0].value_union.ui64 == ErrorCode::Ok;
+}
+
+static bool GetCpuTime(std::shared_ptr<ipc::client> &conn, double &user_ms, double &kernel_ms)
+{
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Capture", "GetCpuTime", {});
+	if (!IsOk(response) || response.size() < 3)
+		return false;
+	user_ms = response[1].value_union.fp64;
+	kernel_ms = response[2].value_union.fp64;
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 3) {
+		std::fprintf(stderr, "usage: %s <capture file> <socket name> [speed]\n", argv[0]);
+		return 1;
+	}
+	double speed = argc > 3 ? std::strtod(argv[3], nullptr) : 1.0;
+
+	std::vector<capture::Call> calls;
+	{
+		capture::Reader reader;
+		if (!reader.Open(argv[1])) {
+			std::fprintf(stderr, "%s is not a capture file\n", argv[1]);
+			return 1;
+		}
+		capture::Call call;
+		while (reader.Next(call))
+			calls.push_back(call);
+	}
+
+	std::string path;
+#ifdef WIN32
+	path = argv[2];
+#else
+	path = std::string("/tmp/") + argv[2];
+#endif
+
+	std::shared_ptr<ipc::client> conn;
+	try {
+		conn = ipc::client::create(path);
+	} catch (...) {
+		conn = nullptr;
+	}
+	if (!conn) {
+		std::fprintf(stderr, "failed to connect to %s\n", path.c_str());
+		return 1;
+	}
+
+	double user_start = 0.0, kernel_start = 0.0;
+	bool cpu_time = GetCpuTime(conn, user_start, kernel_start);
+
+	std::map<std::string, Latencies> actions;
+	std::vector<double> all_ms;
+	all_ms.reserve(calls.size());
+	uint32_t skipped = 0;
+
+	auto replay_start = std::chrono::steady_clock::now();
+	for (auto &call : calls) {
+		std::string cname, fname;
+		// Shutting the server down would end the replay early.
+		if (!capture::SplitAction(call.action, cname, fname) || call.action == "System::Shutdown") {
+			skipped++;
+			continue;
+		}
+
+		if (speed > 0.0) {
+			auto due = replay_start + std::chrono::nanoseconds(uint64_t(call.start_ns / speed));
+			std::this_thread::sleep_until(due);
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		std::vector<ipc::value> response = conn->call_synchronous_helper(cname, fname, call.args);
+		double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		Latencies &latencies = actions[call.action];
+		latencies.replay_ms.push_back(ms);
+		latencies.captured_ms += call.duration_ns / 1000000.0;
+		if (response.empty())
+			latencies.failed++;
+		all_ms.push_back(ms);
+	}
+	double total_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - replay_start).count();
+
+	double user_end = 0.0, kernel_end = 0.0;
+	cpu_time = cpu_time && GetCpuTime(conn, user_end, kernel_end);
+
+	std::printf("calls: %zu replayed, %u skipped, %.1f ms wall time at speed %.2f\n", all_ms.size(), skipped, total_ms, speed);
+	if (cpu_time)
+		std::printf("server cpu: %.1f ms user, %.1f ms kernel\n", user_end - user_start, kernel_end - kernel_start);
+	std::printf("latency (ms): p50 %.3f, p90 %.3f, p99 %.3f, max %.3f\n\n", Percentile(all_ms, 0.50), Percentile(all_ms, 0.90), Percentile(all_ms, 0.99),
+		    Percentile(all_ms, 1.0));
+
+	// Slowest in total first, that is where a regression shows.
+	std::vector<std::pair<double, std::string>> order;
+	for (auto &entry : actions) {
+		double sum = 0.0;
+		for (double ms : entry.second.replay_ms)
+			sum += ms;
+		order.emplace_back(sum, entry.first);
+	}
+	std::sort(order.rbegin(), order.rend());
+
+	std::printf("%-48s %8s %10s %10s %10s %10s %12s %7s\n", "call", "count", "total", "p50", "p99", "max", "captured avg", "failed");
+	for (auto &entry : order) {
+		Latencies &latencies = actions[entry.second];
+		size_t count = latencies.replay_ms.size();
+		std::printf("%-48s %8zu %10.3f %10.3f %10.3f %10.3f %12.3f %7u\n", entry.second.c_str(), count, entry.first,
+			    Percentile(latencies.replay_ms, 0.50), Percentile(latencies.replay_ms, 0.99), Percentile(latencies.replay_ms, 1.0),
+			    latencies.captured_ms / count, latencies.failed);
+	}
+	return 0;
+}
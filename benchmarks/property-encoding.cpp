@@ -0,0 +1,183 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Compares the per-property obs::Property encoding with the flat encoding on a
+// properties set dominated by one 200 entry list, the typical shape of device
+// capture sources.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+#include "obs-property-flat.hpp"
+#include "obs-property.hpp"
+
+static std::vector<std::shared_ptr<obs::Property>> BuildProperties(size_t list_items)
+{
+	std::vector<std::shared_ptr<obs::Property>> props;
+
+	auto list = std::make_shared<obs::ListProperty>();
+	list->name = "video_device_id";
+	list->description = "Device";
+	list->enabled = true;
+	list->visible = true;
+	list->field_type = obs::ListProperty::ListType::List;
+	list->format = obs::ListProperty::Format::String;
+	for (size_t idx = 0; idx < list_items; idx++) {
+		obs::ListProperty::Item item;
+		item.name = "Video Capture Device #" + std::to_string(idx);
+		item.enabled = true;
+		item.value_int = 0;
+		item.value_float = 0;
+		item.value_string = "\\\\?\\usb#vid_046d&pid_0825&mi_00#" + std::to_string(idx) + "#{65e8773d-8f56-11d0-a3b9-00a0c9223196}";
+		list->items.push_back(item);
+	}
+	list->current_value_str = list->items.front().value_string;
+	props.push_back(list);
+
+	for (int idx = 0; idx < 8; idx++) {
+		auto integer = std::make_shared<obs::IntegerProperty>();
+		integer->name = "int_" + std::to_string(idx);
+		integer->description = "Integer " + std::to_string(idx);
+		integer->enabled = true;
+		integer->visible = true;
+		integer->field_type = obs::NumberProperty::NumberType::Scroller;
+		integer->minimum = 0;
+		integer->maximum = 100;
+		integer->step = 1;
+		integer->value = idx;
+		props.push_back(integer);
+
+		auto text = std::make_shared<obs::TextProperty>();
+		text->name = "text_" + std::to_string(idx);
+		text->description = "Text " + std::to_string(idx);
+		text->enabled = true;
+		text->visible = true;
+		text->field_type = obs::TextProperty::TextType::Default;
+		text->info_type = obs::TextProperty::InfoType::Normal;
+		text->value = "value";
+		props.push_back(text);
+	}
+
+	return props;
+}
+
+struct Result {
+	double encode_us;
+	double decode_us;
+	size_t bytes;
+	size_t checksum;
+};
+
+// What the server and client did per call before: one vector per property on
+// the way out, one heap object per property (and per list item) on the way in.
+static Result RunPerProperty(std::vector<std::shared_ptr<obs::Property>> &props, uint32_t iterations)
+{
+	Result result = {};
+	std::vector<std::vector<char>> encoded;
+
+	auto start = std::chrono::high_resolution_clock::now();
+	for (uint32_t iter = 0; iter < iterations; iter++) {
+		encoded.clear();
+		for (auto &prop : props) {
+			std::vector<char> buf(prop->size());
+			prop->serialize(buf);
+			encoded.push_back(std::move(buf));
+		}
+	}
+	auto middle = std::chrono::high_resolution_clock::now();
+	for (uint32_t iter = 0; iter < iterations; iter++) {
+		for (auto &buf : encoded) {
+			std::shared_ptr<obs::Property> prop = obs::Property::deserialize(buf);
+			result.checksum += prop->name.size();
+			if (prop->type() == obs::Property::Type::List) {
+				for (auto &item : std::static_pointer_cast<obs::ListProperty>(prop)->items)
+					result.checksum += item.name.size() + item.value_string.size();
+			}
+		}
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+
+	for (auto &buf : encoded)
+		result.bytes += buf.size();
+	result.encode_us = std::chrono::duration<double, std::micro>(middle - start).count() / iterations;
+	result.decode_us = std::chrono::duration<double, std::micro>(end - middle).count() / iterations;
+	return result;
+}
+
+static Result RunFlat(std::vector<std::shared_ptr<obs::Property>> &props, uint32_t iterations)
+{
+	Result result = {};
+	obs::flat::Writer writer;
+	std::vector<char> encoded;
+
+	auto start = std::chrono::high_resolution_clock::now();
+	for (uint32_t iter = 0; iter < iterations; iter++) {
+		writer.Clear();
+		for (auto &prop : props)
+			writer.Add(*prop);
+		writer.Finish(encoded);
+	}
+	auto middle = std::chrono::high_resolution_clock::now();
+	for (uint32_t iter = 0; iter < iterations; iter++) {
+		obs::flat::View view;
+		if (!view.Open(encoded.data(), encoded.size()))
+			std::abort();
+		for (uint32_t idx = 0; idx < view.Count(); idx++) {
+			const obs::flat::Record &record = view.Get(idx);
+			result.checksum += view.Str(record.name).size();
+			if (obs::Property::Type(record.type) == obs::Property::Type::List) {
+				for (uint32_t item_idx = 0; item_idx < record.item_count; item_idx++) {
+					const obs::flat::Item &item = view.GetItem(record, item_idx);
+					result.checksum += view.Str(item.name).size() + view.Str(item.value).size();
+				}
+			}
+		}
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+
+	result.bytes = encoded.size();
+	result.encode_us = std::chrono::duration<double, std::micro>(middle - start).count() / iterations;
+	result.decode_us = std::chrono::duration<double, std::micro>(end - middle).count() / iterations;
+	return result;
+}
+
+int main(int argc, char *argv[])
+{
+	size_t list_items = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200;
+	uint32_t iterations = argc > 2 ? uint32_t(std::strtoul(argv[2], nullptr, 10)) : 2000;
+	if (iterations == 0)
+		iterations = 1;
+
+	auto props = BuildProperties(list_items);
+	Result legacy = RunPerProperty(props, iterations);
+	Result flat = RunFlat(props, iterations);
+
+	if (legacy.checksum != flat.checksum) {
+		std::fprintf(stderr, "checksum mismatch: %zu != %zu\n", legacy.checksum, flat.checksum);
+		return 1;
+	}
+
+	std::printf("properties: %zu, list items: %zu, iterations: %u\n", props.size(), list_items, iterations);
+	std::printf("%-14s %12s %12s %12s\n", "", "encode (us)", "decode (us)", "bytes");
+	std::printf("%-14s %12.2f %12.2f %12zu\n", "per-property", legacy.encode_us, legacy.decode_us, legacy.bytes);
+	std::printf("%-14s %12.2f %12.2f %12zu\n", "flat", flat.encode_us, flat.decode_us, flat.bytes);
+	return 0;
+}
@@ -0,0 +1,371 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Times the server structures every IPC call goes through, in process and
+// without libobs, ipc transport or graphics: id allocation, object lookup,
+// property and settings serialization, the AUTO_DEBUG argument formatting and
+// the lookup of the called function.
+//
+// Each case runs a fixed workload once to warm up, then `trials` more times.
+// One JSON object per case is written to stdout, so results can be diffed
+// between builds or collected by a script:
+//   {"name":"...","ops":N,"trials":T,"median_ns":...,"min_ns":...,"max_ns":...,"checksum":N}
+// The *_ns fields are per operation. The checksum only depends on the inputs
+// and must not change between runs; a different value means a behaviour change.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "nodeobs_settings_data.h"
+#include "obs-property.hpp"
+#include "packed-args.hpp"
+#include "shared.hpp"
+#include "unique-id.hpp"
+
+struct Case {
+	const char *name;
+	// Number of operations done by one call of `run`.
+	uint64_t ops;
+	std::function<uint64_t()> run;
+};
+
+struct Result {
+	double median_ns;
+	double min_ns;
+	double max_ns;
+	uint64_t checksum;
+};
+
+static constexpr uint32_t ObjectCount = 1024;
+
+static Result Measure(const Case &c, uint32_t trials)
+{
+	Result result = {};
+	result.checksum = c.run();
+
+	std::vector<double> samples;
+	samples.reserve(trials);
+	for (uint32_t trial = 0; trial < trials; trial++) {
+		auto start = std::chrono::steady_clock::now();
+		uint64_t checksum = c.run();
+		auto end = std::chrono::steady_clock::now();
+		if (checksum != result.checksum) {
+			std::fprintf(stderr, "%s: checksum changed between trials\n", c.name);
+			std::exit(1);
+		}
+		samples.push_back(std::chrono::duration<double, std::nano>(end - start).count() / double(c.ops));
+	}
+
+	std::sort(samples.begin(), samples.end());
+	result.min_ns = samples.front();
+	result.max_ns = samples.back();
+	result.median_ns = samples[samples.size() / 2];
+	return result;
+}
+
+static std::vector<std::shared_ptr<obs::Property>> BuildProperties()
+{
+	std::vector<std::shared_ptr<obs::Property>> props;
+
+	auto list = std::make_shared<obs::ListProperty>();
+	list->name = "device_id";
+	list->description = "Device";
+	list->enabled = true;
+	list->visible = true;
+	list->field_type = obs::ListProperty::ListType::List;
+	list->format = obs::ListProperty::Format::String;
+	for (int idx = 0; idx < 32; idx++) {
+		obs::ListProperty::Item item;
+		item.name = "Device #" + std::to_string(idx);
+		item.enabled = true;
+		item.value_int = 0;
+		item.value_float = 0;
+		item.value_string = "device_" + std::to_string(idx);
+		list->items.push_back(item);
+	}
+	list->current_value_str = list->items.front().value_string;
+	props.push_back(list);
+
+	for (int idx = 0; idx < 8; idx++) {
+		auto integer = std::make_shared<obs::IntegerProperty>();
+		integer->name = "int_" + std::to_string(idx);
+		integer->description = "Integer " + std::to_string(idx);
+		integer->enabled = true;
+		integer->visible = true;
+		integer->field_type = obs::NumberProperty::NumberType::Scroller;
+		integer->minimum = 0;
+		integer->maximum = 100;
+		integer->step = 1;
+		integer->value = idx;
+		props.push_back(integer);
+
+		auto text = std::make_shared<obs::TextProperty>();
+		text->name = "text_" + std::to_string(idx);
+		text->description = "Text " + std::to_string(idx);
+		text->enabled = true;
+		text->visible = true;
+		text->field_type = obs::TextProperty::TextType::Default;
+		text->info_type = obs::TextProperty::InfoType::Normal;
+		text->value = "value";
+		props.push_back(text);
+	}
+
+	return props;
+}
+
+// Roughly the shape of the "Output" category: a handful of list parameters
+// carrying their possible values and a few plain ones.
+static SubCategory BuildSubCategory()
+{
+	SubCategory sc;
+	sc.name = "Streaming";
+
+	for (int idx = 0; idx < 16; idx++) {
+		Parameter param;
+		param.name = "Parameter" + std::to_string(idx);
+		param.description = "Description of parameter " + std::to_string(idx);
+		param.type = (idx % 2) ? "OBS_PROPERTY_LIST" : "OBS_PROPERTY_INT";
+		param.subType = (idx % 2) ? "OBS_COMBO_FORMAT_STRING" : "";
+		param.enabled = true;
+		param.masked = false;
+		param.visible = true;
+
+		std::string current = "value_" + std::to_string(idx);
+		param.currentValue.assign(current.begin(), current.end());
+		param.sizeOfCurrentValue = param.currentValue.size();
+
+		if (idx % 2) {
+			for (int value = 0; value < 8; value++) {
+				std::string entry = "option_" + std::to_string(value);
+				uint64_t length = entry.size();
+				const char *bytes = reinterpret_cast<const char *>(&length);
+				param.values.insert(param.values.end(), bytes, bytes + sizeof(length));
+				param.values.insert(param.values.end(), entry.begin(), entry.end());
+				param.countValues++;
+			}
+			param.sizeOfValues = param.values.size();
+		}
+
+		sc.params.push_back(param);
+	}
+	sc.paramsCount = uint32_t(sc.params.size());
+
+	return sc;
+}
+
+static std::vector<Case> BuildCases()
+{
+	std::vector<Case> cases;
+
+	cases.push_back({"unique_id.allocate_free", ObjectCount * 2, [] {
+				 utility::unique_id ids;
+				 uint64_t checksum = 0;
+				 for (uint32_t idx = 0; idx < ObjectCount; idx++)
+					 checksum += ids.allocate();
+				 for (uint32_t idx = 0; idx < ObjectCount; idx++)
+					 ids.free(idx);
+				 return checksum;
+			 }});
+
+	// Every other id freed leaves ObjectCount / 2 ranges in the list, which
+	// is what a long session of creating and releasing sources looks like.
+	cases.push_back({"unique_id.allocate_fragmented", ObjectCount / 2, [] {
+				 utility::unique_id ids;
+				 for (uint32_t idx = 0; idx < ObjectCount; idx++)
+					 ids.allocate();
+				 for (uint32_t idx = 0; idx < ObjectCount; idx += 2)
+					 ids.free(idx);
+
+				 uint64_t checksum = 0;
+				 for (uint32_t idx = 0; idx < ObjectCount / 2; idx++)
+					 checksum += ids.allocate();
+				 return checksum;
+			 }});
+
+	static std::vector<int> objects(ObjectCount);
+	static utility::generic_object_manager<int *> manager;
+	static std::vector<utility::unique_id::id_t> uids;
+	if (uids.empty()) {
+		for (auto &object : objects)
+			uids.push_back(manager.allocate(&object));
+	}
+
+	cases.push_back({"generic_object_manager.allocate_free", ObjectCount * 2, [] {
+				 utility::generic_object_manager<int *> local;
+				 uint64_t checksum = 0;
+				 for (auto &object : objects)
+					 checksum += local.allocate(&object);
+				 for (uint32_t idx = 0; idx < ObjectCount; idx++)
+					 checksum += local.free(utility::unique_id::id_t(idx)) != nullptr;
+				 return checksum;
+			 }});
+
+	cases.push_back({"generic_object_manager.find_by_id", ObjectCount, [] {
+				 uint64_t checksum = 0;
+				 for (auto uid : uids)
+					 checksum += manager.find(uid) - objects.data();
+				 return checksum;
+			 }});
+
+	cases.push_back({"generic_object_manager.find_by_object", ObjectCount, [] {
+				 uint64_t checksum = 0;
+				 for (auto &object : objects)
+					 checksum += manager.find(&object);
+				 return checksum;
+			 }});
+
+	static std::vector<std::shared_ptr<obs::Property>> props = BuildProperties();
+	static std::vector<std::vector<char>> encoded;
+	for (auto &prop : props) {
+		std::vector<char> buf(prop->size());
+		prop->serialize(buf);
+		encoded.push_back(std::move(buf));
+	}
+
+	cases.push_back({"obs_property.serialize", props.size(), [] {
+				 uint64_t checksum = 0;
+				 for (auto &prop : props) {
+					 std::vector<char> buf(prop->size());
+					 prop->serialize(buf);
+					 checksum += buf.size();
+				 }
+				 return checksum;
+			 }});
+
+	cases.push_back({"obs_property.deserialize", encoded.size(), [] {
+				 uint64_t checksum = 0;
+				 for (auto &buf : encoded)
+					 checksum += obs::Property::deserialize(buf)->name.size();
+				 return checksum;
+			 }});
+
+	static SubCategory sc = BuildSubCategory();
+
+	cases.push_back({"settings.parameter_serialize", sc.params.size(), [] {
+				 uint64_t checksum = 0;
+				 for (auto &param : sc.params)
+					 checksum += param.serialize().size();
+				 return checksum;
+			 }});
+
+	cases.push_back({"settings.subcategory_serialize", 1, [] { return uint64_t(sc.serialize().size()); }});
+
+	static std::vector<ipc::value> args = {ipc::value(uint64_t(0)),
+					       ipc::value(std::string("test_source")),
+					       ipc::value(int64_t(-42)),
+					       ipc::value(uint32_t(1920)),
+					       ipc::value(uint32_t(1080)),
+					       ipc::value(1.5f),
+					       ipc::value(0.25),
+					       ipc::value(std::vector<char>(64))};
+
+	cases.push_back({"shared.string_from_ipc_values", 1, [] { return uint64_t(StringFromIPCValueVector(args).size()); }});
+
+	// One call from the client's message to the function, with packed values
+	// standing in for the ipc wire format. By name, the message carries the
+	// collection and function names, and the server looks up the collection,
+	// then the function by its name and argument types, the way the ipc
+	// library does. By id, the message carries the method id and the
+	// arguments packed into one Binary, which Dispatch.Call unpacks and checks
+	// after indexing the method table.
+	static std::vector<std::pair<std::string, std::string>> names;
+	static std::map<std::string, std::map<std::string, uint32_t>> collections;
+	static std::vector<std::vector<ipc::type>> params;
+	static std::vector<ipc::value> call_args = {ipc::value(uint64_t(7)), ipc::value(std::string("test_source")), ipc::value(uint32_t(1))};
+	if (names.empty()) {
+		std::string types;
+		for (auto &arg : call_args)
+			types.push_back(char('0' + int(arg.type)));
+		for (uint32_t cidx = 0; cidx < 40; cidx++) {
+			for (uint32_t fidx = 0; fidx < 12; fidx++) {
+				std::string cname = "Collection" + std::to_string(cidx);
+				std::string fname = "Function" + std::to_string(fidx);
+				collections[cname][fname + types] = uint32_t(names.size());
+				names.push_back({cname, fname});
+				params.push_back({ipc::type::UInt64, ipc::type::String, ipc::type::UInt32});
+			}
+		}
+	}
+
+	cases.push_back({"dispatch.by_name", names.size(), [] {
+				 uint64_t checksum = 0;
+				 for (auto &name : names) {
+					 std::vector<ipc::value> message = {ipc::value(name.first), ipc::value(name.second)};
+					 message.insert(message.end(), call_args.begin(), call_args.end());
+					 std::vector<char> buffer = packed::Pack(message);
+
+					 std::vector<ipc::value> values;
+					 if (!packed::Unpack(buffer, values))
+						 continue;
+					 std::string key = values[1].value_str;
+					 for (size_t idx = 2; idx < values.size(); idx++)
+						 key.push_back(char('0' + int(values[idx].type)));
+					 auto cls = collections.find(values[0].value_str);
+					 if (cls == collections.end())
+						 continue;
+					 auto function = cls->second.find(key);
+					 if (function != cls->second.end())
+						 checksum += function->second;
+				 }
+				 return checksum;
+			 }});
+
+	cases.push_back({"dispatch.by_id", names.size(), [] {
+				 uint64_t checksum = 0;
+				 for (uint32_t method_id = 0; method_id < names.size(); method_id++) {
+					 std::vector<ipc::value> message = {ipc::value(method_id), ipc::value(packed::Pack(call_args))};
+					 std::vector<char> buffer = packed::Pack(message);
+
+					 std::vector<ipc::value> values;
+					 if (!packed::Unpack(buffer, values) || values[0].value_union.ui32 >= params.size())
+						 continue;
+					 std::vector<ipc::value> method_args;
+					 method_args.reserve(params[values[0].value_union.ui32].size());
+					 if (packed::Unpack(values[1].value_bin, method_args) && packed::Matches(method_args, params[values[0].value_union.ui32]))
+						 checksum += values[0].value_union.ui32;
+				 }
+				 return checksum;
+			 }});
+
+	return cases;
+}
+
+int main(int argc, char *argv[])
+{
+	uint32_t trials = argc > 1 ? uint32_t(std::strtoul(argv[1], nullptr, 10)) : 15;
+	const char *filter = argc > 2 ? argv[2] : nullptr;
+	if (trials == 0)
+		trials = 1;
+
+	for (auto &c : BuildCases()) {
+		if (filter && !std::strstr(c.name, filter))
+			continue;
+
+		Result result = Measure(c, trials);
+		std::printf("{\"name\":\"%s\",\"ops\":%llu,\"trials\":%u,\"median_ns\":%.2f,\"min_ns\":%.2f,\"max_ns\":%.2f,\"checksum\":%llu}\n", c.name,
+			    (unsigned long long)c.ops, trials, result.median_ns, result.min_ns, result.max_ns, (unsigned long long)result.checksum);
+	}
+	return 0;
+}
@@ -10,6 +10,38 @@ export declare const enum ESourceFlags {
     Unbuffered = 1,
     ForceMono = 2
 }
+export declare const enum ESourceStateField {
+    Muted = 1,
+    Volume = 2,
+    SyncOffset = 4,
+    AudioMixers = 8,
+    MonitoringType = 16,
+    Width = 32,
+    Height = 64,
+    Active = 128,
+    Showing = 256,
+    Flags = 512,
+    All = 1023
+}
+export declare const enum EMediaState {
+    None = 0,
+    Playing = 1,
+    Opening = 2,
+    Buffering = 3,
+    Paused = 4,
+    Stopped = 5,
+    Ended = 6,
+    Error = 7
+}
+export declare const enum EMediaEventReason {
+    Position = 0,
+    Started = 1,
+    Ended = 2,
+    Paused = 3,
+    Played = 4,
+    Restarted = 5,
+    Stopped = 6
+}
 export declare const enum EMonitoringType {
     None = 0,
     MonitoringOnly = 1,
@@ -347,6 +379,86 @@ export interface IIPC {
     connect(uri: string): void;
     host(uri: string): EIPCError;
     disconnect(): void;
+    benchmarkTransport(payloadSize?: number, iterations?: number): ITransportBenchmark;
+    benchmarkDispatch(iterations?: number): IDispatchBenchmark;
+    flushWrites(): void;
+    getWriteStats(): IWriteStats;
+    getAsyncStats(): IAsyncStats;
+    getLaneStats(): ILaneStats;
+    benchmarkLanes(iterations?: number, payloadSize?: number): ILaneBenchmark;
+    startCapture(path: string): void;
+    stopCapture(): number;
+    getStartupMetrics(): IStartupMetrics;
+}
+export interface IStartupMetrics {
+    spawnMs: number;
+    connectMs: number;
+    attempts: number;
+    serverInitMs?: number;
+    serverFirstConnectMs?: number;
+}
+export interface IAsyncStats {
+    queued: number;
+    completed: number;
+    failed: number;
+    maxInFlight: number;
+}
+export interface ILaneTiming {
+    calls: number;
+    averageMs: number;
+    p50Ms: number;
+    p99Ms: number;
+    maxMs: number;
+}
+export interface ILaneStats {
+    standard: ILaneTiming;
+    realtime: ILaneTiming;
+    realtimeConnected: boolean;
+}
+export interface ILaneBenchmark {
+    iterations: number;
+    payloadSize: number;
+    loadCalls: number;
+    realtimeConnected: boolean;
+    standard: ILaneTiming;
+    realtime: ILaneTiming;
+}
+export interface IWriteStats {
+    queued: number;
+    coalesced: number;
+    batches: number;
+    sent: number;
+}
+export interface ITransportTiming {
+    totalMs: number;
+    callMs: number;
+    megabytesPerSecond: number;
+    sharedCalls: number;
+    checksum: number;
+}
+export interface ITransportBenchmark {
+    payloadSize: number;
+    iterations: number;
+    sharedMemory: boolean;
+    inline: ITransportTiming;
+    shared: ITransportTiming;
+}
+export interface IDispatchTiming {
+    totalMs: number;
+    callMs: number;
+    callsPerSecond: number;
+}
+export interface IDispatchBenchmark {
+    iterations: number;
+    methodCount: number;
+    dispatchById: boolean;
+    byName: IDispatchTiming;
+    byId: IDispatchTiming;
+}
+export interface IDisplayRenderPolicy {
+    maxFps?: number;
+    renderScale?: number;
+    pauseWhenHidden?: boolean;
 }
 export interface IGlobal {
     startup(locale: string, path?: string): void;
@@ -427,6 +539,12 @@ export interface IProperty {
     readonly value: any;
     next(): IProperty;
     modified(): boolean;
+    modifiedAndDiff(settings: ISettings): IPropertyDiff;
+}
+export interface IPropertyDiff {
+    readonly modified: boolean;
+    readonly changed: string[];
+    readonly properties?: IProperties;
 }
 export interface IProperties {
     readonly status: number;
@@ -445,10 +563,33 @@ export interface IFilterFactory extends IFactoryTypes {
 }
 export interface IFilter extends ISource {
 }
+export interface ISourceStates {
+    readonly count: number;
+    readonly valid: Uint8Array;
+    readonly muted?: Uint8Array;
+    readonly volume?: Float32Array;
+    readonly syncOffset?: Float64Array;
+    readonly audioMixers?: Uint32Array;
+    readonly monitoringType?: Int32Array;
+    readonly width?: Uint32Array;
+    readonly height?: Uint32Array;
+    readonly active?: Uint8Array;
+    readonly showing?: Uint8Array;
+    readonly flags?: Uint32Array;
+}
+export interface IMediaEvent {
+    readonly handle: number;
+    readonly state: EMediaState;
+    readonly reason: EMediaEventReason;
+    readonly time: number;
+    readonly duration: number;
+}
 export interface IInputFactory extends IFactoryTypes {
     create(id: string, name: string, settings?: ISettings, hotkeys?: ISettings): IInput;
     createPrivate(id: string, name: string, settings?: ISettings): IInput;
     fromName(name: string): IInput;
+    fromNames(names: string[]): IInput[];
+    getStates(inputs: IInput[], fields?: ESourceStateField): ISourceStates;
     getPublicSources(): IInput[];
 }
 export declare const enum EInteractionFlags {
@@ -505,6 +646,7 @@ export interface IInput extends ISource {
     monitoringType: EMonitoringType;
     deinterlaceFieldOrder: EDeinterlaceFieldOrder;
     deinterlaceMode: EDeinterlaceMode;
+    getSettingsAsync(): Promise<ISettings>;
     duplicate(name?: string, isPrivate?: boolean): IInput;
     findFilter(name: string): IFilter;
     addFilter(filter: IFilter): void;
@@ -525,6 +667,8 @@ export interface IInput extends ISource {
     pause(): void;
     restart(): void;
     stop(): void;
+    subscribeMediaEvents(): number;
+    unsubscribeMediaEvents(): void;
 }
 export interface ISceneFactory {
     create(name: string): IScene;
@@ -568,6 +712,8 @@ export interface ISceneItem {
     remove(): void;
     deferUpdateBegin(): void;
     deferUpdateEnd(): void;
+    getPositionAsync(): Promise<IVec2>;
+    getTransformInfoAsync(): Promise<ITransformInfo>;
     blendingMethod: EBlendingMethod;
     blendingMode: EBlendingMode;
 }
@@ -618,9 +764,16 @@ export interface IVolmeterFactory {
 }
 export interface IVolmeter {
     updateInterval: number;
+    readonly index: number;
     destroy(): void;
     attach(source: IInput): void;
     detach(): void;
+    setBallistics(options: IVolmeterBallistics | null): void;
+}
+export interface IVolmeterBallistics {
+    peakHoldMs?: number;
+    decayRate?: number;
+    rmsWindowMs?: number;
 }
 export interface ICallbackData {
 }
@@ -46,9 +46,9 @@ exports.AdvancedReplayBufferFactory = obs.AdvancedReplayBuffer;
 function addItems(scene, sceneItems) {
     const items = [];
     if (Array.isArray(sceneItems)) {
-        sceneItems.forEach(function (sceneItem) {
-            const source = obs.Input.fromName(sceneItem.name);
-            const item = scene.add(source, sceneItem);
+        const sources = obs.Input.fromNames(sceneItems.map(sceneItem => sceneItem.name));
+        sceneItems.forEach(function (sceneItem, index) {
+            const item = scene.add(sources[index], sceneItem);
             items.push(item);
         });
     }
@@ -86,8 +86,9 @@ exports.createSources = createSources;
 function getSourcesSize(sourcesNames) {
     const sourcesSize = [];
     if (Array.isArray(sourcesNames)) {
-        sourcesNames.forEach(function (sourceName) {
-            const ObsInput = obs.Input.fromName(sourceName);
+        const inputs = obs.Input.fromNames(sourcesNames);
+        sourcesNames.forEach(function (sourceName, index) {
+            const ObsInput = inputs[index];
             if (ObsInput) {
                 sourcesSize.push({ name: sourceName, height: ObsInput.height, width: ObsInput.width, outputFlags: ObsInput.outputFlags });
             }
@@ -35,6 +35,41 @@ export const enum ESourceFlags {
     ForceMono = (1 << 1)
 }
 
+export const enum ESourceStateField {
+    Muted = (1 << 0),
+    Volume = (1 << 1),
+    SyncOffset = (1 << 2),
+    AudioMixers = (1 << 3),
+    MonitoringType = (1 << 4),
+    Width = (1 << 5),
+    Height = (1 << 6),
+    Active = (1 << 7),
+    Showing = (1 << 8),
+    Flags = (1 << 9),
+    All = (1 << 10) - 1
+}
+
+export const enum EMediaState {
+    None,
+    Playing,
+    Opening,
+    Buffering,
+    Paused,
+    Stopped,
+    Ended,
+    Error
+}
+
+export const enum EMediaEventReason {
+    Position,
+    Started,
+    Ended,
+    Paused,
+    Played,
+    Restarted,
+    Stopped
+}
+
 export const enum EMonitoringType {
     None,
     MonitoringOnly,
@@ -482,6 +517,160 @@ export interface IIPC {
      * Disconnect from a server.
      */
 	disconnect(): void;
+
+    /**
+     * Round-trips a generated payload through the server, once through the
+     * socket and once through the shared-memory arena, and reports timings.
+     * @param payloadSize - Size of the payload in bytes (default 1 MB).
+     * @param iterations - Number of round trips per transport (default 100).
+     */
+	benchmarkTransport(payloadSize?: number, iterations?: number): ITransportBenchmark;
+
+    /**
+     * Sends the same small call to the server by name and by method id
+     * and reports timings for both.
+     * @param iterations - Number of calls per path (default 10000).
+     */
+	benchmarkDispatch(iterations?: number): IDispatchBenchmark;
+
+    /**
+     * Sends every coalesced setter call still waiting for the next event loop tick.
+     */
+	flushWrites(): void;
+
+    /**
+     * Counters of the setter write-behind queue.
+     */
+	getWriteStats(): IWriteStats;
+
+    /**
+     * Counters of the Promise based calls (the *Async methods).
+     */
+	getAsyncStats(): IAsyncStats;
+
+    /**
+     * Latency of the calls made on each connection lane. Polling threads use
+     * the realtime lane, everything else the standard one.
+     */
+	getLaneStats(): ILaneStats;
+
+    /**
+     * Pings the server on each lane while the standard lane is kept busy
+     * with large replies, and reports the latency seen on both.
+     * @param iterations - Number of pings per lane (default 200).
+     * @param payloadSize - Size of the replies used as load (default 4 MB).
+     */
+	benchmarkLanes(iterations?: number, payloadSize?: number): ILaneBenchmark;
+
+    /**
+     * Starts recording every call handled by the server, with its arguments
+     * and timings, into a file that the osn-replay benchmark plays back.
+     * @param path - File to write the capture to, replaced if it exists.
+     */
+	startCapture(path: string): void;
+
+    /**
+     * Stops the running capture and closes its file.
+     * @returns - Number of calls recorded.
+     */
+	stopCapture(): number;
+
+    /**
+     * Timings of the last host/connect call. The server fields are only
+     * present while connected.
+     */
+	getStartupMetrics(): IStartupMetrics;
+}
+
+export interface IStartupMetrics {
+    spawnMs: number,
+    connectMs: number,
+    attempts: number,
+    serverInitMs?: number,
+    serverFirstConnectMs?: number
+}
+
+export interface IAsyncStats {
+    queued: number,
+    completed: number,
+    failed: number,
+    maxInFlight: number
+}
+
+export interface ILaneTiming {
+    calls: number,
+    averageMs: number,
+    p50Ms: number,
+    p99Ms: number,
+    maxMs: number
+}
+
+export interface ILaneStats {
+    standard: ILaneTiming,
+    realtime: ILaneTiming,
+    realtimeConnected: boolean
+}
+
+export interface ILaneBenchmark {
+    iterations: number,
+    payloadSize: number,
+    loadCalls: number,
+    realtimeConnected: boolean,
+    standard: ILaneTiming,
+    realtime: ILaneTiming
+}
+
+export interface IWriteStats {
+    queued: number,
+    coalesced: number,
+    batches: number,
+    sent: number
+}
+
+export interface ITransportTiming {
+    totalMs: number,
+    callMs: number,
+    megabytesPerSecond: number,
+    sharedCalls: number,
+    checksum: number
+}
+
+export interface ITransportBenchmark {
+    payloadSize: number,
+    iterations: number,
+    sharedMemory: boolean,
+    inline: ITransportTiming,
+    shared: ITransportTiming
+}
+
+export interface IDispatchTiming {
+    totalMs: number,
+    callMs: number,
+    callsPerSecond: number
+}
+
+export interface IDispatchBenchmark {
+    iterations: number,
+    methodCount: number,
+    dispatchById: boolean,
+    byName: IDispatchTiming,
+    byId: IDispatchTiming
+}
+
+/**
+ * Policy passed to `NodeObs.OBS_content_setDisplayRenderPolicy`, every field is optional.
+ */
+export interface IDisplayRenderPolicy {
+    /** Frames per second cap, 0 (the default) renders every canvas frame */
+    maxFps?: number,
+    /** Size of the source render target relative to the preview area, in (0, 1] */
+    renderScale?: number,
+    /**
+     * Stop rendering while the display is zero-sized or its window is minimized or hidden.
+     * Off by default. Window visibility is only detected on Windows, on macOS only a
+     * zero-sized display pauses.
+     */
+    pauseWhenHidden?: boolean
 }
 
 export interface IGlobal {
@@ -704,6 +893,26 @@ export interface IProperty {
      */
     next(): IProperty;
     modified(): boolean;
+
+    /**
+     * Runs the modified callback of this property with the given
+     * settings and returns only the properties it changed.
+     *
+     * The properties object this property belongs to is updated
+     * in place, so there is no need to fetch the properties again.
+     */
+    modifiedAndDiff(settings: ISettings): IPropertyDiff;
+}
+
+export interface IPropertyDiff {
+    /** Whether the callback asked for the properties to be refreshed */
+    readonly modified: boolean;
+
+    /** Names of the properties that were added or changed */
+    readonly changed: string[];
+
+    /** The updated properties, missing if they have to be fetched again */
+    readonly properties?: IProperties;
 }
 
 /**
@@ -755,6 +964,43 @@ export interface IFilterFactory extends IFactoryTypes {
 export interface IFilter extends ISource {
 }
 
+/**
+ * States of several inputs, as returned by {@link IInputFactory.getStates}.
+ * Each field only exists if it was requested.
+ */
+export interface ISourceStates {
+    readonly count: number;
+    /** 0 for entries that are not a valid input, their other fields are 0 */
+    readonly valid: Uint8Array;
+    readonly muted?: Uint8Array;
+    readonly volume?: Float32Array;
+    /** Sync offset in nanoseconds */
+    readonly syncOffset?: Float64Array;
+    readonly audioMixers?: Uint32Array;
+    readonly monitoringType?: Int32Array;
+    readonly width?: Uint32Array;
+    readonly height?: Uint32Array;
+    readonly active?: Uint8Array;
+    readonly showing?: Uint8Array;
+    readonly flags?: Uint32Array;
+}
+
+/**
+ * Playback change of a media input, see {@link IInput.subscribeMediaEvents}.
+ * Several changes between two ticks of the source callback are reported once
+ * with the latest state.
+ */
+export interface IMediaEvent {
+    /** Handle returned by {@link IInput.subscribeMediaEvents} */
+    readonly handle: number;
+    readonly state: EMediaState;
+    readonly reason: EMediaEventReason;
+    /** Play position in milliseconds */
+    readonly time: number;
+    /** Duration in milliseconds */
+    readonly duration: number;
+}
+
 export interface IInputFactory extends IFactoryTypes {
     /**
      * Create a new instance of an ObsInput
@@ -784,6 +1030,21 @@ export interface IInputFactory extends IFactoryTypes {
      */
     fromName(name: string): IInput;
 
+    /**
+     * Same as {@link fromName} for several names in a single call.
+     * @param names - Names of the sources to look for
+     * @returns - One instance per name, undefined for names that were not found
+     */
+    fromNames(names: string[]): IInput[];
+
+    /**
+     * Reads the state of several inputs in a single call.
+     * @param inputs - Inputs to read
+     * @param fields - Optional, fields to read, all of them by default
+     * @returns - One typed array per requested field, indexed like inputs
+     */
+    getStates(inputs: IInput[], fields?: ESourceStateField): ISourceStates;
+
     /**
      * Fetches a list of all public input sources available.
      */
@@ -858,6 +1119,11 @@ export interface IInput extends ISource {
     deinterlaceFieldOrder: EDeinterlaceFieldOrder;
     deinterlaceMode: EDeinterlaceMode;
 
+    /**
+     * Same as {@link settings}, without blocking while the server answers.
+     */
+    getSettingsAsync(): Promise<ISettings>;
+
     /**
      * Create a new instance using the current instance.
      * If no parameters are provide, an instance is created
@@ -951,6 +1217,18 @@ export interface IInput extends ISource {
      * stop media source
      */
     stop(): void;
+
+    /**
+     * Reports the playback changes of this source to the callback given to
+     * `RegisterMediaCallback`, which needs `RegisterSourceCallback` running.
+     * @returns - Handle found in the events of this source
+     */
+    subscribeMediaEvents(): number;
+
+    /**
+     * Stops the events started by {@link subscribeMediaEvents}
+     */
+    unsubscribeMediaEvents(): void;
 }
 
 export interface ISceneFactory {
@@ -1132,6 +1410,12 @@ export interface ISceneItem {
     /** Allow updating of the item after calling {@link deferUpdateBegin} */
     deferUpdateEnd(): void;
 
+    /** Same as {@link position}, without blocking while the server answers */
+    getPositionAsync(): Promise<IVec2>;
+
+    /** Same as {@link transformInfo}, without blocking while the server answers */
+    getTransformInfoAsync(): Promise<ITransformInfo>;
+
     /** Set the item blending method */
     blendingMethod: EBlendingMethod;
 
@@ -1356,6 +1640,14 @@ export interface IVolmeter {
      */
     updateInterval: number;
 
+    /**
+     * Slot of this volmeter in the typed arrays passed to a volmeter callback
+     * registered with `RegisterVolmeterCallback(callback, true)`. It stays the
+     * same until the volmeter is destroyed. The values of slot `i` start at
+     * `i * 24`, 8 channels of [magnitude, peak, inputPeak].
+     */
+    readonly index: number;
+
     /**
      * Destroy the volmeter object object
      */
@@ -1371,6 +1663,24 @@ export interface IVolmeter {
      * Detaches the currently attached source from the volmeter object
      */
     detach(): void;
+
+    /**
+     * Lets the server apply peak-hold, decay and an RMS window to the values
+     * before they are sent. The callback then delivers magnitude as the
+     * windowed RMS and peak/inputPeak as held and decaying peaks, so the
+     * meters can be polled at a low rate without missing peaks. Pass null to
+     * go back to raw values.
+     */
+    setBallistics(options: IVolmeterBallistics | null): void;
+}
+
+export interface IVolmeterBallistics {
+    /** Time a peak is held before it starts to fall (default 1000). */
+    peakHoldMs?: number,
+    /** Fall rate in dB per second (default 20). */
+    decayRate?: number,
+    /** Length of the RMS window (default 300). */
+    rmsWindowMs?: number
 }
 
 /**
@@ -1486,9 +1796,9 @@ export interface IModule {
 export function addItems(scene: IScene, sceneItems: ISceneItemInfo[]): ISceneItem[] {
     const items: ISceneItem[] = [];
     if (Array.isArray(sceneItems)) {
-        sceneItems.forEach(function(sceneItem) {
-            const source = obs.Input.fromName(sceneItem.name);
-            const item = scene.add(source, sceneItem);
+        const sources: IInput[] = obs.Input.fromNames(sceneItems.map(sceneItem => sceneItem.name));
+        sceneItems.forEach(function(sceneItem, index) {
+            const item = scene.add(sources[index], sceneItem);
             items.push(item);
         });
     }
@@ -1555,8 +1865,9 @@ export interface ISourceSize {
 export function getSourcesSize(sourcesNames: string[]): ISourceSize[] {
     const sourcesSize: ISourceSize[] = [];
     if (Array.isArray(sourcesNames)) {
-        sourcesNames.forEach(function (sourceName) {
-            const ObsInput = obs.Input.fromName(sourceName);
+        const inputs: IInput[] = obs.Input.fromNames(sourcesNames);
+        sourcesNames.forEach(function (sourceName, index) {
+            const ObsInput = inputs[index];
             if(ObsInput) {
                 sourcesSize.push({ name: sourceName, height: ObsInput.height, width: ObsInput.width, outputFlags: ObsInput.outputFlags });
             }
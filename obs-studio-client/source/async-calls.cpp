@@ -0,0 +1,186 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "async-calls.hpp"
+#include "controller.hpp"
+#include "osn-error.hpp"
+#include "shared.hpp"
+#include "utility.hpp"
+
+// Same messages as ValidateResponse, without throwing.
+static bool ResponseError(const std::vector<ipc::value> &response, std::string &message)
+{
+	if (response.size() == 0) {
+		message = "Failed to make IPC call, verify IPC status.";
+		return true;
+	}
+	if (response.size() == 1 && response[0].type == ipc::type::Null) {
+		message = response[0].value_str;
+		return true;
+	}
+
+	ErrorCode error = (ErrorCode)response[0].value_union.ui64;
+	if (error == ErrorCode::Ok)
+		return false;
+
+	if (response.size() == 1)
+		message = "IPC received error code " + std::to_string(uint64_t(error)) + ", no additional description provided.";
+	else
+		message = response[1].value_str;
+	return true;
+}
+
+Napi::Promise AsyncCalls::Call(Napi::Env env, RemoteMethod &method, std::vector<ipc::value> &&args, convert_t convert)
+{
+	Request *request = new Request(env);
+	Napi::Promise promise = request->deferred.Promise();
+
+	request->conn = Controller::GetInstance().GetConnection(method.GetLane());
+	if (!request->conn) {
+		request->deferred.Reject(Napi::Error::New(env, "Failed to obtain IPC connection.").Value());
+		delete request;
+		return promise;
+	}
+	request->method = &method;
+	request->args = std::move(args);
+	request->convert = std::move(convert);
+
+	Start(env);
+	// Only keep the process alive while something is waiting for an answer.
+	if (m_pending++ == 0)
+		m_settle.Ref(env);
+	m_stats.queued++;
+
+	{
+		std::unique_lock<std::mutex> ulock(m_mutex);
+		m_queue.push_back(request);
+	}
+	m_cv.notify_one();
+	return promise;
+}
+
+void AsyncCalls::Start(Napi::Env env)
+{
+	if (!m_settleCreated) {
+		m_settle = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo &info) {}), "AsyncCalls", 0, 1,
+							 [](Napi::Env) {});
+		m_settle.Unref(env);
+		m_settleCreated = true;
+	}
+
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	if (!m_threads.empty())
+		return;
+
+	m_stop = false;
+	for (size_t idx = 0; idx < ThreadCount; idx++)
+		m_threads.emplace_back(&AsyncCalls::Worker, this);
+}
+
+void AsyncCalls::Stop()
+{
+	std::deque<Request *> rejected;
+	{
+		std::unique_lock<std::mutex> ulock(m_mutex);
+		m_stop = true;
+		rejected.swap(m_queue);
+	}
+	m_cv.notify_all();
+
+	for (std::thread &thread : m_threads)
+		thread.join();
+	m_threads.clear();
+
+	// Stop runs on the JavaScript thread, so these can be settled right away.
+	for (Request *request : rejected) {
+		Napi::Env env = request->deferred.Env();
+		request->deferred.Reject(Napi::Error::New(env, "Disconnected before the call was sent.").Value());
+		m_stats.failed++;
+		if (--m_pending == 0)
+			m_settle.Unref(env);
+		delete request;
+	}
+}
+
+void AsyncCalls::Worker()
+{
+	while (true) {
+		Request *request = nullptr;
+		{
+			std::unique_lock<std::mutex> ulock(m_mutex);
+			m_cv.wait(ulock, [this] { return m_stop || !m_queue.empty(); });
+			if (m_stop)
+				return;
+			request = m_queue.front();
+			m_queue.pop_front();
+		}
+
+		uint32_t inFlight = ++m_inFlight;
+		request->response = request->method->Call(request->conn, std::move(request->args));
+		m_inFlight--;
+
+		uint32_t maxInFlight = m_maxInFlight.load();
+		while (inFlight > maxInFlight && !m_maxInFlight.compare_exchange_weak(maxInFlight, inFlight))
+			;
+
+		if (m_settle.BlockingCall(request, Settle) != napi_ok) {
+			// The function is closing with the environment, so it no longer
+			// keeps the loop alive and nothing is left to Unref. Keep the
+			// count right for the requests that still settle.
+			m_pending--;
+			delete request;
+		}
+	}
+}
+
+void AsyncCalls::Settle(Napi::Env env, Napi::Function, Request *request)
+{
+	AsyncCalls &instance = GetInstance();
+	std::unique_ptr<Request> owned(request);
+	if (--instance.m_pending == 0)
+		instance.m_settle.Unref(env);
+
+	Napi::HandleScope scope(env);
+	std::string message;
+	if (ResponseError(request->response, message)) {
+		instance.m_stats.failed++;
+		request->deferred.Reject(Napi::Error::New(env, message).Value());
+		return;
+	}
+
+	Napi::Value value = request->convert(env, request->response);
+	if (env.IsExceptionPending()) {
+		instance.m_stats.failed++;
+		request->deferred.Reject(env.GetAndClearPendingException().Value());
+		return;
+	}
+	instance.m_stats.completed++;
+	request->deferred.Resolve(value);
+}
+
+Napi::Value AsyncCalls::JSGetStats(const Napi::CallbackInfo &info)
+{
+	const Stats &stats = GetInstance().m_stats;
+
+	Napi::Object result = Napi::Object::New(info.Env());
+	result.Set("queued", Napi::Number::New(info.Env(), double(stats.queued)));
+	result.Set("completed", Napi::Number::New(info.Env(), double(stats.completed)));
+	result.Set("failed", Napi::Number::New(info.Env(), double(stats.failed)));
+	result.Set("maxInFlight", Napi::Number::New(info.Env(), GetInstance().m_maxInFlight.load()));
+	return result;
+}
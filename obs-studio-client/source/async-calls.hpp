@@ -0,0 +1,101 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <napi.h>
+#include <thread>
+#include <vector>
+#include "ipc-client.hpp"
+#include "method-table.hpp"
+
+// Promise based server calls. Requests are queued from the JavaScript thread,
+// sent by a few I/O threads so that several of them are in flight on the
+// connection at once, and settled back on the JavaScript thread through a
+// ThreadSafeFunction. The synchronous wrappers are unaffected.
+class AsyncCalls {
+public:
+	static constexpr size_t ThreadCount = 4;
+
+	// Runs on the JavaScript thread with a response that holds ErrorCode::Ok.
+	// The returned value resolves the promise, a pending exception rejects it.
+	typedef std::function<Napi::Value(Napi::Env env, const std::vector<ipc::value> &response)> convert_t;
+
+	struct Stats {
+		uint64_t queued = 0;
+		uint64_t completed = 0;
+		uint64_t failed = 0;
+	};
+
+	static AsyncCalls &GetInstance()
+	{
+		static AsyncCalls _inst;
+		return _inst;
+	}
+
+private:
+	AsyncCalls() {}
+
+public:
+	AsyncCalls(AsyncCalls const &) = delete;
+	void operator=(AsyncCalls const &) = delete;
+
+	Napi::Promise Call(Napi::Env env, RemoteMethod &method, std::vector<ipc::value> &&args, convert_t convert);
+	// Waits for the calls already sent and rejects the ones still queued.
+	// Called before disconnecting, threads start again on the next call.
+	void Stop();
+
+	static Napi::Value JSGetStats(const Napi::CallbackInfo &info);
+
+private:
+	struct Request {
+		RemoteMethod *method;
+		std::shared_ptr<ipc::client> conn;
+		std::vector<ipc::value> args;
+		std::vector<ipc::value> response;
+		convert_t convert;
+		Napi::Promise::Deferred deferred;
+
+		Request(Napi::Env env) : deferred(Napi::Promise::Deferred::New(env)) {}
+	};
+
+	void Start(Napi::Env env);
+	void Worker();
+	static void Settle(Napi::Env env, Napi::Function, Request *request);
+
+	std::mutex m_mutex;
+	std::condition_variable m_cv;
+	std::deque<Request *> m_queue;
+	std::vector<std::thread> m_threads;
+	bool m_stop = false;
+
+	Napi::ThreadSafeFunction m_settle;
+	bool m_settleCreated = false;
+	// Requests not settled yet. Ref/Unref of m_settle only happen on the
+	// JavaScript thread, a worker only decrements it when it cannot hand a
+	// request back.
+	std::atomic<uint32_t> m_pending{0};
+	std::atomic<uint32_t> m_inFlight{0};
+	std::atomic<uint32_t> m_maxInFlight{0};
+	Stats m_stats;
+};
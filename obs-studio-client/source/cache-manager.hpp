@@ -36,8 +36,12 @@ struct SourceDataInfo {
 
 	std::string setting = "";
 	bool settingsChanged = true;
+	// Bumped by every write to the two fields above. An async read only
+	// stores its result if no write happened since it was queued.
+	uint64_t settingsVersion = 0;
 
-	osn::property_map_t properties;
+	std::shared_ptr<osn::PropertySet> properties;
+	uint64_t propertiesVersion = 0;
 	bool propertiesChanged = true;
 
 	uint32_t audioMixers = UINT32_MAX;
@@ -64,6 +68,8 @@ struct SceneItemData {
 	float posX = 0;
 	float posY = 0;
 	bool posChanged = true;
+	// Same as SourceDataInfo::settingsVersion, for the position.
+	uint64_t posVersion = 0;
 
 	float scaleX = 1;
 	float scaleY = 1;
@@ -21,22 +21,38 @@
 #include "osn-error.hpp"
 #include "utility-v8.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <node.h>
 #include <sstream>
 #include <string>
+#include <unordered_map>
+#include "media-events.hpp"
+#include "method-table.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
 #include "volmeter.hpp"
 
 bool globalCallback::isWorkerRunning = false;
 bool globalCallback::worker_stop = true;
-uint32_t globalCallback::sleepIntervalMS = 50;
+std::atomic<uint32_t> globalCallback::sleepIntervalMS{50};
 std::thread *globalCallback::worker_thread = nullptr;
 Napi::ThreadSafeFunction globalCallback::js_source_callback;
 Napi::ThreadSafeFunction globalCallback::js_volmeter_callback;
+Napi::ThreadSafeFunction globalCallback::js_media_callback;
 bool globalCallback::m_all_workers_stop = false;
 std::mutex globalCallback::mtx_volmeters;
 std::unordered_set<uint64_t> globalCallback::volmeters;
+bool globalCallback::volmeter_typed = false;
+std::vector<uint64_t> globalCallback::volmeter_slots;
+std::vector<std::string> globalCallback::volmeter_slot_names;
+VolmeterFrame globalCallback::volmeter_frame;
+std::atomic<bool> globalCallback::volmeter_frame_pending{false};
+
+static constexpr uint64_t FreeSlot = UINT64_MAX;
+static std::unordered_map<uint64_t, uint32_t> volmeter_slot_index;
+static Napi::Reference<Napi::Float32Array> js_volmeter_values;
+static Napi::Reference<Napi::Uint8Array> js_volmeter_channels;
 
 void globalCallback::Init(Napi::Env env, Napi::Object exports)
 {
@@ -45,6 +61,11 @@ void globalCallback::Init(Napi::Env env, Napi::Object exports)
 
 	exports.Set(Napi::String::New(env, "RegisterVolmeterCallback"), Napi::Function::New(env, globalCallback::RegisterVolmeterCallback));
 	exports.Set(Napi::String::New(env, "RemoveVolmeterCallback"), Napi::Function::New(env, globalCallback::RemoveVolmeterCallback));
+	exports.Set(Napi::String::New(env, "GetVolmeterIndexTable"), Napi::Function::New(env, globalCallback::GetVolmeterIndexTable));
+	exports.Set(Napi::String::New(env, "SetCallbackInterval"), Napi::Function::New(env, globalCallback::SetCallbackInterval));
+
+	exports.Set(Napi::String::New(env, "RegisterMediaCallback"), Napi::Function::New(env, globalCallback::RegisterMediaCallback));
+	exports.Set(Napi::String::New(env, "RemoveMediaCallback"), Napi::Function::New(env, globalCallback::RemoveMediaCallback));
 }
 
 Napi::Value globalCallback::RegisterSourceCallback(const Napi::CallbackInfo &info)
@@ -71,6 +92,13 @@ Napi::Value globalCallback::RemoveSourceCallback(const Napi::CallbackInfo &info)
 Napi::Value globalCallback::RegisterVolmeterCallback(const Napi::CallbackInfo &info)
 {
 	Napi::Function async_callback = info[0].As<Napi::Function>();
+	bool typed = info.Length() > 1 && info[1].ToBoolean().Value();
+
+	{
+		std::unique_lock<std::mutex> ulock(mtx_volmeters);
+		volmeter_typed = typed;
+		volmeter_frame_pending = false;
+	}
 	js_volmeter_callback = Napi::ThreadSafeFunction::New(info.Env(), async_callback, "VolmeterCallback", 0, 1, [](Napi::Env) {});
 
 	return Napi::Boolean::New(info.Env(), true);
@@ -79,9 +107,62 @@ Napi::Value globalCallback::RegisterVolmeterCallback(const Napi::CallbackInfo &i
 Napi::Value globalCallback::RemoveVolmeterCallback(const Napi::CallbackInfo &info)
 {
 	js_volmeter_callback.Release();
+	js_volmeter_values.Reset();
+	js_volmeter_channels.Reset();
+	return info.Env().Undefined();
+}
+
+// Events are delivered by the source callback worker, so RegisterSourceCallback
+// must be running as well. The optional interval rate limits the position
+// updates of playing sources, state changes are always sent.
+Napi::Value globalCallback::RegisterMediaCallback(const Napi::CallbackInfo &info)
+{
+	Napi::Function async_callback = info[0].As<Napi::Function>();
+
+	if (info.Length() > 1 && info[1].IsNumber()) {
+		auto conn = GetConnection(info);
+		if (!conn)
+			return info.Env().Undefined();
+
+		std::vector<ipc::value> response = conn->call_synchronous_helper("MediaEvents", "SetInterval", {ipc::value(info[1].ToNumber().Uint32Value())});
+		if (!ValidateResponse(info, response))
+			return info.Env().Undefined();
+	}
+
+	// Registering again replaces the callback.
+	if (js_media_callback)
+		js_media_callback.Release();
+	js_media_callback = Napi::ThreadSafeFunction::New(info.Env(), async_callback, "MediaCallback", 0, 1, [](Napi::Env) {});
+
+	return Napi::Boolean::New(info.Env(), true);
+}
+
+Napi::Value globalCallback::RemoveMediaCallback(const Napi::CallbackInfo &info)
+{
+	if (js_media_callback)
+		js_media_callback.Release();
+	js_media_callback = Napi::ThreadSafeFunction();
 	return info.Env().Undefined();
 }
 
+Napi::Value globalCallback::GetVolmeterIndexTable(const Napi::CallbackInfo &info)
+{
+	std::unique_lock<std::mutex> ulock(mtx_volmeters);
+
+	Napi::Array table = Napi::Array::New(info.Env());
+	uint32_t count = 0;
+	for (uint32_t slot = 0; slot < volmeter_slots.size(); slot++) {
+		if (volmeter_slots[slot] == FreeSlot)
+			continue;
+
+		Napi::Object entry = Napi::Object::New(info.Env());
+		entry.Set("index", Napi::Number::New(info.Env(), slot));
+		entry.Set("sourceName", Napi::String::New(info.Env(), volmeter_slot_names[slot]));
+		table.Set(count++, entry);
+	}
+	return table;
+}
+
 void globalCallback::start_worker(napi_env env, Napi::Function async_callback)
 {
 	if (!worker_stop)
@@ -102,6 +183,106 @@ void globalCallback::stop_worker(void)
 	js_source_callback.Release();
 }
 
+// With server-side ballistics the meters no longer need every update, so the
+// worker can poll less often.
+Napi::Value globalCallback::SetCallbackInterval(const Napi::CallbackInfo &info)
+{
+	uint32_t interval = info[0].ToNumber().Uint32Value();
+	sleepIntervalMS = std::min<uint32_t>(std::max<uint32_t>(interval, 10), 1000);
+	return info.Env().Undefined();
+}
+
+// Writes this tick's values into the staging frame and records the range of
+// slots that changed. Returns true if there is something to deliver. Skipped
+// while the JS thread still copies the previous frame, the next one carries
+// the newer values anyway. `ids` are the volmeters the query asked for, called
+// with mtx_volmeters held.
+static bool fill_volmeter_frame(const std::vector<ipc::value> &response, uint32_t index, const std::vector<uint64_t> &ids)
+{
+	using namespace globalCallback;
+
+	if (volmeter_frame_pending)
+		return false;
+
+	VolmeterFrame &frame = volmeter_frame;
+	frame.first = 0;
+	frame.count = 0;
+
+	uint32_t dirtyFirst = UINT32_MAX;
+	uint32_t dirtyLast = 0;
+	auto markDirty = [&](uint32_t slot) {
+		dirtyFirst = std::min(dirtyFirst, slot);
+		dirtyLast = std::max(dirtyLast, slot);
+	};
+
+	if (frame.channels.size() != volmeter_slots.size()) {
+		frame.channels.resize(volmeter_slots.size(), 0);
+		frame.values.resize(volmeter_slots.size() * VolmeterSlotStride, 0.0f);
+	}
+
+	for (uint32_t slot = 0; slot < volmeter_slots.size(); slot++) {
+		if (volmeter_slots[slot] == FreeSlot && frame.channels[slot] != 0) {
+			frame.channels[slot] = 0;
+			markDirty(slot);
+		}
+	}
+
+	for (auto vol : ids) {
+		if (index + 3 > response.size())
+			break;
+
+		const std::string &name = response[index++].value_str;
+		size_t channels = response[index++].value_union.i32;
+		bool isMuted = response[index++].value_union.i32;
+
+		// Removed while the query was in flight.
+		auto found = volmeter_slot_index.find(vol);
+		if (found == volmeter_slot_index.end()) {
+			if (!isMuted)
+				index += uint32_t(3 * channels);
+			continue;
+		}
+
+		uint32_t slot = found->second;
+		if (volmeter_slot_names[slot] != name)
+			volmeter_slot_names[slot] = name;
+
+		if (isMuted) {
+			if (frame.channels[slot] != 0) {
+				frame.channels[slot] = 0;
+				markDirty(slot);
+			}
+			continue;
+		}
+
+		if (index + 3 * channels > response.size())
+			break;
+
+		size_t used = std::min<size_t>(channels, VolmeterMaxChannels);
+		bool changed = frame.channels[slot] != used;
+		float *values = frame.values.data() + size_t(slot) * VolmeterSlotStride;
+		for (size_t idx = 0; idx < used * VolmeterValuesPerChannel; idx++) {
+			float value = response[index + idx].value_union.fp32;
+			if (values[idx] != value) {
+				values[idx] = value;
+				changed = true;
+			}
+		}
+		frame.channels[slot] = uint8_t(used);
+		if (changed)
+			markDirty(slot);
+
+		index += uint32_t(3 * channels);
+	}
+
+	if (dirtyFirst == UINT32_MAX)
+		return false;
+
+	frame.first = dirtyFirst;
+	frame.count = dirtyLast - dirtyFirst + 1;
+	return true;
+}
+
 void globalCallback::worker()
 {
 	auto sources_callback = [](Napi::Env env, Napi::Function jsCallback, SourceSizeInfoData *data) {
@@ -159,29 +340,94 @@ void globalCallback::worker()
 		delete dataArray;
 	};
 
-	size_t totalSleepMS = 0;
+	// Runs on the JS thread while the worker leaves the frame alone. Only the
+	// dirty slots are copied, the typed arrays are reallocated only when the
+	// number of slots grows.
+	auto volmeter_typed_callback = [](Napi::Env env, Napi::Function jsCallback, VolmeterFrame *frame) {
+		// Called without an environment when the callback was removed meanwhile.
+		if (env == nullptr) {
+			volmeter_frame_pending = false;
+			return;
+		}
+
+		try {
+			uint32_t slots = uint32_t(frame->channels.size());
+			uint32_t first = frame->first;
+			uint32_t count = frame->count;
+
+			if (js_volmeter_channels.IsEmpty() || js_volmeter_channels.Value().ElementLength() != slots) {
+				js_volmeter_values = Napi::Persistent(Napi::Float32Array::New(env, size_t(slots) * VolmeterSlotStride));
+				js_volmeter_values.SuppressDestruct();
+				js_volmeter_channels = Napi::Persistent(Napi::Uint8Array::New(env, slots));
+				js_volmeter_channels.SuppressDestruct();
+				first = 0;
+				count = slots;
+			}
+
+			Napi::Float32Array values = js_volmeter_values.Value();
+			Napi::Uint8Array channels = js_volmeter_channels.Value();
+			std::memcpy(values.Data() + size_t(first) * VolmeterSlotStride, frame->values.data() + size_t(first) * VolmeterSlotStride,
+				    size_t(count) * VolmeterSlotStride * sizeof(float));
+			std::memcpy(channels.Data() + first, frame->channels.data() + first, count);
+			volmeter_frame_pending = false;
+
+			if (count)
+				jsCallback.Call({values, channels, Napi::Number::New(env, first), Napi::Number::New(env, count)});
+		} catch (...) {
+		}
+
+		volmeter_frame_pending = false;
+	};
+
+	auto media_callback = [](Napi::Env env, Napi::Function jsCallback, std::vector<media::Event> *events) {
+		if (env == nullptr) {
+			delete events;
+			return;
+		}
+
+		try {
+			Napi::Array result = Napi::Array::New(env, events->size());
+
+			for (size_t i = 0; i < events->size(); i++) {
+				const media::Event &event = (*events)[i];
+				Napi::Object obj = Napi::Object::New(env);
+				obj.Set("handle", Napi::Number::New(env, double(event.uid)));
+				obj.Set("state", Napi::Number::New(env, event.state));
+				obj.Set("reason", Napi::Number::New(env, event.reason));
+				obj.Set("time", Napi::Number::New(env, double(event.time_ms)));
+				obj.Set("duration", Napi::Number::New(env, double(event.duration_ms)));
+				result.Set(i, obj);
+			}
+			jsCallback.Call({result});
+		} catch (...) {
+		}
+		delete events;
+	};
+
+	int64_t totalSleepMS = 0;
 
 	while (!worker_stop && !m_all_workers_stop) {
 		auto tp_start = std::chrono::high_resolution_clock::now();
 
-		auto conn = Controller::GetInstance().GetConnection();
+		auto conn = Controller::GetInstance().GetConnection(Lane::Realtime);
 		if (!conn)
 			return;
 
-		mtx_volmeters.lock();
-		std::vector<char> volmeters_ids;
+		// Not held across the query, add_volmeter and remove_volmeter run on
+		// the JavaScript thread.
+		std::vector<uint64_t> ids;
 		{
-			uint32_t index = 0;
-			volmeters_ids.resize(sizeof(uint64_t) * volmeters.size());
-			for (auto vol : volmeters) {
-				*reinterpret_cast<uint64_t *>(volmeters_ids.data() + index) = vol;
-				index += sizeof(uint64_t);
-			}
+			std::unique_lock<std::mutex> ulock(mtx_volmeters);
+			ids.assign(volmeters.begin(), volmeters.end());
 		}
 
+		std::vector<char> volmeters_ids(sizeof(uint64_t) * ids.size());
+		if (!ids.empty())
+			std::memcpy(volmeters_ids.data(), ids.data(), volmeters_ids.size());
+
 		{
-			std::vector<ipc::value> response = conn->call_synchronous_helper(
-				"CallbackManager", "GlobalQuery", {ipc::value((uint64_t)volmeters_ids.size()), ipc::value(volmeters_ids)});
+			static RemoteMethod globalQuery("CallbackManager", "GlobalQuery", Lane::Realtime);
+			std::vector<ipc::value> response = globalQuery.Call(conn, {ipc::value((uint64_t)volmeters_ids.size()), ipc::value(volmeters_ids)});
 			if (!response.size() || (response.size() == 1)) {
 				goto do_sleep;
 			}
@@ -209,8 +455,34 @@ void globalCallback::worker()
 
 			index++;
 
+			// Media events sit between the sizes and the volmeters.
+			if (index < response.size() && response[index].type == ipc::type::Binary) {
+				const std::vector<char> &packed = response[index++].value_bin;
+				size_t count = packed.size() / sizeof(media::Event);
+				if (count && js_media_callback) {
+					auto events = new std::vector<media::Event>(count);
+					std::memcpy(events->data(), packed.data(), count * sizeof(media::Event));
+					napi_status status = js_media_callback.NonBlockingCall(events, media_callback);
+					if (status != napi_ok)
+						delete events;
+				}
+			}
+
+			std::unique_lock<std::mutex> ulock(mtx_volmeters);
+			if (volmeter_typed) {
+				if (fill_volmeter_frame(response, index, ids) && js_volmeter_callback) {
+					volmeter_frame_pending = true;
+					napi_status status = js_volmeter_callback.NonBlockingCall(&volmeter_frame, volmeter_typed_callback);
+					if (status != napi_ok)
+						volmeter_frame_pending = false;
+				}
+				goto do_sleep;
+			}
+
+			ulock.unlock();
+
 			auto volmeterDataArray = new VolmeterDataArray;
-			for (auto vol : volmeters) {
+			for (size_t idx = 0; idx < ids.size(); idx++) {
 				VolmeterData *item = new VolmeterData{{}, {}, {}};
 
 				item->source_name = response[index++].value_str;
@@ -243,7 +515,6 @@ void globalCallback::worker()
 		}
 
 	do_sleep:
-		mtx_volmeters.unlock();
 		auto tp_end = std::chrono::high_resolution_clock::now();
 		auto dur = std::chrono::duration_cast<std::chrono::milliseconds>(tp_end - tp_start);
 		totalSleepMS = sleepIntervalMS - dur.count();
@@ -255,10 +526,38 @@ void globalCallback::worker()
 
 void globalCallback::add_volmeter(uint64_t id)
 {
+	std::unique_lock<std::mutex> ulock(mtx_volmeters);
 	volmeters.insert(id);
+
+	// Slots are reused but never move, so indices handed out stay valid.
+	auto free = std::find(volmeter_slots.begin(), volmeter_slots.end(), FreeSlot);
+	uint32_t slot = uint32_t(free - volmeter_slots.begin());
+	if (free == volmeter_slots.end()) {
+		volmeter_slots.push_back(id);
+		volmeter_slot_names.emplace_back();
+	} else {
+		*free = id;
+		volmeter_slot_names[slot].clear();
+	}
+	volmeter_slot_index[id] = slot;
 }
 
 void globalCallback::remove_volmeter(uint64_t id)
 {
+	std::unique_lock<std::mutex> ulock(mtx_volmeters);
 	volmeters.erase(id);
+
+	auto found = volmeter_slot_index.find(id);
+	if (found == volmeter_slot_index.end())
+		return;
+	volmeter_slots[found->second] = FreeSlot;
+	volmeter_slot_names[found->second].clear();
+	volmeter_slot_index.erase(found);
+}
+
+int32_t globalCallback::volmeter_index(uint64_t id)
+{
+	std::unique_lock<std::mutex> ulock(mtx_volmeters);
+	auto found = volmeter_slot_index.find(id);
+	return found == volmeter_slot_index.end() ? -1 : int32_t(found->second);
 }
\ No newline at end of file
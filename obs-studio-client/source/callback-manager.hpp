@@ -16,6 +16,7 @@
 
 ******************************************************************************/
 
+#include <atomic>
 #include <mutex>
 #include <napi.h>
 #include <thread>
@@ -33,24 +34,49 @@ struct SourceSizeInfoData {
 	std::vector<std::unique_ptr<SourceSizeInfo>> items;
 };
 
+// Typed volmeter delivery. Every meter owns a fixed slot of
+// VolmeterMaxChannels * 3 floats laid out as [channel][magnitude, peak,
+// inputPeak], plus its channel count (0 while muted). The worker fills this
+// staging copy and the JS thread copies the dirty slots into the
+// preallocated typed arrays.
+constexpr uint32_t VolmeterMaxChannels = 8;
+constexpr uint32_t VolmeterValuesPerChannel = 3;
+constexpr uint32_t VolmeterSlotStride = VolmeterMaxChannels * VolmeterValuesPerChannel;
+
+struct VolmeterFrame {
+	std::vector<float> values;
+	std::vector<uint8_t> channels;
+	uint32_t first = 0;
+	uint32_t count = 0;
+};
+
 namespace globalCallback {
 extern bool isWorkerRunning;
 extern bool worker_stop;
-extern uint32_t sleepIntervalMS;
+extern std::atomic<uint32_t> sleepIntervalMS;
 extern std::thread *worker_thread;
 extern Napi::ThreadSafeFunction js_source_callback;
 extern Napi::ThreadSafeFunction js_volmeter_callback;
+extern Napi::ThreadSafeFunction js_media_callback;
 extern bool m_all_workers_stop;
 
 extern std::mutex mtx_volmeters;
 extern std::unordered_set<uint64_t> volmeters;
 
+extern bool volmeter_typed;
+extern std::vector<uint64_t> volmeter_slots;
+extern std::vector<std::string> volmeter_slot_names;
+extern VolmeterFrame volmeter_frame;
+extern std::atomic<bool> volmeter_frame_pending;
+
 void worker(void);
 void start_worker(napi_env env, Napi::Function async_callback);
 void stop_worker(void);
 
 void add_volmeter(uint64_t id);
 void remove_volmeter(uint64_t id);
+// Slot of the meter in the typed arrays, -1 if unknown.
+int32_t volmeter_index(uint64_t id);
 
 void Init(Napi::Env env, Napi::Object exports);
 
@@ -59,4 +85,9 @@ Napi::Value RemoveSourceCallback(const Napi::CallbackInfo &info);
 
 Napi::Value RegisterVolmeterCallback(const Napi::CallbackInfo &info);
 Napi::Value RemoveVolmeterCallback(const Napi::CallbackInfo &info);
+Napi::Value GetVolmeterIndexTable(const Napi::CallbackInfo &info);
+Napi::Value SetCallbackInterval(const Napi::CallbackInfo &info);
+
+Napi::Value RegisterMediaCallback(const Napi::CallbackInfo &info);
+Napi::Value RemoveMediaCallback(const Napi::CallbackInfo &info);
 }
\ No newline at end of file
@@ -17,14 +17,23 @@
 ******************************************************************************/
 
 #include "controller.hpp"
+#include <chrono>
 #include <codecvt>
 #include <fstream>
 #include <sstream>
 #include <locale>
 #include <sstream>
 #include <string>
+#include <thread>
+#include "async-calls.hpp"
+#include "lanes.hpp"
+#include "method-table.hpp"
+#include "osn-error.hpp"
 #include "shared.hpp"
+#include "shared-memory.hpp"
+#include "startup-signal.hpp"
 #include "utility.hpp"
+#include "write-behind.hpp"
 
 static std::string serverBinaryPath = "";
 static std::string serverWorkingPath = "";
@@ -276,10 +285,12 @@ std::shared_ptr<ipc::client> Controller::host(const std::string &uri)
 
 	check_pid_file(pid_path);
 
+	auto spawnStart = std::chrono::high_resolution_clock::now();
 	procId = spawn(serverBinaryPath, commandLine.str(), workingDirectory);
 	if (procId.id == 0) {
 		return nullptr;
 	}
+	m_startup.spawnMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - spawnStart).count();
 
 	write_pid_file(pid_path, procId.id);
 
@@ -312,7 +323,9 @@ std::shared_ptr<ipc::client> Controller::host(const std::string &uri)
 	char *argv[] = {"obs64", uri_str.data(), (char *)version.c_str(), (char *)serverBinaryPath.c_str(), NULL};
 	remove(uri.c_str());
 
+	auto spawnStart = std::chrono::high_resolution_clock::now();
 	int ret = posix_spawnp(&pid, serverBinaryPath.c_str(), NULL, NULL, argv, environ);
+	m_startup.spawnMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - spawnStart).count();
 	// Connect
 	std::shared_ptr<ipc::client> cl = connect(uri);
 	if (!cl) { // Assume the server broke or was not allowed to run.
@@ -336,16 +349,24 @@ std::shared_ptr<ipc::client> Controller::connect(const std::string &uri)
 	if (m_connection)
 		return nullptr;
 
-	std::shared_ptr<ipc::client> cl;
-	using std::chrono::high_resolution_clock;
-	while (!cl) {
-		try {
-			std::string path;
+	std::string path;
 #ifdef WIN32
-			path = uri;
+	path = uri;
 #else
-			path = "/tmp/" + uri;
+	path = "/tmp/" + uri;
 #endif
+
+	// The server sets this once its socket listens, so the first attempt
+	// after the wait normally succeeds.
+	std::unique_ptr<startup::ReadySignal> readySignal = startup::ReadySignal::Create(path);
+
+	std::shared_ptr<ipc::client> cl;
+	auto connectStart = std::chrono::high_resolution_clock::now();
+	m_startup.attempts = 0;
+	bool signaled = false;
+	while (!cl) {
+		m_startup.attempts++;
+		try {
 			cl = ipc::client::create(path);
 		} catch (...) {
 			cl = nullptr;
@@ -362,22 +383,49 @@ std::shared_ptr<ipc::client> Controller::connect(const std::string &uri)
 #endif
 		}
 
-		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		if (!readySignal) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			continue;
+		}
+
+		// Signaled but still refused: left behind by a server that is gone.
+		if (signaled)
+			readySignal->Reset();
+
+		// The timeout still catches servers that never set the signal.
+		signaled = readySignal->Wait(250, uint64_t(procId.handle)) == startup::ReadySignal::WaitResult::Ready;
 	}
+	m_startup.connectMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - connectStart).count();
 	if (!cl) {
 		return nullptr;
 	}
 
 	m_connection = cl;
+	// Falls back to sending every payload through the socket if this fails.
+	SharedMemory::GetInstance().Negotiate(m_connection);
+	// Calls go by name until the table is loaded.
+	MethodTable::GetInstance().Load(m_connection);
+	// Served by its own worker on the server, calls stay on the standard lane if it fails.
+	try {
+		m_realtime = ipc::client::create(path);
+	} catch (...) {
+		m_realtime = nullptr;
+	}
 	return m_connection;
 }
 
 void Controller::disconnect()
 {
+	WriteBehind::GetInstance().Flush();
+	AsyncCalls::GetInstance().Stop();
+	m_realtime = nullptr;
 	if (m_isServer) {
 		m_connection->call_synchronous_helper("System", "Shutdown", {});
 		m_isServer = false;
 	}
+	SharedMemory::GetInstance().Reset();
+	WriteBehind::GetInstance().Reset();
+	MethodTable::GetInstance().Reset();
 	m_connection = nullptr;
 }
 
@@ -386,11 +434,18 @@ DWORD Controller::GetExitCode()
 	return procId.exit_code;
 }
 
-std::shared_ptr<ipc::client> Controller::GetConnection()
+std::shared_ptr<ipc::client> Controller::GetConnection(Lane lane)
 {
+	if (lane == Lane::Realtime && m_realtime)
+		return m_realtime;
 	return m_connection;
 }
 
+bool Controller::HasLane(Lane lane)
+{
+	return lane == Lane::Standard ? bool(m_connection) : bool(m_realtime);
+}
+
 Napi::Value js_setServerPath(const Napi::CallbackInfo &info)
 {
 	if (info.Length() == 0) {
@@ -475,6 +530,58 @@ Napi::Value js_host(const Napi::CallbackInfo &info)
 	return Napi::Number::New(info.Env(), exit_code);
 }
 
+Napi::Value js_getStartupMetrics(const Napi::CallbackInfo &info)
+{
+	const Controller::StartupMetrics &metrics = Controller::GetInstance().GetStartupMetrics();
+
+	Napi::Object result = Napi::Object::New(info.Env());
+	result.Set("spawnMs", Napi::Number::New(info.Env(), metrics.spawnMs));
+	result.Set("connectMs", Napi::Number::New(info.Env(), metrics.connectMs));
+	result.Set("attempts", Napi::Number::New(info.Env(), metrics.attempts));
+
+	auto conn = Controller::GetInstance().GetConnection();
+	if (conn) {
+		std::vector<ipc::value> response = conn->call_synchronous_helper("System", "GetStartupMetrics", {});
+		if (response.size() == 3 && (ErrorCode)response[0].value_union.ui64 == ErrorCode::Ok) {
+			result.Set("serverInitMs", Napi::Number::New(info.Env(), response[1].value_union.fp64));
+			result.Set("serverFirstConnectMs", Napi::Number::New(info.Env(), response[2].value_union.fp64));
+		}
+	}
+	return result;
+}
+
+Napi::Value js_startCapture(const Napi::CallbackInfo &info)
+{
+	if (info.Length() < 1 || !info[0].IsString()) {
+		Napi::Error::New(info.Env(), "Too few arguments, usage: startCapture(<string> path).").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	// Setters still waiting in the queue belong before the capture.
+	WriteBehind::GetInstance().Flush();
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Capture", "Start", {ipc::value(info[0].ToString().Utf8Value())});
+	ValidateResponse(info, response);
+	return info.Env().Undefined();
+}
+
+Napi::Value js_stopCapture(const Napi::CallbackInfo &info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	WriteBehind::GetInstance().Flush();
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Capture", "Stop", {});
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return Napi::Number::New(info.Env(), double(response[1].value_union.ui64));
+}
+
 Napi::Value js_disconnect(const Napi::CallbackInfo &info)
 {
 	Controller::GetInstance().disconnect();
@@ -488,5 +595,15 @@ void Controller::Init(Napi::Env env, Napi::Object exports)
 	obj.Set(Napi::String::New(env, "connect"), Napi::Function::New(env, js_connect));
 	obj.Set(Napi::String::New(env, "host"), Napi::Function::New(env, js_host));
 	obj.Set(Napi::String::New(env, "disconnect"), Napi::Function::New(env, js_disconnect));
+	obj.Set(Napi::String::New(env, "getStartupMetrics"), Napi::Function::New(env, js_getStartupMetrics));
+	obj.Set(Napi::String::New(env, "startCapture"), Napi::Function::New(env, js_startCapture));
+	obj.Set(Napi::String::New(env, "stopCapture"), Napi::Function::New(env, js_stopCapture));
+	obj.Set(Napi::String::New(env, "benchmarkTransport"), Napi::Function::New(env, SharedMemory::BenchmarkTransport));
+	obj.Set(Napi::String::New(env, "benchmarkDispatch"), Napi::Function::New(env, MethodTable::JSBenchmark));
+	obj.Set(Napi::String::New(env, "getAsyncStats"), Napi::Function::New(env, AsyncCalls::JSGetStats));
+	obj.Set(Napi::String::New(env, "getLaneStats"), Napi::Function::New(env, LaneStats::JSGetStats));
+	obj.Set(Napi::String::New(env, "benchmarkLanes"), Napi::Function::New(env, LaneStats::JSBenchmark));
+	obj.Set(Napi::String::New(env, "flushWrites"), Napi::Function::New(env, WriteBehind::JSFlush));
+	obj.Set(Napi::String::New(env, "getWriteStats"), Napi::Function::New(env, WriteBehind::JSGetStats));
 	exports.Set("IPC", obj);
 }
@@ -23,6 +23,7 @@
 #include "ipc.hpp"
 #include "ipc-client.hpp"
 #include <napi.h>
+#include "lanes.hpp"
 
 class Controller {
 public:
@@ -51,10 +52,22 @@ public:
 
 	void disconnect();
 
-	std::shared_ptr<ipc::client> GetConnection();
+	// Lanes without a connection of their own share the standard one.
+	std::shared_ptr<ipc::client> GetConnection(Lane lane = Lane::Standard);
+	bool HasLane(Lane lane);
+
+	// Timings of the last host/connect, in milliseconds.
+	struct StartupMetrics {
+		double spawnMs = 0.0;
+		double connectMs = 0.0;
+		uint32_t attempts = 0;
+	};
+	const StartupMetrics &GetStartupMetrics() { return m_startup; }
 
 private:
 	bool m_isServer = false;
+	StartupMetrics m_startup;
 	std::shared_ptr<ipc::client> m_connection;
+	std::shared_ptr<ipc::client> m_realtime;
 	ipc::ProcessInfo procId;
 };
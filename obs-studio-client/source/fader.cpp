@@ -23,6 +23,7 @@
 #include "osn-error.hpp"
 #include "input.hpp"
 #include "shared.hpp"
+#include "write-behind.hpp"
 #include <iostream>
 
 Napi::FunctionReference osn::Fader::constructor;
@@ -60,6 +61,7 @@ osn::Fader::Fader(const Napi::CallbackInfo &info) : Napi::ObjectWrap<osn::Fader>
 	}
 
 	this->uid = (uint64_t)info[0].ToNumber().Int64Value();
+	this->sourceId = WriteBehind::NoSource;
 }
 
 Napi::Value osn::Fader::Create(const Napi::CallbackInfo &info)
@@ -89,6 +91,8 @@ Napi::Value osn::Fader::GetDeziBel(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	// dB, deflection and multiplier are views on the same value.
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Fader", "GetDeziBel",
 									 {
 										 ipc::value(this->uid),
@@ -108,7 +112,7 @@ void osn::Fader::SetDezibel(const Napi::CallbackInfo &info, const Napi::Value &v
 	if (!conn)
 		return;
 
-	conn->call("Fader", "SetDeziBel", {ipc::value(this->uid), ipc::value(db)});
+	WriteBehind::GetInstance().Queue(info.Env(), batch::Setter::FaderSetDeziBel, this->uid, {ipc::value(this->uid), ipc::value(db)}, this->sourceId);
 }
 
 Napi::Value osn::Fader::GetDeflection(const Napi::CallbackInfo &info)
@@ -117,6 +121,8 @@ Napi::Value osn::Fader::GetDeflection(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	// dB, deflection and multiplier are views on the same value.
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Fader", "GetDeflection",
 									 {
 										 ipc::value(this->uid),
@@ -136,7 +142,8 @@ void osn::Fader::SetDeflection(const Napi::CallbackInfo &info, const Napi::Value
 	if (!conn)
 		return;
 
-	conn->call("Fader", "SetDeflection", {ipc::value(this->uid), ipc::value(deflection)});
+	WriteBehind::GetInstance().Queue(info.Env(), batch::Setter::FaderSetDeflection, this->uid, {ipc::value(this->uid), ipc::value(deflection)},
+					 this->sourceId);
 }
 
 Napi::Value osn::Fader::GetMultiplier(const Napi::CallbackInfo &info)
@@ -145,6 +152,8 @@ Napi::Value osn::Fader::GetMultiplier(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	// dB, deflection and multiplier are views on the same value.
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Fader", "GetMultiplier",
 									 {
 										 ipc::value(this->uid),
@@ -164,7 +173,7 @@ void osn::Fader::SetMultiplier(const Napi::CallbackInfo &info, const Napi::Value
 	if (!conn)
 		return;
 
-	conn->call("Fader", "SetMultiplier", {ipc::value(this->uid), ipc::value(mul)});
+	WriteBehind::GetInstance().Queue(info.Env(), batch::Setter::FaderSetMultiplier, this->uid, {ipc::value(this->uid), ipc::value(mul)}, this->sourceId);
 }
 
 Napi::Value osn::Fader::Destroy(const Napi::CallbackInfo &info)
@@ -173,6 +182,7 @@ Napi::Value osn::Fader::Destroy(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	conn->call_synchronous_helper("Fader", "Destroy", {ipc::value(this->uid)});
 
 	return info.Env().Undefined();
@@ -186,11 +196,15 @@ Napi::Value osn::Fader::Attach(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	// Pending writes go to the source the fader was attached to when they were made.
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Fader", "Attach", {ipc::value(this->uid), ipc::value(input->sourceId)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
+	this->sourceId = input->sourceId;
+
 	return info.Env().Undefined();
 }
 
@@ -200,10 +214,13 @@ Napi::Value osn::Fader::Detach(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Fader", "Detach", {ipc::value(this->uid)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
+	this->sourceId = WriteBehind::NoSource;
+
 	return info.Env().Undefined();
 }
\ No newline at end of file
@@ -25,6 +25,8 @@ namespace osn {
 class Fader : public Napi::ObjectWrap<osn::Fader> {
 public:
 	uint64_t uid;
+	// Input the fader is attached to, WriteBehind::NoSource if none.
+	uint64_t sourceId;
 
 public:
 	static Napi::FunctionReference constructor;
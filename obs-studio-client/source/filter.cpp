@@ -159,6 +159,7 @@ Napi::Value osn::Filter::CallGetSettings(const Napi::CallbackInfo &info)
 	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
 	if (sdi && sdi->obs_sourceId.compare("vst_filter") == 0) {
 		sdi->settingsChanged = true;
+		sdi->settingsVersion++;
 	}
 	return ret;
 }
@@ -255,6 +256,7 @@ Napi::Value osn::Filter::CallUpdate(const Napi::CallbackInfo &info)
 	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
 	if (sdi && sdi->obs_sourceId.compare("vst_filter") == 0) {
 		sdi->settingsChanged = true;
+		sdi->settingsVersion++;
 	}
 
 	return info.Env().Undefined();
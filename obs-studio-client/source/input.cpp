@@ -27,7 +27,9 @@
 #include "filter.hpp"
 #include "ipc-value.hpp"
 #include "shared.hpp"
+#include "source-states.hpp"
 #include "utility.hpp"
+#include "write-behind.hpp"
 
 Napi::FunctionReference osn::Input::constructor;
 
@@ -40,6 +42,8 @@ Napi::Object osn::Input::Init(Napi::Env env, Napi::Object exports)
 			     StaticMethod("create", &osn::Input::Create),
 			     StaticMethod("createPrivate", &osn::Input::CreatePrivate),
 			     StaticMethod("fromName", &osn::Input::FromName),
+			     StaticMethod("fromNames", &osn::Input::FromNames),
+			     StaticMethod("getStates", &osn::Input::GetStates),
 			     StaticMethod("getPublicSources", &osn::Input::GetPublicSources),
 
 			     InstanceMethod("duplicate", &osn::Input::Duplicate),
@@ -77,6 +81,7 @@ Napi::Object osn::Input::Init(Napi::Env env, Napi::Object exports)
 
 			     InstanceMethod("release", &osn::Input::CallRelease),
 			     InstanceMethod("remove", &osn::Input::CallRemove),
+			     InstanceMethod("getSettingsAsync", &osn::Input::CallGetSettingsAsync),
 			     InstanceMethod("update", &osn::Input::CallUpdate),
 			     InstanceMethod("load", &osn::Input::CallLoad),
 			     InstanceMethod("save", &osn::Input::CallSave),
@@ -91,6 +96,8 @@ Napi::Object osn::Input::Init(Napi::Env env, Napi::Object exports)
 			     InstanceMethod("restart", &osn::Input::Restart),
 			     InstanceMethod("stop", &osn::Input::Stop),
 			     InstanceMethod("getMediaState", &osn::Input::GetMediaState),
+			     InstanceMethod("subscribeMediaEvents", &osn::Input::SubscribeMediaEvents),
+			     InstanceMethod("unsubscribeMediaEvents", &osn::Input::UnsubscribeMediaEvents),
 			     InstanceMethod("callHandler", &osn::Input::CallCallHandler)});
 	exports.Set("Input", func);
 	osn::Input::constructor = Napi::Persistent(func);
@@ -118,6 +125,7 @@ Napi::Value osn::Input::Types(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "Types", {});
 
 	if (!ValidateResponse(info, response))
@@ -160,6 +168,7 @@ Napi::Value osn::Input::Create(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	auto params = std::vector<ipc::value>{ipc::value(type), ipc::value(name)};
 	if (settings.Utf8Value().length() != 0) {
 		std::string value;
@@ -213,6 +222,7 @@ Napi::Value osn::Input::CreatePrivate(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	auto params = std::vector<ipc::value>{ipc::value(type), ipc::value(name)};
 	if (settings.Utf8Value().length() != 0) {
 		std::string value;
@@ -256,6 +266,7 @@ Napi::Value osn::Input::FromName(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "FromName", {ipc::value(name)});
 
 	if (!ValidateResponse(info, response))
@@ -266,12 +277,135 @@ Napi::Value osn::Input::FromName(const Napi::CallbackInfo &info)
 	return instance;
 }
 
+Napi::Value osn::Input::FromNames(const Napi::CallbackInfo &info)
+{
+	Napi::Array names = info[0].As<Napi::Array>();
+	Napi::Array result = Napi::Array::New(info.Env(), names.Length());
+
+	// Names already in the cache are resolved here, every other name goes
+	// to the server in one call.
+	std::vector<uint32_t> pending;
+	std::vector<char> packed;
+	for (uint32_t idx = 0; idx < names.Length(); idx++) {
+		std::string name = names.Get(idx).ToString().Utf8Value();
+
+		SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(name);
+		if (sdi) {
+			result.Set(idx, osn::Input::constructor.New({Napi::Number::New(info.Env(), sdi->id)}));
+			continue;
+		}
+
+		result.Set(idx, info.Env().Undefined());
+		pending.push_back(idx);
+		packed.insert(packed.end(), name.begin(), name.end());
+		packed.push_back('\0');
+	}
+
+	if (pending.empty())
+		return result;
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	WriteBehind::GetInstance().Flush();
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "FromNames", {ipc::value(packed)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	for (size_t idx = 0; idx < pending.size() && idx + 1 < response.size(); idx++) {
+		uint64_t uid = response[idx + 1].value_union.ui64;
+		if (uid == UINT64_MAX)
+			continue;
+
+		result.Set(pending[idx], osn::Input::constructor.New({Napi::Number::New(info.Env(), uid)}));
+	}
+
+	return result;
+}
+
+static Napi::Value StateArray(Napi::Env env, states::Field field, const states::Layout &layout, Napi::ArrayBuffer buffer)
+{
+	size_t offset = layout.Offset(field);
+	switch (field) {
+	case states::Field::Volume:
+		return Napi::Float32Array::New(env, layout.Count(), buffer, offset);
+	case states::Field::SyncOffset:
+		return Napi::Float64Array::New(env, layout.Count(), buffer, offset);
+	case states::Field::AudioMixers:
+	case states::Field::Width:
+	case states::Field::Height:
+	case states::Field::Flags:
+		return Napi::Uint32Array::New(env, layout.Count(), buffer, offset);
+	case states::Field::MonitoringType:
+		return Napi::Int32Array::New(env, layout.Count(), buffer, offset);
+	default:
+		return Napi::Uint8Array::New(env, layout.Count(), buffer, offset);
+	}
+}
+
+Napi::Value osn::Input::GetStates(const Napi::CallbackInfo &info)
+{
+	Napi::Array inputs = info[0].As<Napi::Array>();
+	uint32_t mask = states::AllFields;
+	if (info.Length() >= 2 && info[1].IsNumber())
+		mask = info[1].ToNumber().Uint32Value();
+
+	std::vector<char> uids(size_t(inputs.Length()) * sizeof(uint64_t));
+	for (uint32_t idx = 0; idx < inputs.Length(); idx++) {
+		uint64_t uid = UINT64_MAX;
+		Napi::Value value = inputs.Get(idx);
+		// Anything but an input gets an invalid uid, which the server reports as not valid.
+		if (value.IsObject() && value.ToObject().InstanceOf(osn::Input::constructor.Value())) {
+			osn::Input *input = Napi::ObjectWrap<osn::Input>::Unwrap(value.ToObject());
+			if (input)
+				uid = input->sourceId;
+		}
+		memcpy(uids.data() + idx * sizeof(uint64_t), &uid, sizeof(uint64_t));
+	}
+
+	// Muted, volume and sync offset writes may still be queued.
+	WriteBehind::GetInstance().Flush();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetStates", {ipc::value(uids), ipc::value(mask)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	states::Layout layout(response[1].value_union.ui32, response[2].value_union.ui32);
+	const std::vector<char> &packed = response[3].value_bin;
+	if (packed.size() < layout.Size()) {
+		Napi::Error::New(info.Env(), "Source states reply is truncated.").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	// One copy into a buffer owned by JS, every field is a view on top of it.
+	Napi::ArrayBuffer buffer = Napi::ArrayBuffer::New(info.Env(), layout.Size());
+	memcpy(buffer.Data(), packed.data(), layout.Size());
+
+	Napi::Object result = Napi::Object::New(info.Env());
+	result.Set("count", Napi::Number::New(info.Env(), layout.Count()));
+	result.Set("valid", Napi::Uint8Array::New(info.Env(), layout.Count(), buffer, 0));
+	for (uint32_t idx = 0; idx < uint32_t(states::Field::Count); idx++) {
+		states::Field field = states::Field(idx);
+		if (layout.Has(field))
+			result.Set(states::Layout::Name(field), StateArray(info.Env(), field, layout, buffer));
+	}
+	return result;
+}
+
 Napi::Value osn::Input::GetPublicSources(const Napi::CallbackInfo &info)
 {
 	auto conn = GetConnection(info);
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "GetPublicSources", {});
 
 	if (!ValidateResponse(info, response))
@@ -301,6 +435,7 @@ Napi::Value osn::Input::Duplicate(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	auto params = std::vector<ipc::value>{ipc::value((uint64_t)this->sourceId)};
 	if (info.Length() >= 1) {
 		params.push_back(ipc::value(name));
@@ -324,6 +459,7 @@ Napi::Value osn::Input::Active(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "GetActive", {ipc::value((uint64_t)this->sourceId)});
 
 	if (!ValidateResponse(info, response))
@@ -338,6 +474,7 @@ Napi::Value osn::Input::Showing(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "GetShowing", {ipc::value((uint64_t)this->sourceId)});
 
 	if (!ValidateResponse(info, response))
@@ -352,6 +489,7 @@ Napi::Value osn::Input::Width(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "GetWidth", {ipc::value((uint64_t)this->sourceId)});
 
 	if (!ValidateResponse(info, response))
@@ -366,6 +504,7 @@ Napi::Value osn::Input::Height(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "GetHeight", {ipc::value((uint64_t)this->sourceId)});
 
 	if (!ValidateResponse(info, response))
@@ -380,6 +519,8 @@ Napi::Value osn::Input::GetVolume(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	// Fader writes change the volume as well.
+	WriteBehind::GetInstance().FlushSource(this->sourceId);
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "GetVolume", {ipc::value((uint64_t)this->sourceId)});
 
 	if (!ValidateResponse(info, response))
@@ -394,7 +535,8 @@ void osn::Input::SetVolume(const Napi::CallbackInfo &info, const Napi::Value &va
 	if (!conn)
 		return;
 
-	conn->call("Input", "SetVolume", {ipc::value((uint64_t)this->sourceId), ipc::value(value.ToNumber().FloatValue())});
+	WriteBehind::GetInstance().Queue(info.Env(), batch::Setter::InputSetVolume, this->sourceId,
+					 {ipc::value((uint64_t)this->sourceId), ipc::value(value.ToNumber().FloatValue())}, this->sourceId);
 }
 
 Napi::Value osn::Input::GetSyncOffset(const Napi::CallbackInfo &info)
@@ -403,6 +545,7 @@ Napi::Value osn::Input::GetSyncOffset(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().FlushIfPending(batch::Setter::InputSetSyncOffset, this->sourceId);
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "GetSyncOffset", {ipc::value((uint64_t)this->sourceId)});
 
 	if (!ValidateResponse(info, response))
@@ -427,7 +570,8 @@ void osn::Input::SetSyncOffset(const Napi::CallbackInfo &info, const Napi::Value
 	if (!conn)
 		return;
 
-	conn->call("Input", "SetSyncOffset", {ipc::value((uint64_t)this->sourceId), ipc::value(syncoffset)});
+	WriteBehind::GetInstance().Queue(info.Env(), batch::Setter::InputSetSyncOffset, this->sourceId,
+					 {ipc::value((uint64_t)this->sourceId), ipc::value(syncoffset)}, this->sourceId);
 }
 
 Napi::Value osn::Input::GetAudioMixers(const Napi::CallbackInfo &info)
@@ -440,6 +584,7 @@ Napi::Value osn::Input::GetAudioMixers(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "GetAudioMixers", {ipc::value((uint64_t)this->sourceId)});
 
 	if (!ValidateResponse(info, response))
@@ -461,6 +606,7 @@ void osn::Input::SetAudioMixers(const Napi::CallbackInfo &info, const Napi::Valu
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("Input", "SetAudioMixers", {ipc::value((uint64_t)this->sourceId), ipc::value(audiomixers)});
 
 	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
@@ -475,6 +621,7 @@ Napi::Value osn::Input::GetMonitoringType(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "GetMonitoringType", {ipc::value((uint64_t)this->sourceId)});
 
 	if (!ValidateResponse(info, response))
@@ -491,6 +638,7 @@ void osn::Input::SetMonitoringType(const Napi::CallbackInfo &info, const Napi::V
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("Input", "SetMonitoringType", {ipc::value((uint64_t)this->sourceId), ipc::value(audiomixers)});
 }
 
@@ -500,6 +648,7 @@ Napi::Value osn::Input::GetDeinterlaceFieldOrder(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "GetDeInterlaceFieldOrder", {ipc::value((uint64_t)this->sourceId)});
 
 	if (!ValidateResponse(info, response))
@@ -516,6 +665,7 @@ void osn::Input::SetDeinterlaceFieldOrder(const Napi::CallbackInfo &info, const
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("Input", "SetDeInterlaceFieldOrder", {ipc::value((uint64_t)this->sourceId), ipc::value(deinterlaceOrder)});
 }
 
@@ -525,6 +675,7 @@ Napi::Value osn::Input::GetDeinterlaceMode(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "GetDeInterlaceMode", {ipc::value((uint64_t)this->sourceId)});
 
 	if (!ValidateResponse(info, response))
@@ -541,6 +692,7 @@ void osn::Input::SetDeinterlaceMode(const Napi::CallbackInfo &info, const Napi::
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("Input", "SetDeInterlaceMode", {ipc::value((uint64_t)this->sourceId), ipc::value(deinterlaceMode)});
 }
 
@@ -562,6 +714,7 @@ Napi::Value osn::Input::Filters(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "GetFilters", {ipc::value(this->sourceId)});
 
 	if (!ValidateResponse(info, response))
@@ -596,6 +749,7 @@ Napi::Value osn::Input::AddFilter(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("Input", "AddFilter", {ipc::value(this->sourceId), ipc::value(objfilter->sourceId)});
 	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
 	if (sdi) {
@@ -612,6 +766,7 @@ Napi::Value osn::Input::RemoveFilter(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("Input", "RemoveFilter", {ipc::value(this->sourceId), ipc::value(objfilter->sourceId)});
 
 	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
@@ -630,6 +785,7 @@ Napi::Value osn::Input::SetFilterOrder(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("Input", "MoveFilter", {ipc::value(this->sourceId), ipc::value(objfilter->sourceId), ipc::value(movement)});
 
 	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
@@ -648,6 +804,7 @@ Napi::Value osn::Input::FindFilter(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "FindFilter", {ipc::value(this->sourceId), ipc::value(name)});
 
 	if (!ValidateResponse(info, response))
@@ -668,6 +825,7 @@ Napi::Value osn::Input::CopyFilters(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("Input", "CopyFiltersTo", {ipc::value(this->sourceId), ipc::value(objfilter->sourceId)});
 }
 
@@ -694,10 +852,16 @@ Napi::Value osn::Input::CallGetSettings(const Napi::CallbackInfo &info)
 	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
 	if (sdi && sdi->obs_sourceId.compare("screen_capture") == 0) {
 		sdi->settingsChanged = true;
+		sdi->settingsVersion++;
 	}
 	return ret;
 }
 
+Napi::Value osn::Input::CallGetSettingsAsync(const Napi::CallbackInfo &info)
+{
+	return osn::ISource::GetSettingsAsync(info, this->sourceId);
+}
+
 Napi::Value osn::Input::CallGetSlowUncachedSettings(const Napi::CallbackInfo &info)
 {
 	return osn::ISource::GetSlowUncachedSettings(info, this->sourceId);
@@ -790,6 +954,7 @@ Napi::Value osn::Input::CallUpdate(const Napi::CallbackInfo &info)
 	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
 	if (sdi && sdi->obs_sourceId.compare("screen_capture") == 0) {
 		sdi->settingsChanged = true;
+		sdi->settingsVersion++;
 	}
 
 	return info.Env().Undefined();
@@ -851,6 +1016,7 @@ Napi::Value osn::Input::GetDuration(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "GetDuration", {ipc::value((uint64_t)this->sourceId)});
 
 	if (!ValidateResponse(info, response))
@@ -866,6 +1032,7 @@ Napi::Value osn::Input::GetTime(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "GetTime", {ipc::value((uint64_t)this->sourceId)});
 
 	if (!ValidateResponse(info, response))
@@ -882,6 +1049,7 @@ void osn::Input::SetTime(const Napi::CallbackInfo &info, const Napi::Value &valu
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("Input", "SetTime", {ipc::value((uint64_t)this->sourceId), ipc::value(ms)});
 }
 
@@ -891,6 +1059,7 @@ void osn::Input::Play(const Napi::CallbackInfo &info)
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("Input", "Play", {ipc::value((uint64_t)this->sourceId)});
 }
 
@@ -900,6 +1069,7 @@ void osn::Input::Pause(const Napi::CallbackInfo &info)
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("Input", "Pause", {ipc::value((uint64_t)this->sourceId)});
 }
 
@@ -909,6 +1079,7 @@ void osn::Input::Restart(const Napi::CallbackInfo &info)
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("Input", "Restart", {ipc::value((uint64_t)this->sourceId)});
 }
 
@@ -918,6 +1089,7 @@ void osn::Input::Stop(const Napi::CallbackInfo &info)
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("Input", "Stop", {ipc::value((uint64_t)this->sourceId)});
 }
 
@@ -928,10 +1100,38 @@ Napi::Value osn::Input::GetMediaState(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "GetMediaState", {ipc::value((uint64_t)this->sourceId)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
 	return Napi::Number::New(info.Env(), response[1].value_union.ui64);
-}
\ No newline at end of file
+}
+
+// The returned handle is the one carried by the events of this input.
+Napi::Value osn::Input::SubscribeMediaEvents(const Napi::CallbackInfo &info)
+{
+	auto conn = GetConnection(info);
+
+	if (!conn)
+		return info.Env().Undefined();
+
+	WriteBehind::GetInstance().Flush();
+	std::vector<ipc::value> response = conn->call_synchronous_helper("MediaEvents", "Subscribe", {ipc::value((uint64_t)this->sourceId)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return Napi::Number::New(info.Env(), double(this->sourceId));
+}
+
+void osn::Input::UnsubscribeMediaEvents(const Napi::CallbackInfo &info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return;
+
+	WriteBehind::GetInstance().Flush();
+	conn->call("MediaEvents", "Unsubscribe", {ipc::value((uint64_t)this->sourceId)});
+}
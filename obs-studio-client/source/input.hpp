@@ -35,6 +35,8 @@ public:
 	static Napi::Value Create(const Napi::CallbackInfo &info);
 	static Napi::Value CreatePrivate(const Napi::CallbackInfo &info);
 	static Napi::Value FromName(const Napi::CallbackInfo &info);
+	static Napi::Value FromNames(const Napi::CallbackInfo &info);
+	static Napi::Value GetStates(const Napi::CallbackInfo &info);
 	static Napi::Value GetPublicSources(const Napi::CallbackInfo &info);
 
 	Napi::Value Duplicate(const Napi::CallbackInfo &info);
@@ -65,6 +67,7 @@ public:
 	Napi::Value CallIsConfigurable(const Napi::CallbackInfo &info);
 	Napi::Value CallGetProperties(const Napi::CallbackInfo &info);
 	Napi::Value CallGetSettings(const Napi::CallbackInfo &info);
+	Napi::Value CallGetSettingsAsync(const Napi::CallbackInfo &info);
 	Napi::Value CallGetSlowUncachedSettings(const Napi::CallbackInfo &info);
 
 	Napi::Value CallGetType(const Napi::CallbackInfo &info);
@@ -100,6 +103,8 @@ public:
 	void Restart(const Napi::CallbackInfo &info);
 	void Stop(const Napi::CallbackInfo &info);
 	Napi::Value GetMediaState(const Napi::CallbackInfo &info);
+	Napi::Value SubscribeMediaEvents(const Napi::CallbackInfo &info);
+	void UnsubscribeMediaEvents(const Napi::CallbackInfo &info);
 
 	Napi::Value CallCallHandler(const Napi::CallbackInfo &info);
 };
@@ -19,10 +19,13 @@
 #include "isource.hpp"
 #include "osn-error.hpp"
 #include <functional>
+#include "async-calls.hpp"
 #include "controller.hpp"
 #include "shared.hpp"
+#include "shared-memory.hpp"
 #include "utility-v8.hpp"
 #include "utility.hpp"
+#include "write-behind.hpp"
 
 void osn::ISource::Release(const Napi::CallbackInfo &info, uint64_t id)
 {
@@ -30,6 +33,7 @@ void osn::ISource::Release(const Napi::CallbackInfo &info, uint64_t id)
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("Source", "Release", {ipc::value(id)});
 }
 
@@ -41,6 +45,7 @@ void osn::ISource::Remove(const Napi::CallbackInfo &info, uint64_t id)
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("Source", "Remove", {ipc::value(id)});
 }
 
@@ -54,6 +59,7 @@ Napi::Value osn::ISource::IsConfigurable(const Napi::CallbackInfo &info, uint64_
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "IsConfigurable", {ipc::value(id)});
 
 	if (!ValidateResponse(info, response))
@@ -70,35 +76,40 @@ Napi::Value osn::ISource::GetProperties(const Napi::CallbackInfo &info, uint64_t
 
 	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
 
-	if (sdi && !sdi->propertiesChanged && sdi->properties.size() > 0) {
-		std::shared_ptr<property_map_t> pSomeObject = std::make_shared<property_map_t>(sdi->properties);
-		auto prop_ptr = Napi::External<property_map_t>::New(info.Env(), pSomeObject.get());
-		auto instance = osn::Properties::constructor.New({prop_ptr, Napi::Number::New(info.Env(), (uint32_t)id)});
-		return instance;
-	}
+	if (sdi && !sdi->propertiesChanged && sdi->properties)
+		return osn::Properties::Create(info.Env(), sdi->properties, id);
 
 	auto conn = GetConnection(info);
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetProperties", {ipc::value(id)});
+	WriteBehind::GetInstance().Flush();
+	uint64_t knownVersion = (sdi && sdi->properties) ? sdi->propertiesVersion : 0;
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetProperties", {ipc::value(id), ipc::value(knownVersion)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
-	if (response.size() == 1)
-		return info.Env().Null();
+	uint64_t version = response[1].value_union.ui64;
+	bool unchanged = !!response[2].value_union.i32;
+
+	std::shared_ptr<osn::PropertySet> properties;
+	if (unchanged && sdi) {
+		properties = sdi->properties;
+	} else {
+		SharedMemory::Payload payload = SharedMemory::GetInstance().ReadPayload(response, 3);
+		properties = osn::PropertySet::Create(payload.data(), payload.size());
+	}
 
-	osn::property_map_t pmap = osn::ProcessProperties(response, 1);
+	if (!properties || properties->Count() == 0)
+		return info.Env().Null();
 
 	if (sdi) {
-		sdi->properties = pmap;
+		sdi->properties = properties;
+		sdi->propertiesVersion = version;
 		sdi->propertiesChanged = false;
 	}
-	std::shared_ptr<property_map_t> pSomeObject = std::make_shared<property_map_t>(pmap);
-	auto prop_ptr = Napi::External<property_map_t>::New(info.Env(), pSomeObject.get());
-	auto instance = osn::Properties::constructor.New({prop_ptr, Napi::Number::New(info.Env(), (uint32_t)id)});
-	return instance;
+	return osn::Properties::Create(info.Env(), properties, id);
 }
 
 Napi::Value osn::ISource::GetSlowUncachedSettings(const Napi::CallbackInfo &info, uint64_t id)
@@ -111,6 +122,7 @@ Napi::Value osn::ISource::GetSlowUncachedSettings(const Napi::CallbackInfo &info
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().FlushSource(id);
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetSettings", {ipc::value(id)});
 
 	if (!ValidateResponse(info, response))
@@ -146,6 +158,7 @@ Napi::Value osn::ISource::GetSettings(const Napi::CallbackInfo &info, uint64_t i
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().FlushSource(id);
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetSettings", {ipc::value(id)});
 
 	if (!ValidateResponse(info, response))
@@ -157,11 +170,45 @@ Napi::Value osn::ISource::GetSettings(const Napi::CallbackInfo &info, uint64_t i
 	if (sdi) {
 		sdi->setting = response[1].value_str;
 		sdi->settingsChanged = false;
+		sdi->settingsVersion++;
 	}
 
 	return jsonObj;
 }
 
+Napi::Value osn::ISource::GetSettingsAsync(const Napi::CallbackInfo &info, uint64_t id)
+{
+	Napi::Object json = info.Env().Global().Get("JSON").As<Napi::Object>();
+	Napi::Function parse = json.Get("parse").As<Napi::Function>();
+
+	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
+	if (sdi && !sdi->settingsChanged && sdi->setting.size() > 0) {
+		Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(info.Env());
+		deferred.Resolve(parse.Call(json, {Napi::String::New(info.Env(), sdi->setting)}));
+		return deferred.Promise();
+	}
+
+	WriteBehind::GetInstance().FlushSource(id);
+	uint64_t version = sdi ? sdi->settingsVersion : 0;
+	static RemoteMethod method("Source", "GetSettings");
+	return AsyncCalls::GetInstance().Call(info.Env(), method, {ipc::value(id)}, [id, version](Napi::Env env, const std::vector<ipc::value> &response) {
+		Napi::Object json = env.Global().Get("JSON").As<Napi::Object>();
+		Napi::Function parse = json.Get("parse").As<Napi::Function>();
+		Napi::Value jsonObj = parse.Call(json, {Napi::String::New(env, response[1].value_str)});
+
+		// The source may have been released while the call was in flight,
+		// and an update made after queueing is newer than this response.
+		SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
+		if (sdi && sdi->settingsVersion == version) {
+			sdi->setting = response[1].value_str;
+			// Screen capture settings are never served from the cache, see Input::CallGetSettings.
+			sdi->settingsChanged = sdi->obs_sourceId.compare("screen_capture") == 0;
+			sdi->settingsVersion++;
+		}
+		return jsonObj;
+	});
+}
+
 void osn::ISource::Update(const Napi::CallbackInfo &info, uint64_t id)
 {
 	Napi::Object jsonObj = info[0].ToObject();
@@ -195,6 +242,7 @@ void osn::ISource::Update(const Napi::CallbackInfo &info, uint64_t id)
 		if (!conn)
 			return;
 
+		WriteBehind::GetInstance().Flush();
 		std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "Update", {ipc::value(id), ipc::value(jsondata)});
 
 		if (!ValidateResponse(info, response))
@@ -203,6 +251,7 @@ void osn::ISource::Update(const Napi::CallbackInfo &info, uint64_t id)
 		if (sdi) {
 			sdi->setting = response[1].value_str;
 			sdi->settingsChanged = false;
+			sdi->settingsVersion++;
 			sdi->propertiesChanged = true;
 		}
 	}
@@ -214,6 +263,7 @@ void osn::ISource::Load(const Napi::CallbackInfo &info, uint64_t id)
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("Source", "Load", {ipc::value(id)});
 }
 
@@ -223,6 +273,8 @@ void osn::ISource::Save(const Napi::CallbackInfo &info, uint64_t id)
 	if (!conn)
 		return;
 
+	// Saving also serializes filters and scene items, whose writes may be queued too.
+	WriteBehind::GetInstance().Flush();
 	conn->call("Source", "Save", {ipc::value(id)});
 }
 
@@ -236,6 +288,7 @@ Napi::Value osn::ISource::GetType(const Napi::CallbackInfo &info, uint64_t id)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetType", {ipc::value(id)});
 
 	if (!ValidateResponse(info, response))
@@ -262,6 +315,7 @@ Napi::Value osn::ISource::GetName(const Napi::CallbackInfo &info, uint64_t id)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetName", {ipc::value(id)});
 
 	if (!ValidateResponse(info, response))
@@ -285,7 +339,20 @@ void osn::ISource::SetName(const Napi::CallbackInfo &info, const Napi::Value &va
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("Source", "SetName", {ipc::value(id), ipc::value(name)});
+
+	// Keep the name lookups of fromName and fromNames in line with the server.
+	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
+	if (sdi) {
+		CacheManager<SourceDataInfo *>::getInstance().Remove(id);
+		CacheManager<SourceDataInfo *>::getInstance().Store(id, name, sdi);
+	}
+	SceneInfo *si = CacheManager<SceneInfo *>::getInstance().Retrieve(id);
+	if (si) {
+		CacheManager<SceneInfo *>::getInstance().Remove(id);
+		CacheManager<SceneInfo *>::getInstance().Store(id, name, si);
+	}
 }
 
 Napi::Value osn::ISource::GetOutputFlags(const Napi::CallbackInfo &info, uint64_t id)
@@ -298,6 +365,7 @@ Napi::Value osn::ISource::GetOutputFlags(const Napi::CallbackInfo &info, uint64_
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetOutputFlags", {ipc::value(id)});
 
 	if (!ValidateResponse(info, response))
@@ -316,6 +384,7 @@ Napi::Value osn::ISource::GetFlags(const Napi::CallbackInfo &info, uint64_t id)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetFlags", {ipc::value(id)});
 
 	if (!ValidateResponse(info, response))
@@ -336,6 +405,7 @@ void osn::ISource::SetFlags(const Napi::CallbackInfo &info, const Napi::Value &v
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("Source", "SetFlags", {ipc::value(id), ipc::value(flags)});
 }
 
@@ -349,6 +419,7 @@ Napi::Value osn::ISource::GetStatus(const Napi::CallbackInfo &info, uint64_t id)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetStatus", {ipc::value(id)});
 
 	if (!ValidateResponse(info, response))
@@ -374,6 +445,7 @@ Napi::Value osn::ISource::GetId(const Napi::CallbackInfo &info, uint64_t id)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetId", {ipc::value(id)});
 
 	if (!ValidateResponse(info, response))
@@ -403,6 +475,7 @@ Napi::Value osn::ISource::GetMuted(const Napi::CallbackInfo &info, uint64_t id)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().FlushIfPending(batch::Setter::SourceSetMuted, id);
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetMuted", {ipc::value(id)});
 
 	if (!ValidateResponse(info, response))
@@ -428,7 +501,7 @@ void osn::ISource::SetMuted(const Napi::CallbackInfo &info, const Napi::Value &v
 	if (!conn)
 		return;
 
-	conn->call("Source", "SetMuted", {ipc::value(id), ipc::value(muted)});
+	WriteBehind::GetInstance().Queue(info.Env(), batch::Setter::SourceSetMuted, id, {ipc::value(id), ipc::value(muted)}, id);
 
 	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
 	if (sdi)
@@ -448,6 +521,7 @@ Napi::Object osn::ISource::CallHandler(const Napi::CallbackInfo &info, uint64_t
 		return result;
 	}
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response =
 		conn->call_synchronous_helper("Source", "CallHandler", {ipc::value(id), ipc::value(fuction_name), ipc::value(fuction_input)});
 
@@ -470,6 +544,7 @@ Napi::Value osn::ISource::GetEnabled(const Napi::CallbackInfo &info, uint64_t id
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().FlushIfPending(batch::Setter::SourceSetEnabled, id);
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetEnabled", {ipc::value(id)});
 
 	if (!ValidateResponse(info, response))
@@ -490,7 +565,7 @@ void osn::ISource::SetEnabled(const Napi::CallbackInfo &info, const Napi::Value
 	if (!conn)
 		return;
 
-	conn->call("Source", "SetEnabled", {ipc::value(id), ipc::value(enabled)});
+	WriteBehind::GetInstance().Queue(info.Env(), batch::Setter::SourceSetEnabled, id, {ipc::value(id), ipc::value(enabled)}, id);
 }
 
 void osn::ISource::SendMouseClick(const Napi::CallbackInfo &info, uint64_t id)
@@ -499,6 +574,7 @@ void osn::ISource::SendMouseClick(const Napi::CallbackInfo &info, uint64_t id)
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	Napi::Object mouse_event_obj = info[0].ToObject();
 	uint32_t type = info[1].ToNumber().Uint32Value();
 	bool mouse_up = info[2].ToBoolean().Value();
@@ -518,6 +594,7 @@ void osn::ISource::SendMouseMove(const Napi::CallbackInfo &info, uint64_t id)
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	Napi::Object mouse_event_obj = info[0].ToObject();
 	bool mouse_leave = info[1].ToBoolean().Value();
 
@@ -534,6 +611,7 @@ void osn::ISource::SendMouseWheel(const Napi::CallbackInfo &info, uint64_t id)
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	Napi::Object mouse_event_obj = info[0].ToObject();
 	int32_t x_delta = info[1].ToNumber().Int32Value();
 	int32_t y_delta = info[2].ToNumber().Int32Value();
@@ -553,6 +631,7 @@ void osn::ISource::SendFocus(const Napi::CallbackInfo &info, uint64_t id)
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("Source", "SendFocus", {ipc::value(id), ipc::value(focus)});
 }
 
@@ -570,6 +649,7 @@ void osn::ISource::SendKeyClick(const Napi::CallbackInfo &info, uint64_t id)
 	uint32_t native_vkey = key_event_obj.Get("nativeVkey").ToNumber().Uint32Value();
 	std::string text = key_event_obj.Get("text").ToString().Utf8Value();
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("Source", "SendKeyClick",
 		   {ipc::value(id), ipc::value(modifiers), ipc::value(text), ipc::value(native_modifiers), ipc::value(native_scancode), ipc::value(native_vkey),
 		    ipc::value((int32_t)key_up)});
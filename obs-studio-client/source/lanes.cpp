@@ -0,0 +1,170 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "lanes.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "controller.hpp"
+#include "method-table.hpp"
+#include "shared.hpp"
+#include "utility.hpp"
+
+const char *LaneName(Lane lane)
+{
+	switch (lane) {
+	case Lane::Standard:
+		return "standard";
+	case Lane::Realtime:
+		return "realtime";
+	default:
+		return "unknown";
+	}
+}
+
+template<typename T> static LaneStats::Summary Summarize(std::vector<T> &samples, uint64_t calls, double totalMs, double maxMs)
+{
+	LaneStats::Summary summary;
+	summary.calls = calls;
+	summary.averageMs = calls ? totalMs / calls : 0.0;
+	summary.maxMs = maxMs;
+	if (samples.empty())
+		return summary;
+
+	auto percentile = [&samples](double rank) {
+		auto nth = samples.begin() + size_t(rank * (samples.size() - 1));
+		std::nth_element(samples.begin(), nth, samples.end());
+		return double(*nth);
+	};
+	summary.p50Ms = percentile(0.50);
+	summary.p99Ms = percentile(0.99);
+	return summary;
+}
+
+static Napi::Object SummaryToObject(Napi::Env env, const LaneStats::Summary &summary)
+{
+	Napi::Object result = Napi::Object::New(env);
+	result.Set("calls", Napi::Number::New(env, double(summary.calls)));
+	result.Set("averageMs", Napi::Number::New(env, summary.averageMs));
+	result.Set("p50Ms", Napi::Number::New(env, summary.p50Ms));
+	result.Set("p99Ms", Napi::Number::New(env, summary.p99Ms));
+	result.Set("maxMs", Napi::Number::New(env, summary.maxMs));
+	return result;
+}
+
+void LaneStats::Record(Lane lane, double ms)
+{
+	Samples &samples = m_lanes[size_t(lane)];
+	std::unique_lock<std::mutex> ulock(samples.mutex);
+	samples.calls++;
+	samples.totalMs += ms;
+	samples.maxMs = std::max(samples.maxMs, ms);
+	samples.recent[samples.next % SampleCount] = float(ms);
+	samples.next++;
+}
+
+LaneStats::Summary LaneStats::Summarize(Lane lane)
+{
+	Samples &samples = m_lanes[size_t(lane)];
+	std::unique_lock<std::mutex> ulock(samples.mutex);
+	std::vector<float> recent(samples.recent.begin(), samples.recent.begin() + std::min(samples.next, SampleCount));
+	return ::Summarize(recent, samples.calls, samples.totalMs, samples.maxMs);
+}
+
+void LaneStats::Reset()
+{
+	for (Samples &samples : m_lanes) {
+		std::unique_lock<std::mutex> ulock(samples.mutex);
+		samples.calls = 0;
+		samples.totalMs = 0.0;
+		samples.maxMs = 0.0;
+		samples.next = 0;
+	}
+}
+
+Napi::Value LaneStats::JSGetStats(const Napi::CallbackInfo &info)
+{
+	Napi::Object result = Napi::Object::New(info.Env());
+	for (size_t idx = 0; idx < size_t(Lane::Count); idx++)
+		result.Set(LaneName(Lane(idx)), SummaryToObject(info.Env(), GetInstance().Summarize(Lane(idx))));
+	result.Set("realtimeConnected", Napi::Boolean::New(info.Env(), Controller::GetInstance().HasLane(Lane::Realtime)));
+	return result;
+}
+
+Napi::Value LaneStats::JSBenchmark(const Napi::CallbackInfo &info)
+{
+	uint32_t iterations = 200;
+	if (info.Length() > 0 && info[0].IsNumber())
+		iterations = info[0].ToNumber().Uint32Value();
+	if (iterations == 0)
+		iterations = 1;
+	uint64_t payloadSize = 4 * 1024 * 1024;
+	if (info.Length() > 1 && info[1].IsNumber())
+		payloadSize = uint64_t(info[1].ToNumber().Int64Value());
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	// Keeps the standard lane busy with large replies sent through the socket.
+	std::atomic<bool> stop{false};
+	std::atomic<uint64_t> loadCalls{0};
+	std::thread load([conn, payloadSize, &stop, &loadCalls]() {
+		while (!stop) {
+			conn->call_synchronous_helper("SharedMemory", "Echo", {ipc::value(payloadSize), ipc::value((int32_t)0)});
+			loadCalls++;
+		}
+	});
+
+	auto run = [&](Lane lane) -> Napi::Value {
+		RemoteMethod ping("Dispatch", "Ping", lane);
+		auto laneConn = Controller::GetInstance().GetConnection(lane);
+		std::vector<double> samples;
+		samples.reserve(iterations);
+		double totalMs = 0.0;
+		double maxMs = 0.0;
+		for (uint32_t idx = 0; idx < iterations; idx++) {
+			auto start = std::chrono::high_resolution_clock::now();
+			std::vector<ipc::value> response = ping.Call(laneConn, {ipc::value((uint64_t)idx)});
+			double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+			if (!ValidateResponse(info, response))
+				return info.Env().Undefined();
+			samples.push_back(ms);
+			totalMs += ms;
+			maxMs = std::max(maxMs, ms);
+		}
+		return SummaryToObject(info.Env(), ::Summarize(samples, iterations, totalMs, maxMs));
+	};
+
+	Napi::Value standard = run(Lane::Standard);
+	Napi::Value realtime = standard.IsUndefined() ? standard : run(Lane::Realtime);
+	stop = true;
+	load.join();
+	if (realtime.IsUndefined())
+		return realtime;
+
+	Napi::Object result = Napi::Object::New(info.Env());
+	result.Set("iterations", Napi::Number::New(info.Env(), iterations));
+	result.Set("payloadSize", Napi::Number::New(info.Env(), double(payloadSize)));
+	result.Set("loadCalls", Napi::Number::New(info.Env(), double(loadCalls.load())));
+	result.Set("realtimeConnected", Napi::Boolean::New(info.Env(), Controller::GetInstance().HasLane(Lane::Realtime)));
+	result.Set(LaneName(Lane::Standard), standard);
+	result.Set(LaneName(Lane::Realtime), realtime);
+	return result;
+}
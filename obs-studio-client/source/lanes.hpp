@@ -0,0 +1,87 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <array>
+#include <inttypes.h>
+#include <mutex>
+#include <napi.h>
+#include <vector>
+
+// Priority classes of server calls. Each lane is its own connection to the
+// server and the server serves every connection on its own worker, so calls on
+// the realtime lane never wait behind a long call on the standard one.
+enum class Lane : uint32_t {
+	// Everything sent from the JavaScript thread and the async I/O threads.
+	Standard,
+	// Small calls made by the polling threads (callbacks, output signals)
+	// and the preview resize and move, which follow the window as it is dragged.
+	// The server serializes every other call on a single lock, so only the
+	// ones listed in its MethodTable::IsConcurrent skip the queue here.
+	Realtime,
+	Count,
+};
+
+const char *LaneName(Lane lane);
+
+// Latency of the calls made through RemoteMethod, per lane.
+class LaneStats {
+public:
+	// Percentiles are taken over this many of the latest calls.
+	static constexpr size_t SampleCount = 1024;
+
+	struct Summary {
+		uint64_t calls = 0;
+		double averageMs = 0.0;
+		double p50Ms = 0.0;
+		double p99Ms = 0.0;
+		double maxMs = 0.0;
+	};
+
+	static LaneStats &GetInstance()
+	{
+		static LaneStats _inst;
+		return _inst;
+	}
+
+private:
+	LaneStats() {}
+
+public:
+	LaneStats(LaneStats const &) = delete;
+	void operator=(LaneStats const &) = delete;
+
+	void Record(Lane lane, double ms);
+	Summary Summarize(Lane lane);
+	void Reset();
+
+	static Napi::Value JSGetStats(const Napi::CallbackInfo &info);
+	static Napi::Value JSBenchmark(const Napi::CallbackInfo &info);
+
+private:
+	struct Samples {
+		std::mutex mutex;
+		uint64_t calls = 0;
+		double totalMs = 0.0;
+		double maxMs = 0.0;
+		std::array<float, SampleCount> recent;
+		size_t next = 0;
+	};
+
+	Samples m_lanes[size_t(Lane::Count)];
+};
@@ -0,0 +1,147 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "method-table.hpp"
+#include <chrono>
+#include "osn-error.hpp"
+#include "packed-args.hpp"
+#include "shared.hpp"
+#include "utility.hpp"
+
+bool MethodTable::Load(std::shared_ptr<ipc::client> conn)
+{
+	Reset();
+	if (!conn)
+		return false;
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Dispatch", "GetMethods", {});
+	if (response.size() < 3 || (ErrorCode)response[0].value_union.ui64 != ErrorCode::Ok)
+		return false;
+
+	uint32_t count = response[1].value_union.ui32;
+	const std::vector<char> &names = response[2].value_bin;
+
+	std::unordered_map<std::string, uint32_t> ids;
+	ids.reserve(count);
+	size_t start = 0;
+	for (uint32_t id = 0; id < count && start < names.size(); id++) {
+		size_t end = start;
+		while (end < names.size() && names[end] != '\0')
+			end++;
+		// A collection registered twice keeps the id of its first functions.
+		ids.emplace(std::string(names.data() + start, end - start), id);
+		start = end + 1;
+	}
+
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	m_ids = std::move(ids);
+	m_generation++;
+	return true;
+}
+
+void MethodTable::Reset()
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	m_ids.clear();
+	m_generation++;
+}
+
+uint32_t MethodTable::Find(const std::string &cname, const std::string &fname)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	auto found = m_ids.find(cname + "." + fname);
+	return found != m_ids.end() ? found->second : InvalidId;
+}
+
+size_t MethodTable::Count()
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	return m_ids.size();
+}
+
+std::vector<ipc::value> RemoteMethod::Call(const std::shared_ptr<ipc::client> &conn, std::vector<ipc::value> args)
+{
+	MethodTable &table = MethodTable::GetInstance();
+	uint32_t generation = table.Generation();
+	uint64_t resolved = m_resolved.load(std::memory_order_relaxed);
+	uint32_t id = uint32_t(resolved);
+	if (uint32_t(resolved >> 32) != generation) {
+		id = table.Find(m_cname, m_fname);
+		m_resolved.store((uint64_t(generation) << 32) | id, std::memory_order_relaxed);
+	}
+
+	auto start = std::chrono::high_resolution_clock::now();
+	std::vector<ipc::value> response;
+	if (id == MethodTable::InvalidId) {
+		response = conn->call_synchronous_helper(m_cname, m_fname, args);
+	} else {
+		response = conn->call_synchronous_helper("Dispatch", "Call", {ipc::value(id), ipc::value(packed::Pack(args))});
+	}
+	LaneStats::GetInstance().Record(m_lane, std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count());
+	return response;
+}
+
+Napi::Value MethodTable::JSBenchmark(const Napi::CallbackInfo &info)
+{
+	uint32_t iterations = 10000;
+	if (info.Length() > 0 && info[0].IsNumber())
+		iterations = info[0].ToNumber().Uint32Value();
+	if (iterations == 0)
+		iterations = 1;
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	RemoteMethod ping("Dispatch", "Ping");
+	auto run = [&](bool byId) -> Napi::Value {
+		auto start = std::chrono::high_resolution_clock::now();
+		for (uint32_t idx = 0; idx < iterations; idx++) {
+			std::vector<ipc::value> response = byId ? ping.Call(conn, {ipc::value((uint64_t)idx)})
+								: conn->call_synchronous_helper("Dispatch", "Ping", {ipc::value((uint64_t)idx)});
+			if (!ValidateResponse(info, response))
+				return info.Env().Undefined();
+			if (response.size() < 2 || response[1].value_union.ui64 != idx) {
+				Napi::Error::New(info.Env(), "Received a reply to another call.").ThrowAsJavaScriptException();
+				return info.Env().Undefined();
+			}
+		}
+		auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+		Napi::Object result = Napi::Object::New(info.Env());
+		result.Set("totalMs", Napi::Number::New(info.Env(), elapsed));
+		result.Set("callMs", Napi::Number::New(info.Env(), elapsed / iterations));
+		result.Set("callsPerSecond", Napi::Number::New(info.Env(), elapsed > 0 ? iterations / (elapsed / 1000.0) : 0));
+		return result;
+	};
+
+	Napi::Value byName = run(false);
+	if (byName.IsUndefined())
+		return byName;
+	Napi::Value byId = run(true);
+	if (byId.IsUndefined())
+		return byId;
+
+	Napi::Object result = Napi::Object::New(info.Env());
+	result.Set("iterations", Napi::Number::New(info.Env(), iterations));
+	result.Set("methodCount", Napi::Number::New(info.Env(), double(GetInstance().Count())));
+	result.Set("dispatchById", Napi::Boolean::New(info.Env(), GetInstance().Find("Dispatch", "Ping") != InvalidId));
+	result.Set("byName", byName);
+	result.Set("byId", byId);
+	return result;
+}
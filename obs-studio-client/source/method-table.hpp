@@ -0,0 +1,92 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <inttypes.h>
+#include <memory>
+#include <mutex>
+#include <napi.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ipc-client.hpp"
+#include "lanes.hpp"
+
+// Ids of every function registered on the server, fetched once per connection
+// through Dispatch.GetMethods. A call by id skips the collection and function
+// name lookups on the server and sends two short strings instead of the names.
+class MethodTable {
+public:
+	static constexpr uint32_t InvalidId = UINT32_MAX;
+
+	static MethodTable &GetInstance()
+	{
+		static MethodTable _inst;
+		return _inst;
+	}
+
+private:
+	MethodTable() {}
+
+public:
+	MethodTable(MethodTable const &) = delete;
+	void operator=(MethodTable const &) = delete;
+
+	bool Load(std::shared_ptr<ipc::client> conn);
+	void Reset();
+
+	// Returns InvalidId if the server does not know the function (or the table
+	// could not be loaded), in which case callers fall back to calling by name.
+	uint32_t Find(const std::string &cname, const std::string &fname);
+	size_t Count();
+	// Changes every time the table is loaded or reset.
+	uint32_t Generation() { return m_generation.load(std::memory_order_acquire); }
+
+	static Napi::Value JSBenchmark(const Napi::CallbackInfo &info);
+
+private:
+	std::mutex m_mutex;
+	std::unordered_map<std::string, uint32_t> m_ids;
+	std::atomic<uint32_t> m_generation{1};
+};
+
+// A call site that resolves its id once and keeps it until the next connection:
+//
+//   static RemoteMethod method("SceneItem", "GetPosition");
+//   std::vector<ipc::value> response = method.Call(conn, {ipc::value(itemId)});
+//
+// Safe to call from any thread. The latency of every call is recorded for the
+// lane given here, which should match the connection it is called on.
+class RemoteMethod {
+public:
+	RemoteMethod(const char *cname, const char *fname, Lane lane = Lane::Standard) : m_cname(cname), m_fname(fname), m_lane(lane) {}
+
+	std::vector<ipc::value> Call(const std::shared_ptr<ipc::client> &conn, std::vector<ipc::value> args);
+
+	const char *Collection() const { return m_cname; }
+	const char *Function() const { return m_fname; }
+	Lane GetLane() const { return m_lane; }
+
+private:
+	const char *m_cname;
+	const char *m_fname;
+	Lane m_lane;
+	// Table generation in the high half, id in the low half.
+	std::atomic<uint64_t> m_resolved{0};
+};
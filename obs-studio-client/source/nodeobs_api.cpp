@@ -186,6 +186,49 @@ Napi::Value api::OBS_API_QueryHotkeys(const Napi::CallbackInfo &info)
 	return hotkeyInfos;
 }
 
+Napi::Value api::OBS_API_QueryHotkeysSince(const Napi::CallbackInfo &info)
+{
+	uint64_t generation = 0;
+	if (info.Length() > 0 && info[0].IsNumber())
+		generation = (uint64_t)info[0].ToNumber().Int64Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("API", "OBS_API_QueryHotkeysSince", {ipc::value(generation)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	size_t index = 1;
+	Napi::Object result = Napi::Object::New(info.Env());
+	result.Set("generation", Napi::Number::New(info.Env(), (double)response[index++].value_union.ui64));
+	result.Set("reset", Napi::Boolean::New(info.Env(), !!response[index++].value_union.i32));
+
+	uint32_t changedCount = response[index++].value_union.ui32;
+	Napi::Array hotkeyInfos = Napi::Array::New(info.Env(), changedCount);
+	for (uint32_t i = 0; i < changedCount; i++) {
+		Napi::Object object = Napi::Object::New(info.Env());
+		object.Set("ObjectName", Napi::String::New(info.Env(), response[index + 0].value_str));
+		object.Set("ObjectType", Napi::Number::New(info.Env(), response[index + 1].value_union.ui32));
+		object.Set("HotkeyName", Napi::String::New(info.Env(), response[index + 2].value_str));
+		object.Set("HotkeyDesc", Napi::String::New(info.Env(), response[index + 3].value_str));
+		object.Set("HotkeyId", Napi::Number::New(info.Env(), (double)response[index + 4].value_union.ui64));
+		hotkeyInfos.Set(i, object);
+		index += 5;
+	}
+	result.Set("hotkeys", hotkeyInfos);
+
+	uint32_t removedCount = response[index++].value_union.ui32;
+	Napi::Array removed = Napi::Array::New(info.Env(), removedCount);
+	for (uint32_t i = 0; i < removedCount; i++)
+		removed.Set(i, Napi::Number::New(info.Env(), (double)response[index++].value_union.ui64));
+	result.Set("removed", removed);
+
+	return result;
+}
+
 Napi::Value api::OBS_API_ProcessHotkeyStatus(const Napi::CallbackInfo &info)
 {
 	uint64_t hotkeyId;
@@ -563,6 +606,7 @@ void api::Init(Napi::Env env, Napi::Object exports)
 	exports.Set(Napi::String::New(env, "SetWorkingDirectory"), Napi::Function::New(env, api::SetWorkingDirectory));
 	exports.Set(Napi::String::New(env, "InitShutdownSequence"), Napi::Function::New(env, api::InitShutdownSequence));
 	exports.Set(Napi::String::New(env, "OBS_API_QueryHotkeys"), Napi::Function::New(env, api::OBS_API_QueryHotkeys));
+	exports.Set(Napi::String::New(env, "OBS_API_QueryHotkeysSince"), Napi::Function::New(env, api::OBS_API_QueryHotkeysSince));
 	exports.Set(Napi::String::New(env, "OBS_API_ProcessHotkeyStatus"), Napi::Function::New(env, api::OBS_API_ProcessHotkeyStatus));
 	exports.Set(Napi::String::New(env, "SetUsername"), Napi::Function::New(env, api::SetUsername));
 	exports.Set(Napi::String::New(env, "GetPermissionsStatus"), Napi::Function::New(env, api::GetPermissionsStatus));
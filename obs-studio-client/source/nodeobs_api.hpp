@@ -34,6 +34,7 @@ Napi::Value OBS_API_getPerformanceStatistics(const Napi::CallbackInfo &info);
 Napi::Value SetWorkingDirectory(const Napi::CallbackInfo &info);
 Napi::Value InitShutdownSequence(const Napi::CallbackInfo &info);
 Napi::Value OBS_API_QueryHotkeys(const Napi::CallbackInfo &info);
+Napi::Value OBS_API_QueryHotkeysSince(const Napi::CallbackInfo &info);
 Napi::Value OBS_API_ProcessHotkeyStatus(const Napi::CallbackInfo &info);
 Napi::Value SetUsername(const Napi::CallbackInfo &info);
 Napi::Value GetPermissionsStatus(const Napi::CallbackInfo &info);
@@ -17,6 +17,7 @@
 ******************************************************************************/
 
 #include "nodeobs_autoconfig.hpp"
+#include "method-table.hpp"
 #include "shared.hpp"
 
 bool autoConfig::isWorkerRunning = false;
@@ -41,13 +42,14 @@ void autoConfig::worker()
 	while (!worker_stop) {
 		auto tp_start = std::chrono::high_resolution_clock::now();
 
-		auto conn = Controller::GetInstance().GetConnection();
+		auto conn = Controller::GetInstance().GetConnection(Lane::Realtime);
 		if (!conn) {
 			goto do_sleep;
 		}
 
 		{
-			std::vector<ipc::value> response = conn->call_synchronous_helper("AutoConfig", "Query", {});
+			static RemoteMethod query("AutoConfig", "Query", Lane::Realtime);
+			std::vector<ipc::value> response = query.Call(conn, {});
 			if (!response.size() || (response.size() == 1)) {
 				goto do_sleep;
 			}
@@ -264,6 +266,101 @@ Napi::Value autoConfig::StartSaveSettings(const Napi::CallbackInfo &info)
 	return info.Env().Undefined();
 }
 
+Napi::Value autoConfig::StartEncoderBenchmark(const Napi::CallbackInfo &info)
+{
+	double secondsPerPoint = 0.0;
+	if (info.Length() > 0 && info[0].IsNumber())
+		secondsPerPoint = info[0].ToNumber().DoubleValue();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("AutoConfig", "StartEncoderBenchmark", {ipc::value(secondsPerPoint)});
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return info.Env().Undefined();
+}
+
+Napi::Value autoConfig::GetEncoderBenchmarkResults(const Napi::CallbackInfo &info)
+{
+	std::string path;
+	if (info.Length() > 0 && info[0].IsString())
+		path = info[0].ToString().Utf8Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("AutoConfig", "GetEncoderBenchmarkResults", {ipc::value(path)});
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return Napi::String::New(info.Env(), response[1].value_str);
+}
+
+Napi::Value autoConfig::SetBandwidthTestTarget(const Napi::CallbackInfo &info)
+{
+	std::string target = info[0].ToString().Utf8Value();
+
+	uint32_t throughputKbps = 0;
+	uint32_t latencyMs = 0;
+	uint32_t servers = 1;
+	if (info.Length() > 1 && info[1].IsObject()) {
+		Napi::Object shaping = info[1].ToObject();
+		throughputKbps = shaping.Has("throughputKbps") ? shaping.Get("throughputKbps").ToNumber().Uint32Value() : 0;
+		latencyMs = shaping.Has("latencyMs") ? shaping.Get("latencyMs").ToNumber().Uint32Value() : 0;
+		servers = shaping.Has("servers") ? shaping.Get("servers").ToNumber().Uint32Value() : 1;
+	}
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("AutoConfig", "SetBandwidthTestTarget",
+									 {ipc::value(target), ipc::value(throughputKbps), ipc::value(latencyMs), ipc::value(servers)});
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return info.Env().Undefined();
+}
+
+Napi::Value autoConfig::SetBandwidthTestOptions(const Napi::CallbackInfo &info)
+{
+	uint32_t maxThroughputTests = 3;
+	bool parallel = false;
+	if (info.Length() > 0 && info[0].IsObject()) {
+		Napi::Object options = info[0].ToObject();
+		maxThroughputTests = options.Has("maxThroughputTests") ? options.Get("maxThroughputTests").ToNumber().Uint32Value() : 3;
+		parallel = options.Has("parallel") ? options.Get("parallel").ToBoolean().Value() : false;
+	}
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+		conn->call_synchronous_helper("AutoConfig", "SetBandwidthTestOptions", {ipc::value(maxThroughputTests), ipc::value((int32_t)parallel)});
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return info.Env().Undefined();
+}
+
+Napi::Value autoConfig::GetBandwidthTestResults(const Napi::CallbackInfo &info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("AutoConfig", "GetBandwidthTestResults", {});
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return Napi::String::New(info.Env(), response[1].value_str);
+}
+
 Napi::Value autoConfig::TerminateAutoConfig(const Napi::CallbackInfo &info)
 {
 	auto conn = GetConnection(info);
@@ -291,5 +388,10 @@ void autoConfig::Init(Napi::Env env, Napi::Object exports)
 	exports.Set(Napi::String::New(env, "StartSetDefaultSettings"), Napi::Function::New(env, autoConfig::StartSetDefaultSettings));
 	exports.Set(Napi::String::New(env, "StartSaveStreamSettings"), Napi::Function::New(env, autoConfig::StartSaveStreamSettings));
 	exports.Set(Napi::String::New(env, "StartSaveSettings"), Napi::Function::New(env, autoConfig::StartSaveSettings));
+	exports.Set(Napi::String::New(env, "StartEncoderBenchmark"), Napi::Function::New(env, autoConfig::StartEncoderBenchmark));
+	exports.Set(Napi::String::New(env, "GetEncoderBenchmarkResults"), Napi::Function::New(env, autoConfig::GetEncoderBenchmarkResults));
+	exports.Set(Napi::String::New(env, "SetBandwidthTestTarget"), Napi::Function::New(env, autoConfig::SetBandwidthTestTarget));
+	exports.Set(Napi::String::New(env, "SetBandwidthTestOptions"), Napi::Function::New(env, autoConfig::SetBandwidthTestOptions));
+	exports.Set(Napi::String::New(env, "GetBandwidthTestResults"), Napi::Function::New(env, autoConfig::GetBandwidthTestResults));
 	exports.Set(Napi::String::New(env, "TerminateAutoConfig"), Napi::Function::New(env, autoConfig::TerminateAutoConfig));
 }
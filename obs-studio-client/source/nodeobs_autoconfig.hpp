@@ -60,5 +60,10 @@ Napi::Value StartCheckSettings(const Napi::CallbackInfo &info);
 Napi::Value StartSetDefaultSettings(const Napi::CallbackInfo &info);
 Napi::Value StartSaveStreamSettings(const Napi::CallbackInfo &info);
 Napi::Value StartSaveSettings(const Napi::CallbackInfo &info);
+Napi::Value StartEncoderBenchmark(const Napi::CallbackInfo &info);
+Napi::Value GetEncoderBenchmarkResults(const Napi::CallbackInfo &info);
+Napi::Value SetBandwidthTestTarget(const Napi::CallbackInfo &info);
+Napi::Value SetBandwidthTestOptions(const Napi::CallbackInfo &info);
+Napi::Value GetBandwidthTestResults(const Napi::CallbackInfo &info);
 Napi::Value TerminateAutoConfig(const Napi::CallbackInfo &info);
 }
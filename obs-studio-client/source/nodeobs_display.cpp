@@ -154,6 +154,32 @@ Napi::Value display::OBS_content_getDisplayPreviewSize(const Napi::CallbackInfo
 	return previewSize;
 }
 
+Napi::Value display::OBS_content_getDisplayOverlayStats(const Napi::CallbackInfo &info)
+{
+	std::string key = info[0].ToString().Utf8Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Display", "OBS_content_getDisplayOverlayStats", {ipc::value(key)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	uint64_t frames = response[1].value_union.ui64;
+	double totalMs = double(response[2].value_union.ui64) / 1000000.0;
+
+	Napi::Object stats = Napi::Object::New(info.Env());
+	stats.Set("frames", Napi::Number::New(info.Env(), double(frames)));
+	stats.Set("averageMs", Napi::Number::New(info.Env(), frames ? totalMs / double(frames) : 0.0));
+	stats.Set("maxMs", Napi::Number::New(info.Env(), double(response[3].value_union.ui64) / 1000000.0));
+	stats.Set("uploadedBytes", Napi::Number::New(info.Env(), double(response[4].value_union.ui64)));
+	stats.Set("drawCalls", Napi::Number::New(info.Env(), frames ? double(response[5].value_union.ui64) / double(frames) : 0.0));
+	stats.Set("cachedFrames", Napi::Number::New(info.Env(), double(response[6].value_union.ui64)));
+	return stats;
+}
+
 Napi::Value display::OBS_content_createSourcePreviewDisplay(const Napi::CallbackInfo &info)
 {
 	Napi::Buffer<void *> bufferData = info[0].As<Napi::Buffer<void *>>();
@@ -194,7 +220,9 @@ Napi::Value display::OBS_content_resizeDisplay(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	conn->call("Display", "OBS_content_resizeDisplay", {ipc::value(key), ipc::value(width), ipc::value(height)});
+	// On the realtime lane so dragging the window is not stuck behind a long
+	// call. The server keeps the geometry if the create call is still on its way.
+	Controller::GetInstance().GetConnection(Lane::Realtime)->call("Display", "OBS_content_resizeDisplay", {ipc::value(key), ipc::value(width), ipc::value(height)});
 
 	return info.Env().Undefined();
 }
@@ -209,7 +237,9 @@ Napi::Value display::OBS_content_moveDisplay(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	conn->call("Display", "OBS_content_moveDisplay", {ipc::value(key), ipc::value(x), ipc::value(y)});
+	// On the realtime lane so dragging the window is not stuck behind a long
+	// call. The server keeps the geometry if the create call is still on its way.
+	Controller::GetInstance().GetConnection(Lane::Realtime)->call("Display", "OBS_content_moveDisplay", {ipc::value(key), ipc::value(x), ipc::value(y)});
 	return info.Env().Undefined();
 }
 
@@ -322,6 +352,44 @@ Napi::Value display::OBS_content_setDrawRotationHandle(const Napi::CallbackInfo
 	return info.Env().Undefined();
 }
 
+Napi::Value display::OBS_content_setDisplayRenderPolicy(const Napi::CallbackInfo &info)
+{
+	std::string key = info[0].ToString().Utf8Value();
+	Napi::Object policy = info[1].ToObject();
+
+	uint32_t maxFps = policy.Has("maxFps") ? policy.Get("maxFps").ToNumber().Uint32Value() : 0;
+	double renderScale = policy.Has("renderScale") ? policy.Get("renderScale").ToNumber().DoubleValue() : 1.0;
+	bool pauseWhenHidden = policy.Has("pauseWhenHidden") ? policy.Get("pauseWhenHidden").ToBoolean().Value() : false;
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	conn->call("Display", "OBS_content_setDisplayRenderPolicy",
+		   {ipc::value(key), ipc::value(maxFps), ipc::value(renderScale), ipc::value((int32_t)pauseWhenHidden)});
+	return info.Env().Undefined();
+}
+
+Napi::Value display::OBS_content_getDisplayRenderStats(const Napi::CallbackInfo &info)
+{
+	std::string key = info[0].ToString().Utf8Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Display", "OBS_content_getDisplayRenderStats", {ipc::value(key)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	Napi::Object stats = Napi::Object::New(info.Env());
+	stats.Set("renderedFrames", Napi::Number::New(info.Env(), double(response[1].value_union.ui64)));
+	stats.Set("skippedFrames", Napi::Number::New(info.Env(), double(response[2].value_union.ui64)));
+	stats.Set("paused", Napi::Boolean::New(info.Env(), response[3].value_union.ui32 != 0));
+	return stats;
+}
+
 Napi::Value display::OBS_content_createIOSurface(const Napi::CallbackInfo &info)
 {
 	std::string key = info[0].ToString().Utf8Value();
@@ -345,6 +413,7 @@ void display::Init(Napi::Env env, Napi::Object exports)
 	exports.Set(Napi::String::New(env, "OBS_content_destroyDisplay"), Napi::Function::New(env, display::OBS_content_destroyDisplay));
 	exports.Set(Napi::String::New(env, "OBS_content_getDisplayPreviewOffset"), Napi::Function::New(env, display::OBS_content_getDisplayPreviewOffset));
 	exports.Set(Napi::String::New(env, "OBS_content_getDisplayPreviewSize"), Napi::Function::New(env, display::OBS_content_getDisplayPreviewSize));
+	exports.Set(Napi::String::New(env, "OBS_content_getDisplayOverlayStats"), Napi::Function::New(env, display::OBS_content_getDisplayOverlayStats));
 	exports.Set(Napi::String::New(env, "OBS_content_createSourcePreviewDisplay"),
 		    Napi::Function::New(env, display::OBS_content_createSourcePreviewDisplay));
 	exports.Set(Napi::String::New(env, "OBS_content_resizeDisplay"), Napi::Function::New(env, display::OBS_content_resizeDisplay));
@@ -355,5 +424,7 @@ void display::Init(Napi::Env env, Napi::Object exports)
 	exports.Set(Napi::String::New(env, "OBS_content_setShouldDrawUI"), Napi::Function::New(env, display::OBS_content_setShouldDrawUI));
 	exports.Set(Napi::String::New(env, "OBS_content_setDrawGuideLines"), Napi::Function::New(env, display::OBS_content_setDrawGuideLines));
 	exports.Set(Napi::String::New(env, "OBS_content_setDrawRotationHandle"), Napi::Function::New(env, display::OBS_content_setDrawRotationHandle));
+	exports.Set(Napi::String::New(env, "OBS_content_setDisplayRenderPolicy"), Napi::Function::New(env, display::OBS_content_setDisplayRenderPolicy));
+	exports.Set(Napi::String::New(env, "OBS_content_getDisplayRenderStats"), Napi::Function::New(env, display::OBS_content_getDisplayRenderStats));
 	exports.Set(Napi::String::New(env, "OBS_content_createIOSurface"), Napi::Function::New(env, display::OBS_content_createIOSurface));
 }
\ No newline at end of file
@@ -26,6 +26,7 @@ Napi::Value OBS_content_createDisplay(const Napi::CallbackInfo &info);
 Napi::Value OBS_content_destroyDisplay(const Napi::CallbackInfo &info);
 Napi::Value OBS_content_getDisplayPreviewOffset(const Napi::CallbackInfo &info);
 Napi::Value OBS_content_getDisplayPreviewSize(const Napi::CallbackInfo &info);
+Napi::Value OBS_content_getDisplayOverlayStats(const Napi::CallbackInfo &info);
 Napi::Value OBS_content_createSourcePreviewDisplay(const Napi::CallbackInfo &info);
 Napi::Value OBS_content_resizeDisplay(const Napi::CallbackInfo &info);
 Napi::Value OBS_content_moveDisplay(const Napi::CallbackInfo &info);
@@ -36,5 +37,7 @@ Napi::Value OBS_content_setCropOutlineColor(const Napi::CallbackInfo &info);
 Napi::Value OBS_content_setShouldDrawUI(const Napi::CallbackInfo &info);
 Napi::Value OBS_content_setDrawGuideLines(const Napi::CallbackInfo &info);
 Napi::Value OBS_content_setDrawRotationHandle(const Napi::CallbackInfo &info);
+Napi::Value OBS_content_setDisplayRenderPolicy(const Napi::CallbackInfo &info);
+Napi::Value OBS_content_getDisplayRenderStats(const Napi::CallbackInfo &info);
 Napi::Value OBS_content_createIOSurface(const Napi::CallbackInfo &info);
 }
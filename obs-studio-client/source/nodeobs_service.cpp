@@ -24,6 +24,7 @@
 #include <node.h>
 #include <sstream>
 #include <string>
+#include "method-table.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
 #include "video.hpp"
@@ -305,9 +306,10 @@ void service::worker()
 		auto tp_start = std::chrono::high_resolution_clock::now();
 
 		// Validate Connection
-		auto conn = Controller::GetInstance().GetConnection();
+		auto conn = Controller::GetInstance().GetConnection(Lane::Realtime);
 		if (conn) {
-			std::vector<ipc::value> response = conn->call_synchronous_helper("NodeOBS_Service", "Query", {});
+			static RemoteMethod query("NodeOBS_Service", "Query", Lane::Realtime);
+			std::vector<ipc::value> response = query.Call(conn, {});
 			if ((response.size() == 6) && signalsList.size() < maximum_signals_in_queue) {
 				ErrorCode error = (ErrorCode)response[0].value_union.ui64;
 				if (error == ErrorCode::Ok) {
@@ -25,9 +25,10 @@
 #include <sstream>
 #include <string>
 #include "shared.hpp"
+#include "shared-memory.hpp"
 #include "utility.hpp"
 
-std::vector<settings::SubCategory> serializeCategory(uint32_t subCategoriesCount, uint32_t sizeStruct, std::vector<char> buffer)
+std::vector<settings::SubCategory> serializeCategory(uint32_t subCategoriesCount, uint32_t sizeStruct, const char *buffer)
 {
 	std::vector<settings::SubCategory> category;
 
@@ -35,76 +36,76 @@ std::vector<settings::SubCategory> serializeCategory(uint32_t subCategoriesCount
 	for (int i = 0; i < int(subCategoriesCount); i++) {
 		settings::SubCategory sc;
 
-		uint64_t *sizeMessage = reinterpret_cast<uint64_t *>(buffer.data() + indexData);
+		const uint64_t *sizeMessage = reinterpret_cast<const uint64_t *>(buffer + indexData);
 		indexData += sizeof(uint64_t);
 
-		std::string name(buffer.data() + indexData, *sizeMessage);
+		std::string name(buffer + indexData, *sizeMessage);
 		indexData += uint32_t(*sizeMessage);
 
-		uint32_t *paramsCount = reinterpret_cast<uint32_t *>(buffer.data() + indexData);
+		const uint32_t *paramsCount = reinterpret_cast<const uint32_t *>(buffer + indexData);
 		indexData += sizeof(uint32_t);
 
 		settings::Parameter param;
 		for (int j = 0; j < *paramsCount; j++) {
-			uint64_t *sizeName = reinterpret_cast<uint64_t *>(buffer.data() + indexData);
+			const uint64_t *sizeName = reinterpret_cast<const uint64_t *>(buffer + indexData);
 			indexData += sizeof(uint64_t);
 
-			std::string name(buffer.data() + indexData, *sizeName);
+			std::string name(buffer + indexData, *sizeName);
 			indexData += uint32_t(*sizeName);
 
-			uint64_t *sizeDescription = reinterpret_cast<uint64_t *>(buffer.data() + indexData);
+			const uint64_t *sizeDescription = reinterpret_cast<const uint64_t *>(buffer + indexData);
 			indexData += sizeof(uint64_t);
 
-			std::string description(buffer.data() + indexData, *sizeDescription);
+			std::string description(buffer + indexData, *sizeDescription);
 			indexData += uint32_t(*sizeDescription);
 
-			uint64_t *sizeType = reinterpret_cast<uint64_t *>(buffer.data() + indexData);
+			const uint64_t *sizeType = reinterpret_cast<const uint64_t *>(buffer + indexData);
 			indexData += sizeof(uint64_t);
 
-			std::string type(buffer.data() + indexData, *sizeType);
+			std::string type(buffer + indexData, *sizeType);
 			indexData += uint32_t(*sizeType);
 
-			uint64_t *sizeSubType = reinterpret_cast<uint64_t *>(buffer.data() + indexData);
+			const uint64_t *sizeSubType = reinterpret_cast<const uint64_t *>(buffer + indexData);
 			indexData += sizeof(uint64_t);
 
-			std::string subType(buffer.data() + indexData, *sizeSubType);
+			std::string subType(buffer + indexData, *sizeSubType);
 			indexData += uint32_t(*sizeSubType);
 
-			bool *enabled = reinterpret_cast<bool *>(buffer.data() + indexData);
+			const bool *enabled = reinterpret_cast<const bool *>(buffer + indexData);
 			indexData += sizeof(bool);
 
-			bool *masked = reinterpret_cast<bool *>(buffer.data() + indexData);
+			const bool *masked = reinterpret_cast<const bool *>(buffer + indexData);
 			indexData += sizeof(bool);
 
-			bool *visible = reinterpret_cast<bool *>(buffer.data() + indexData);
+			const bool *visible = reinterpret_cast<const bool *>(buffer + indexData);
 			indexData += sizeof(bool);
 
-			double *minVal = reinterpret_cast<double *>(buffer.data() + indexData);
+			const double *minVal = reinterpret_cast<const double *>(buffer + indexData);
 			indexData += sizeof(double);
 
-			double *maxVal = reinterpret_cast<double *>(buffer.data() + indexData);
+			const double *maxVal = reinterpret_cast<const double *>(buffer + indexData);
 			indexData += sizeof(double);
 
-			double *stepVal = reinterpret_cast<double *>(buffer.data() + indexData);
+			const double *stepVal = reinterpret_cast<const double *>(buffer + indexData);
 			indexData += sizeof(double);
 
-			uint64_t *sizeOfCurrentValue = reinterpret_cast<uint64_t *>(buffer.data() + indexData);
+			const uint64_t *sizeOfCurrentValue = reinterpret_cast<const uint64_t *>(buffer + indexData);
 			indexData += sizeof(uint64_t);
 
 			std::vector<char> currentValue;
 			currentValue.resize(*sizeOfCurrentValue);
-			memcpy(currentValue.data(), buffer.data() + indexData, *sizeOfCurrentValue);
+			memcpy(currentValue.data(), buffer + indexData, *sizeOfCurrentValue);
 			indexData += uint32_t(*sizeOfCurrentValue);
 
-			uint64_t *sizeOfValues = reinterpret_cast<uint64_t *>(buffer.data() + indexData);
+			const uint64_t *sizeOfValues = reinterpret_cast<const uint64_t *>(buffer + indexData);
 			indexData += sizeof(uint64_t);
 
-			uint64_t *countValues = reinterpret_cast<uint64_t *>(buffer.data() + indexData);
+			const uint64_t *countValues = reinterpret_cast<const uint64_t *>(buffer + indexData);
 			indexData += sizeof(uint64_t);
 
 			std::vector<char> values;
 			values.resize(*sizeOfValues);
-			memcpy(values.data(), buffer.data() + indexData, *sizeOfValues);
+			memcpy(values.data(), buffer + indexData, *sizeOfValues);
 			indexData += uint32_t(*sizeOfValues);
 
 			param.name = name;
@@ -151,8 +152,15 @@ Napi::Value settings::OBS_settings_getSettings(const Napi::CallbackInfo &info)
 	Napi::Array array = Napi::Array::New(info.Env());
 	Napi::Object settings = Napi::Object::New(info.Env());
 
-	std::vector<settings::SubCategory> categorySettings =
-		serializeCategory(uint32_t(response[1].value_union.ui64), uint32_t(response[2].value_union.ui64), response[3].value_bin);
+	std::vector<settings::SubCategory> categorySettings;
+	{
+		SharedMemory::Payload payload = SharedMemory::GetInstance().ReadPayload(response, 3);
+		if (payload.size() < response[2].value_union.ui64) {
+			Napi::Error::New(info.Env(), "Failed to read settings payload.").ThrowAsJavaScriptException();
+			return info.Env().Undefined();
+		}
+		categorySettings = serializeCategory(uint32_t(response[1].value_union.ui64), uint32_t(response[2].value_union.ui64), payload.data());
+	}
 
 	for (int i = 0; i < categorySettings.size(); i++) {
 		Napi::Object subCategory = Napi::Object::New(info.Env());
@@ -285,7 +293,7 @@ Napi::Value settings::OBS_settings_getSettings(const Napi::CallbackInfo &info)
 		subCategory.Set("parameters", subCategoryParameters);
 		array.Set(i, subCategory);
 		settings.Set("data", array);
-		settings.Set("type", Napi::Number::New(info.Env(), response[4].value_union.ui32));
+		settings.Set("type", Napi::Number::New(info.Env(), response[6].value_union.ui32));
 	}
 	return settings;
 }
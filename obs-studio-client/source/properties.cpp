@@ -18,12 +18,65 @@
 
 #include "properties.hpp"
 #include "isource.hpp"
+#include "shared-memory.hpp"
 #include "utility-v8.hpp"
 
-std::shared_ptr<osn::property_map_t> osn::Properties::GetProperties()
+static inline Napi::String ToJSString(Napi::Env env, std::string_view str)
 {
-	return properties;
+	return Napi::String::New(env, str.data(), str.size());
 }
+
+// Frame rate properties are shown to JS as a string list whose values are JSON.
+static std::string FrameRateJson(uint32_t numerator, uint32_t denominator)
+{
+	return "{\"denominator\":" + std::to_string(denominator) + ",\"numerator\":" + std::to_string(numerator) + "}";
+}
+
+static obs::Property::Type VisibleType(const obs::flat::Record &record)
+{
+	obs::Property::Type type = obs::Property::Type(record.type);
+	if (type == obs::Property::Type::FrameRate)
+		return obs::Property::Type::List;
+	return type;
+}
+
+std::shared_ptr<osn::PropertySet> osn::PropertySet::Create(const char *data, uint64_t size)
+{
+	std::shared_ptr<PropertySet> set(new PropertySet());
+	set->m_buffer.assign(data, data + size);
+	if (!set->m_view.Open(set->m_buffer.data(), set->m_buffer.size()))
+		return nullptr;
+	return set;
+}
+
+std::shared_ptr<osn::PropertySet> osn::PropertySet::Merge(const obs::flat::View &changed, const std::vector<char> &layout) const
+{
+	obs::flat::Writer writer;
+	size_t start = 0;
+	while (start < layout.size()) {
+		size_t end = start;
+		while (end < layout.size() && layout[end] != '\0')
+			end++;
+		std::string_view name(layout.data() + start, end - start);
+		start = end + 1;
+
+		uint32_t found = changed.Find(name);
+		if (found != changed.Count()) {
+			writer.Copy(changed, changed.Get(found));
+			continue;
+		}
+
+		found = m_view.Find(name);
+		if (found == m_view.Count())
+			return nullptr;
+		writer.Copy(m_view, m_view.Get(found));
+	}
+
+	std::vector<char> buffer;
+	writer.Finish(buffer);
+	return Create(buffer.data(), buffer.size());
+}
+
 Napi::FunctionReference osn::Properties::constructor;
 
 Napi::Object osn::Properties::Init(Napi::Env env, Napi::Object exports)
@@ -42,66 +95,51 @@ Napi::Object osn::Properties::Init(Napi::Env env, Napi::Object exports)
 	return exports;
 }
 
+Napi::Object osn::Properties::Create(Napi::Env env, const std::shared_ptr<PropertySet> &properties, uint64_t sourceId)
+{
+	std::shared_ptr<PropertySet> ref = properties;
+	auto prop_ptr = Napi::External<std::shared_ptr<PropertySet>>::New(env, &ref);
+	return osn::Properties::constructor.New({prop_ptr, Napi::Number::New(env, (uint32_t)sourceId)});
+}
+
 osn::Properties::Properties(const Napi::CallbackInfo &info) : Napi::ObjectWrap<osn::Properties>(info)
 {
 	Napi::Env env = info.Env();
 	Napi::HandleScope scope(env);
-	this->properties = std::make_shared<property_map_t>(*info[0].As<const Napi::External<property_map_t>>().Data());
+	this->properties = *info[0].As<const Napi::External<std::shared_ptr<PropertySet>>>().Data();
 	this->sourceId = (uint64_t)info[1].ToNumber().Uint32Value();
 }
 
 Napi::Value osn::Properties::Count(const Napi::CallbackInfo &info)
 {
-	osn::Properties *obj = Napi::ObjectWrap<osn::Properties>::Unwrap(info.This().ToObject());
-	if (!obj)
-		return info.Env().Undefined();
-
-	return Napi::Number::New(info.Env(), (uint32_t)obj->properties->size());
+	return Napi::Number::New(info.Env(), this->properties->Count());
 }
 
 Napi::Value osn::Properties::First(const Napi::CallbackInfo &info)
 {
-	osn::Properties *obj = Napi::ObjectWrap<osn::Properties>::Unwrap(info.This().ToObject());
-	if (!obj)
-		return info.Env().Undefined();
-
-	if (obj->properties->size() == 0)
+	if (this->properties->Count() == 0)
 		return info.Env().Undefined();
 
-	auto iter = obj->properties->begin();
-	auto instance = osn::PropertyObject::constructor.New({info.This(), Napi::Number::New(info.Env(), (uint32_t)iter->first)});
-	return instance;
+	return osn::PropertyObject::constructor.New({info.This(), Napi::Number::New(info.Env(), 0)});
 }
 
 Napi::Value osn::Properties::Last(const Napi::CallbackInfo &info)
 {
-	osn::Properties *obj = Napi::ObjectWrap<osn::Properties>::Unwrap(info.This().ToObject());
-	if (!obj)
+	if (this->properties->Count() == 0)
 		return info.Env().Undefined();
 
-	if (obj->properties->size() == 0)
-		return info.Env().Undefined();
-
-	auto iter = --obj->properties->end();
-	auto instance = osn::PropertyObject::constructor.New({info.This(), Napi::Number::New(info.Env(), (uint32_t)iter->first)});
-	return instance;
+	return osn::PropertyObject::constructor.New({info.This(), Napi::Number::New(info.Env(), this->properties->Count() - 1)});
 }
 
 Napi::Value osn::Properties::Get(const Napi::CallbackInfo &info)
 {
-	osn::Properties *obj = Napi::ObjectWrap<osn::Properties>::Unwrap(info.This().ToObject());
-	if (!obj)
-		return info.Env().Undefined();
-
 	std::string name = info[0].ToString().Utf8Value();
 
-	for (auto iter = obj->properties->begin(); iter != obj->properties->end(); iter++) {
-		if (iter->second->name == name) {
-			auto instance = osn::PropertyObject::constructor.New({info.This(), Napi::Number::New(info.Env(), (uint32_t)iter->first)});
-			return instance;
-		}
-	}
-	return info.Env().Undefined();
+	uint32_t idx = this->properties->View().Find(name);
+	if (idx == this->properties->Count())
+		return info.Env().Undefined();
+
+	return osn::PropertyObject::constructor.New({info.This(), Napi::Number::New(info.Env(), idx)});
 }
 
 Napi::FunctionReference osn::PropertyObject::constructor;
@@ -126,6 +164,7 @@ Napi::Object osn::PropertyObject::Init(Napi::Env env, Napi::Object exports)
 						  InstanceAccessor("type", &osn::PropertyObject::GetType, nullptr),
 
 						  InstanceMethod("modified", &osn::PropertyObject::Modified),
+						  InstanceMethod("modifiedAndDiff", &osn::PropertyObject::ModifiedAndDiff),
 						  InstanceMethod("buttonClicked", &osn::PropertyObject::ButtonClicked),
 					  });
 	exports.Set("Property", func);
@@ -139,160 +178,104 @@ osn::PropertyObject::PropertyObject(const Napi::CallbackInfo &info) : Napi::Obje
 	Napi::Env env = info.Env();
 	Napi::HandleScope scope(env);
 	this->parent = Napi::ObjectWrap<osn::Properties>::Unwrap(info[0].ToObject());
-	this->index = (uint64_t)info[1].ToNumber().Uint32Value();
+	this->index = info[1].ToNumber().Uint32Value();
 }
 
-Napi::Value osn::PropertyObject::Previous(const Napi::CallbackInfo &info)
+const obs::flat::Record *osn::PropertyObject::GetRecord()
 {
-	osn::PropertyObject *self = Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
-	if (!self)
-		return info.Env().Undefined();
-	osn::Properties *parent = self->parent;
-	if (!parent)
-		return info.Env().Undefined();
-
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
-		return info.Env().Undefined();
+	if (!this->parent || !this->parent->properties || this->index >= this->parent->properties->Count())
+		return nullptr;
+	return &this->parent->properties->View().Get(this->index);
+}
 
-	if (iter == parent->GetProperties()->begin())
+Napi::Value osn::PropertyObject::Previous(const Napi::CallbackInfo &info)
+{
+	if (!GetRecord() || this->index == 0)
 		return info.Env().Undefined();
 
-	iter--;
-
-	auto instance = osn::PropertyObject::constructor.New({parent->Get(info), Napi::Number::New(info.Env(), (uint32_t)iter->first)});
-	return instance;
+	auto obj = osn::Properties::Create(info.Env(), this->parent->properties, this->parent->sourceId);
+	return osn::PropertyObject::constructor.New({obj, Napi::Number::New(info.Env(), this->index - 1)});
 }
 
 Napi::Value osn::PropertyObject::Next(const Napi::CallbackInfo &info)
 {
-	osn::PropertyObject *self = Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
-	if (!self)
+	if (!GetRecord() || this->index + 1 >= this->parent->properties->Count())
 		return info.Env().Undefined();
-	osn::Properties *parent = self->parent;
-	if (!parent)
-		return info.Env().Undefined();
-
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
-		return info.Env().Undefined();
-
-	iter++;
-	if (iter == parent->GetProperties()->end())
-		return info.Env().Undefined();
-
-	auto prop_ptr = Napi::External<property_map_t>::New(info.Env(), parent->properties.get());
-	auto obj = osn::Properties::constructor.New({prop_ptr, Napi::Number::New(info.Env(), (uint32_t)parent->sourceId)});
 
-	auto instance = osn::PropertyObject::constructor.New({obj, Napi::Number::New(info.Env(), (uint32_t)iter->first)});
-	return instance;
+	auto obj = osn::Properties::Create(info.Env(), this->parent->properties, this->parent->sourceId);
+	return osn::PropertyObject::constructor.New({obj, Napi::Number::New(info.Env(), this->index + 1)});
 }
 
 Napi::Value osn::PropertyObject::IsFirst(const Napi::CallbackInfo &info)
 {
-	osn::PropertyObject *self = Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
-	if (!self)
-		return info.Env().Undefined();
-	osn::Properties *parent = self->parent;
-	if (!parent)
+	if (!GetRecord())
 		return info.Env().Undefined();
 
-	auto iter = parent->GetProperties()->find(self->index);
-	return Napi::Boolean::New(info.Env(), iter == parent->GetProperties()->begin());
+	return Napi::Boolean::New(info.Env(), this->index == 0);
 }
 
 Napi::Value osn::PropertyObject::IsLast(const Napi::CallbackInfo &info)
 {
-	osn::PropertyObject *self = Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
-	if (!self)
-		return info.Env().Undefined();
-	osn::Properties *parent = self->parent;
-	if (!parent)
+	if (!GetRecord())
 		return info.Env().Undefined();
 
-	auto iter = property_map_t::reverse_iterator(parent->GetProperties()->find(self->index));
-	return Napi::Boolean::New(info.Env(), iter == parent->GetProperties()->rbegin());
+	return Napi::Boolean::New(info.Env(), this->index + 1 == this->parent->properties->Count());
 }
 
 Napi::Value osn::PropertyObject::GetValue(const Napi::CallbackInfo &info)
 {
-	osn::PropertyObject *self = Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
-	if (!self)
-		return info.Env().Undefined();
-	osn::Properties *parent = self->parent;
-	if (!parent)
-		return info.Env().Undefined();
-
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
-		return info.Env().Undefined();
-
-	switch (iter->second->type) {
-	case osn::Property::Type::INVALID:
-		return info.Env().Undefined();
-	case osn::Property::Type::BOOL: {
-		std::shared_ptr<osn::NumberProperty> cast_property = std::static_pointer_cast<osn::NumberProperty>(iter->second);
-		return Napi::Boolean::New(info.Env(), cast_property->bool_value.value);
-	}
-	case osn::Property::Type::INT: {
-		std::shared_ptr<osn::NumberProperty> cast_property = std::static_pointer_cast<osn::NumberProperty>(iter->second);
-		return Napi::Number::New(info.Env(), cast_property->int_value.value);
-	}
-	case osn::Property::Type::COLOR: {
-		std::shared_ptr<osn::NumberProperty> cast_property = std::static_pointer_cast<osn::NumberProperty>(iter->second);
-		return Napi::Number::New(info.Env(), cast_property->int_value.value);
-	}
-	case osn::Property::Type::FLOAT: {
-		std::shared_ptr<osn::NumberProperty> cast_property = std::static_pointer_cast<osn::NumberProperty>(iter->second);
-		return Napi::Number::New(info.Env(), cast_property->float_value.value);
-	}
-	case osn::Property::Type::TEXT: {
-		std::shared_ptr<osn::TextProperty> cast_property = std::static_pointer_cast<osn::TextProperty>(iter->second);
-		return Napi::String::New(info.Env(), cast_property->value);
-	}
-	case osn::Property::Type::PATH: {
-		std::shared_ptr<osn::PathProperty> cast_property = std::static_pointer_cast<osn::PathProperty>(iter->second);
-		return Napi::String::New(info.Env(), cast_property->value);
-	}
-
-	case osn::Property::Type::LIST: {
-		std::shared_ptr<osn::ListProperty> cast_property = std::static_pointer_cast<osn::ListProperty>(iter->second);
-		switch (cast_property->item_format) {
-		case ListProperty::Format::FLOAT:
-			return Napi::Number::New(info.Env(), cast_property->current_value_float);
-		case ListProperty::Format::INT:
-			return Napi::Number::New(info.Env(), cast_property->current_value_int);
-		case ListProperty::Format::STRING:
-			return Napi::String::New(info.Env(), cast_property->current_value_str);
+	const obs::flat::Record *record = GetRecord();
+	if (!record)
+		return info.Env().Undefined();
+	const obs::flat::View &view = this->parent->properties->View();
+
+	switch (obs::Property::Type(record->type)) {
+	case obs::Property::Type::Boolean:
+		return Napi::Boolean::New(info.Env(), !!record->ints[0]);
+	case obs::Property::Type::Integer:
+		return Napi::Number::New(info.Env(), record->ints[3]);
+	case obs::Property::Type::Color:
+		return Napi::Number::New(info.Env(), record->ints[0]);
+	case obs::Property::Type::Float:
+		return Napi::Number::New(info.Env(), record->floats[3]);
+	case obs::Property::Type::Text:
+		return ToJSString(info.Env(), view.Str(record->text[0]));
+	case obs::Property::Type::Path:
+		return ToJSString(info.Env(), view.Str(record->text[2]));
+	case obs::Property::Type::List: {
+		switch (obs::ListProperty::Format(record->format)) {
+		case obs::ListProperty::Format::Float:
+			return Napi::Number::New(info.Env(), record->floats[0]);
+		case obs::ListProperty::Format::Integer:
+			return Napi::Number::New(info.Env(), record->ints[0]);
+		case obs::ListProperty::Format::String:
+			return ToJSString(info.Env(), view.Str(record->text[0]));
+		default:
+			break;
 		}
 		break;
 	}
-	case osn::Property::Type::EDITABLELIST: {
-		std::shared_ptr<osn::EditableListProperty> cast_property = std::static_pointer_cast<osn::EditableListProperty>(iter->second);
-
-		Napi::Array values = Napi::Array::New(info.Env());
-		size_t idx = 0;
-		for (auto value : cast_property->values) {
+	case obs::Property::Type::FrameRate:
+		return Napi::String::New(info.Env(), FrameRateJson(uint32_t(record->ints[0]), uint32_t(record->ints[1])));
+	case obs::Property::Type::EditableList: {
+		Napi::Array values = Napi::Array::New(info.Env(), record->item_count);
+		for (uint32_t idx = 0; idx < record->item_count; idx++) {
 			Napi::Object iobj = Napi::Object::New(info.Env());
-			iobj.Set("value", value);
-			values.Set((uint32_t)idx++, iobj);
+			iobj.Set("value", ToJSString(info.Env(), view.Str(view.GetItem(*record, idx).value)));
+			values.Set(idx, iobj);
 		}
-
 		return values;
 	}
-	case osn::Property::Type::BUTTON:
-		break;
-	case osn::Property::Type::FONT: {
-		std::shared_ptr<osn::FontProperty> cast_property = std::static_pointer_cast<osn::FontProperty>(iter->second);
+	case obs::Property::Type::Font: {
 		Napi::Object font = Napi::Object::New(info.Env());
-		font.Set("face", cast_property->face);
-		font.Set("style", cast_property->style);
-		font.Set("path", cast_property->path);
-		font.Set("size", Napi::Number::New(info.Env(), cast_property->sizeF));
-		font.Set("flags", Napi::Number::New(info.Env(), cast_property->flags));
+		font.Set("face", ToJSString(info.Env(), view.Str(record->text[0])));
+		font.Set("style", ToJSString(info.Env(), view.Str(record->text[1])));
+		font.Set("path", ToJSString(info.Env(), view.Str(record->text[2])));
+		font.Set("size", Napi::Number::New(info.Env(), record->ints[0]));
+		font.Set("flags", Napi::Number::New(info.Env(), (uint32_t)record->ints[1]));
 		return font;
 	}
-	case osn::Property::Type::FRAMERATE:
+	default:
 		break;
 	}
 	return info.Env().Undefined();
@@ -300,219 +283,155 @@ Napi::Value osn::PropertyObject::GetValue(const Napi::CallbackInfo &info)
 
 Napi::Value osn::PropertyObject::GetName(const Napi::CallbackInfo &info)
 {
-	osn::PropertyObject *self = Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
-	if (!self)
-		return info.Env().Undefined();
-	osn::Properties *parent = self->parent;
-	if (!parent)
-		return info.Env().Undefined();
-
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
+	const obs::flat::Record *record = GetRecord();
+	if (!record)
 		return info.Env().Undefined();
 
-	return Napi::String::New(info.Env(), iter->second->name);
+	return ToJSString(info.Env(), this->parent->properties->View().Str(record->name));
 }
 
 Napi::Value osn::PropertyObject::GetDescription(const Napi::CallbackInfo &info)
 {
-	osn::PropertyObject *self = Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
-	if (!self)
-		return info.Env().Undefined();
-	osn::Properties *parent = self->parent;
-	if (!parent)
+	const obs::flat::Record *record = GetRecord();
+	if (!record)
 		return info.Env().Undefined();
 
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
-		return info.Env().Undefined();
-
-	return Napi::String::New(info.Env(), iter->second->description);
+	return ToJSString(info.Env(), this->parent->properties->View().Str(record->description));
 }
 
 Napi::Value osn::PropertyObject::GetLongDescription(const Napi::CallbackInfo &info)
 {
-	osn::PropertyObject *self = Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
-	if (!self)
-		return info.Env().Undefined();
-	osn::Properties *parent = self->parent;
-	if (!parent)
-		return info.Env().Undefined();
-
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
+	const obs::flat::Record *record = GetRecord();
+	if (!record)
 		return info.Env().Undefined();
 
-	return Napi::String::New(info.Env(), iter->second->long_description);
+	return ToJSString(info.Env(), this->parent->properties->View().Str(record->long_description));
 }
 
 Napi::Value osn::PropertyObject::IsEnabled(const Napi::CallbackInfo &info)
 {
-	osn::PropertyObject *self = Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
-	if (!self)
-		return info.Env().Undefined();
-	osn::Properties *parent = self->parent;
-	if (!parent)
-		return info.Env().Undefined();
-
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
+	const obs::flat::Record *record = GetRecord();
+	if (!record)
 		return info.Env().Undefined();
 
-	return Napi::Boolean::New(info.Env(), iter->second->enabled);
+	return Napi::Boolean::New(info.Env(), !!(record->flags & obs::flat::RecordFlags::Enabled));
 }
 
 Napi::Value osn::PropertyObject::IsVisible(const Napi::CallbackInfo &info)
 {
-	osn::PropertyObject *self = Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
-	if (!self)
-		return info.Env().Undefined();
-	osn::Properties *parent = self->parent;
-	if (!parent)
-		return info.Env().Undefined();
-
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
+	const obs::flat::Record *record = GetRecord();
+	if (!record)
 		return info.Env().Undefined();
 
-	return Napi::Boolean::New(info.Env(), iter->second->visible);
+	return Napi::Boolean::New(info.Env(), !!(record->flags & obs::flat::RecordFlags::Visible));
 }
 
 Napi::Value osn::PropertyObject::GetType(const Napi::CallbackInfo &info)
 {
-	osn::PropertyObject *self = Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
-	if (!self)
-		return info.Env().Undefined();
-	osn::Properties *parent = self->parent;
-	if (!parent)
+	const obs::flat::Record *record = GetRecord();
+	if (!record)
 		return info.Env().Undefined();
 
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
-		return info.Env().Undefined();
-
-	return Napi::Number::New(info.Env(), (uint32_t)iter->second->type);
+	return Napi::Number::New(info.Env(), (uint32_t)VisibleType(*record));
 }
 
 Napi::Value osn::PropertyObject::GetDetails(const Napi::CallbackInfo &info)
 {
-	osn::PropertyObject *self = Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
-	if (!self)
-		return info.Env().Undefined();
-	osn::Properties *parent = self->parent;
-	if (!parent)
-		return info.Env().Undefined();
-
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
+	const obs::flat::Record *record = GetRecord();
+	if (!record)
 		return info.Env().Undefined();
+	const obs::flat::View &view = this->parent->properties->View();
 
 	Napi::Object object = Napi::Object::New(info.Env());
 
-	switch (iter->second->type) {
-	case osn::Property::Type::INT: {
-		std::shared_ptr<osn::NumberProperty> prop = std::static_pointer_cast<osn::NumberProperty>(iter->second);
-
-		object.Set("type", Napi::Number::New(info.Env(), (uint32_t)prop->field_type));
-		object.Set("min", Napi::Number::New(info.Env(), prop->int_value.min));
-		object.Set("max", Napi::Number::New(info.Env(), prop->int_value.max));
-		object.Set("step", Napi::Number::New(info.Env(), prop->int_value.step));
+	switch (obs::Property::Type(record->type)) {
+	case obs::Property::Type::Integer: {
+		object.Set("type", Napi::Number::New(info.Env(), (uint32_t)record->field_type));
+		object.Set("min", Napi::Number::New(info.Env(), record->ints[0]));
+		object.Set("max", Napi::Number::New(info.Env(), record->ints[1]));
+		object.Set("step", Napi::Number::New(info.Env(), record->ints[2]));
 		break;
 	}
-	case osn::Property::Type::FLOAT: {
-		std::shared_ptr<osn::NumberProperty> prop = std::static_pointer_cast<osn::NumberProperty>(iter->second);
-
-		object.Set("type", Napi::Number::New(info.Env(), (uint32_t)prop->field_type));
-		object.Set("min", Napi::Number::New(info.Env(), prop->float_value.min));
-		object.Set("max", Napi::Number::New(info.Env(), prop->float_value.max));
-		object.Set("step", Napi::Number::New(info.Env(), prop->float_value.step));
+	case obs::Property::Type::Float: {
+		object.Set("type", Napi::Number::New(info.Env(), (uint32_t)record->field_type));
+		object.Set("min", Napi::Number::New(info.Env(), record->floats[0]));
+		object.Set("max", Napi::Number::New(info.Env(), record->floats[1]));
+		object.Set("step", Napi::Number::New(info.Env(), record->floats[2]));
 		break;
 	}
-	case osn::Property::Type::TEXT: {
-		std::shared_ptr<osn::TextProperty> prop = std::static_pointer_cast<osn::TextProperty>(iter->second);
-
-		object.Set("type", Napi::Number::New(info.Env(), (uint32_t)prop->field_type));
-		object.Set("infoType", Napi::Number::New(info.Env(), (uint32_t)prop->info_type));
+	case obs::Property::Type::Text: {
+		object.Set("type", Napi::Number::New(info.Env(), (uint32_t)record->field_type));
+		object.Set("infoType", Napi::Number::New(info.Env(), (uint32_t)record->format));
 		break;
 	}
-	case osn::Property::Type::PATH: {
-		std::shared_ptr<osn::PathProperty> prop = std::static_pointer_cast<osn::PathProperty>(iter->second);
-
-		object.Set("type", Napi::Number::New(info.Env(), (uint32_t)prop->field_type));
-		object.Set("filter", Napi::String::New(info.Env(), prop->filter));
-		object.Set("defaultPath", Napi::String::New(info.Env(), prop->default_path));
+	case obs::Property::Type::Path: {
+		object.Set("type", Napi::Number::New(info.Env(), (uint32_t)record->field_type));
+		object.Set("filter", ToJSString(info.Env(), view.Str(record->text[0])));
+		object.Set("defaultPath", ToJSString(info.Env(), view.Str(record->text[1])));
 		break;
 	}
-	case osn::Property::Type::LIST: {
-		std::shared_ptr<osn::ListProperty> prop = std::static_pointer_cast<osn::ListProperty>(iter->second);
-
-		object.Set("type", Napi::Number::New(info.Env(), (uint32_t)prop->field_type));
-		object.Set("format", Napi::Number::New(info.Env(), (uint32_t)prop->item_format));
-
-		Napi::Array itemsobj = Napi::Array::New(info.Env());
-		size_t idx = 0;
-		for (auto itm : prop->items) {
+	case obs::Property::Type::List: {
+		obs::ListProperty::Format format = obs::ListProperty::Format(record->format);
+		object.Set("type", Napi::Number::New(info.Env(), (uint32_t)record->field_type));
+		object.Set("format", Napi::Number::New(info.Env(), (uint32_t)format));
+
+		Napi::Array itemsobj = Napi::Array::New(info.Env(), record->item_count);
+		for (uint32_t idx = 0; idx < record->item_count; idx++) {
+			const obs::flat::Item &itm = view.GetItem(*record, idx);
 			Napi::Object iobj = Napi::Object::New(info.Env());
-			iobj.Set("name", Napi::String::New(info.Env(), itm.name));
-			iobj.Set("enabled", Napi::Boolean::New(info.Env(), !itm.disabled));
+			iobj.Set("name", ToJSString(info.Env(), view.Str(itm.name)));
+			iobj.Set("enabled", Napi::Boolean::New(info.Env(), !!itm.enabled));
 
-			switch (prop->item_format) {
-			case ListProperty::Format::INT:
+			switch (format) {
+			case obs::ListProperty::Format::Integer:
 				iobj.Set("value", Napi::Number::New(info.Env(), itm.value_int));
 				break;
-			case ListProperty::Format::FLOAT:
+			case obs::ListProperty::Format::Float:
 				iobj.Set("value", Napi::Number::New(info.Env(), itm.value_float));
 				break;
-			case ListProperty::Format::STRING:
-				iobj.Set("value", Napi::String::New(info.Env(), itm.value_str));
+			case obs::ListProperty::Format::String:
+				iobj.Set("value", ToJSString(info.Env(), view.Str(itm.value)));
+				break;
+			default:
 				break;
 			}
-			itemsobj.Set((uint32_t)idx++, iobj);
+			itemsobj.Set(idx, iobj);
 		}
 		object.Set("items", itemsobj);
 		break;
 	}
-	case osn::Property::Type::EDITABLELIST: {
-		std::shared_ptr<osn::EditableListProperty> prop = std::static_pointer_cast<osn::EditableListProperty>(iter->second);
-
-		object.Set("type", Napi::Number::New(info.Env(), (uint32_t)prop->field_type));
-		object.Set("filter", Napi::String::New(info.Env(), prop->filter));
-		object.Set("defaultPath", Napi::String::New(info.Env(), prop->default_path));
-		break;
-	}
-	case osn::Property::Type::FRAMERATE: {
-		std::shared_ptr<osn::FrameRateProperty> prop = std::static_pointer_cast<osn::FrameRateProperty>(iter->second);
-
-		Napi::Array rangesobj = Napi::Array::New(info.Env());
-		size_t idx = 0;
-		for (auto itm : prop->ranges) {
-			Napi::Object minobj = Napi::Object::New(info.Env());
-			minobj.Set("numerator", Napi::Number::New(info.Env(), itm.first.numerator));
-			minobj.Set("denominator", Napi::Number::New(info.Env(), itm.first.denominator));
-
-			Napi::Object maxobj = Napi::Object::New(info.Env());
-			maxobj.Set("numerator", Napi::Number::New(info.Env(), itm.second.numerator));
-			maxobj.Set("denominator", Napi::Number::New(info.Env(), itm.second.denominator));
+	case obs::Property::Type::FrameRate: {
+		// Presented as a list of the maximum of every range.
+		object.Set("type", Napi::Number::New(info.Env(), (uint32_t)obs::ListProperty::ListType::List));
+		object.Set("format", Napi::Number::New(info.Env(), (uint32_t)obs::ListProperty::Format::String));
 
-			Napi::Object iobj = Napi::Object::New(info.Env());
-			iobj.Set("min", minobj);
-			iobj.Set("max", maxobj);
+		Napi::Array itemsobj = Napi::Array::New(info.Env());
+		uint32_t count = 0;
+		for (uint32_t idx = 0; idx < record->item_count; idx++) {
+			const obs::flat::Item &itm = view.GetItem(*record, idx);
+			if (itm.kind != obs::flat::ItemKind::FrameRateRange)
+				continue;
 
-			rangesobj.Set((uint32_t)idx++, iobj);
-		}
-		object.Set("ranges", rangesobj);
+			uint32_t numerator = uint32_t(uint64_t(itm.value_int2) >> 32);
+			uint32_t denominator = uint32_t(itm.value_int2 & 0xFFFFFFFF);
 
-		Napi::Array itemsobj = Napi::Array::New(info.Env());
-		idx = 0;
-		for (auto itm : prop->options) {
 			Napi::Object iobj = Napi::Object::New(info.Env());
-			iobj.Set("name", Napi::String::New(info.Env(), itm.name));
-			iobj.Set("description", Napi::String::New(info.Env(), itm.description));
-			rangesobj.Set((uint32_t)idx++, iobj);
+			iobj.Set("name", Napi::String::New(info.Env(), std::to_string(denominator ? numerator / denominator : 0)));
+			iobj.Set("enabled", Napi::Boolean::New(info.Env(), true));
+			iobj.Set("value", Napi::String::New(info.Env(), FrameRateJson(numerator, denominator)));
+			itemsobj.Set(count++, iobj);
 		}
 		object.Set("items", itemsobj);
 		break;
 	}
+	case obs::Property::Type::EditableList: {
+		object.Set("type", Napi::Number::New(info.Env(), (uint32_t)record->field_type));
+		object.Set("filter", ToJSString(info.Env(), view.Str(record->text[0])));
+		object.Set("defaultPath", ToJSString(info.Env(), view.Str(record->text[1])));
+		break;
+	}
+	default:
+		break;
 	}
 
 	return object;
@@ -525,16 +444,10 @@ Napi::Value osn::PropertyObject::Modified(const Napi::CallbackInfo &info)
 	Napi::Object json = info.Env().Global().Get("JSON").As<Napi::Object>();
 	Napi::Function stringify = json.Get("stringify").As<Napi::Function>();
 
-	osn::PropertyObject *self = Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
-	if (!self)
-		return info.Env().Undefined();
-	osn::Properties *parent = self->parent;
-	if (!parent)
-		return info.Env().Undefined();
-
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
+	const obs::flat::Record *record = GetRecord();
+	if (!record)
 		return info.Env().Null();
+	std::string name(this->parent->properties->View().Str(record->name));
 
 	Napi::String settings_str = stringify.Call(json, {settings}).As<Napi::String>();
 	std::string value = settings_str.Utf8Value();
@@ -543,235 +456,131 @@ Napi::Value osn::PropertyObject::Modified(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	auto rval = conn->call_synchronous_helper("Properties", "Modified", {ipc::value(parent->sourceId), ipc::value(iter->second->name), ipc::value(value)});
+	auto rval = conn->call_synchronous_helper("Properties", "Modified", {ipc::value(this->parent->sourceId), ipc::value(name), ipc::value(value)});
 
 	if (!ValidateResponse(info, rval))
 		return Napi::Boolean::New(info.Env(), false);
 
-	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(parent->sourceId);
+	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->parent->sourceId);
 	if (sdi) {
 		sdi->propertiesChanged = true;
 		sdi->settingsChanged = true;
+		sdi->settingsVersion++;
 	}
 
 	return Napi::Boolean::New(info.Env(), !!rval[1].value_union.i32);
 }
 
-Napi::Value osn::PropertyObject::ButtonClicked(const Napi::CallbackInfo &info)
+Napi::Value osn::PropertyObject::ModifiedAndDiff(const Napi::CallbackInfo &info)
 {
-	osn::PropertyObject *self = Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
-	if (!self)
+	Napi::Object settings = info[0].ToObject();
+
+	Napi::Object json = info.Env().Global().Get("JSON").As<Napi::Object>();
+	Napi::Function stringify = json.Get("stringify").As<Napi::Function>();
+
+	const obs::flat::Record *record = GetRecord();
+	if (!record)
+		return info.Env().Null();
+	std::string name(this->parent->properties->View().Str(record->name));
+
+	Napi::String settings_str = stringify.Call(json, {settings}).As<Napi::String>();
+	std::string value = settings_str.Utf8Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
 		return info.Env().Undefined();
-	osn::Properties *parent = self->parent;
-	if (!parent)
+
+	// The server diffs against the tree with this version, if it still has it.
+	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->parent->sourceId);
+	uint64_t knownVersion = (sdi && sdi->properties == this->parent->properties) ? sdi->propertiesVersion : 0;
+
+	auto rval = conn->call_synchronous_helper("Properties", "ModifiedAndDiff",
+						  {ipc::value(this->parent->sourceId), ipc::value(name), ipc::value(value), ipc::value(knownVersion)});
+
+	if (!ValidateResponse(info, rval))
 		return info.Env().Undefined();
 
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
+	bool modified = !!rval[1].value_union.i32;
+	Napi::Object result = Napi::Object::New(info.Env());
+	Napi::Array changed = Napi::Array::New(info.Env());
+	result.Set("modified", Napi::Boolean::New(info.Env(), modified));
+	result.Set("changed", changed);
+
+	if (sdi) {
+		sdi->settingsChanged = true;
+		sdi->settingsVersion++;
+		// The tree below is built from settings the source may not have yet,
+		// the next GetProperties checks it against the server.
+		sdi->propertiesChanged = true;
+	}
+	if (!modified)
+		return result;
+
+	uint64_t version = rval[2].value_union.ui64;
+	SharedMemory::Payload payload = SharedMemory::GetInstance().ReadPayload(rval, 4);
+	obs::flat::View diff;
+	std::shared_ptr<PropertySet> merged;
+	if (diff.Open(payload.data(), payload.size()))
+		merged = this->parent->properties->Merge(diff, rval[3].value_bin);
+
+	// Leave it to the next GetProperties call to fetch the whole tree.
+	if (!merged)
+		return result;
+
+	// Only report what differs from the tree this property came from, the
+	// server sends everything when it no longer knew that tree.
+	const obs::flat::View &current = this->parent->properties->View();
+	uint32_t count = 0;
+	for (uint32_t idx = 0; idx < diff.Count(); idx++) {
+		const obs::flat::Record &record = diff.Get(idx);
+		uint32_t found = current.Find(diff.Str(record.name));
+		if (found == current.Count() || !obs::flat::View::Equal(current, current.Get(found), diff, record))
+			changed.Set(count++, ToJSString(info.Env(), diff.Str(record.name)));
+	}
+
+	// The Properties object this property came from sees the new tree as well.
+	this->parent->properties = merged;
+	uint32_t index = merged->View().Find(name);
+	if (index != merged->Count())
+		this->index = index;
+
+	if (sdi) {
+		sdi->properties = merged;
+		sdi->propertiesVersion = version;
+	}
+
+	result.Set("properties", osn::Properties::Create(info.Env(), merged, this->parent->sourceId));
+	return result;
+}
+
+Napi::Value osn::PropertyObject::ButtonClicked(const Napi::CallbackInfo &info)
+{
+	const obs::flat::Record *record = GetRecord();
+	if (!record)
 		return info.Env().Null();
+	std::string name(this->parent->properties->View().Str(record->name));
 
 	// Call
 	auto conn = GetConnection(info);
 	if (!conn)
 		return info.Env().Undefined();
 
-	auto rval = conn->call_synchronous_helper("Properties", "Clicked", {ipc::value(parent->sourceId), ipc::value(iter->second->name)});
+	auto rval = conn->call_synchronous_helper("Properties", "Clicked", {ipc::value(this->parent->sourceId), ipc::value(name)});
 
 	if (!ValidateResponse(info, rval))
 		return Napi::Boolean::New(info.Env(), false);
 
-	rval = conn->call_synchronous_helper("Properties", "Modified", {ipc::value(parent->sourceId), ipc::value(iter->second->name), ipc::value("")});
+	rval = conn->call_synchronous_helper("Properties", "Modified", {ipc::value(this->parent->sourceId), ipc::value(name), ipc::value("")});
 	bool settings_changed = false;
 	if (ValidateResponse(info, rval))
 		settings_changed = true;
 
-	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(parent->sourceId);
+	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->parent->sourceId);
 	if (sdi) {
 		sdi->propertiesChanged = true;
 		sdi->settingsChanged = settings_changed;
+		sdi->settingsVersion++;
 	}
 
 	return Napi::Boolean::New(info.Env(), true);
 }
-
-osn::property_map_t osn::ProcessProperties(const std::vector<ipc::value> &data, size_t index)
-{
-	osn::property_map_t pmap;
-	for (size_t idx = index; idx < data.size(); ++idx) {
-		auto raw_property = obs::Property::deserialize(data[idx].value_bin);
-
-		std::shared_ptr<osn::Property> pr;
-
-		switch (raw_property->type()) {
-		case obs::Property::Type::Boolean: {
-			std::shared_ptr<obs::BooleanProperty> cast_property = std::dynamic_pointer_cast<obs::BooleanProperty>(raw_property);
-			std::shared_ptr<osn::NumberProperty> pr2 = std::make_shared<osn::NumberProperty>();
-			pr2->bool_value.value = cast_property->value;
-			pr = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::Integer: {
-			std::shared_ptr<obs::IntegerProperty> cast_property = std::dynamic_pointer_cast<obs::IntegerProperty>(raw_property);
-			std::shared_ptr<osn::NumberProperty> pr2 = std::make_shared<osn::NumberProperty>();
-			pr2->field_type = osn::NumberProperty::Type(cast_property->field_type);
-			pr2->int_value.min = cast_property->minimum;
-			pr2->int_value.max = cast_property->maximum;
-			pr2->int_value.step = cast_property->step;
-			pr2->int_value.value = cast_property->value;
-			pr = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::Color: {
-			std::shared_ptr<obs::ColorProperty> cast_property = std::dynamic_pointer_cast<obs::ColorProperty>(raw_property);
-			std::shared_ptr<osn::NumberProperty> pr2 = std::make_shared<osn::NumberProperty>();
-			pr2->field_type = osn::NumberProperty::Type(cast_property->field_type);
-			pr2->int_value.value = cast_property->value;
-			pr = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::Capture: {
-			std::shared_ptr<obs::CaptureProperty> cast_property = std::dynamic_pointer_cast<obs::CaptureProperty>(raw_property);
-			std::shared_ptr<osn::NumberProperty> pr2 = std::make_shared<osn::NumberProperty>();
-			pr2->field_type = osn::NumberProperty::Type(cast_property->field_type);
-			pr2->int_value.value = cast_property->value;
-			pr = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::Float: {
-			std::shared_ptr<obs::FloatProperty> cast_property = std::dynamic_pointer_cast<obs::FloatProperty>(raw_property);
-			std::shared_ptr<osn::NumberProperty> pr2 = std::make_shared<osn::NumberProperty>();
-			pr2->field_type = osn::NumberProperty::Type(cast_property->field_type);
-			pr2->float_value.min = cast_property->minimum;
-			pr2->float_value.max = cast_property->maximum;
-			pr2->float_value.step = cast_property->step;
-			pr2->float_value.value = cast_property->value;
-			pr = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::Text: {
-			std::shared_ptr<obs::TextProperty> cast_property = std::dynamic_pointer_cast<obs::TextProperty>(raw_property);
-			std::shared_ptr<osn::TextProperty> pr2 = std::make_shared<osn::TextProperty>();
-			pr2->field_type = cast_property->field_type;
-			pr2->info_type = cast_property->info_type;
-			pr2->value = cast_property->value;
-			pr = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::Path: {
-			std::shared_ptr<obs::PathProperty> cast_property = std::dynamic_pointer_cast<obs::PathProperty>(raw_property);
-			std::shared_ptr<osn::PathProperty> pr2 = std::make_shared<osn::PathProperty>();
-			pr2->field_type = osn::PathProperty::Type(cast_property->field_type);
-			pr2->filter = cast_property->filter;
-			pr2->default_path = cast_property->default_path;
-			pr2->value = cast_property->value;
-			pr = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::List: {
-			std::shared_ptr<obs::ListProperty> cast_property = std::dynamic_pointer_cast<obs::ListProperty>(raw_property);
-			std::shared_ptr<osn::ListProperty> pr2 = std::make_shared<osn::ListProperty>();
-			pr2->field_type = osn::ListProperty::Type(cast_property->field_type);
-			pr2->item_format = osn::ListProperty::Format(cast_property->format);
-
-			switch (cast_property->format) {
-			case obs::ListProperty::Format::Integer:
-				pr2->current_value_int = cast_property->current_value_int;
-				break;
-			case obs::ListProperty::Format::Float:
-				pr2->current_value_float = cast_property->current_value_float;
-				break;
-			case obs::ListProperty::Format::String:
-				pr2->current_value_str = cast_property->current_value_str;
-				break;
-			}
-
-			for (auto &item : cast_property->items) {
-				osn::ListProperty::Item item2;
-				item2.name = item.name;
-				item2.disabled = !item.enabled;
-				switch (cast_property->format) {
-				case obs::ListProperty::Format::Integer:
-					item2.value_int = item.value_int;
-					break;
-				case obs::ListProperty::Format::Float:
-					item2.value_float = item.value_float;
-					break;
-				case obs::ListProperty::Format::String:
-					item2.value_str = item.value_string;
-					break;
-				}
-				pr2->items.push_back(std::move(item2));
-			}
-			pr = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::Font: {
-			std::shared_ptr<obs::FontProperty> cast_property = std::dynamic_pointer_cast<obs::FontProperty>(raw_property);
-			std::shared_ptr<osn::FontProperty> pr2 = std::make_shared<osn::FontProperty>();
-			pr2->face = cast_property->face;
-			pr2->style = cast_property->style;
-			pr2->path = cast_property->path;
-			pr2->sizeF = cast_property->sizeF;
-			pr2->flags = cast_property->flags;
-			pr = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::EditableList: {
-			std::shared_ptr<obs::EditableListProperty> cast_property = std::dynamic_pointer_cast<obs::EditableListProperty>(raw_property);
-			std::shared_ptr<osn::EditableListProperty> pr2 = std::make_shared<osn::EditableListProperty>();
-			pr2->field_type = osn::EditableListProperty::Type(cast_property->field_type);
-			pr2->filter = cast_property->filter;
-			pr2->default_path = cast_property->default_path;
-
-			for (auto &item : cast_property->values) {
-				pr2->values.push_back(item);
-			}
-			pr = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::FrameRate: {
-			std::shared_ptr<obs::FrameRateProperty> cast_property = std::dynamic_pointer_cast<obs::FrameRateProperty>(raw_property);
-			std::shared_ptr<osn::ListProperty> pr2 = std::make_shared<osn::ListProperty>();
-			pr2->field_type = osn::ListProperty::Type::LIST;
-			pr2->item_format = osn::ListProperty::Format::STRING;
-
-			nlohmann::json fps;
-			fps["numerator"] = cast_property->current_numerator;
-			fps["denominator"] = cast_property->current_denominator;
-			pr2->current_value_str = fps.dump();
-
-			for (auto &option : cast_property->ranges) {
-				nlohmann::json fps;
-				fps["numerator"] = option.maximum.first;
-				fps["denominator"] = option.maximum.second;
-				osn::ListProperty::Item item2;
-				item2.name = std::to_string(option.maximum.first / option.maximum.second);
-				item2.disabled = false;
-				item2.value_str = fps.dump();
-				pr2->items.push_back(std::move(item2));
-			}
-
-			pr = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		default: {
-			pr = std::make_shared<osn::Property>();
-			break;
-		}
-		}
-
-		if (pr) {
-			pr->name = raw_property->name;
-			pr->description = raw_property->description;
-			pr->long_description = raw_property->long_description;
-			pr->type = osn::Property::Type(raw_property->type());
-			if (pr->type == osn::Property::Type::FRAMERATE)
-				pr->type = osn::Property::Type::LIST;
-			pr->enabled = raw_property->enabled;
-			pr->visible = raw_property->visible;
-
-			pmap.emplace(idx - 1, pr);
-		}
-	}
-	return pmap;
-}
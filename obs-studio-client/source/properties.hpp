@@ -18,160 +18,48 @@
 
 #pragma once
 #include <inttypes.h>
-#include <map>
-#include <math.h>
+#include <memory>
 #include <napi.h>
-#include <unordered_map>
+#include <vector>
 #include "utility-v8.hpp"
-#include "obs-property.hpp"
+#include "obs-property-flat.hpp"
 
 namespace osn {
-struct Property {
-	enum class Type {
-		INVALID,
-		BOOL,
-		INT,
-		FLOAT,
-		TEXT,
-		PATH,
-		LIST,
-		COLOR,
-		BUTTON,
-		FONT,
-		EDITABLELIST,
-		FRAMERATE,
-	};
-
-	std::string name;
-	std::string description;
-	std::string long_description;
-
-	bool enabled;
-	bool visible;
-
-	Type type;
-};
-
-struct NumberProperty : Property {
-	enum class Type {
-		SCROLLER,
-		SLIDER,
-	};
-
-	union {
-		struct {
-			int64_t min, max, step, value;
-		} int_value;
-		struct {
-			double_t min, max, step, value;
-		} float_value;
-		struct {
-			bool value;
-		} bool_value;
-	};
-
-	Type field_type;
-};
-
-struct TextProperty : Property {
-	obs::TextProperty::TextType field_type;
-	obs::TextProperty::InfoType info_type;
-	std::string value;
-};
-
-struct PathProperty : Property {
-	enum class Type { FILE, FILE_SAVE, PATH_DIRECTORY };
+// One set of properties exactly as the server sent it. Everything is read in
+// place from the flat buffer, JS objects are only created when accessed.
+class PropertySet {
+public:
+	// Copies the buffer and validates it, returns nullptr if it is malformed.
+	static std::shared_ptr<PropertySet> Create(const char *data, uint64_t size);
 
-	Type field_type;
-	std::string filter;
-	std::string default_path;
-	std::string value;
-};
+	PropertySet(PropertySet const &) = delete;
+	void operator=(PropertySet const &) = delete;
 
-struct ListProperty : Property {
-	enum class Type {
-		INVALID,
-		EDITABLE,
-		LIST,
-	};
-	enum class Format {
-		INVALID,
-		INT,
-		FLOAT,
-		STRING,
-	};
-
-	struct Item {
-		std::string name;
-		bool disabled;
-
-		union {
-			int64_t value_int;
-			double_t value_float;
-		};
-		std::string value_str;
-	};
-
-	union {
-		int64_t current_value_int;
-		double_t current_value_float;
-	};
-	std::string current_value_str;
-
-	Type field_type;
-	Format item_format;
-	std::list<Item> items;
-};
+	const obs::flat::View &View() const { return m_view; }
+	uint32_t Count() const { return m_view.Count(); }
 
-struct FontProperty : Property {
-	std::string face;
-	std::string style;
-	std::string path;
-	int64_t sizeF;
-	uint32_t flags;
-};
+	// Builds a new set ordered by `layout` (names separated by '\0') that takes
+	// every record in `changed` and the rest from this set. Returns nullptr if
+	// a name is in neither.
+	std::shared_ptr<PropertySet> Merge(const obs::flat::View &changed, const std::vector<char> &layout) const;
 
-// Contrary to the name, not compatible with the ListProperty. Actually more comparable to PathProperty.
-struct EditableListProperty : Property {
-	enum class Type {
-		STRINGS,
-		FILES,
-		FILES_AND_URLS,
-	};
-
-	Type field_type;
-	std::string filter;
-	std::string default_path;
-	std::list<std::string> values;
-};
+private:
+	PropertySet() {}
 
-struct FrameRateProperty : Property {
-	struct FrameRate {
-		uint32_t numerator;
-		uint32_t denominator;
-	};
-	struct Option {
-		std::string name;
-		std::string description;
-	};
-
-	std::list<std::pair<FrameRate, FrameRate>> ranges; // minmax range
-	std::list<Option> options;                         // Could also be a list, but this allows fast indexing by name.
+	std::vector<char> m_buffer;
+	obs::flat::View m_view;
 };
 
-// This is a class that basically implements the OBS behavior.
-typedef std::map<size_t, std::shared_ptr<Property>> property_map_t;
-
 // The actual classes that work with JavaScript
 class Properties : public Napi::ObjectWrap<osn::Properties> {
 public:
-	std::shared_ptr<property_map_t> properties;
+	std::shared_ptr<PropertySet> properties;
 	uint64_t sourceId;
 
 public:
-	std::shared_ptr<property_map_t> GetProperties();
 	static Napi::FunctionReference constructor;
 	static Napi::Object Init(Napi::Env env, Napi::Object exports);
+	static Napi::Object Create(Napi::Env env, const std::shared_ptr<PropertySet> &properties, uint64_t sourceId);
 	Properties(const Napi::CallbackInfo &info);
 
 	Napi::Value Count(const Napi::CallbackInfo &info);
@@ -184,6 +72,8 @@ class PropertyObject : public Napi::ObjectWrap<osn::PropertyObject> {
 	osn::Properties *parent;
 	uint32_t index;
 
+	const obs::flat::Record *GetRecord();
+
 public:
 	static Napi::FunctionReference constructor;
 	static Napi::Object Init(Napi::Env env, Napi::Object exports);
@@ -206,8 +96,7 @@ public:
 	Napi::Value GetDetails(const Napi::CallbackInfo &info);
 
 	Napi::Value Modified(const Napi::CallbackInfo &info);
+	Napi::Value ModifiedAndDiff(const Napi::CallbackInfo &info);
 	Napi::Value ButtonClicked(const Napi::CallbackInfo &info);
 };
-
-property_map_t ProcessProperties(const std::vector<ipc::value> &data, size_t index);
 }
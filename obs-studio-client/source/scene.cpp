@@ -28,6 +28,7 @@
 #include "sceneitem.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
+#include "write-behind.hpp"
 
 Napi::FunctionReference osn::Scene::constructor;
 
@@ -104,6 +105,7 @@ Napi::Value osn::Scene::Create(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Scene", "Create", std::vector<ipc::value>{ipc::value(name)});
 
 	if (!ValidateResponse(info, response))
@@ -135,6 +137,7 @@ Napi::Value osn::Scene::CreatePrivate(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Scene", "CreatePrivate", std::vector<ipc::value>{ipc::value(name)});
 
 	if (!ValidateResponse(info, response))
@@ -168,6 +171,7 @@ Napi::Value osn::Scene::FromName(const Napi::CallbackInfo &info)
 		if (!conn)
 			return info.Env().Undefined();
 
+		WriteBehind::GetInstance().Flush();
 		std::vector<ipc::value> response = conn->call_synchronous_helper("Scene", "FromName", {ipc::value(name)});
 
 		if (!ValidateResponse(info, response))
@@ -189,6 +193,7 @@ Napi::Value osn::Scene::Release(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("Scene", "Release", std::vector<ipc::value>{ipc::value(this->sourceId)});
 	return info.Env().Undefined();
 }
@@ -199,6 +204,7 @@ Napi::Value osn::Scene::Remove(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("Scene", "Remove", std::vector<ipc::value>{ipc::value(this->sourceId)});
 	return info.Env().Undefined();
 }
@@ -219,6 +225,7 @@ Napi::Value osn::Scene::Duplicate(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper(
 		"Scene", "Duplicate", std::vector<ipc::value>{ipc::value(this->sourceId), ipc::value(name), ipc::value(duplicate_type)});
 
@@ -283,6 +290,7 @@ Napi::Value osn::Scene::AddSource(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Scene", info.Length() >= 2 ? "AddSourceWithTransform" : "AddSource", params);
 
 	if (!ValidateResponse(info, response))
@@ -390,6 +398,7 @@ Napi::Value osn::Scene::FindItem(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response;
 	if (haveName) {
 		response = conn->call_synchronous_helper("Scene", "FindItemByName", std::vector<ipc::value>{ipc::value(this->sourceId), ipc::value(name)});
@@ -416,6 +425,7 @@ Napi::Value osn::Scene::MoveItem(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response =
 		conn->call_synchronous_helper("Scene", "MoveItem", std::vector<ipc::value>{ipc::value(this->sourceId), ipc::value(from), ipc::value(to)});
 
@@ -454,6 +464,7 @@ Napi::Value osn::Scene::OrderItems(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response =
 		conn->call_synchronous_helper("Scene", "OrderItems", std::vector<ipc::value>{ipc::value(this->sourceId), ipc::value(order_char)});
 
@@ -482,6 +493,7 @@ Napi::Value osn::Scene::GetItemAtIndex(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response =
 		conn->call_synchronous_helper("Scene", "GetItem", std::vector<ipc::value>{ipc::value(this->sourceId), ipc::value(index)});
 
@@ -522,6 +534,7 @@ Napi::Value osn::Scene::GetItems(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Scene", "GetItems", std::vector<ipc::value>{ipc::value(this->sourceId)});
 
 	if (!ValidateResponse(info, response))
@@ -556,6 +569,7 @@ Napi::Value osn::Scene::GetItemsInRange(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Scene", "GetItemsInRange",
 									 std::vector<ipc::value>{ipc::value(this->sourceId), ipc::value(from), ipc::value(to)});
 
@@ -20,15 +20,18 @@
 #include <mutex>
 #include <string>
 
+#include "async-calls.hpp"
 #include "controller.hpp"
 #include "osn-error.hpp"
 #include "input.hpp"
 #include "ipc-value.hpp"
+#include "method-table.hpp"
 #include "scene.hpp"
 #include "sceneitem.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
 #include "video.hpp"
+#include "write-behind.hpp"
 
 Napi::FunctionReference osn::SceneItem::constructor;
 
@@ -67,6 +70,8 @@ Napi::Object osn::SceneItem::Init(Napi::Env env, Napi::Object exports)
 				    InstanceMethod("remove", &osn::SceneItem::Remove),
 				    InstanceMethod("deferUpdateBegin", &osn::SceneItem::DeferUpdateBegin),
 				    InstanceMethod("deferUpdateEnd", &osn::SceneItem::DeferUpdateEnd),
+				    InstanceMethod("getPositionAsync", &osn::SceneItem::GetPositionAsync),
+				    InstanceMethod("getTransformInfoAsync", &osn::SceneItem::GetTransformInfoAsync),
 			    });
 	exports.Set("SceneItem", func);
 	osn::SceneItem::constructor = Napi::Persistent(func);
@@ -94,7 +99,9 @@ Napi::Value osn::SceneItem::GetSource(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("SceneItem", "GetSource", std::vector<ipc::value>{ipc::value(this->itemId)});
+	WriteBehind::GetInstance().Flush();
+	static RemoteMethod method("SceneItem", "GetSource");
+	std::vector<ipc::value> response = method.Call(conn, {ipc::value(this->itemId)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
@@ -111,7 +118,9 @@ Napi::Value osn::SceneItem::GetScene(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("SceneItem", "GetScene", std::vector<ipc::value>{ipc::value(this->itemId)});
+	WriteBehind::GetInstance().Flush();
+	static RemoteMethod method("SceneItem", "GetScene");
+	std::vector<ipc::value> response = method.Call(conn, {ipc::value(this->itemId)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
@@ -128,6 +137,7 @@ Napi::Value osn::SceneItem::Remove(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("SceneItem", "Remove", std::vector<ipc::value>{ipc::value(this->itemId)});
 
 	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
@@ -156,7 +166,9 @@ Napi::Value osn::SceneItem::IsVisible(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("SceneItem", "IsVisible", std::vector<ipc::value>{ipc::value(this->itemId)});
+	WriteBehind::GetInstance().FlushIfPending(batch::Setter::SceneItemSetVisible, this->itemId);
+	static RemoteMethod method("SceneItem", "IsVisible");
+	std::vector<ipc::value> response = method.Call(conn, {ipc::value(this->itemId)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
@@ -180,7 +192,7 @@ void osn::SceneItem::SetVisible(const Napi::CallbackInfo &info, const Napi::Valu
 	if (!conn)
 		return;
 
-	conn->call("SceneItem", "SetVisible", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(visible)});
+	WriteBehind::GetInstance().Queue(info.Env(), batch::Setter::SceneItemSetVisible, this->itemId, {ipc::value(this->itemId), ipc::value(visible)});
 
 	sid->isVisible = visible;
 }
@@ -197,7 +209,9 @@ Napi::Value osn::SceneItem::IsSelected(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("SceneItem", "IsSelected", std::vector<ipc::value>{ipc::value(this->itemId)});
+	WriteBehind::GetInstance().FlushIfPending(batch::Setter::SceneItemSetSelected, this->itemId);
+	static RemoteMethod method("SceneItem", "IsSelected");
+	std::vector<ipc::value> response = method.Call(conn, {ipc::value(this->itemId)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
@@ -227,7 +241,7 @@ void osn::SceneItem::SetSelected(const Napi::CallbackInfo &info, const Napi::Val
 	if (!conn)
 		return;
 
-	conn->call("SceneItem", "SetSelected", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(selected)});
+	WriteBehind::GetInstance().Queue(info.Env(), batch::Setter::SceneItemSetSelected, this->itemId, {ipc::value(this->itemId), ipc::value(selected)});
 
 	sid->selectedChanged = true;
 	sid->cached = true;
@@ -245,7 +259,9 @@ Napi::Value osn::SceneItem::IsStreamVisible(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("SceneItem", "IsStreamVisible", std::vector<ipc::value>{ipc::value(this->itemId)});
+	WriteBehind::GetInstance().Flush();
+	static RemoteMethod method("SceneItem", "IsStreamVisible");
+	std::vector<ipc::value> response = method.Call(conn, {ipc::value(this->itemId)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
@@ -277,6 +293,7 @@ void osn::SceneItem::SetStreamVisible(const Napi::CallbackInfo &info, const Napi
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("SceneItem", "SetStreamVisible", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(streamVisible)});
 
 	sid->streamVisibleChanged = true;
@@ -295,7 +312,9 @@ Napi::Value osn::SceneItem::IsRecordingVisible(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("SceneItem", "IsRecordingVisible", std::vector<ipc::value>{ipc::value(this->itemId)});
+	WriteBehind::GetInstance().Flush();
+	static RemoteMethod method("SceneItem", "IsRecordingVisible");
+	std::vector<ipc::value> response = method.Call(conn, {ipc::value(this->itemId)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
@@ -325,6 +344,7 @@ void osn::SceneItem::SetRecordingVisible(const Napi::CallbackInfo &info, const N
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("SceneItem", "SetRecordingVisible", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(recordingVisible)});
 
 	if (sid) {
@@ -333,6 +353,28 @@ void osn::SceneItem::SetRecordingVisible(const Napi::CallbackInfo &info, const N
 	}
 }
 
+// `queuedVersion` is the position version when an async read was queued, the
+// cache is then left alone if the position was written since.
+static Napi::Value PositionFromResponse(Napi::Env env, uint64_t itemId, const std::vector<ipc::value> &response, uint64_t queuedVersion = UINT64_MAX)
+{
+	float x = response[1].value_union.fp32;
+	float y = response[2].value_union.fp32;
+
+	Napi::Object obj = Napi::Object::New(env);
+	obj.Set("x", Napi::Number::New(env, x));
+	obj.Set("y", Napi::Number::New(env, y));
+
+	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(itemId);
+	if (sid && (queuedVersion == UINT64_MAX || sid->posVersion == queuedVersion)) {
+		sid->posX = x;
+		sid->posY = y;
+		sid->posChanged = false;
+		sid->posVersion++;
+	}
+
+	return obj;
+}
+
 Napi::Value osn::SceneItem::GetPosition(const Napi::CallbackInfo &info)
 {
 	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
@@ -348,22 +390,39 @@ Napi::Value osn::SceneItem::GetPosition(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("SceneItem", "GetPosition", std::vector<ipc::value>{ipc::value(this->itemId)});
+	WriteBehind::GetInstance().FlushIfPending(batch::Setter::SceneItemSetPosition, this->itemId);
+	static RemoteMethod method("SceneItem", "GetPosition");
+	std::vector<ipc::value> response = method.Call(conn, {ipc::value(this->itemId)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
-	float x = response[1].value_union.fp32;
-	float y = response[2].value_union.fp32;
 
-	Napi::Object obj = Napi::Object::New(info.Env());
-	obj.Set("x", Napi::Number::New(info.Env(), x));
-	obj.Set("y", Napi::Number::New(info.Env(), y));
+	return PositionFromResponse(info.Env(), this->itemId, response);
+}
 
-	sid->posX = x;
-	sid->posY = y;
-	sid->posChanged = false;
+Napi::Value osn::SceneItem::GetPositionAsync(const Napi::CallbackInfo &info)
+{
+	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 
-	return obj;
+	if (sid && !sid->posChanged) {
+		Napi::Object obj = Napi::Object::New(info.Env());
+		obj.Set("x", Napi::Number::New(info.Env(), sid->posX));
+		obj.Set("y", Napi::Number::New(info.Env(), sid->posY));
+
+		Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(info.Env());
+		deferred.Resolve(obj);
+		return deferred.Promise();
+	}
+
+	// Pending writes are sent before the request, so the read observes them.
+	WriteBehind::GetInstance().FlushIfPending(batch::Setter::SceneItemSetPosition, this->itemId);
+	static RemoteMethod method("SceneItem", "GetPosition");
+	uint64_t itemId = this->itemId;
+	uint64_t version = sid ? sid->posVersion : 0;
+	return AsyncCalls::GetInstance().Call(info.Env(), method, {ipc::value(itemId)},
+					      [itemId, version](Napi::Env env, const std::vector<ipc::value> &response) -> Napi::Value {
+						      return PositionFromResponse(env, itemId, response, version);
+					      });
 }
 
 void osn::SceneItem::SetPosition(const Napi::CallbackInfo &info, const Napi::Value &value)
@@ -381,10 +440,12 @@ void osn::SceneItem::SetPosition(const Napi::CallbackInfo &info, const Napi::Val
 	if (!conn)
 		return;
 
-	conn->call("SceneItem", "SetPosition", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(x), ipc::value(y)});
+	WriteBehind::GetInstance().Queue(info.Env(), batch::Setter::SceneItemSetPosition, this->itemId,
+					 {ipc::value(this->itemId), ipc::value(x), ipc::value(y)});
 
 	sid->posX = x;
 	sid->posY = y;
+	sid->posVersion++;
 }
 
 Napi::Value osn::SceneItem::GetCanvas(const Napi::CallbackInfo &info)
@@ -393,7 +454,9 @@ Napi::Value osn::SceneItem::GetCanvas(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("SceneItem", "GetCanvas", {ipc::value(this->itemId)});
+	WriteBehind::GetInstance().Flush();
+	static RemoteMethod method("SceneItem", "GetCanvas");
+	std::vector<ipc::value> response = method.Call(conn, {ipc::value(this->itemId)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
@@ -416,6 +479,7 @@ void osn::SceneItem::SetCanvas(const Napi::CallbackInfo &info, const Napi::Value
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("SceneItem", "SetCanvas", {ipc::value(this->itemId), ipc::value(canvas->canvasId)});
 }
 
@@ -430,7 +494,9 @@ Napi::Value osn::SceneItem::GetRotation(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("SceneItem", "GetRotation", std::vector<ipc::value>{ipc::value(this->itemId)});
+	WriteBehind::GetInstance().FlushIfPending(batch::Setter::SceneItemSetRotation, this->itemId);
+	static RemoteMethod method("SceneItem", "GetRotation");
+	std::vector<ipc::value> response = method.Call(conn, {ipc::value(this->itemId)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
@@ -455,7 +521,7 @@ void osn::SceneItem::SetRotation(const Napi::CallbackInfo &info, const Napi::Val
 	if (!conn)
 		return;
 
-	conn->call("SceneItem", "SetRotation", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(vector)});
+	WriteBehind::GetInstance().Queue(info.Env(), batch::Setter::SceneItemSetRotation, this->itemId, {ipc::value(this->itemId), ipc::value(vector)});
 
 	sid->rotation = vector;
 }
@@ -475,7 +541,9 @@ Napi::Value osn::SceneItem::GetScale(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("SceneItem", "GetScale", std::vector<ipc::value>{ipc::value(this->itemId)});
+	WriteBehind::GetInstance().FlushIfPending(batch::Setter::SceneItemSetScale, this->itemId);
+	static RemoteMethod method("SceneItem", "GetScale");
+	std::vector<ipc::value> response = method.Call(conn, {ipc::value(this->itemId)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
@@ -508,7 +576,7 @@ void osn::SceneItem::SetScale(const Napi::CallbackInfo &info, const Napi::Value
 	if (!conn)
 		return;
 
-	conn->call("SceneItem", "SetScale", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(x), ipc::value(y)});
+	WriteBehind::GetInstance().Queue(info.Env(), batch::Setter::SceneItemSetScale, this->itemId, {ipc::value(this->itemId), ipc::value(x), ipc::value(y)});
 
 	sid->scaleX = x;
 	sid->scaleY = y;
@@ -525,7 +593,9 @@ Napi::Value osn::SceneItem::GetScaleFilter(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("SceneItem", "GetScaleFilter", std::vector<ipc::value>{ipc::value(this->itemId)});
+	WriteBehind::GetInstance().Flush();
+	static RemoteMethod method("SceneItem", "GetScaleFilter");
+	std::vector<ipc::value> response = method.Call(conn, {ipc::value(this->itemId)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
@@ -549,6 +619,7 @@ void osn::SceneItem::SetScaleFilter(const Napi::CallbackInfo &info, const Napi::
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("SceneItem", "SetScaleFilter", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(filter)});
 
 	sid->scaleFilter = filter;
@@ -561,7 +632,9 @@ Napi::Value osn::SceneItem::GetAlignment(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("SceneItem", "GetAlignment", std::vector<ipc::value>{ipc::value(this->itemId)});
+	WriteBehind::GetInstance().Flush();
+	static RemoteMethod method("SceneItem", "GetAlignment");
+	std::vector<ipc::value> response = method.Call(conn, {ipc::value(this->itemId)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
@@ -579,6 +652,7 @@ void osn::SceneItem::SetAlignment(const Napi::CallbackInfo &info, const Napi::Va
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("SceneItem", "SetAlignment", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(flag)});
 }
 
@@ -588,7 +662,9 @@ Napi::Value osn::SceneItem::GetBounds(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("SceneItem", "GetBounds", std::vector<ipc::value>{ipc::value(this->itemId)});
+	WriteBehind::GetInstance().Flush();
+	static RemoteMethod method("SceneItem", "GetBounds");
+	std::vector<ipc::value> response = method.Call(conn, {ipc::value(this->itemId)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
@@ -611,6 +687,7 @@ void osn::SceneItem::SetBounds(const Napi::CallbackInfo &info, const Napi::Value
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("SceneItem", "SetBounds", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(x), ipc::value(y)});
 }
 
@@ -620,7 +697,9 @@ Napi::Value osn::SceneItem::GetBoundsAlignment(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("SceneItem", "GetBoundsAlignment", std::vector<ipc::value>{ipc::value(this->itemId)});
+	WriteBehind::GetInstance().Flush();
+	static RemoteMethod method("SceneItem", "GetBoundsAlignment");
+	std::vector<ipc::value> response = method.Call(conn, {ipc::value(this->itemId)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
@@ -637,6 +716,7 @@ void osn::SceneItem::SetBoundsAlignment(const Napi::CallbackInfo &info, const Na
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("SceneItem", "SetBoundsAlignment", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(visible)});
 }
 
@@ -646,7 +726,9 @@ Napi::Value osn::SceneItem::GetBoundsType(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("SceneItem", "GetBoundsType", std::vector<ipc::value>{ipc::value(this->itemId)});
+	WriteBehind::GetInstance().Flush();
+	static RemoteMethod method("SceneItem", "GetBoundsType");
+	std::vector<ipc::value> response = method.Call(conn, {ipc::value(this->itemId)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
@@ -663,6 +745,7 @@ void osn::SceneItem::SetBoundsType(const Napi::CallbackInfo &info, const Napi::V
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("SceneItem", "SetBoundsType", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(boundsType)});
 }
 
@@ -683,7 +766,9 @@ Napi::Value osn::SceneItem::GetCrop(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("SceneItem", "GetCrop", std::vector<ipc::value>{ipc::value(this->itemId)});
+	WriteBehind::GetInstance().FlushIfPending(batch::Setter::SceneItemSetCrop, this->itemId);
+	static RemoteMethod method("SceneItem", "GetCrop");
+	std::vector<ipc::value> response = method.Call(conn, {ipc::value(this->itemId)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
@@ -725,8 +810,8 @@ void osn::SceneItem::SetCrop(const Napi::CallbackInfo &info, const Napi::Value &
 	if (!conn)
 		return;
 
-	conn->call("SceneItem", "SetCrop",
-		   std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(left), ipc::value(top), ipc::value(right), ipc::value(bottom)});
+	WriteBehind::GetInstance().Queue(info.Env(), batch::Setter::SceneItemSetCrop, this->itemId,
+					 {ipc::value(this->itemId), ipc::value(left), ipc::value(top), ipc::value(right), ipc::value(bottom)});
 
 	sid->cropLeft = left;
 	sid->cropTop = top;
@@ -734,43 +819,57 @@ void osn::SceneItem::SetCrop(const Napi::CallbackInfo &info, const Napi::Value &
 	sid->cropBottom = bottom;
 }
 
-Napi::Value osn::SceneItem::GetTransformInfo(const Napi::CallbackInfo &info)
+static Napi::Value TransformInfoFromResponse(Napi::Env env, const std::vector<ipc::value> &response)
 {
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	std::vector<ipc::value> response = conn->call_synchronous_helper("SceneItem", "GetTransformInfo", std::vector<ipc::value>{ipc::value(this->itemId)});
+	Napi::Object obj = Napi::Object::New(env);
 
-	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
-
-	Napi::Object obj = Napi::Object::New(info.Env());
-
-	Napi::Object positionObj = Napi::Object::New(info.Env());
-	positionObj.Set("x", Napi::Number::New(info.Env(), response[1].value_union.fp32));
-	positionObj.Set("y", Napi::Number::New(info.Env(), response[2].value_union.fp32));
+	Napi::Object positionObj = Napi::Object::New(env);
+	positionObj.Set("x", Napi::Number::New(env, response[1].value_union.fp32));
+	positionObj.Set("y", Napi::Number::New(env, response[2].value_union.fp32));
 	obj.Set("pos", positionObj);
 
-	obj.Set("rot", Napi::Number::New(info.Env(), response[3].value_union.fp32));
+	obj.Set("rot", Napi::Number::New(env, response[3].value_union.fp32));
 
-	Napi::Object scaleObj = Napi::Object::New(info.Env());
-	scaleObj.Set("x", Napi::Number::New(info.Env(), response[4].value_union.fp32));
-	scaleObj.Set("y", Napi::Number::New(info.Env(), response[5].value_union.fp32));
+	Napi::Object scaleObj = Napi::Object::New(env);
+	scaleObj.Set("x", Napi::Number::New(env, response[4].value_union.fp32));
+	scaleObj.Set("y", Napi::Number::New(env, response[5].value_union.fp32));
 	obj.Set("scale", scaleObj);
 
-	obj.Set("alignment", Napi::Number::New(info.Env(), response[6].value_union.ui32));
-	obj.Set("boundsType", Napi::Number::New(info.Env(), response[7].value_union.ui32));
-	obj.Set("boundsAlignment", Napi::Number::New(info.Env(), response[8].value_union.ui32));
+	obj.Set("alignment", Napi::Number::New(env, response[6].value_union.ui32));
+	obj.Set("boundsType", Napi::Number::New(env, response[7].value_union.ui32));
+	obj.Set("boundsAlignment", Napi::Number::New(env, response[8].value_union.ui32));
 
-	Napi::Object boundsObj = Napi::Object::New(info.Env());
-	boundsObj.Set("x", Napi::Number::New(info.Env(), response[9].value_union.fp32));
-	boundsObj.Set("y", Napi::Number::New(info.Env(), response[10].value_union.fp32));
+	Napi::Object boundsObj = Napi::Object::New(env);
+	boundsObj.Set("x", Napi::Number::New(env, response[9].value_union.fp32));
+	boundsObj.Set("y", Napi::Number::New(env, response[10].value_union.fp32));
 	obj.Set("bounds", boundsObj);
 
 	return obj;
 }
 
+Napi::Value osn::SceneItem::GetTransformInfo(const Napi::CallbackInfo &info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	WriteBehind::GetInstance().Flush();
+	static RemoteMethod method("SceneItem", "GetTransformInfo");
+	std::vector<ipc::value> response = method.Call(conn, {ipc::value(this->itemId)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return TransformInfoFromResponse(info.Env(), response);
+}
+
+Napi::Value osn::SceneItem::GetTransformInfoAsync(const Napi::CallbackInfo &info)
+{
+	WriteBehind::GetInstance().Flush();
+	static RemoteMethod method("SceneItem", "GetTransformInfo");
+	return AsyncCalls::GetInstance().Call(info.Env(), method, {ipc::value(this->itemId)}, TransformInfoFromResponse);
+}
+
 void osn::SceneItem::SetTransformInfo(const Napi::CallbackInfo &info, const Napi::Value &value)
 {
 	Napi::Object vector = info[0].ToObject();
@@ -800,6 +899,7 @@ void osn::SceneItem::SetTransformInfo(const Napi::CallbackInfo &info, const Napi
 		bounds.Get("x").ToNumber().FloatValue(),
 		bounds.Get("y").ToNumber().FloatValue(),
 	};
+	WriteBehind::GetInstance().Flush();
 	const auto b = conn->call("SceneItem", "SetTransformInfo", std::move(params));
 }
 
@@ -816,7 +916,9 @@ Napi::Value osn::SceneItem::GetId(const Napi::CallbackInfo &info)
 		if (!conn)
 			return info.Env().Undefined();
 
-		std::vector<ipc::value> response = conn->call_synchronous_helper("SceneItem", "GetId", std::vector<ipc::value>{ipc::value(this->itemId)});
+		WriteBehind::GetInstance().Flush();
+		static RemoteMethod method("SceneItem", "GetId");
+		std::vector<ipc::value> response = method.Call(conn, {ipc::value(this->itemId)});
 
 		if (!ValidateResponse(info, response))
 			return info.Env().Undefined();
@@ -833,6 +935,7 @@ Napi::Value osn::SceneItem::MoveUp(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("SceneItem", "MoveUp", std::vector<ipc::value>{ipc::value(this->itemId)});
 	return info.Env().Undefined();
 }
@@ -843,6 +946,7 @@ Napi::Value osn::SceneItem::MoveDown(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("SceneItem", "MoveDown", std::vector<ipc::value>{ipc::value(this->itemId)});
 	return info.Env().Undefined();
 }
@@ -853,6 +957,7 @@ Napi::Value osn::SceneItem::MoveTop(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("SceneItem", "MoveTop", std::vector<ipc::value>{ipc::value(this->itemId)});
 	return info.Env().Undefined();
 }
@@ -863,6 +968,7 @@ Napi::Value osn::SceneItem::MoveBottom(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("SceneItem", "MoveBottom", std::vector<ipc::value>{ipc::value(this->itemId)});
 	return info.Env().Undefined();
 }
@@ -875,6 +981,7 @@ Napi::Value osn::SceneItem::Move(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("SceneItem", "Move", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(position)});
 	return info.Env().Undefined();
 }
@@ -885,6 +992,7 @@ Napi::Value osn::SceneItem::DeferUpdateBegin(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("SceneItem", "DeferUpdateBegin", std::vector<ipc::value>{ipc::value(this->itemId)});
 	return info.Env().Undefined();
 }
@@ -895,6 +1003,7 @@ Napi::Value osn::SceneItem::DeferUpdateEnd(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("SceneItem", "DeferUpdateEnd", std::vector<ipc::value>{ipc::value(this->itemId)});
 	return info.Env().Undefined();
 }
@@ -910,7 +1019,9 @@ Napi::Value osn::SceneItem::GetBlendingMethod(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("SceneItem", "GetBlendingMethod", std::vector<ipc::value>{ipc::value(this->itemId)});
+	WriteBehind::GetInstance().Flush();
+	static RemoteMethod method("SceneItem", "GetBlendingMethod");
+	std::vector<ipc::value> response = method.Call(conn, {ipc::value(this->itemId)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
@@ -934,6 +1045,7 @@ void osn::SceneItem::SetBlendingMethod(const Napi::CallbackInfo &info, const Nap
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("SceneItem", "SetBlendingMethod", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(method)});
 
 	sid->blendingMethod = method;
@@ -951,7 +1063,9 @@ Napi::Value osn::SceneItem::GetBlendingMode(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("SceneItem", "GetBlendingMode", std::vector<ipc::value>{ipc::value(this->itemId)});
+	WriteBehind::GetInstance().Flush();
+	static RemoteMethod method("SceneItem", "GetBlendingMode");
+	std::vector<ipc::value> response = method.Call(conn, {ipc::value(this->itemId)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
@@ -975,6 +1089,7 @@ void osn::SceneItem::SetBlendingMode(const Napi::CallbackInfo &info, const Napi:
 	if (!conn)
 		return;
 
+	WriteBehind::GetInstance().Flush();
 	conn->call("SceneItem", "SetBlendingMode", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(mode)});
 
 	sid->blendingMode = mode;
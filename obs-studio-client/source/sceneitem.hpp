@@ -46,6 +46,7 @@ public:
 	void SetRecordingVisible(const Napi::CallbackInfo &info, const Napi::Value &value);
 
 	Napi::Value GetPosition(const Napi::CallbackInfo &info);
+	Napi::Value GetPositionAsync(const Napi::CallbackInfo &info);
 	void SetPosition(const Napi::CallbackInfo &info, const Napi::Value &value);
 	Napi::Value GetCanvas(const Napi::CallbackInfo &info);
 	void SetCanvas(const Napi::CallbackInfo &info, const Napi::Value &value);
@@ -66,6 +67,7 @@ public:
 	Napi::Value GetCrop(const Napi::CallbackInfo &info);
 	void SetCrop(const Napi::CallbackInfo &info, const Napi::Value &value);
 	Napi::Value GetTransformInfo(const Napi::CallbackInfo &info);
+	Napi::Value GetTransformInfoAsync(const Napi::CallbackInfo &info);
 	void SetTransformInfo(const Napi::CallbackInfo &info, const Napi::Value &value);
 	Napi::Value GetId(const Napi::CallbackInfo &info);
 	Napi::Value MoveUp(const Napi::CallbackInfo &info);
@@ -21,6 +21,7 @@
 #include "utility.hpp"
 #include "utility-v8.hpp"
 #include "properties.hpp"
+#include "shared-memory.hpp"
 #include "obs-property.hpp"
 
 Napi::FunctionReference osn::Service::constructor;
@@ -152,15 +153,16 @@ Napi::Value osn::Service::GetProperties(const Napi::CallbackInfo &info)
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
-	if (response.size() == 1)
-		return info.Env().Null();
+	std::shared_ptr<osn::PropertySet> properties;
+	{
+		SharedMemory::Payload payload = SharedMemory::GetInstance().ReadPayload(response, 1);
+		properties = osn::PropertySet::Create(payload.data(), payload.size());
+	}
 
-	osn::property_map_t pmap = osn::ProcessProperties(response, 1);
+	if (!properties || properties->Count() == 0)
+		return info.Env().Null();
 
-	std::shared_ptr<property_map_t> pSomeObject = std::make_shared<property_map_t>(pmap);
-	auto prop_ptr = Napi::External<property_map_t>::New(info.Env(), pSomeObject.get());
-	auto instance = osn::Properties::constructor.New({prop_ptr, Napi::Number::New(info.Env(), (uint32_t)this->uid)});
-	return instance;
+	return osn::Properties::Create(info.Env(), properties, this->uid);
 }
 
 void osn::Service::Update(const Napi::CallbackInfo &info)
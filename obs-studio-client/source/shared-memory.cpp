@@ -0,0 +1,190 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "shared-memory.hpp"
+#include <chrono>
+#include "osn-error.hpp"
+#include "shared.hpp"
+#include "utility.hpp"
+
+SharedMemory::Payload::Payload(std::shared_ptr<shm::Arena> arena, uint32_t slot, const char *data, uint64_t size)
+	: m_arena(arena), m_slot(slot), m_data(data), m_size(size)
+{
+}
+
+SharedMemory::Payload::~Payload()
+{
+	release();
+}
+
+SharedMemory::Payload::Payload(Payload &&other) noexcept
+{
+	*this = std::move(other);
+}
+
+SharedMemory::Payload &SharedMemory::Payload::operator=(Payload &&other) noexcept
+{
+	if (this != &other) {
+		release();
+		m_arena = std::move(other.m_arena);
+		m_slot = other.m_slot;
+		m_data = other.m_data;
+		m_size = other.m_size;
+		other.m_slot = shm::InvalidSlot;
+		other.m_data = nullptr;
+		other.m_size = 0;
+	}
+	return *this;
+}
+
+void SharedMemory::Payload::release()
+{
+	if (m_arena && m_slot != shm::InvalidSlot)
+		m_arena->Release(m_slot);
+	m_arena = nullptr;
+	m_slot = shm::InvalidSlot;
+}
+
+bool SharedMemory::Negotiate(std::shared_ptr<ipc::client> conn)
+{
+	if (!conn)
+		return false;
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("SharedMemory", "Negotiate", {});
+	if (response.size() < 2 || (ErrorCode)response[0].value_union.ui64 != ErrorCode::Ok)
+		return false;
+
+	std::shared_ptr<shm::Arena> arena = shm::Arena::Open(response[1].value_str);
+	if (!arena)
+		return false;
+
+	response = conn->call_synchronous_helper("SharedMemory", "SetEnabled", {ipc::value((int32_t)1)});
+	if (response.size() < 2 || (ErrorCode)response[0].value_union.ui64 != ErrorCode::Ok || !response[1].value_union.i32)
+		return false;
+
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	m_arena = arena;
+	return true;
+}
+
+void SharedMemory::Reset()
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	m_arena = nullptr;
+}
+
+bool SharedMemory::IsEnabled()
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	return !!m_arena;
+}
+
+SharedMemory::Payload SharedMemory::ReadPayload(const std::vector<ipc::value> &response, size_t index)
+{
+	if (response.size() < index + 3)
+		return Payload();
+
+	uint32_t slot = response[index].value_union.ui32;
+	uint64_t size = response[index + 2].value_union.ui64;
+
+	if (slot == shm::InvalidSlot) {
+		const std::vector<char> &bin = response[index + 1].value_bin;
+		return Payload(nullptr, shm::InvalidSlot, bin.data(), std::min<uint64_t>(size, bin.size()));
+	}
+
+	std::shared_ptr<shm::Arena> arena;
+	{
+		std::unique_lock<std::mutex> ulock(m_mutex);
+		arena = m_arena;
+	}
+	if (!arena)
+		return Payload();
+
+	uint64_t reserved = 0;
+	const char *data = arena->Data(slot, reserved);
+	if (!data || reserved < size) {
+		arena->Release(slot);
+		return Payload();
+	}
+
+	return Payload(arena, slot, data, size);
+}
+
+Napi::Value SharedMemory::BenchmarkTransport(const Napi::CallbackInfo &info)
+{
+	uint64_t payloadSize = 1024 * 1024;
+	uint32_t iterations = 100;
+	if (info.Length() > 0 && info[0].IsNumber())
+		payloadSize = (uint64_t)info[0].ToNumber().Int64Value();
+	if (info.Length() > 1 && info[1].IsNumber())
+		iterations = info[1].ToNumber().Uint32Value();
+	if (iterations == 0)
+		iterations = 1;
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	auto run = [&](bool allowShared) -> Napi::Value {
+		uint64_t checksum = 0;
+		uint32_t sharedCount = 0;
+		auto start = std::chrono::high_resolution_clock::now();
+		for (uint32_t idx = 0; idx < iterations; idx++) {
+			std::vector<ipc::value> response =
+				conn->call_synchronous_helper("SharedMemory", "Echo", {ipc::value(payloadSize), ipc::value((int32_t)allowShared)});
+			if (!ValidateResponse(info, response))
+				return info.Env().Undefined();
+
+			Payload payload = SharedMemory::GetInstance().ReadPayload(response, 1);
+			if (payload.size() != payloadSize) {
+				Napi::Error::New(info.Env(), "Received a truncated payload.").ThrowAsJavaScriptException();
+				return info.Env().Undefined();
+			}
+			// Touch both ends so the measurement includes actually reading the data.
+			if (payload.size() > 0)
+				checksum += uint8_t(payload.data()[0]) + uint8_t(payload.data()[payload.size() - 1]);
+			if (payload.shared())
+				sharedCount++;
+		}
+		auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+		Napi::Object result = Napi::Object::New(info.Env());
+		result.Set("totalMs", Napi::Number::New(info.Env(), elapsed));
+		result.Set("callMs", Napi::Number::New(info.Env(), elapsed / iterations));
+		result.Set("megabytesPerSecond",
+			   Napi::Number::New(info.Env(), elapsed > 0 ? (double(payloadSize) * iterations / (1024.0 * 1024.0)) / (elapsed / 1000.0) : 0));
+		result.Set("sharedCalls", Napi::Number::New(info.Env(), sharedCount));
+		result.Set("checksum", Napi::Number::New(info.Env(), (double)checksum));
+		return result;
+	};
+
+	Napi::Value inlineResult = run(false);
+	if (inlineResult.IsUndefined())
+		return inlineResult;
+	Napi::Value sharedResult = run(true);
+	if (sharedResult.IsUndefined())
+		return sharedResult;
+
+	Napi::Object result = Napi::Object::New(info.Env());
+	result.Set("payloadSize", Napi::Number::New(info.Env(), (double)payloadSize));
+	result.Set("iterations", Napi::Number::New(info.Env(), iterations));
+	result.Set("sharedMemory", Napi::Boolean::New(info.Env(), SharedMemory::GetInstance().IsEnabled()));
+	result.Set("inline", inlineResult);
+	result.Set("shared", sharedResult);
+	return result;
+}
@@ -0,0 +1,81 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <memory>
+#include <mutex>
+#include <napi.h>
+#include <vector>
+#include "ipc-client.hpp"
+#include "shared-memory-arena.hpp"
+
+class SharedMemory {
+public:
+	// A view on a payload sent by osn::SharedMemory::PushPayload on the server.
+	// Either points into the shared arena (and frees the slot on destruction) or
+	// into the Binary value of the response, which must outlive the payload.
+	class Payload {
+	public:
+		Payload() {}
+		Payload(std::shared_ptr<shm::Arena> arena, uint32_t slot, const char *data, uint64_t size);
+		~Payload();
+
+		Payload(Payload &&other) noexcept;
+		Payload &operator=(Payload &&other) noexcept;
+		Payload(Payload const &) = delete;
+		void operator=(Payload const &) = delete;
+
+		const char *data() const { return m_data; }
+		uint64_t size() const { return m_size; }
+		bool shared() const { return m_slot != shm::InvalidSlot; }
+
+	private:
+		void release();
+
+		std::shared_ptr<shm::Arena> m_arena;
+		uint32_t m_slot = shm::InvalidSlot;
+		const char *m_data = nullptr;
+		uint64_t m_size = 0;
+	};
+
+	static SharedMemory &GetInstance()
+	{
+		static SharedMemory _inst;
+		return _inst;
+	}
+
+private:
+	SharedMemory() {}
+
+public:
+	SharedMemory(SharedMemory const &) = delete;
+	void operator=(SharedMemory const &) = delete;
+
+	bool Negotiate(std::shared_ptr<ipc::client> conn);
+	void Reset();
+	bool IsEnabled();
+
+	// Reads the three values [slot, data, size] starting at response[index].
+	Payload ReadPayload(const std::vector<ipc::value> &response, size_t index);
+
+	static Napi::Value BenchmarkTransport(const Napi::CallbackInfo &info);
+
+private:
+	std::mutex m_mutex;
+	std::shared_ptr<shm::Arena> m_arena;
+};
@@ -19,6 +19,7 @@
 #include "video-encoder.hpp"
 #include "utility.hpp"
 #include "properties.hpp"
+#include "shared-memory.hpp"
 #include "obs-property.hpp"
 
 Napi::FunctionReference osn::VideoEncoder::constructor;
@@ -225,16 +226,16 @@ Napi::Value osn::VideoEncoder::GetProperties(const Napi::CallbackInfo &info)
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
-	if (response.size() == 1)
-		return info.Env().Undefined();
-
-	osn::property_map_t pmap = osn::ProcessProperties(response, 1);
+	std::shared_ptr<osn::PropertySet> properties;
+	{
+		SharedMemory::Payload payload = SharedMemory::GetInstance().ReadPayload(response, 1);
+		properties = osn::PropertySet::Create(payload.data(), payload.size());
+	}
 
-	std::shared_ptr<property_map_t> pSomeObject = std::make_shared<property_map_t>(pmap);
-	auto prop_ptr = Napi::External<property_map_t>::New(info.Env(), pSomeObject.get());
-	auto instance = osn::Properties::constructor.New({prop_ptr, Napi::Number::New(info.Env(), (uint32_t)this->uid)});
+	if (!properties || properties->Count() == 0)
+		return info.Env().Undefined();
 
-	return instance;
+	return osn::Properties::Create(info.Env(), properties, this->uid);
 }
 
 Napi::Value osn::VideoEncoder::GetSettings(const Napi::CallbackInfo &info)
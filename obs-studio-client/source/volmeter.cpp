@@ -40,6 +40,9 @@ Napi::Object osn::Volmeter::Init(Napi::Env env, Napi::Object exports)
 						  InstanceMethod("destroy", &osn::Volmeter::Destroy),
 						  InstanceMethod("attach", &osn::Volmeter::Attach),
 						  InstanceMethod("detach", &osn::Volmeter::Detach),
+						  InstanceMethod("setBallistics", &osn::Volmeter::SetBallistics),
+
+						  InstanceAccessor("index", &osn::Volmeter::GetIndex, nullptr),
 					  });
 	exports.Set("Volmeter", func);
 	osn::Volmeter::constructor = Napi::Persistent(func);
@@ -119,3 +122,36 @@ Napi::Value osn::Volmeter::Detach(const Napi::CallbackInfo &info)
 	conn->call("Volmeter", "Detach", {ipc::value(this->m_uid)});
 	return info.Env().Undefined();
 }
+
+Napi::Value osn::Volmeter::SetBallistics(const Napi::CallbackInfo &info)
+{
+	// Passing nothing or null goes back to raw values.
+	bool enabled = info.Length() > 0 && info[0].IsObject();
+	uint32_t peakHoldMs = 1000;
+	double decayRate = 20.0;
+	uint32_t rmsWindowMs = 300;
+	if (enabled) {
+		Napi::Object options = info[0].ToObject();
+		if (options.Has("peakHoldMs"))
+			peakHoldMs = options.Get("peakHoldMs").ToNumber().Uint32Value();
+		if (options.Has("decayRate"))
+			decayRate = options.Get("decayRate").ToNumber().DoubleValue();
+		if (options.Has("rmsWindowMs"))
+			rmsWindowMs = options.Get("rmsWindowMs").ToNumber().Uint32Value();
+	}
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+		"Volmeter", "SetBallistics",
+		{ipc::value(this->m_uid), ipc::value((int32_t)enabled), ipc::value(peakHoldMs), ipc::value(decayRate), ipc::value(rmsWindowMs)});
+	ValidateResponse(info, response);
+	return info.Env().Undefined();
+}
+
+Napi::Value osn::Volmeter::GetIndex(const Napi::CallbackInfo &info)
+{
+	return Napi::Number::New(info.Env(), globalCallback::volmeter_index(this->m_uid));
+}
@@ -46,5 +46,7 @@ public:
 	Napi::Value Destroy(const Napi::CallbackInfo &info);
 	Napi::Value Attach(const Napi::CallbackInfo &info);
 	Napi::Value Detach(const Napi::CallbackInfo &info);
+	Napi::Value SetBallistics(const Napi::CallbackInfo &info);
+	Napi::Value GetIndex(const Napi::CallbackInfo &info);
 };
 }
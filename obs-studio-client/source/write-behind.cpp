@@ -0,0 +1,175 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "write-behind.hpp"
+#include "controller.hpp"
+#include "shared.hpp"
+#include "utility.hpp"
+
+void WriteBehind::Queue(Napi::Env env, batch::Setter setter, uint64_t uid, std::vector<ipc::value> &&args, uint64_t source)
+{
+	m_stats.queued++;
+
+	auto found = m_index.find(key_t(setter, uid));
+	if (found != m_index.end() && !IsOvertaken(found->second, uid, source)) {
+		found->second->args = std::move(args);
+		if (found->second->source != source) {
+			RemoveSource(found->second->source);
+			AddSource(source);
+			found->second->source = source;
+		}
+		m_stats.coalesced++;
+		return;
+	}
+
+	m_pending.push_back({setter, uid, std::move(args), source});
+	m_index.insert_or_assign(key_t(setter, uid), std::prev(m_pending.end()));
+	AddSource(source);
+	Schedule(env);
+}
+
+bool WriteBehind::IsOvertaken(std::list<Pending>::iterator pending, uint64_t uid, uint64_t source)
+{
+	for (auto it = std::next(pending); it != m_pending.end(); ++it) {
+		if (it->uid == uid)
+			return true;
+		if (it->source != NoSource && (it->source == source || it->source == pending->source))
+			return true;
+	}
+	return false;
+}
+
+void WriteBehind::Flush()
+{
+	if (m_pending.empty())
+		return;
+
+	auto conn = Controller::GetInstance().GetConnection();
+	if (!conn) {
+		Reset();
+		return;
+	}
+
+	auto send = [&]() {
+		if (!m_writer.Count())
+			return;
+		m_stats.sent += m_writer.Count();
+		m_stats.batches++;
+		conn->call("WriteBatch", "Apply", {ipc::value(m_writer.Finish())});
+		m_writer.Clear();
+	};
+
+	m_writer.Clear();
+	for (auto &pending : m_pending) {
+		if (m_writer.Add(pending.setter, pending.args))
+			continue;
+
+		// Cannot be encoded, send what came before it and then the write
+		// itself so the order is kept.
+		send();
+		conn->call(batch::CollectionName(pending.setter), batch::FunctionName(pending.setter), pending.args);
+		m_stats.sent++;
+	}
+	send();
+
+	m_pending.clear();
+	m_index.clear();
+	m_sources.clear();
+}
+
+void WriteBehind::FlushIfPending(batch::Setter setter, uint64_t uid)
+{
+	if (m_pending.empty())
+		return;
+
+	if (m_index.find(key_t(setter, uid)) != m_index.end())
+		Flush();
+}
+
+void WriteBehind::FlushSource(uint64_t source)
+{
+	if (m_sources.find(source) != m_sources.end())
+		Flush();
+}
+
+void WriteBehind::Reset()
+{
+	m_pending.clear();
+	m_index.clear();
+	m_sources.clear();
+	m_writer.Clear();
+}
+
+void WriteBehind::AddSource(uint64_t source)
+{
+	if (source != NoSource)
+		m_sources[source]++;
+}
+
+void WriteBehind::RemoveSource(uint64_t source)
+{
+	auto found = m_sources.find(source);
+	if (found != m_sources.end() && --found->second == 0)
+		m_sources.erase(found);
+}
+
+void WriteBehind::Schedule(Napi::Env env)
+{
+	if (m_scheduled)
+		return;
+
+	Napi::Value setImmediate = env.Global().Get("setImmediate");
+	if (!setImmediate.IsFunction()) {
+		Flush();
+		return;
+	}
+
+	if (m_callback.IsEmpty()) {
+		m_callback = Napi::Persistent(Napi::Function::New(env, OnImmediate));
+		m_callback.SuppressDestruct();
+	}
+
+	m_scheduled = true;
+	setImmediate.As<Napi::Function>().Call({m_callback.Value()});
+}
+
+Napi::Value WriteBehind::OnImmediate(const Napi::CallbackInfo &info)
+{
+	WriteBehind &instance = GetInstance();
+	instance.m_scheduled = false;
+	instance.Flush();
+	return info.Env().Undefined();
+}
+
+Napi::Value WriteBehind::JSFlush(const Napi::CallbackInfo &info)
+{
+	GetInstance().Flush();
+	return info.Env().Undefined();
+}
+
+Napi::Value WriteBehind::JSGetStats(const Napi::CallbackInfo &info)
+{
+	const Stats &stats = GetInstance().GetStats();
+
+	Napi::Object result = Napi::Object::New(info.Env());
+	result.Set("queued", Napi::Number::New(info.Env(), double(stats.queued)));
+	result.Set("coalesced", Napi::Number::New(info.Env(), double(stats.coalesced)));
+	result.Set("batches", Napi::Number::New(info.Env(), double(stats.batches)));
+	result.Set("sent", Napi::Number::New(info.Env(), double(stats.sent)));
+	return result;
+}
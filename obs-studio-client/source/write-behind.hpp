@@ -0,0 +1,111 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <list>
+#include <map>
+#include <napi.h>
+#include <utility>
+#include <vector>
+#include "ipc-value.hpp"
+#include "write-batch.hpp"
+
+// Client side write-behind queue for setters that are called many times in a
+// row with only the last value mattering (sliders, drags). Writes are coalesced
+// per (setter, object) and sent as a single WriteBatch.Apply call on the next
+// turn of the event loop. Only used from the JavaScript thread.
+//
+// A coalesced write keeps its place in the queue and only takes the new
+// arguments, so the batch applies writes in the order they were made. A write
+// is not coalesced once another write to the same object or source was
+// queued after it, it is queued again instead. This keeps setters that alias
+// the same state (fader dB and deflection) and related fields of one source
+// (volume and sync offset) in program order.
+//
+// Every write also records the source it ends up changing, a fader write
+// changes the volume of the input it is attached to. Reads of a source call
+// FlushSource so they are ordered after every pending write touching it.
+class WriteBehind {
+public:
+	static constexpr uint64_t NoSource = UINT64_MAX;
+
+	struct Stats {
+		uint64_t queued = 0;
+		uint64_t coalesced = 0;
+		uint64_t batches = 0;
+		uint64_t sent = 0;
+	};
+
+	static WriteBehind &GetInstance()
+	{
+		static WriteBehind _inst;
+		return _inst;
+	}
+
+private:
+	WriteBehind() {}
+
+public:
+	WriteBehind(WriteBehind const &) = delete;
+	void operator=(WriteBehind const &) = delete;
+
+	// `args` must start with the object id, like the direct call would.
+	// `source` is the source the write changes, if any.
+	void Queue(Napi::Env env, batch::Setter setter, uint64_t uid, std::vector<ipc::value> &&args, uint64_t source = NoSource);
+
+	// Sends every pending write now. Called before reading a field that has a
+	// pending write so that the read observes it.
+	void Flush();
+	void FlushIfPending(batch::Setter setter, uint64_t uid);
+	// Flushes if any pending write changes the given source.
+	void FlushSource(uint64_t source);
+	void Reset();
+
+	const Stats &GetStats() { return m_stats; }
+
+	static Napi::Value JSFlush(const Napi::CallbackInfo &info);
+	static Napi::Value JSGetStats(const Napi::CallbackInfo &info);
+
+private:
+	void Schedule(Napi::Env env);
+	static Napi::Value OnImmediate(const Napi::CallbackInfo &info);
+
+	typedef std::pair<batch::Setter, uint64_t> key_t;
+
+	struct Pending {
+		batch::Setter setter;
+		uint64_t uid;
+		std::vector<ipc::value> args;
+		uint64_t source;
+	};
+
+	// Whether a write to the same object or source was queued after `pending`.
+	bool IsOvertaken(std::list<Pending>::iterator pending, uint64_t uid, uint64_t source);
+	void AddSource(uint64_t source);
+	void RemoveSource(uint64_t source);
+
+	std::list<Pending> m_pending;
+	// Latest pending write of each (setter, object).
+	std::map<key_t, std::list<Pending>::iterator> m_index;
+	// Number of pending writes per source they change.
+	std::map<uint64_t, uint32_t> m_sources;
+	batch::Writer m_writer;
+	Napi::FunctionReference m_callback;
+	bool m_scheduled = false;
+	Stats m_stats;
+};
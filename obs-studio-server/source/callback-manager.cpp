@@ -22,6 +22,8 @@
 #include <windows.h>
 #endif
 #include "osn-error.hpp"
+#include "osn-media-events.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 #include "osn-source.hpp"
 #include "osn-volmeter.hpp"
@@ -34,14 +36,16 @@ void CallbackManager::Register(ipc::server &srv)
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("CallbackManager");
 	cls->register_function(std::make_shared<ipc::function>("GlobalQuery", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Binary}, GlobalQuery));
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void CallbackManager::GlobalQuery(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 
+	// Runs on the realtime lane, concurrently with calls that add or remove sources.
+	sources_sizes_mtx.lock();
 	if (!sources.empty()) {
-		sources_sizes_mtx.lock();
 		uint32_t size = 0;
 
 		for (auto item : sources) {
@@ -66,10 +70,12 @@ void CallbackManager::GlobalQuery(void *data, const int64_t id, const std::vecto
 		}
 
 		rval.insert(rval.begin() + 1, ipc::value(size));
-		sources_sizes_mtx.unlock();
 	} else {
 		rval.insert(rval.begin() + 1, ipc::value((uint32_t)0));
 	}
+	sources_sizes_mtx.unlock();
+
+	rval.push_back(ipc::value(osn::MediaEvents::GetInstance().Collect()));
 
 	uint64_t size_buffer = args[0].value_union.ui64;
 
@@ -0,0 +1,177 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "gs-overlaybatch.h"
+#include <algorithm>
+
+void GS::OverlayBatch::Shape::Add(float px, float py)
+{
+	x.push_back(px);
+	y.push_back(py);
+}
+
+void GS::OverlayBatch::Stream::Push(float px, float py, uint32_t c)
+{
+	x.push_back(px);
+	y.push_back(py);
+	color.push_back(c);
+}
+
+GS::OverlayBatch::OverlayBatch(uint32_t initialVertices)
+{
+	m_lines.buffer = std::make_unique<VertexBuffer>(initialVertices);
+	m_triangles.buffer = std::make_unique<VertexBuffer>(initialVertices);
+}
+
+void GS::OverlayBatch::Clear()
+{
+	for (Stream *stream : {&m_lines, &m_triangles}) {
+		stream->x.clear();
+		stream->y.clear();
+		stream->color.clear();
+	}
+}
+
+void GS::OverlayBatch::Transform(const matrix4 &mtx, const Shape &shape)
+{
+	uint32_t count = shape.Size();
+	m_tx.resize(count);
+	m_ty.resize(count);
+
+	// Same as vec3_transform with z = 0 and w = 1, one component at a time.
+	const float xx = mtx.x.x, xy = mtx.x.y, yx = mtx.y.x, yy = mtx.y.y, tx = mtx.t.x, ty = mtx.t.y;
+	const float *sx = shape.x.data();
+	const float *sy = shape.y.data();
+	float *dx = m_tx.data();
+	float *dy = m_ty.data();
+	for (uint32_t idx = 0; idx < count; idx++) {
+		dx[idx] = sx[idx] * xx + sy[idx] * yx + tx;
+		dy[idx] = sx[idx] * xy + sy[idx] * yy + ty;
+	}
+}
+
+void GS::OverlayBatch::AddLineStrip(const matrix4 &mtx, const Shape &shape, uint32_t color)
+{
+	if (shape.Size() < 2)
+		return;
+
+	Transform(mtx, shape);
+	for (uint32_t idx = 1; idx < shape.Size(); idx++) {
+		m_lines.Push(m_tx[idx - 1], m_ty[idx - 1], color);
+		m_lines.Push(m_tx[idx], m_ty[idx], color);
+	}
+}
+
+void GS::OverlayBatch::AddTriangleStrip(const matrix4 &mtx, const Shape &shape, uint32_t color)
+{
+	if (shape.Size() < 3)
+		return;
+
+	Transform(mtx, shape);
+	for (uint32_t idx = 2; idx < shape.Size(); idx++) {
+		// Every other triangle of a strip has its first two vertices swapped to keep the winding.
+		uint32_t a = (idx & 1) ? idx - 1 : idx - 2;
+		uint32_t b = (idx & 1) ? idx - 2 : idx - 1;
+		m_triangles.Push(m_tx[a], m_ty[a], color);
+		m_triangles.Push(m_tx[b], m_ty[b], color);
+		m_triangles.Push(m_tx[idx], m_ty[idx], color);
+	}
+}
+
+void GS::OverlayBatch::AddLine(float x1, float y1, float x2, float y2, uint32_t color)
+{
+	m_lines.Push(x1, y1, color);
+	m_lines.Push(x2, y2, color);
+}
+
+void GS::OverlayBatch::AddQuads(const matrix4 &mtx, const Shape &shape, uint32_t color)
+{
+	Transform(mtx, shape);
+	for (uint32_t idx = 3; idx < shape.Size(); idx += 4) {
+		const uint32_t quad[6] = {idx - 3, idx - 2, idx - 1, idx - 1, idx - 2, idx};
+		for (uint32_t corner : quad)
+			m_triangles.Push(m_tx[corner], m_ty[corner], color);
+	}
+}
+
+bool GS::OverlayBatch::DrawStream(Stream &stream, gs_draw_mode mode)
+{
+	uint32_t count = stream.Size();
+	stream.uploaded = 0;
+	if (count == 0)
+		return false;
+
+	VertexBuffer *vb = stream.buffer.get();
+	if (count > vb->Capacity()) {
+		uint32_t capacity = vb->Capacity();
+		while (capacity < count)
+			capacity *= 2;
+		// A failed grow keeps the old buffer, the draw below is clamped to it.
+		vb->Reserve(std::min(capacity, MAXIMUM_VERTICES));
+	}
+	count = std::min(count, vb->Capacity());
+
+	vb->Resize(count);
+	vec3 *positions = vb->GetPositions();
+	uint32_t *colors = vb->GetColors();
+	for (uint32_t idx = 0; idx < count; idx++) {
+		vec3_set(&positions[idx], stream.x[idx], stream.y[idx], 0.0f);
+		colors[idx] = stream.color[idx];
+	}
+
+	gs_load_vertexbuffer(vb->Update());
+	gs_draw(mode, 0, count);
+	stream.uploaded = count;
+	return true;
+}
+
+bool GS::OverlayBatch::RedrawStream(Stream &stream, gs_draw_mode mode)
+{
+	if (stream.uploaded == 0)
+		return false;
+
+	gs_load_vertexbuffer(stream.buffer->Update(false));
+	gs_draw(mode, 0, stream.uploaded);
+	return true;
+}
+
+uint32_t GS::OverlayBatch::Draw()
+{
+	uint32_t calls = 0;
+	// Filled shapes first so that outlines stay visible on top of them.
+	if (DrawStream(m_triangles, GS_TRIS))
+		calls++;
+	if (DrawStream(m_lines, GS_LINES))
+		calls++;
+	return calls;
+}
+
+uint32_t GS::OverlayBatch::Redraw()
+{
+	uint32_t calls = 0;
+	if (RedrawStream(m_triangles, GS_TRIS))
+		calls++;
+	if (RedrawStream(m_lines, GS_LINES))
+		calls++;
+	return calls;
+}
+
+uint64_t GS::OverlayBatch::GetUploadedBytes()
+{
+	return m_lines.buffer->GetUploadedBytes() + m_triangles.buffer->GetUploadedBytes();
+}
@@ -0,0 +1,115 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+#include <memory>
+#include <vector>
+#include "gs-vertexbuffer.h"
+extern "C" {
+#pragma warning(push)
+#pragma warning(disable : 4201)
+#include <graphics/graphics.h>
+#include <graphics/matrix4.h>
+#pragma warning(pop)
+}
+
+namespace GS {
+/*!
+	* \brief Collects the selection overlay of a whole frame (outlines, crop
+	* marks, guide lines, resize boxes, rotation handles) and draws it with one
+	* call for triangles and one for lines.
+	*
+	* Shapes are transformed on the CPU. Points are kept as separate x and y
+	* arrays so the transform is a flat multiply-add loop the compiler can
+	* vectorize.
+	*/
+class OverlayBatch {
+public:
+	// A shape in unit space, stored as structure of arrays.
+	struct Shape {
+		std::vector<float> x;
+		std::vector<float> y;
+
+		void Add(float px, float py);
+		uint32_t Size() const { return uint32_t(x.size()); }
+	};
+
+	OverlayBatch(uint32_t initialVertices);
+
+	void Clear();
+
+	/*!
+		* \brief Transform `shape` by `mtx` and append it to the batch.
+		*
+		* Line strips and triangle strips are expanded into lists so that every
+		* shape of the frame ends up in the same two buffers.
+		*/
+	void AddLineStrip(const matrix4 &mtx, const Shape &shape, uint32_t color);
+	void AddTriangleStrip(const matrix4 &mtx, const Shape &shape, uint32_t color);
+
+	// Every four points of `shape` form a separate quad, in triangle strip order.
+	void AddQuads(const matrix4 &mtx, const Shape &shape, uint32_t color);
+
+	// Append a line that is already in world space.
+	void AddLine(float x1, float y1, float x2, float y2, uint32_t color);
+
+	/*!
+		* \brief Upload and draw everything collected since Clear().
+		*
+		* Must be called inside a pass of a technique taking per vertex colors.
+		*
+		* \return Number of draw calls issued.
+		*/
+	uint32_t Draw();
+
+	/*!
+		* \brief Draw what the last Draw() uploaded again, without touching the buffers.
+		*
+		* \return Number of draw calls issued.
+		*/
+	uint32_t Redraw();
+
+	uint32_t LineVertices() const { return m_lines.Size(); }
+	uint32_t TriangleVertices() const { return m_triangles.Size(); }
+	uint64_t GetUploadedBytes();
+
+private:
+	struct Stream {
+		std::vector<float> x;
+		std::vector<float> y;
+		std::vector<uint32_t> color;
+		std::unique_ptr<VertexBuffer> buffer;
+		// Vertices uploaded to `buffer` by the last Draw().
+		uint32_t uploaded = 0;
+
+		void Push(float px, float py, uint32_t c);
+		uint32_t Size() const { return uint32_t(x.size()); }
+	};
+
+	void Transform(const matrix4 &mtx, const Shape &shape);
+	bool DrawStream(Stream &stream, gs_draw_mode mode);
+	bool RedrawStream(Stream &stream, gs_draw_mode mode);
+
+	Stream m_lines;
+	Stream m_triangles;
+	// Scratch space for the transformed points of the shape being added.
+	std::vector<float> m_tx;
+	std::vector<float> m_ty;
+};
+} // namespace GS
@@ -167,11 +167,75 @@ void GS::VertexBuffer::Resize(uint32_t new_size)
 	m_size = new_size;
 }
 
+bool GS::VertexBuffer::Reserve(uint32_t capacity)
+{
+	if (capacity <= m_capacity)
+		return true;
+	if (capacity > MAXIMUM_VERTICES)
+		return false;
+
+	// Build the new storage aside, the current buffer stays usable until the GPU buffer exists.
+	gs_vb_data *vertexbufferdata = gs_vbdata_create();
+	vertexbufferdata->num = capacity;
+	vertexbufferdata->points = (vec3 *)bzalloc(sizeof(vec3) * capacity);
+	vertexbufferdata->normals = (vec3 *)bzalloc(sizeof(vec3) * capacity);
+	vertexbufferdata->tangents = (vec3 *)bzalloc(sizeof(vec3) * capacity);
+	vertexbufferdata->colors = (uint32_t *)bzalloc(sizeof(uint32_t) * capacity);
+	vertexbufferdata->num_tex = MAXIMUM_UVW_LAYERS;
+	gs_tvertarray *layerdata = (gs_tvertarray *)bzalloc(sizeof(gs_tvertarray) * MAXIMUM_UVW_LAYERS);
+	vertexbufferdata->tvarray = layerdata;
+	for (size_t n = 0; n < MAXIMUM_UVW_LAYERS; n++) {
+		layerdata[n].array = bzalloc(sizeof(vec4) * capacity);
+		layerdata[n].width = 4;
+	}
+
+	memcpy(vertexbufferdata->points, m_positions, m_size * sizeof(vec3));
+	memcpy(vertexbufferdata->normals, m_normals, m_size * sizeof(vec3));
+	memcpy(vertexbufferdata->tangents, m_tangents, m_size * sizeof(vec3));
+	memcpy(vertexbufferdata->colors, m_colors, m_size * sizeof(uint32_t));
+	for (size_t n = 0; n < MAXIMUM_UVW_LAYERS; n++) {
+		memcpy(layerdata[n].array, m_uvs[n], m_size * sizeof(vec4));
+	}
+
+	obs_enter_graphics();
+	gs_vertbuffer_t *vertexbuffer = gs_vertexbuffer_create(vertexbufferdata, GS_DYNAMIC);
+	obs_leave_graphics();
+	if (!vertexbuffer) {
+		// A failed create frees the data it was given, the members still describe the old buffer.
+		blog(LOG_WARNING, "GS::VertexBuffer: failed to grow buffer to %u vertices", capacity);
+		return false;
+	}
+
+	gs_vertbuffer_t *oldvertexbuffer = m_vertexbuffer;
+	m_capacity = capacity;
+	m_vertexbufferdata = vertexbufferdata;
+	m_layerdata = layerdata;
+	m_positions = vertexbufferdata->points;
+	m_normals = vertexbufferdata->normals;
+	m_tangents = vertexbufferdata->tangents;
+	m_colors = vertexbufferdata->colors;
+	for (size_t n = 0; n < MAXIMUM_UVW_LAYERS; n++) {
+		m_uvs[n] = (vec4 *)layerdata[n].array;
+	}
+	m_vertexbuffer = vertexbuffer;
+
+	// The old buffer owns the old memory and frees it.
+	obs_enter_graphics();
+	gs_vertexbuffer_destroy(oldvertexbuffer);
+	obs_leave_graphics();
+	return true;
+}
+
 uint32_t GS::VertexBuffer::Size()
 {
 	return m_size;
 }
 
+uint32_t GS::VertexBuffer::Capacity()
+{
+	return m_capacity;
+}
+
 bool GS::VertexBuffer::Empty()
 {
 	return m_size == 0;
@@ -241,10 +305,21 @@ gs_vertbuffer_t *GS::VertexBuffer::Update(bool refreshGPU)
 	if (m_size > m_capacity)
 		throw std::out_of_range("size is larger than capacity");
 
+	if (m_size == 0)
+		return m_vertexbuffer;
+
 	// Update VertexBuffer data.
 	m_vertexbufferdata = gs_vertexbuffer_get_data(m_vertexbuffer);
 	memset(m_vertexbufferdata, 0, sizeof(gs_vb_data));
-	m_vertexbufferdata->num = m_capacity;
+#ifdef _WIN32
+	// D3D11 maps the buffer with discard and copies `num` vertices, so only the
+	// ones in use need to be uploaded.
+	uint32_t uploaded = m_size;
+#else
+	// OpenGL refuses to flush a different number of vertices than the buffer was created with.
+	uint32_t uploaded = m_capacity;
+#endif
+	m_vertexbufferdata->num = uploaded;
 	m_vertexbufferdata->points = m_positions;
 	m_vertexbufferdata->normals = m_normals;
 	m_vertexbufferdata->tangents = m_tangents;
@@ -260,6 +335,7 @@ gs_vertbuffer_t *GS::VertexBuffer::Update(bool refreshGPU)
 	obs_enter_graphics();
 	gs_vertexbuffer_flush(m_vertexbuffer);
 	obs_leave_graphics();
+	m_uploadedBytes += uint64_t(uploaded) * (sizeof(vec3) * 3 + sizeof(uint32_t) + sizeof(vec4) * m_layers);
 
 	// WORKAROUND: OBS Studio 20.x and below incorrectly deletes data that it doesn't own.
 	m_vertexbufferdata->num = m_capacity;
@@ -276,6 +352,11 @@ gs_vertbuffer_t *GS::VertexBuffer::Update()
 	return Update(true);
 }
 
+uint64_t GS::VertexBuffer::GetUploadedBytes()
+{
+	return m_uploadedBytes;
+}
+
 void GS::VertexBuffer::SetupVertexBuffer(uint32_t maximumVertices)
 {
 	if (maximumVertices > MAXIMUM_VERTICES) {
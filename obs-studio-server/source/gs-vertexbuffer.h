@@ -93,8 +93,20 @@ public:
 
 	void Resize(uint32_t new_size);
 
+	/*!
+		* \brief Grow the storage to hold at least the given number of vertices
+		* Existing vertices are kept, the GPU buffer is recreated.
+		* On failure the buffer is left as it was.
+		*
+		* \param capacity Minimum number of vertices to store.
+		* \return false if the capacity is out of range or the GPU buffer could not be created.
+		*/
+	bool Reserve(uint32_t capacity);
+
 	uint32_t Size();
 
+	uint32_t Capacity();
+
 	bool Empty();
 
 	const GS::Vertex At(uint32_t idx);
@@ -149,6 +161,11 @@ public:
 
 	gs_vertbuffer_t *Update(bool refreshGPU);
 
+	/*!
+		* \brief Total number of bytes sent to the GPU by Update()
+		*/
+	uint64_t GetUploadedBytes();
+
 private:
 	void SetupVertexBuffer(uint32_t maximumVertices);
 
@@ -156,6 +173,7 @@ private:
 	uint32_t m_size;
 	uint32_t m_capacity;
 	uint32_t m_layers;
+	uint64_t m_uploadedBytes = 0;
 
 	// Memory Storage
 	vec3 *m_positions;
@@ -17,6 +17,7 @@
 ******************************************************************************/
 
 #include <chrono>
+#include <condition_variable>
 #include <inttypes.h>
 #include <iostream>
 #include <ipc-class.hpp>
@@ -58,9 +59,16 @@
 #include "osn-simple-recording.hpp"
 #include "osn-audio-encoder.hpp"
 #include "osn-advanced-recording.hpp"
+#include "startup-signal.hpp"
 #include "osn-simple-replay-buffer.hpp"
 #include "osn-advanced-replay-buffer.hpp"
 #include "osn-file-output.hpp"
+#include "osn-hotkey-index.hpp"
+#include "osn-shared-memory.hpp"
+#include "osn-write-batch.hpp"
+#include "osn-method-table.hpp"
+#include "osn-call-capture.hpp"
+#include "osn-media-events.hpp"
 
 #include "util-crashmanager.h"
 #include "shared.hpp"
@@ -131,16 +139,33 @@ extern "C" __declspec(dllexport) DWORD NvOptimusEnablement = [] {
 
 struct ServerData {
 	std::mutex mtx;
+	// Wakes the main thread on connect, disconnect and shutdown.
+	std::condition_variable cv;
 	std::chrono::high_resolution_clock::time_point last_connect, last_disconnect;
 	size_t count_connected = 0;
+	bool shutdown = false;
+
+	// Startup metrics, relative to the start of main.
+	std::chrono::high_resolution_clock::time_point started, listening, first_connect;
+	bool connected_once = false;
 };
 
+static inline double elapsed_ms(std::chrono::high_resolution_clock::time_point from, std::chrono::high_resolution_clock::time_point to)
+{
+	return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
 bool ServerConnectHandler(void *data, int64_t)
 {
 	ServerData *sd = reinterpret_cast<ServerData *>(data);
 	std::unique_lock<std::mutex> ulock(sd->mtx);
 	sd->last_connect = std::chrono::high_resolution_clock::now();
 	sd->count_connected++;
+	if (!sd->connected_once) {
+		sd->first_connect = sd->last_connect;
+		sd->connected_once = true;
+	}
+	sd->cv.notify_all();
 	return true;
 }
 
@@ -150,23 +175,41 @@ void ServerDisconnectHandler(void *data, int64_t)
 	std::unique_lock<std::mutex> ulock(sd->mtx);
 	sd->last_disconnect = std::chrono::high_resolution_clock::now();
 	sd->count_connected--;
+	sd->cv.notify_all();
 }
 
 namespace System {
 static void Shutdown(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	bool *shutdown = (bool *)data;
-	*shutdown = true;
+	ServerData *sd = reinterpret_cast<ServerData *>(data);
+	{
+		std::unique_lock<std::mutex> ulock(sd->mtx);
+		sd->shutdown = true;
+		sd->cv.notify_all();
+	}
 #ifdef __APPLE__
 	g_util_osx->stopApplication();
 #endif
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	return;
 }
+
+static void GetStartupMetrics(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	ServerData *sd = reinterpret_cast<ServerData *>(data);
+	std::unique_lock<std::mutex> ulock(sd->mtx);
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(elapsed_ms(sd->started, sd->listening)));
+	rval.push_back(ipc::value(sd->connected_once ? elapsed_ms(sd->started, sd->first_connect) : -1.0));
+	return;
+}
 } // namespace System
 
 int main(int argc, char *argv[])
 {
+	ServerData sd;
+	sd.started = std::chrono::high_resolution_clock::now();
+
 #ifdef __APPLE__
 	std::string_view slobsStdOutPath("/tmp/slobs-stdout");
 	std::string_view slobsStdErrPath("/tmp/slobs-stderr");
@@ -223,8 +266,6 @@ int main(int argc, char *argv[])
 
 	// Instance
 	ipc::server myServer;
-	bool doShutdown = false;
-	ServerData sd;
 	sd.last_disconnect = sd.last_connect = std::chrono::high_resolution_clock::now();
 	sd.count_connected = 0;
 	OBS_API::SetCrashHandlerPipe(std::wstring(socketPath.begin(), socketPath.end()));
@@ -234,8 +275,10 @@ int main(int argc, char *argv[])
 	/// System
 	{
 		std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("System");
-		cls->register_function(std::make_shared<ipc::function>("Shutdown", std::vector<ipc::type>{}, System::Shutdown, &doShutdown));
+		cls->register_function(std::make_shared<ipc::function>("Shutdown", std::vector<ipc::type>{}, System::Shutdown, &sd));
+		cls->register_function(std::make_shared<ipc::function>("GetStartupMetrics", std::vector<ipc::type>{}, System::GetStartupMetrics, &sd));
 		myServer.register_collection(cls);
+		osn::MethodTable::GetInstance().Add(cls);
 	};
 
 	/// OBS Studio Node
@@ -273,6 +316,11 @@ int main(int argc, char *argv[])
 	osn::ISimpleReplayBuffer::Register(myServer);
 	osn::IAdvancedReplayBuffer::Register(myServer);
 	osn::IFileOutput::Register(myServer);
+	osn::SharedMemory::Register(myServer);
+	osn::WriteBatch::Register(myServer);
+	osn::MediaEvents::Register(myServer);
+	osn::MethodTable::Register(myServer);
+	osn::CallCapture::Register(myServer);
 
 	OBS_API::CreateCrashHandlerExitPipe();
 
@@ -292,7 +340,15 @@ int main(int argc, char *argv[])
 	}
 
 	// Reset Connect/Disconnect time.
-	sd.last_disconnect = sd.last_connect = std::chrono::high_resolution_clock::now();
+	{
+		std::unique_lock<std::mutex> ulock(sd.mtx);
+		sd.last_disconnect = sd.last_connect = sd.listening = std::chrono::high_resolution_clock::now();
+	}
+
+	// Tell a waiting client that the socket is ready.
+	std::unique_ptr<startup::ReadySignal> readySignal = startup::ReadySignal::Create(socketPath);
+	if (readySignal)
+		readySignal->Set();
 
 #ifdef __APPLE__
 	// WARNING: Blocking function -> this won't return until the application
@@ -301,16 +357,23 @@ int main(int argc, char *argv[])
 #endif
 #ifdef WIN32
 	bool waitBeforeClosing = false;
-	while (!doShutdown) {
-		if (sd.count_connected == 0) {
-			auto tp = std::chrono::high_resolution_clock::now();
-			auto delta = tp - sd.last_disconnect;
-			if (std::chrono::duration_cast<std::chrono::milliseconds>(delta).count() > 5000) {
-				doShutdown = true;
+	{
+		// Shut down on request, or once no client has been connected for 5 seconds.
+		std::unique_lock<std::mutex> ulock(sd.mtx);
+		while (!sd.shutdown) {
+			if (sd.count_connected != 0) {
+				sd.cv.wait(ulock);
+				continue;
+			}
+
+			auto deadline = sd.last_disconnect + std::chrono::milliseconds(5000);
+			if (std::chrono::high_resolution_clock::now() >= deadline) {
+				sd.shutdown = true;
 				waitBeforeClosing = true;
+				break;
 			}
+			sd.cv.wait_until(ulock, deadline);
 		}
-		std::this_thread::sleep_for(std::chrono::milliseconds(50));
 	}
 	// Wait for crash handler listening thread to finish.
 	// flag waitBeforeClosing: server process expect to receive the exit message from the crash-handler
@@ -319,9 +382,14 @@ int main(int argc, char *argv[])
 	OBS_API::WaitCrashHandlerClose(waitBeforeClosing);
 #endif
 	osn::Source::finalize_global_signals();
+	osn::HotkeyIndex::GetInstance().Finalize();
+
+	if (readySignal)
+		readySignal->Reset();
 
 	// First, be sure there are no connected clients
 	myServer.finalize();
+	osn::SharedMemory::Finalize();
 
 	// Then, shutdown OBS
 	OBS_API::destroyOBS_API();
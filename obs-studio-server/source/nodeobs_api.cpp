@@ -25,6 +25,7 @@
 #include "osn-filter.hpp"
 #include "osn-volmeter.hpp"
 #include "osn-fader.hpp"
+#include "osn-hotkey-index.hpp"
 #include "nodeobs_autoconfig.h"
 #include "util/lexer.h"
 #include "util-crashmanager.h"
@@ -62,6 +63,8 @@
 #include <string>
 #endif
 #include "nodeobs_content.h"
+#include "osn-call-capture.hpp"
+#include "osn-method-table.hpp"
 
 #ifdef _MSC_VER
 #include <direct.h>
@@ -150,6 +153,7 @@ void OBS_API::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("SetWorkingDirectory", std::vector<ipc::type>{ipc::type::String}, SetWorkingDirectory));
 	cls->register_function(std::make_shared<ipc::function>("StopCrashHandler", std::vector<ipc::type>{}, StopCrashHandler));
 	cls->register_function(std::make_shared<ipc::function>("OBS_API_QueryHotkeys", std::vector<ipc::type>{}, QueryHotkeys));
+	cls->register_function(std::make_shared<ipc::function>("OBS_API_QueryHotkeysSince", std::vector<ipc::type>{ipc::type::UInt64}, QueryHotkeysSince));
 	cls->register_function(std::make_shared<ipc::function>("OBS_API_ProcessHotkeyStatus", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32},
 							       ProcessHotkeyStatus));
 	cls->register_function(std::make_shared<ipc::function>("SetUsername", std::vector<ipc::type>{ipc::type::String}, SetUsername));
@@ -179,6 +183,7 @@ void OBS_API::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("GetForceGPURenderingLegacy", std::vector<ipc::type>{}, GetForceGPURenderingLegacy));
 
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 	g_server = &srv;
 }
 
@@ -859,16 +864,14 @@ void OBS_API::OBS_API_initAPI(void *data, const int64_t id, const std::vector<ip
 
 #ifdef WIN32
 	// Register the pre and post server callbacks to log the data into the crashmanager
-	g_server->set_pre_callback(
-		[](std::string cname, std::string fname, const std::vector<ipc::value> &args, void *data) {
+	osn::CallCapture::GetInstance().SetHooks(
+		[](const std::string &action, const std::vector<ipc::value> &args, void *data) {
 			util::CrashManager &crashManager = *static_cast<util::CrashManager *>(data);
-			crashManager.ProcessPreServerCall(cname, fname, args);
+			crashManager.ProcessPreServerCall(action, args);
 		},
-		&crashManager);
-	g_server->set_post_callback(
-		[](std::string cname, std::string fname, const std::vector<ipc::value> &args, void *data) {
+		[](const std::string &action, const std::vector<ipc::value> &args, void *data) {
 			util::CrashManager &crashManager = *static_cast<util::CrashManager *>(data);
-			crashManager.ProcessPostServerCall(cname, fname, args);
+			crashManager.ProcessPostServerCall(action, args);
 		},
 		&crashManager);
 
@@ -946,6 +949,7 @@ void OBS_API::OBS_API_initAPI(void *data, const int64_t id, const std::vector<ip
 #endif
 
 	osn::Source::initialize_global_signals();
+	osn::HotkeyIndex::GetInstance().Initialize();
 
 	cpuUsageInfo = os_cpu_usage_info_start();
 	ConfigManager::getInstance().setAppdataPath(appdata);
@@ -1019,6 +1023,7 @@ void OBS_API::OBS_API_destroyOBS_API(void *data, const int64_t id, const std::ve
 	//  want to miss a single create or destroy signal OBS gives us for the
 	//  osn::Source::Manager.
 	osn::Source::finalize_global_signals();
+	osn::HotkeyIndex::GetInstance().Finalize();
 	/* END INJECT osn::Source::Manager */
 	destroyOBS_API();
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
@@ -1054,110 +1059,9 @@ void OBS_API::OBS_API_getPerformanceStatistics(void *data, const int64_t id, con
 
 void OBS_API::QueryHotkeys(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	struct HotkeyInfo {
-		std::string objectName;
-		obs_hotkey_registerer_type objectType;
-		std::string hotkeyName;
-		std::string hotkeyDesc;
-		obs_hotkey_id hotkeyId;
-	};
-
-	// For each registered hotkey
-	std::vector<HotkeyInfo> hotkeyInfos;
-	obs_enum_hotkeys(
-		[](void *data, obs_hotkey_id id, obs_hotkey_t *key) {
-			// Make sure every word has an initial capital letter
-			auto ToTitle = [](std::string s) {
-				bool last = true;
-				for (char &c : s) {
-					int full_c = (uint8_t)c;
-					full_c = last ? ::toupper(full_c) : ::tolower(full_c);
-					last = ::isspace(full_c);
-				}
-				return s;
-			};
-			std::vector<HotkeyInfo> &hotkeyInfos = *static_cast<std::vector<HotkeyInfo> *>(data);
-			auto registerer_type = obs_hotkey_get_registerer_type(key);
-			void *registerer = obs_hotkey_get_registerer(key);
-			HotkeyInfo currentHotkeyInfo;
-			if (registerer == nullptr)
-				return true;
-
-			// Discover the type of object registered with this hotkey
-			switch (registerer_type) {
-			case OBS_HOTKEY_REGISTERER_NONE:
-			case OBS_HOTKEY_REGISTERER_FRONTEND: {
-				// Ignore any frontend hotkey
-				return true;
-				break;
-			}
-			case OBS_HOTKEY_REGISTERER_SOURCE: {
-				auto *weak_source = static_cast<obs_weak_source_t *>(registerer);
-				auto key_source = OBSGetStrongRef(weak_source);
-				if (key_source == nullptr)
-					return true;
-				currentHotkeyInfo.objectName = obs_source_get_name(key_source);
-				currentHotkeyInfo.objectType = OBS_HOTKEY_REGISTERER_SOURCE;
-				break;
-			}
-			case OBS_HOTKEY_REGISTERER_OUTPUT: {
-				auto *weak_output = static_cast<obs_weak_output_t *>(registerer);
-				auto key_output = OBSGetStrongRef(weak_output);
-				if (key_output == nullptr)
-					return true;
-				currentHotkeyInfo.objectName = obs_output_get_name(key_output);
-				currentHotkeyInfo.objectType = OBS_HOTKEY_REGISTERER_OUTPUT;
-				break;
-			}
-			case OBS_HOTKEY_REGISTERER_ENCODER: {
-				auto *weak_encoder = static_cast<obs_weak_encoder_t *>(registerer);
-				auto key_encoder = OBSGetStrongRef(weak_encoder);
-				if (key_encoder == nullptr)
-					return true;
-				currentHotkeyInfo.objectName = obs_encoder_get_name(key_encoder);
-				currentHotkeyInfo.objectType = OBS_HOTKEY_REGISTERER_ENCODER;
-				break;
-			}
-			case OBS_HOTKEY_REGISTERER_SERVICE: {
-				auto *weak_service = static_cast<obs_weak_service_t *>(registerer);
-				auto key_service = OBSGetStrongRef(weak_service);
-				if (key_service == nullptr)
-					return true;
-				currentHotkeyInfo.objectName = obs_service_get_name(key_service);
-				currentHotkeyInfo.objectType = OBS_HOTKEY_REGISTERER_SERVICE;
-				break;
-			}
-			}
-
-			// Key defs
-			const char *_key_name = obs_hotkey_get_name(key);
-			const char *_desc = obs_hotkey_get_description(key);
-
-			if (!_key_name)
-				return true;
-
-			if (!_desc)
-				_desc = "";
-
-			auto key_name = std::string(_key_name);
-			auto desc = std::string(_desc);
-			const auto hotkeyId = obs_hotkey_get_id(key);
-
-			// Parse the key name and the description
-			key_name = key_name.substr(key_name.find_first_of(".") + 1);
-			std::replace(key_name.begin(), key_name.end(), '-', '_');
-			std::transform(key_name.begin(), key_name.end(), key_name.begin(), ::toupper);
-			std::replace(desc.begin(), desc.end(), '-', ' ');
-			desc = ToTitle(desc);
-
-			currentHotkeyInfo.hotkeyName = key_name;
-			currentHotkeyInfo.hotkeyDesc = desc;
-			currentHotkeyInfo.hotkeyId = hotkeyId;
-			hotkeyInfos.push_back(currentHotkeyInfo);
-
-			return true;
-		},
-		&hotkeyInfos);
+	std::vector<osn::HotkeyIndex::Entry> hotkeyInfos;
+	bool reset = false;
+	osn::HotkeyIndex::GetInstance().Query(0, hotkeyInfos, reset);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 
@@ -1173,6 +1077,34 @@ void OBS_API::QueryHotkeys(void *data, const int64_t id, const std::vector<ipc::
 	AUTO_DEBUG;
 }
 
+void OBS_API::QueryHotkeysSince(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	std::vector<osn::HotkeyIndex::Entry> changed;
+	bool reset = false;
+	uint64_t generation = osn::HotkeyIndex::GetInstance().Query(args[0].value_union.ui64, changed, reset);
+
+	auto removed = std::stable_partition(changed.begin(), changed.end(), [](const osn::HotkeyIndex::Entry &entry) { return !entry.removed; });
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(generation));
+	rval.push_back(ipc::value((int32_t)reset));
+
+	rval.push_back(ipc::value(uint32_t(removed - changed.begin())));
+	for (auto iter = changed.begin(); iter != removed; iter++) {
+		rval.push_back(ipc::value(iter->objectName));
+		rval.push_back(ipc::value(uint32_t(iter->objectType)));
+		rval.push_back(ipc::value(iter->hotkeyName));
+		rval.push_back(ipc::value(iter->hotkeyDesc));
+		rval.push_back(ipc::value(uint64_t(iter->hotkeyId)));
+	}
+
+	rval.push_back(ipc::value(uint32_t(changed.end() - removed)));
+	for (auto iter = removed; iter != changed.end(); iter++)
+		rval.push_back(ipc::value(uint64_t(iter->hotkeyId)));
+
+	AUTO_DEBUG;
+}
+
 void OBS_API::ProcessHotkeyStatus(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
 	obs_hotkey_id hotkeyId = args[0].value_union.ui64;
@@ -1276,6 +1208,9 @@ bool DisableAudioDucking(bool disable)
 
 void OBS_API::setAudioDeviceMonitoring(void)
 {
+	if (utility::IsHeadless())
+		return;
+
 /* load audio monitoring */
 #if defined(_WIN32) || defined(__APPLE__)
 	const char *device_name = config_get_string(ConfigManager::getInstance().getBasic(), "Audio", "MonitoringDeviceName");
@@ -17,10 +17,17 @@
 ******************************************************************************/
 
 #include "nodeobs_autoconfig.h"
+#include <algorithm>
 #include <array>
 #include <future>
+#include <memory>
+#include "osn-encoder-benchmark.hpp"
 #include "osn-error.hpp"
+#include "osn-rtmp-loopback.hpp"
+#include "osn-rtmp-probe.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
+#include "utility.hpp"
 
 enum class Type { Invalid, Streaming, Recording };
 
@@ -32,7 +39,16 @@ enum class Quality { Stream, High };
 
 enum class FPSType : int { PreferHighFPS, PreferHighRes, UseCurrent, fps30, fps60 };
 
-enum ThreadedTests : int { BandwidthTest, StreamEncoderTest, RecordingEncoderTest, SaveStreamSettings, SaveSettings, SetDefaultSettings, Count };
+enum ThreadedTests : int {
+	BandwidthTest,
+	StreamEncoderTest,
+	RecordingEncoderTest,
+	SaveStreamSettings,
+	SaveSettings,
+	SetDefaultSettings,
+	EncoderBenchmark,
+	Count
+};
 
 class AutoConfigInfo {
 public:
@@ -101,11 +117,30 @@ bool started = false;
 
 bool softwareTested = false;
 
+std::mutex benchmarkMutex;
+OBSData benchmarkData;
+double benchmarkSecondsPerPoint = 3.0;
+bool benchmarkApplied = false;
+
+std::mutex bandwidthMutex;
+OBSData bandwidthData;
+std::string bandwidthTargetName = "service";
+osn::RtmpLoopback::Shaping loopbackShaping;
+uint32_t loopbackServers = 1;
+uint32_t bandwidthMaxThroughputTests = 3;
+bool bandwidthParallel = false;
+uint32_t bandwidthProbeTimeoutMs = 2000;
+
 struct ServerInfo {
 	std::string name;
 	std::string address;
 	int bitrate = 0;
 	int ms = -1;
+	int durationMs = 0;
+	int measuredKbps = 0;
+	bool converged = false;
+	bool tested = false;
+	osn::RtmpProbe::Result probe;
 
 	inline ServerInfo() {}
 
@@ -124,10 +159,22 @@ void autoConfig::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("StartSetDefaultSettings", std::vector<ipc::type>{}, autoConfig::StartSetDefaultSettings));
 	cls->register_function(std::make_shared<ipc::function>("StartSaveStreamSettings", std::vector<ipc::type>{}, autoConfig::StartSaveStreamSettings));
 	cls->register_function(std::make_shared<ipc::function>("StartSaveSettings", std::vector<ipc::type>{}, autoConfig::StartSaveSettings));
+	cls->register_function(
+		std::make_shared<ipc::function>("StartEncoderBenchmark", std::vector<ipc::type>{ipc::type::Double}, autoConfig::StartEncoderBenchmark));
+	cls->register_function(std::make_shared<ipc::function>("GetEncoderBenchmarkResults", std::vector<ipc::type>{ipc::type::String},
+							       autoConfig::GetEncoderBenchmarkResults));
+	cls->register_function(std::make_shared<ipc::function>("SetBandwidthTestTarget",
+							       std::vector<ipc::type>{ipc::type::String, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32},
+							       autoConfig::SetBandwidthTestTarget));
+	cls->register_function(std::make_shared<ipc::function>("SetBandwidthTestOptions", std::vector<ipc::type>{ipc::type::UInt32, ipc::type::Int32},
+							       autoConfig::SetBandwidthTestOptions));
+	cls->register_function(
+		std::make_shared<ipc::function>("GetBandwidthTestResults", std::vector<ipc::type>{}, autoConfig::GetBandwidthTestResults));
 	cls->register_function(std::make_shared<ipc::function>("TerminateAutoConfig", std::vector<ipc::type>{}, autoConfig::TerminateAutoConfig));
 	cls->register_function(std::make_shared<ipc::function>("Query", std::vector<ipc::type>{}, autoConfig::Query));
 
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void autoConfig::WaitPendingTests(double timeout)
@@ -322,6 +369,7 @@ void autoConfig::InitializeAutoConfig(void *data, const int64_t id, const std::v
 		OBS_service::setStreamingOutput(nullptr, StreamServiceId::Main);
 
 	cancel = false;
+	benchmarkApplied = false;
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
@@ -378,6 +426,75 @@ void autoConfig::StartCheckSettings(void *data, const int64_t id, const std::vec
 	AUTO_DEBUG;
 }
 
+void autoConfig::StartEncoderBenchmark(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	if (args[0].value_union.fp64 > 0.0)
+		benchmarkSecondsPerPoint = args[0].value_union.fp64;
+
+	asyncTests[ThreadedTests::EncoderBenchmark] = std::async(std::launch::async, EncoderBenchmarkThread);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void autoConfig::GetEncoderBenchmarkResults(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	std::unique_lock<std::mutex> ulock(benchmarkMutex);
+	if (!benchmarkData) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "No encoder benchmark has completed.");
+	}
+
+	const std::string &path = args[0].value_str;
+	if (!path.empty() && !obs_data_save_json_safe(benchmarkData, path.c_str(), "tmp", "bak")) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Failed to save the encoder benchmark results.");
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(obs_data_get_json(benchmarkData)));
+	AUTO_DEBUG;
+}
+
+void autoConfig::SetBandwidthTestTarget(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	const std::string &name = args[0].value_str;
+	if (name != "service" && name != "loopback") {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Unknown bandwidth test target.");
+	}
+
+	bandwidthTargetName = name;
+	loopbackShaping.throughputKbps = args[1].value_union.ui32;
+	loopbackShaping.latencyMs = args[2].value_union.ui32;
+	loopbackServers = std::max<uint32_t>(args[3].value_union.ui32, 1);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void autoConfig::SetBandwidthTestOptions(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	if (args[0].value_union.ui32 == 0) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "At least one server must get the throughput test.");
+	}
+
+	bandwidthMaxThroughputTests = args[0].value_union.ui32;
+	bandwidthParallel = args[1].value_union.i32 != 0;
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void autoConfig::GetBandwidthTestResults(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	std::unique_lock<std::mutex> ulock(bandwidthMutex);
+	if (!bandwidthData) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "No bandwidth test has completed.");
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(obs_data_get_json(bandwidthData)));
+	AUTO_DEBUG;
+}
+
 void autoConfig::StartSetDefaultSettings(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
 	asyncTests[ThreadedTests::SetDefaultSettings] = std::async(std::launch::async, SetDefaultSettings);
@@ -386,85 +503,275 @@ void autoConfig::StartSetDefaultSettings(void *data, const int64_t id, const std
 	AUTO_DEBUG;
 }
 
-int EvaluateBandwidth(ServerInfo &server, bool &connected, bool &stopped, bool &success, bool &errorOnStop, OBSData &service_settings, OBSService &service,
-		      OBSOutput &output, OBSData &vencoder_settings)
-{
-	connected = false;
-	stopped = false;
-	errorOnStop = false;
+// Bitrate estimate over a sliding window of output byte counts. It is stable
+// once several consecutive windows agree, at which point the test can stop
+// instead of running for the full duration.
+class BandwidthEstimator {
+public:
+	static constexpr uint64_t SampleIntervalMs = 250;
+	static constexpr size_t WindowSamples = 4;
+	static constexpr size_t StableWindows = 4;
+	static constexpr double Tolerance = 0.05;
+	// Leaves time for the socket buffers to fill before the rate is trusted.
+	static constexpr uint64_t MinDurationNs = 3000000000ULL;
 
-	obs_data_set_string(service_settings, "server", server.address.c_str());
-	obs_service_update(service, service_settings);
+	void AddSample(uint64_t elapsedNs, uint64_t bytes) { m_samples.push_back({elapsedNs, bytes}); }
 
-	if (!obs_output_start(output))
-		return -1;
+	bool Converged(double &kbps) const
+	{
+		if (m_samples.size() < WindowSamples + StableWindows || m_samples.back().elapsedNs < MinDurationNs)
+			return false;
 
-	std::unique_lock<std::mutex> ul(m);
-	if (cancel) {
-		ul.unlock();
-		obs_output_force_stop(output);
-		return -1;
+		double rates[StableWindows];
+		double mean = 0.0;
+		for (size_t idx = 0; idx < StableWindows; idx++) {
+			const Sample &last = m_samples[m_samples.size() - 1 - idx];
+			const Sample &first = m_samples[m_samples.size() - 1 - idx - WindowSamples];
+			rates[idx] = double(last.bytes - first.bytes) * 8.0 * 1000000.0 / double(last.elapsedNs - first.elapsedNs);
+			mean += rates[idx] / StableWindows;
+		}
+
+		if (mean <= 0.0)
+			return false;
+		for (double rate : rates) {
+			if (std::abs(rate - mean) > mean * Tolerance)
+				return false;
+		}
+
+		kbps = mean;
+		return true;
 	}
-	if (!stopped && !connected)
-		cv.wait(ul);
-	if (cancel) {
-		ul.unlock();
-		obs_output_force_stop(output);
-		return -1;
+
+private:
+	struct Sample {
+		uint64_t elapsedNs;
+		uint64_t bytes;
+	};
+	std::vector<Sample> m_samples;
+};
+
+// One rtmp_output streaming to one server. Several of them can share the test
+// encoders and run at the same time. The flags are protected by m.
+class ThroughputTest {
+public:
+	ThroughputTest(ServerInfo &server) : m_server(server) {}
+	~ThroughputTest()
+	{
+		if (m_output) {
+			signal_handler_t *sh = obs_output_get_signal_handler(m_output);
+			signal_handler_disconnect(sh, "start", OnStart, this);
+			signal_handler_disconnect(sh, "stop", OnStop, this);
+			signal_handler_disconnect(sh, "deactivate", OnDeactivate, this);
+			obs_output_release(m_output);
+		}
+		if (m_service)
+			obs_service_release(m_service);
+	}
+
+	bool Start(size_t index, const char *serverType, OBSData &service_settings, OBSData &output_settings, obs_encoder_t *vencoder, obs_encoder_t *aencoder)
+	{
+		std::string suffix = std::to_string(index);
+
+		OBSData settings = obs_data_create();
+		obs_data_release(settings);
+		obs_data_apply(settings, service_settings);
+		obs_data_set_string(settings, "server", m_server.address.c_str());
+
+		m_service = obs_service_create(serverType, ("test_service_" + suffix).c_str(), settings, nullptr);
+		m_output = obs_output_create("rtmp_output", ("test_stream_" + suffix).c_str(), output_settings, nullptr);
+		if (!m_service || !m_output) {
+			m_failed = true;
+			return false;
+		}
+
+		obs_output_set_video_encoder(m_output, vencoder);
+		obs_output_set_audio_encoder(m_output, aencoder, 0);
+		obs_output_set_service(m_output, m_service);
+
+		signal_handler_t *sh = obs_output_get_signal_handler(m_output);
+		signal_handler_connect(sh, "start", OnStart, this);
+		signal_handler_connect(sh, "stop", OnStop, this);
+		signal_handler_connect(sh, "deactivate", OnDeactivate, this);
+
+		m_server.tested = true;
+		if (!obs_output_start(m_output)) {
+			std::unique_lock<std::mutex> ul(m);
+			m_failed = true;
+			return false;
+		}
+		return true;
 	}
-	if (!connected) {
-		return -1;
+
+	bool IsConnecting() const { return !m_connected && !m_stopped && !m_failed; }
+	bool IsSampling() const { return m_connected && !m_stopped && !m_failed && !m_server.converged; }
+
+	void Begin()
+	{
+		if (!m_connected || m_stopped)
+			return;
+		m_startNs = os_gettime_ns();
+		m_startBytes = obs_output_get_total_bytes(m_output);
+		m_endNs = m_startNs;
+		m_endBytes = m_startBytes;
 	}
 
-	uint64_t t_start = os_gettime_ns();
+	void Sample()
+	{
+		if (m_stopped) {
+			m_failed = true;
+			return;
+		}
+
+		m_endNs = os_gettime_ns();
+		m_endBytes = obs_output_get_total_bytes(m_output);
+		m_estimator.AddSample(m_endNs - m_startNs, m_endBytes - m_startBytes);
+		if (m_estimator.Converged(m_convergedKbps))
+			m_server.converged = true;
+	}
+
+	void GiveUp() { m_failed = true; }
 
-	//wait for start signal from output
-	cv.wait_for(ul, std::chrono::seconds(10));
-	if (stopped)
-		return -1;
-	if (cancel) {
-		ul.unlock();
-		obs_output_force_stop(output);
-		return -1;
+	// Called without m held, the output may signal synchronously.
+	void Stop(bool force)
+	{
+		if (!m_output || !obs_output_active(m_output))
+			return;
+		if (force || m_errorOnStop)
+			obs_output_force_stop(m_output);
+		else
+			obs_output_stop(m_output);
 	}
 
-	obs_output_stop(output);
+	bool IsActive() const { return m_output && obs_output_active(m_output) && !m_deactivated; }
+
+	bool Finish()
+	{
+		if (m_failed || !m_connected)
+			return false;
+
+		uint64_t total_time = m_endNs - m_startNs;
+		uint64_t total_bytes = m_endBytes - m_startBytes;
+		m_server.durationMs = int(total_time / 1000000);
 
-	while (!obs_output_active(output)) {
-		if (errorOnStop) {
-			ul.unlock();
-			obs_output_force_stop(output);
-			return -1;
+		uint64_t bitrate = 0;
+		if (m_server.converged) {
+			bitrate = (uint64_t)m_convergedKbps;
+		} else if (total_time > 0) {
+			bitrate = total_bytes * 8U * 1000000000U / total_time / 1000U;
+		}
+		m_server.measuredKbps = int(bitrate);
+
+		if (obs_output_get_frames_dropped(m_output) || (int)bitrate < (startingBitrate * 75 / 100)) {
+			m_server.bitrate = (int)bitrate * 70 / 100;
+		} else {
+			m_server.bitrate = startingBitrate;
 		}
 
-		std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		m_server.ms = obs_output_get_connect_time_ms(m_output);
+		return true;
 	}
 
-	//wait for stop signal from output
-	cv.wait(ul);
+private:
+	static void OnStart(void *data, calldata_t *)
+	{
+		ThroughputTest *test = reinterpret_cast<ThroughputTest *>(data);
+		std::unique_lock<std::mutex> lock(m);
+		test->m_connected = true;
+		test->m_stopped = false;
+		cv.notify_all();
+	}
 
-	uint64_t total_time = os_gettime_ns() - t_start;
-	int total_bytes = (int)obs_output_get_total_bytes(output);
-	uint64_t bitrate = 0;
+	static void OnStop(void *data, calldata_t *)
+	{
+		ThroughputTest *test = reinterpret_cast<ThroughputTest *>(data);
+		std::unique_lock<std::mutex> lock(m);
+		if (obs_output_get_last_error(test->m_output) != nullptr)
+			test->m_errorOnStop = true;
+		test->m_stopped = true;
+		cv.notify_all();
+	}
 
-	if (total_time > 0) {
-		bitrate = (uint64_t)total_bytes * 8U * 1000000000U / total_time / 1000U;
+	static void OnDeactivate(void *data, calldata_t *)
+	{
+		ThroughputTest *test = reinterpret_cast<ThroughputTest *>(data);
+		std::unique_lock<std::mutex> lock(m);
+		test->m_deactivated = true;
+		cv.notify_all();
 	}
 
-	startingBitrate = (int)obs_data_get_int(vencoder_settings, "bitrate");
-	if (obs_output_get_frames_dropped(output) || (int)bitrate < (startingBitrate * 75 / 100)) {
-		server.bitrate = (int)bitrate * 70 / 100;
-	} else {
-		server.bitrate = startingBitrate;
+	ServerInfo &m_server;
+	obs_service_t *m_service = nullptr;
+	obs_output_t *m_output = nullptr;
+
+	bool m_connected = false;
+	bool m_stopped = false;
+	bool m_errorOnStop = false;
+	bool m_deactivated = false;
+	bool m_failed = false;
+
+	BandwidthEstimator m_estimator;
+	double m_convergedKbps = 0.0;
+	uint64_t m_startNs = 0;
+	uint64_t m_startBytes = 0;
+	uint64_t m_endNs = 0;
+	uint64_t m_endBytes = 0;
+};
+
+// Streams to every server in `tests` at once until each bitrate estimate
+// settles or the time is up. Returns true if at least one test succeeded.
+static bool RunThroughputTests(std::vector<std::unique_ptr<ThroughputTest>> &tests)
+{
+	std::unique_lock<std::mutex> ul(m);
+
+	//wait for every output to connect or fail
+	uint64_t deadline = os_gettime_ns() + 20000000000ULL;
+	auto connecting = [&]() { return std::any_of(tests.begin(), tests.end(), [](auto &test) { return test->IsConnecting(); }); };
+	while (!cancel && connecting()) {
+		if (os_gettime_ns() >= deadline) {
+			for (auto &test : tests) {
+				if (test->IsConnecting())
+					test->GiveUp();
+			}
+			break;
+		}
+		cv.wait_for(ul, std::chrono::milliseconds(BandwidthEstimator::SampleIntervalMs));
+	}
+
+	for (auto &test : tests)
+		test->Begin();
+
+	//sample until every estimate settles or the time is up
+	uint64_t t_start = os_gettime_ns();
+	auto sampling = [&]() { return std::any_of(tests.begin(), tests.end(), [](auto &test) { return test->IsSampling(); }); };
+	while (!cancel && sampling() && os_gettime_ns() - t_start < 10000000000ULL) {
+		cv.wait_for(ul, std::chrono::milliseconds(BandwidthEstimator::SampleIntervalMs));
+		for (auto &test : tests) {
+			if (test->IsSampling())
+				test->Sample();
+		}
 	}
 
-	server.ms = obs_output_get_connect_time_ms(output);
-	success = true;
+	bool canceled = cancel;
+	if (canceled) {
+		for (auto &test : tests)
+			test->GiveUp();
+	}
+	ul.unlock();
+
+	for (auto &test : tests)
+		test->Stop(canceled);
 
-	//wait for deactivate signal from output
-	cv.wait(ul);
+	//wait for deactivate signal from every output
+	ul.lock();
+	deadline = os_gettime_ns() + 5000000000ULL;
+	while (std::any_of(tests.begin(), tests.end(), [](auto &test) { return test->IsActive(); }) && os_gettime_ns() < deadline)
+		cv.wait_for(ul, std::chrono::milliseconds(50));
+	ul.unlock();
 
-	return 0;
+	bool success = false;
+	for (auto &test : tests)
+		success |= test->Finish();
+	return success;
 }
 
 void sendErrorMessage(const std::string &message)
@@ -474,15 +781,202 @@ void sendErrorMessage(const std::string &message)
 	eventsMutex.unlock();
 }
 
+// Where the bandwidth test streams to.
+class BandwidthTarget {
+public:
+	virtual ~BandwidthTarget() {}
+
+	virtual const char *GetName() const = 0;
+	virtual const char *GetServiceType() const = 0;
+	// Fills the service settings shared by every server, false if the target can't be tested.
+	virtual bool Configure(OBSData &service_settings) = 0;
+	virtual int GetStartingBitrate() = 0;
+	virtual void GetServers(std::vector<ServerInfo> &servers) = 0;
+	// Called with the best server once every server was tested.
+	virtual void Select(const ServerInfo &best) = 0;
+	virtual void Describe(obs_data_t *data) {}
+};
+
+// The ingest servers of the configured streaming service.
+class ServiceBandwidthTarget : public BandwidthTarget {
+public:
+	const char *GetName() const override { return "service"; }
+	const char *GetServiceType() const override { return "rtmp_common"; }
+
+	bool Configure(OBSData &service_settings) override
+	{
+		obs_service_t *currentService = OBS_service::getService(StreamServiceId::Main);
+		if (!currentService)
+			return false;
+
+		obs_data_t *currentServiceSettings = obs_service_get_settings(currentService);
+		if (!currentServiceSettings)
+			return false;
+
+		if (serviceName.compare("") == 0)
+			serviceName = obs_data_get_string(currentServiceSettings, "service");
+
+		key = obs_service_get_key(currentService);
+		if (key.empty())
+			return false;
+
+		if (!customServer) {
+			if (serviceName == "Twitch")
+				serviceSelected = Service::Twitch;
+			else if (serviceName == "hitbox.tv")
+				serviceSelected = Service::Hitbox;
+			else if (serviceName == "beam.pro")
+				serviceSelected = Service::Beam;
+			else if (serviceName.find("YouTube") != std::string::npos)
+				serviceSelected = Service::YouTube;
+			else
+				serviceSelected = Service::Other;
+		} else {
+			serviceSelected = Service::Other;
+		}
+		std::string keyToEvaluate = key;
+
+		if (serviceSelected == Service::Twitch) {
+			string_depad_key(key);
+			keyToEvaluate += "?bandwidthtest";
+		}
+
+		if (serviceSelected == Service::YouTube) {
+			serverName = "Stream URL";
+			server = obs_service_get_url(currentService);
+		}
+
+		obs_data_set_string(service_settings, "service", serviceName.c_str());
+		obs_data_set_string(service_settings, "key", keyToEvaluate.c_str());
+		return true;
+	}
+
+	int GetStartingBitrate() override
+	{
+		OBSData service_settingsawd = obs_data_create();
+		obs_data_release(service_settingsawd);
+
+		obs_data_set_string(service_settingsawd, "service", serviceName.c_str());
+
+		OBSService servicewad = obs_service_create(GetServiceType(), "temp_service", service_settingsawd, nullptr);
+		obs_service_release(servicewad);
+
+		int bitrate = 10000;
+
+		OBSData settings = obs_data_create();
+		obs_data_release(settings);
+		obs_data_set_int(settings, "bitrate", bitrate);
+		obs_service_apply_encoder_settings(servicewad, settings, nullptr);
+
+		return (int)obs_data_get_int(settings, "bitrate");
+	}
+
+	void GetServers(std::vector<ServerInfo> &servers) override
+	{
+		if (serverName.compare("") != 0) {
+			servers.emplace_back(serverName.c_str(), server.c_str());
+			return;
+		}
+
+		if (customServer)
+			servers.emplace_back(server.c_str(), server.c_str());
+		else
+			::GetServers(servers);
+
+		/* just use the first server if it only has one alternate server */
+		if (servers.size() < 3)
+			servers.resize(1);
+	}
+
+	void Select(const ServerInfo &best) override
+	{
+		server = best.address;
+		serverName = best.name;
+	}
+};
+
+// The built-in loopback sinks, so the test runs offline with a known bandwidth.
+// Sink n answers n times slower than the first one, so probing ranks them in a
+// known order. Each sink applies its own throughput cap.
+class LoopbackBandwidthTarget : public BandwidthTarget {
+public:
+	LoopbackBandwidthTarget(const osn::RtmpLoopback::Shaping &shaping, uint32_t count) : m_shaping(shaping)
+	{
+		for (uint32_t idx = 0; idx < std::max<uint32_t>(count, 1); idx++)
+			m_sinks.push_back(std::make_unique<osn::RtmpLoopback>());
+	}
+
+	const char *GetName() const override { return "loopback"; }
+	const char *GetServiceType() const override { return "rtmp_custom"; }
+
+	bool Configure(OBSData &service_settings) override
+	{
+		for (size_t idx = 0; idx < m_sinks.size(); idx++) {
+			osn::RtmpLoopback::Shaping shaping = m_shaping;
+			shaping.latencyMs = m_shaping.latencyMs * uint32_t(idx + 1);
+			if (!m_sinks[idx]->Start(shaping))
+				return false;
+		}
+
+		obs_data_set_string(service_settings, "key", "loopback");
+		obs_data_set_bool(service_settings, "use_auth", false);
+		return true;
+	}
+
+	int GetStartingBitrate() override { return 10000; }
+
+	void GetServers(std::vector<ServerInfo> &servers) override
+	{
+		for (size_t idx = 0; idx < m_sinks.size(); idx++) {
+			std::string name = "Loopback " + std::to_string(idx + 1);
+			servers.emplace_back(name.c_str(), m_sinks[idx]->GetUrl().c_str());
+		}
+	}
+
+	// The loopback address must never end up in the saved stream settings.
+	void Select(const ServerInfo &best) override {}
+
+	void Describe(obs_data_t *data) override
+	{
+		osn::RtmpLoopback::Stats total;
+		for (auto &sink : m_sinks) {
+			osn::RtmpLoopback::Stats stats = sink->GetStats();
+			total.connections += stats.connections;
+			total.publishes += stats.publishes;
+			total.bytesReceived += stats.bytesReceived;
+		}
+
+		obs_data_set_int(data, "throughputKbps", m_shaping.throughputKbps);
+		obs_data_set_int(data, "latencyMs", m_shaping.latencyMs);
+		obs_data_set_int(data, "connections", total.connections);
+		obs_data_set_int(data, "publishes", total.publishes);
+		obs_data_set_int(data, "bytesReceived", total.bytesReceived);
+	}
+
+private:
+	osn::RtmpLoopback::Shaping m_shaping;
+	std::vector<std::unique_ptr<osn::RtmpLoopback>> m_sinks;
+};
+
+static std::unique_ptr<BandwidthTarget> CreateBandwidthTarget()
+{
+	if (bandwidthTargetName == "loopback")
+		return std::make_unique<LoopbackBandwidthTarget>(loopbackShaping, loopbackServers);
+	return std::make_unique<ServiceBandwidthTarget>();
+}
+
+static inline int elapsed_ms(uint64_t since)
+{
+	return int((os_gettime_ns() - since) / 1000000);
+}
+
 void autoConfig::TestBandwidthThread(void)
 {
 	eventsMutex.lock();
 	events.push(AutoConfigInfo("starting_step", "bandwidth_test", 0));
 	eventsMutex.unlock();
 
-	bool connected = false;
-	bool stopped = false;
-	bool errorOnStop = false;
+	uint64_t testStart = os_gettime_ns();
 	bool gotError = false;
 
 	obs_video_info video = {0};
@@ -513,12 +1007,12 @@ void autoConfig::TestBandwidthThread(void)
 		return;
 	}
 
-	const char *serverType = "rtmp_common";
+	std::unique_ptr<BandwidthTarget> target = CreateBandwidthTarget();
+	const char *serverType = target->GetServiceType();
 
 	OBSEncoder vencoder = obs_video_encoder_create("obs_x264", "test_x264", nullptr, nullptr);
 	OBSEncoder aencoder = obs_audio_encoder_create("ffmpeg_aac", "test_aac", nullptr, 0, nullptr);
 	OBSService service = obs_service_create(serverType, "test_service", nullptr, nullptr);
-	OBSOutput output = obs_output_create("rtmp_output", "test_stream", nullptr, nullptr);
 
 	/* -----------------------------------*/
 	/* configure settings                 */
@@ -539,29 +1033,8 @@ void autoConfig::TestBandwidthThread(void)
 	obs_data_release(aencoder_settings);
 	obs_data_release(output_settings);
 
-	obs_service_t *currentService = OBS_service::getService(StreamServiceId::Main);
-	if (currentService) {
-		obs_data_t *currentServiceSettings = obs_service_get_settings(currentService);
-		if (currentServiceSettings) {
-			if (serviceName.compare("") == 0)
-				serviceName = obs_data_get_string(currentServiceSettings, "service");
-
-			key = obs_service_get_key(currentService);
-			if (key.empty()) {
-				sendErrorMessage("invalid_stream_settings");
-				gotError = true;
-			}
-		} else {
-			sendErrorMessage("invalid_stream_settings");
-			gotError = true;
-		}
-	} else {
+	if (!target->Configure(service_settings)) {
 		sendErrorMessage("invalid_stream_settings");
-		gotError = true;
-	}
-
-	if (gotError) {
-		obs_output_release(output);
 		obs_encoder_release(vencoder);
 		obs_encoder_release(aencoder);
 		obs_service_release(service);
@@ -569,52 +1042,8 @@ void autoConfig::TestBandwidthThread(void)
 		return;
 	}
 
-	if (!customServer) {
-		if (serviceName == "Twitch")
-			serviceSelected = Service::Twitch;
-		else if (serviceName == "hitbox.tv")
-			serviceSelected = Service::Hitbox;
-		else if (serviceName == "beam.pro")
-			serviceSelected = Service::Beam;
-		else if (serviceName.find("YouTube") != std::string::npos)
-			serviceSelected = Service::YouTube;
-		else
-			serviceSelected = Service::Other;
-	} else {
-		serviceSelected = Service::Other;
-	}
-	std::string keyToEvaluate = key;
-
-	if (serviceSelected == Service::Twitch) {
-		string_depad_key(key);
-		keyToEvaluate += "?bandwidthtest";
-	}
-
-	if (serviceSelected == Service::YouTube) {
-		serverName = "Stream URL";
-		server = obs_service_get_url(currentService);
-	}
-
-	obs_data_set_string(service_settings, "service", serviceName.c_str());
-	obs_data_set_string(service_settings, "key", keyToEvaluate.c_str());
-
 	//Setting starting bitrate
-	OBSData service_settingsawd = obs_data_create();
-	obs_data_release(service_settingsawd);
-
-	obs_data_set_string(service_settingsawd, "service", serviceName.c_str());
-
-	OBSService servicewad = obs_service_create(serverType, "temp_service", service_settingsawd, nullptr);
-	obs_service_release(servicewad);
-
-	int bitrate = 10000;
-
-	OBSData settings = obs_data_create();
-	obs_data_release(settings);
-	obs_data_set_int(settings, "bitrate", bitrate);
-	obs_service_apply_encoder_settings(servicewad, settings, nullptr);
-
-	int awstartingBitrate = (int)obs_data_get_int(settings, "bitrate");
+	int awstartingBitrate = target->GetStartingBitrate();
 	obs_data_set_int(vencoder_settings, "bitrate", awstartingBitrate);
 	obs_data_set_string(vencoder_settings, "rate_control", "CBR");
 	obs_data_set_string(vencoder_settings, "preset", "veryfast");
@@ -629,14 +1058,7 @@ void autoConfig::TestBandwidthThread(void)
 	/* determine which servers to test    */
 
 	std::vector<ServerInfo> servers;
-	if (customServer)
-		servers.emplace_back(server.c_str(), server.c_str());
-	else
-		GetServers(servers);
-
-	/* just use the first server if it only has one alternate server */
-	if (servers.size() < 3)
-		servers.resize(1);
+	target->GetServers(servers);
 
 	/* -----------------------------------*/
 	/* apply settings                     */
@@ -650,124 +1072,152 @@ void autoConfig::TestBandwidthThread(void)
 	obs_encoder_set_video_mix(vencoder, obs_video_mix_get(ovi, OBS_MAIN_VIDEO_RENDERING));
 	obs_encoder_set_audio(aencoder, obs_get_audio());
 
-	/* -----------------------------------*/
-	/* connect encoders/services/outputs  */
-
-	obs_output_set_video_encoder(output, vencoder);
-	obs_output_set_audio_encoder(output, aencoder, 0);
-
-	obs_output_update(output, output_settings);
-
-	obs_output_set_service(output, service);
+	startingBitrate = (int)obs_data_get_int(vencoder_settings, "bitrate");
 
 	/* -----------------------------------*/
-	/* connect signals                    */
-
-	auto on_started = [&]() {
-		std::unique_lock<std::mutex> lock(m);
-		connected = true;
-		stopped = false;
-		cv.notify_one();
-	};
-
-	auto on_stopped = [&]() {
-		const char *output_error = obs_output_get_last_error(output);
-
-		if (output_error == nullptr) {
-			std::unique_lock<std::mutex> lock(m);
-			connected = false;
-			stopped = true;
-			cv.notify_one();
-		} else {
-			errorOnStop = true;
-		}
-	};
-
-	auto on_deactivate = [&]() { cv.notify_one(); };
-
-	using on_started_t = decltype(on_started);
-	using on_stopped_t = decltype(on_stopped);
-	using on_deactivate_t = decltype(on_deactivate);
-
-	auto pre_on_started = [](void *data, calldata_t *) {
-		on_started_t &on_started = *reinterpret_cast<on_started_t *>(data);
-		on_started();
-	};
-
-	auto pre_on_stopped = [](void *data, calldata_t *) {
-		on_stopped_t &on_stopped = *reinterpret_cast<on_stopped_t *>(data);
-		on_stopped();
-	};
-
-	auto pre_on_deactivate = [](void *data, calldata_t *) {
-		on_deactivate_t &on_deactivate = *reinterpret_cast<on_deactivate_t *>(data);
-		on_deactivate();
-	};
+	/* probe every server at once         */
+
+	uint64_t phaseStart = os_gettime_ns();
+
+	std::vector<std::string> urls;
+	for (auto &server : servers)
+		urls.push_back(server.address);
+
+	std::vector<osn::RtmpProbe::Result> probes = osn::RtmpProbe::ProbeAll(urls, bandwidthProbeTimeoutMs);
+	for (size_t i = 0; i < servers.size(); i++)
+		servers[i].probe = probes[i];
+
+	int probeMs = elapsed_ms(phaseStart);
+
+	// Fastest handshake first. Servers the probe could not reach stay at the
+	// end but are still tested if there are not enough others, since the
+	// output may get through where a bare socket can't (e.g. "auto").
+	std::vector<ServerInfo *> candidates;
+	for (auto &server : servers)
+		candidates.push_back(&server);
+	std::stable_sort(candidates.begin(), candidates.end(), [](const ServerInfo *a, const ServerInfo *b) {
+		if (a->probe.reachable != b->probe.reachable)
+			return a->probe.reachable;
+		int aMs = a->probe.handshakeMs >= 0 ? a->probe.handshakeMs : a->probe.connectMs;
+		int bMs = b->probe.handshakeMs >= 0 ? b->probe.handshakeMs : b->probe.connectMs;
+		return aMs < bMs;
+	});
+	if (candidates.size() > bandwidthMaxThroughputTests)
+		candidates.resize(std::max<size_t>(bandwidthMaxThroughputTests, 1));
 
-	signal_handler *sh = obs_output_get_signal_handler(output);
-	signal_handler_connect(sh, "start", pre_on_started, &on_started);
-	signal_handler_connect(sh, "stop", pre_on_stopped, &on_stopped);
-	signal_handler_connect(sh, "deactivate", pre_on_deactivate, &on_deactivate);
+	eventsMutex.lock();
+	events.push(AutoConfigInfo("progress", "bandwidth_test", 10));
+	eventsMutex.unlock();
 
 	/* -----------------------------------*/
-	/* test servers                       */
+	/* test throughput of the best ones   */
 
-	int bestBitrate = 0;
-	int bestMS = 0x7FFFFFFF;
-	std::string bestServer;
-	std::string bestServerName;
-	bool success = false;
-
-	if (serverName.compare("") != 0) {
-		ServerInfo info(serverName.c_str(), server.c_str());
-
-		if (EvaluateBandwidth(info, connected, stopped, success, errorOnStop, service_settings, service, output, vencoder_settings) < 0) {
-			eventsMutex.lock();
-			events.push(AutoConfigInfo("error", "invalid_stream_settings", 0));
-			eventsMutex.unlock();
-			gotError = true;
-		} else {
-			bestServer = info.address;
-			bestServerName = info.name;
-			bestBitrate = info.bitrate;
+	phaseStart = os_gettime_ns();
 
-			eventsMutex.lock();
-			events.push(AutoConfigInfo("progress", "bandwidth_test", 100));
-			eventsMutex.unlock();
+	bool success = false;
+	if (bandwidthParallel) {
+		std::vector<std::unique_ptr<ThroughputTest>> tests;
+		for (size_t i = 0; i < candidates.size(); i++) {
+			tests.push_back(std::make_unique<ThroughputTest>(*candidates[i]));
+			tests.back()->Start(i, serverType, service_settings, output_settings, vencoder, aencoder);
 		}
+		success = RunThroughputTests(tests);
 	} else {
-		for (size_t i = 0; i < servers.size(); i++) {
-			EvaluateBandwidth(servers[i], connected, stopped, success, errorOnStop, service_settings, service, output, vencoder_settings);
+		for (size_t i = 0; i < candidates.size(); i++) {
+			std::vector<std::unique_ptr<ThroughputTest>> tests;
+			tests.push_back(std::make_unique<ThroughputTest>(*candidates[i]));
+			tests.back()->Start(i, serverType, service_settings, output_settings, vencoder, aencoder);
+			success |= RunThroughputTests(tests);
+
 			eventsMutex.lock();
-			events.push(AutoConfigInfo("progress", "bandwidth_test", (double)(i + 1) * 100 / servers.size()));
+			events.push(AutoConfigInfo("progress", "bandwidth_test", 10 + (double)(i + 1) * 90 / candidates.size()));
 			eventsMutex.unlock();
 		}
 	}
 
-	if (!success && !gotError) {
+	int throughputMs = elapsed_ms(phaseStart);
+
+	if (!success) {
 		eventsMutex.lock();
 		events.push(AutoConfigInfo("error", "invalid_stream_settings", 0));
 		eventsMutex.unlock();
 		gotError = true;
 	}
 
+	int bestBitrate = 0;
+	int bestMS = 0x7FFFFFFF;
+	ServerInfo best;
+
 	if (!gotError) {
-		for (auto &server : servers) {
-			bool close = abs(server.bitrate - bestBitrate) < 400;
-
-			if ((!close && server.bitrate > bestBitrate) || (close && server.ms < bestMS)) {
-				bestServer = server.address;
-				bestServerName = server.name;
-				bestBitrate = server.bitrate;
-				bestMS = server.ms;
+		for (auto server : candidates) {
+			bool close = abs(server->bitrate - bestBitrate) < 400;
+
+			if ((!close && server->bitrate > bestBitrate) || (close && server->ms < bestMS)) {
+				best = *server;
+				bestBitrate = server->bitrate;
+				bestMS = server->ms;
 			}
 		}
-		server = bestServer;
-		serverName = bestServerName;
+
+		// Parallel outputs split the uplink between them, their sum is what a
+		// single stream would get.
+		if (bandwidthParallel) {
+			int capacity = 0;
+			for (auto server : candidates)
+				capacity += server->measuredKbps;
+			bestBitrate = capacity < (startingBitrate * 75 / 100) ? capacity * 70 / 100 : startingBitrate;
+		}
+
+		target->Select(best);
 		idealBitrate = bestBitrate;
 	}
 
-	obs_output_release(output);
+	OBSData results = obs_data_create();
+	obs_data_release(results);
+	obs_data_set_string(results, "target", target->GetName());
+	obs_data_set_bool(results, "success", !gotError);
+	obs_data_set_bool(results, "parallel", bandwidthParallel);
+	obs_data_set_int(results, "maxThroughputTests", bandwidthMaxThroughputTests);
+	obs_data_set_int(results, "startingBitrate", awstartingBitrate);
+	obs_data_set_int(results, "bitrate", gotError ? 0 : bestBitrate);
+	obs_data_set_string(results, "server", gotError ? "" : best.name.c_str());
+	target->Describe(results);
+
+	OBSData phases = obs_data_create();
+	obs_data_release(phases);
+	obs_data_set_int(phases, "probeMs", probeMs);
+	obs_data_set_int(phases, "throughputMs", throughputMs);
+	obs_data_set_int(phases, "totalMs", elapsed_ms(testStart));
+	obs_data_set_obj(results, "phases", phases);
+
+	obs_data_array_t *serverResults = obs_data_array_create();
+	for (auto &server : servers) {
+		obs_data_t *item = obs_data_create();
+		obs_data_set_string(item, "name", server.name.c_str());
+		obs_data_set_string(item, "address", server.address.c_str());
+		obs_data_set_bool(item, "reachable", server.probe.reachable);
+		obs_data_set_int(item, "connectMs", server.probe.connectMs);
+		obs_data_set_int(item, "handshakeMs", server.probe.handshakeMs);
+		obs_data_set_bool(item, "tested", server.tested);
+		obs_data_set_int(item, "measuredKbps", server.measuredKbps);
+		obs_data_set_int(item, "bitrate", server.bitrate);
+		obs_data_set_int(item, "ms", server.ms);
+		obs_data_set_int(item, "durationMs", server.durationMs);
+		obs_data_set_bool(item, "converged", server.converged);
+		obs_data_array_push_back(serverResults, item);
+		obs_data_release(item);
+	}
+	obs_data_set_array(results, "servers", serverResults);
+	obs_data_array_release(serverResults);
+
+	blog(LOG_INFO, "[AUTOCONFIG] Bandwidth test: probed %zu servers in %dms, tested %zu in %dms", servers.size(), probeMs, candidates.size(),
+	     throughputMs);
+
+	{
+		std::unique_lock<std::mutex> ulock(bandwidthMutex);
+		bandwidthData = results;
+	}
+
 	obs_encoder_release(vencoder);
 	obs_encoder_release(aencoder);
 	obs_service_release(service);
@@ -1170,29 +1620,32 @@ void autoConfig::TestStreamEncoderThread()
 
 	TestHardwareEncoding();
 
-	if (!softwareTested) {
-		if (!preferHardware || !hardwareEncodingAvailable) {
-			if (!TestSoftwareEncoding()) {
-				return;
+	// A completed encoder benchmark already picked the encoder, resolution and frame rate.
+	if (!benchmarkApplied) {
+		if (!softwareTested) {
+			if (!preferHardware || !hardwareEncodingAvailable) {
+				if (!TestSoftwareEncoding()) {
+					return;
+				}
 			}
 		}
-	}
-
-	if (preferHardware && !softwareTested && hardwareEncodingAvailable)
-		FindIdealHardwareResolution();
 
-	if (!softwareTested) {
-		if (nvencAvailable || jimnvencAvailable)
-			streamingEncoder = Encoder::NVENC;
-		else if (qsvAvailable)
-			streamingEncoder = Encoder::QSV;
-		else if (vceAvailable)
-			streamingEncoder = Encoder::AMD;
-		// HW encoding seems to not be stable on Mac
-		// else if (appleHWAvailable)
-		// 	streamingEncoder = Encoder::appleHW;
-	} else {
-		streamingEncoder = Encoder::x264;
+		if (preferHardware && !softwareTested && hardwareEncodingAvailable)
+			FindIdealHardwareResolution();
+
+		if (!softwareTested) {
+			if (nvencAvailable || jimnvencAvailable)
+				streamingEncoder = Encoder::NVENC;
+			else if (qsvAvailable)
+				streamingEncoder = Encoder::QSV;
+			else if (vceAvailable)
+				streamingEncoder = Encoder::AMD;
+			// HW encoding seems to not be stable on Mac
+			// else if (appleHWAvailable)
+			// 	streamingEncoder = Encoder::appleHW;
+		} else {
+			streamingEncoder = Encoder::x264;
+		}
 	}
 
 	eventsMutex.lock();
@@ -1208,13 +1661,13 @@ void autoConfig::TestRecordingEncoderThread()
 
 	TestHardwareEncoding();
 
-	if (!hardwareEncodingAvailable && !softwareTested) {
+	if (!hardwareEncodingAvailable && !softwareTested && !benchmarkApplied) {
 		if (!TestSoftwareEncoding()) {
 			return;
 		}
 	}
 
-	if (type == Type::Recording && hardwareEncodingAvailable)
+	if (type == Type::Recording && hardwareEncodingAvailable && !benchmarkApplied)
 		FindIdealHardwareResolution();
 
 	recordingQuality = Quality::High;
@@ -1285,6 +1738,176 @@ inline const char *GetEncoderDisplayName(Encoder enc)
 	}
 };
 
+void autoConfig::EncoderBenchmarkThread()
+{
+	eventsMutex.lock();
+	events.push(AutoConfigInfo("starting_step", "encoder_benchmark", 0));
+	eventsMutex.unlock();
+
+	TestHardwareEncoding();
+
+	std::vector<Encoder> encoders = {Encoder::x264};
+	if (nvencAvailable || jimnvencAvailable)
+		encoders.push_back(Encoder::NVENC);
+	if (qsvAvailable)
+		encoders.push_back(Encoder::QSV);
+	if (vceAvailable)
+		encoders.push_back(Encoder::AMD);
+
+	std::vector<std::string> encoderIds;
+	for (auto encoder : encoders)
+		encoderIds.push_back(GetEncoderId(encoder));
+
+	/* -----------------------------------*/
+	/* same ladder as the software test   */
+
+	std::vector<osn::EncoderBenchmark::Point> points;
+	auto addPoint = [&](long double div, int fps_num, int fps_den) {
+		if (!fps_num || !fps_den) {
+			fps_num = specificFPSNum;
+			fps_den = specificFPSDen;
+		}
+
+		// NV12 needs even dimensions.
+		uint32_t cx = uint32_t((long double)baseResolutionCX / div) & ~1u;
+		uint32_t cy = uint32_t((long double)baseResolutionCY / div) & ~1u;
+		points.push_back({cx, cy, uint32_t(fps_num), uint32_t(fps_den)});
+	};
+
+	const long double divs[] = {1.0, 1.5, 1.0 / 0.6, 2.0, 2.25};
+	for (long double div : divs) {
+		if (specificFPSNum && specificFPSDen) {
+			addPoint(div, 0, 0);
+		} else {
+			addPoint(div, 60, 1);
+			addPoint(div, 30, 1);
+		}
+	}
+
+	osn::EncoderBenchmark::Options options;
+	options.secondsPerPoint = benchmarkSecondsPerPoint;
+	options.bitrate = idealBitrate;
+	options.recording = type == Type::Recording;
+
+	std::vector<osn::EncoderBenchmark::Result> results = osn::EncoderBenchmark::Run(encoderIds, points, options, [](int percentage) {
+		eventsMutex.lock();
+		events.push(AutoConfigInfo("progress", "encoder_benchmark", percentage));
+		eventsMutex.unlock();
+
+		std::unique_lock<std::mutex> ul(m);
+		return !cancel;
+	});
+
+	{
+		std::unique_lock<std::mutex> ul(m);
+		if (cancel) {
+			eventsMutex.lock();
+			events.push(AutoConfigInfo("stopping_step", "encoder_benchmark", 100));
+			eventsMutex.unlock();
+			return;
+		}
+	}
+
+	/* -----------------------------------*/
+	/* find preferred settings            */
+
+	// Best sustained point of each encoder, walking the ladder from the largest
+	// resolution down as the software test does.
+	auto findBest = [&](const std::string &encoderId, const osn::EncoderBenchmark::Result **best) {
+		std::vector<const osn::EncoderBenchmark::Result *> passed;
+		for (auto &result : results) {
+			if (result.encoder != encoderId || !result.sustained)
+				continue;
+
+			const osn::EncoderBenchmark::Point &point = result.point;
+			if (!options.recording) {
+				int est = int(EstimateMinBitrate(point.width, point.height, point.fpsNum, point.fpsDen));
+				if (est > idealBitrate)
+					continue;
+			}
+			passed.push_back(&result);
+		}
+
+		if (passed.empty())
+			return false;
+
+		int minArea = 960 * 540 + 1000;
+		if (!specificFPSNum && preferHighFPS && passed.size() > 1) {
+			const osn::EncoderBenchmark::Point &point1 = passed[0]->point;
+			const osn::EncoderBenchmark::Point &point2 = passed[1]->point;
+			if (point1.fpsNum == 30 && point2.fpsNum == 60 && int(point2.width * point2.height) >= minArea)
+				passed.erase(passed.begin());
+		}
+
+		*best = passed.front();
+		return true;
+	};
+
+	Encoder chosenEncoder = Encoder::x264;
+	const osn::EncoderBenchmark::Result *chosen = nullptr;
+	const osn::EncoderBenchmark::Result *softwareBest = nullptr;
+	findBest(GetEncoderId(Encoder::x264), &softwareBest);
+
+	for (size_t idx = 1; idx < encoders.size() && !chosen; idx++) {
+		const osn::EncoderBenchmark::Result *hardwareBest = nullptr;
+		if (!findBest(encoderIds[idx], &hardwareBest))
+			continue;
+		if (preferHardware || !softwareBest) {
+			chosenEncoder = encoders[idx];
+			chosen = hardwareBest;
+		}
+	}
+
+	if (!chosen)
+		chosen = softwareBest;
+
+	std::unique_lock<std::mutex> ulock(benchmarkMutex);
+	benchmarkData = osn::EncoderBenchmark::ToData(results, options);
+
+	if (!chosen) {
+		blog(LOG_WARNING, "[ENCODER_BENCHMARK] No encoder sustained any of the tested points");
+		benchmarkApplied = false;
+	} else {
+		streamingEncoder = chosenEncoder;
+		idealResolutionCX = chosen->point.width;
+		idealResolutionCY = chosen->point.height;
+
+		if (idealResolutionCX * idealResolutionCY > 1280 * 720) {
+			idealResolutionCX = 1280;
+			idealResolutionCY = 720;
+		}
+
+		idealFPSNum = chosen->point.fpsNum;
+		idealFPSDen = chosen->point.fpsDen;
+
+		long double fUpperBitrate = EstimateUpperBitrate(chosen->point.width, chosen->point.height, chosen->point.fpsNum, chosen->point.fpsDen);
+		int upperBitrate = int(floor(fUpperBitrate / 50.0l) * 50.0l);
+		if (streamingEncoder != Encoder::x264) {
+			upperBitrate *= 114;
+			upperBitrate /= 100;
+		}
+		if (idealBitrate > upperBitrate)
+			idealBitrate = upperBitrate;
+
+		OBSData recommendation = obs_data_create();
+		obs_data_release(recommendation);
+		obs_data_set_string(recommendation, "encoder", GetEncoderId(streamingEncoder));
+		obs_data_set_int(recommendation, "width", idealResolutionCX);
+		obs_data_set_int(recommendation, "height", idealResolutionCY);
+		obs_data_set_int(recommendation, "fpsNum", idealFPSNum);
+		obs_data_set_int(recommendation, "fpsDen", idealFPSDen);
+		obs_data_set_int(recommendation, "bitrate", idealBitrate);
+		obs_data_set_obj(benchmarkData, "recommendation", recommendation);
+
+		benchmarkApplied = true;
+	}
+	ulock.unlock();
+
+	eventsMutex.lock();
+	events.push(AutoConfigInfo("stopping_step", "encoder_benchmark", 100));
+	eventsMutex.unlock();
+}
+
 bool autoConfig::CheckSettings(void)
 {
 	OBSData settings = obs_data_create();
@@ -38,6 +38,11 @@ void StartCheckSettings(void *data, const int64_t id, const std::vector<ipc::val
 void StartSetDefaultSettings(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 void StartSaveStreamSettings(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 void StartSaveSettings(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+void StartEncoderBenchmark(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+void GetEncoderBenchmarkResults(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+void SetBandwidthTestTarget(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+void SetBandwidthTestOptions(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+void GetBandwidthTestResults(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 void TerminateAutoConfig(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 void Query(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 
@@ -47,6 +52,7 @@ bool TestSoftwareEncoding();
 void TestBandwidthThread();
 void TestStreamEncoderThread();
 void TestRecordingEncoderThread();
+void EncoderBenchmarkThread();
 void SaveStreamSettings();
 void SaveSettings();
 bool CheckSettings();
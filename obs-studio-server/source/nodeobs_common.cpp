@@ -25,6 +25,7 @@
 #include <graphics/matrix4.h>
 
 #include "osn-error.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 #include "osn-video.hpp"
 
@@ -39,6 +40,61 @@ std::thread *windowMessage = NULL;
 ipc::server *g_srv;
 bool displayCreated = false;
 
+// Resize and move come on the client's realtime lane and can overtake the
+// create call of their display, which is sent on the standard lane. They are
+// kept here and applied once the display exists. Guarded by displaysMutex.
+struct PendingGeometry {
+	bool hasSize = false;
+	uint32_t cx = 0;
+	uint32_t cy = 0;
+	bool hasPosition = false;
+	uint32_t x = 0;
+	uint32_t y = 0;
+};
+static std::map<std::string, PendingGeometry> pendingGeometry;
+
+static void ResizeDisplay(OBS::Display *display, uint32_t cx, uint32_t cy)
+{
+	blog(LOG_INFO, ">> OBS_content::OBS_content_resizeDisplay() width: %u; height: %u", cx, cy);
+
+	display->m_gsInitData.cx = cx;
+	display->m_gsInitData.cy = cy;
+
+#ifdef WIN32
+	display->SetSize(display->m_gsInitData.cx, display->m_gsInitData.cy);
+#else
+	// Resize Display
+	obs_display_resize(display->m_display, display->m_gsInitData.cx, display->m_gsInitData.cy);
+
+	// Store new size.
+	display->UpdatePreviewArea();
+#endif
+}
+
+static void MoveDisplay(OBS::Display *display, uint32_t x, uint32_t y)
+{
+	display->m_position.first = x;
+	display->m_position.second = y;
+
+	display->SetPosition(x, y);
+}
+
+static void ApplyPendingGeometry(const std::string &key)
+{
+	auto pending = pendingGeometry.find(key);
+	if (pending == pendingGeometry.end())
+		return;
+
+	auto found = displays.find(key);
+	if (found != displays.end() && found->second) {
+		if (pending->second.hasSize)
+			ResizeDisplay(found->second, pending->second.cx, pending->second.cy);
+		if (pending->second.hasPosition)
+			MoveDisplay(found->second, pending->second.x, pending->second.y);
+	}
+	pendingGeometry.erase(pending);
+}
+
 /* A lot of the sceneitem functionality is a lazy copy-pasta from the Qt UI. */
 // https://github.com/jp9000/obs-studio/blob/master/UI/window-basic-main.cpp#L4888
 static void GetItemBox(obs_sceneitem_t *item, vec3 &tl, vec3 &br)
@@ -172,6 +228,9 @@ void OBS_content::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("OBS_content_getDisplayPreviewSize", std::vector<ipc::type>{ipc::type::String},
 							       OBS_content_getDisplayPreviewSize));
 
+	cls->register_function(std::make_shared<ipc::function>("OBS_content_getDisplayOverlayStats", std::vector<ipc::type>{ipc::type::String},
+							       OBS_content_getDisplayOverlayStats));
+
 	cls->register_function(std::make_shared<ipc::function>("OBS_content_createSourcePreviewDisplay",
 							       std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String, ipc::type::String,
 										      ipc::type::UInt32, ipc::type::UInt64},
@@ -215,10 +274,19 @@ void OBS_content::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("OBS_content_setDrawRotationHandle", std::vector<ipc::type>{ipc::type::String, ipc::type::Int32},
 							       OBS_content_setDrawRotationHandle));
 
+	cls->register_function(std::make_shared<ipc::function>("OBS_content_setDisplayRenderPolicy",
+							       std::vector<ipc::type>{ipc::type::String, ipc::type::UInt32, ipc::type::Double,
+										      ipc::type::Int32},
+							       OBS_content_setDisplayRenderPolicy));
+
+	cls->register_function(std::make_shared<ipc::function>("OBS_content_getDisplayRenderStats", std::vector<ipc::type>{ipc::type::String},
+							       OBS_content_getDisplayRenderStats));
+
 	cls->register_function(
 		std::make_shared<ipc::function>("OBS_content_createIOSurface", std::vector<ipc::type>{ipc::type::String}, OBS_content_createIOSurface));
 
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 	g_srv = &srv;
 }
 
@@ -245,6 +313,10 @@ void OBS_content::OBS_content_setDayTheme(void *data, const int64_t id, const st
 
 void OBS_content::OBS_content_createDisplay(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
+	if (utility::IsHeadless()) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Displays are not available in headless mode.");
+	}
+
 	std::scoped_lock lock(displaysMutex);
 
 	uint64_t windowHandle = args[0].value_union.ui64;
@@ -287,6 +359,7 @@ void OBS_content::OBS_content_createDisplay(void *data, const int64_t id, const
 		OBS::Display *display = new OBS::Display(windowHandle, mode, args[3].value_union.i32, canvas);
 		displays.insert_or_assign(args[1].value_str, display);
 #endif
+		ApplyPendingGeometry(args[1].value_str);
 
 		// device rebuild functionality available only with D3D
 #ifdef _WIN32
@@ -331,6 +404,7 @@ void OBS_content::OBS_content_destroyDisplay(void *data, const int64_t id, const
 
 	delete found->second;
 	displays.erase(found);
+	pendingGeometry.erase(args[0].value_str);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
@@ -346,10 +420,15 @@ void OBS_content::OBS_content_shutdownDisplays()
 		delete itr->second;
 		displays.erase(itr);
 	}
+	pendingGeometry.clear();
 }
 
 void OBS_content::OBS_content_createSourcePreviewDisplay(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
+	if (utility::IsHeadless()) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Displays are not available in headless mode.");
+	}
+
 	std::scoped_lock lock(displaysMutex);
 
 	uint64_t windowHandle = args[0].value_union.ui64;
@@ -368,6 +447,7 @@ void OBS_content::OBS_content_createSourcePreviewDisplay(void *data, const int64
 	try {
 		OBS::Display *display = new OBS::Display(windowHandle, OBS_MAIN_VIDEO_RENDERING, args[1].value_str, args[3].value_union.ui32, canvas);
 		displays.insert_or_assign(args[2].value_str, display);
+		ApplyPendingGeometry(args[2].value_str);
 	} catch (const std::exception &e) {
 		std::string message(std::string("Source preview display creation failed: ") + e.what());
 		std::cerr << message << std::endl;
@@ -380,57 +460,48 @@ void OBS_content::OBS_content_createSourcePreviewDisplay(void *data, const int64
 
 void OBS_content::OBS_content_resizeDisplay(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
+	// Runs on the realtime lane, without the call lock.
+	std::scoped_lock lock(displaysMutex);
+
 	auto value = displays.find(args[0].value_str);
 	if (value == displays.end()) {
-		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
-		rval.push_back(ipc::value("Invalid key provided to resizeDisplay: " + args[0].value_str));
+		PendingGeometry &pending = pendingGeometry[args[0].value_str];
+		pending.hasSize = true;
+		pending.cx = args[1].value_union.ui32;
+		pending.cy = args[2].value_union.ui32;
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 		return;
 	}
 
-	OBS::Display *display = value->second;
-
-	blog(LOG_INFO, ">> OBS_content::OBS_content_resizeDisplay() width: %u; height: %u", args[1].value_union.ui32, args[2].value_union.ui32);
-
-	display->m_gsInitData.cx = args[1].value_union.ui32;
-	display->m_gsInitData.cy = args[2].value_union.ui32;
-
-#ifdef WIN32
-	display->SetSize(display->m_gsInitData.cx, display->m_gsInitData.cy);
-#else
-	// Resize Display
-	obs_display_resize(display->m_display, display->m_gsInitData.cx, display->m_gsInitData.cy);
-
-	// Store new size.
-	display->UpdatePreviewArea();
-#endif
+	ResizeDisplay(value->second, args[1].value_union.ui32, args[2].value_union.ui32);
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
 }
 
 void OBS_content::OBS_content_moveDisplay(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
+	// Runs on the realtime lane, without the call lock.
+	std::scoped_lock lock(displaysMutex);
+
 	auto value = displays.find(args[0].value_str);
 	if (value == displays.end()) {
-		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
-		rval.push_back(ipc::value("Invalid key provided to moveDisplay: " + args[0].value_str));
+		PendingGeometry &pending = pendingGeometry[args[0].value_str];
+		pending.hasPosition = true;
+		pending.x = args[1].value_union.ui32;
+		pending.y = args[2].value_union.ui32;
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 		return;
 	}
 
-	OBS::Display *display = value->second;
-
-	int x = args[1].value_union.ui32;
-	int y = args[2].value_union.ui32;
-
-	display->m_position.first = x;
-	display->m_position.second = y;
-
-	display->SetPosition(x, y);
+	MoveDisplay(value->second, args[1].value_union.ui32, args[2].value_union.ui32);
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
 }
 
 void OBS_content::OBS_content_setPaddingSize(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
+	std::scoped_lock lock(displaysMutex);
+
 	// Find Display
 	auto it = displays.find(args[0].value_str);
 	if (it == displays.end()) {
@@ -447,6 +518,8 @@ void OBS_content::OBS_content_setPaddingSize(void *data, const int64_t id, const
 
 void OBS_content::OBS_content_setPaddingColor(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
+	std::scoped_lock lock(displaysMutex);
+
 	union {
 		uint32_t rgba;
 		uint8_t c[4];
@@ -478,6 +551,8 @@ void OBS_content::OBS_content_setPaddingColor(void *data, const int64_t id, cons
 
 void OBS_content::OBS_content_setBackgroundColor(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
+	std::scoped_lock lock(displaysMutex);
+
 	union {
 		uint32_t rgba;
 		uint8_t c[4];
@@ -509,6 +584,8 @@ void OBS_content::OBS_content_setBackgroundColor(void *data, const int64_t id, c
 
 void OBS_content::OBS_content_setOutlineColor(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
+	std::scoped_lock lock(displaysMutex);
+
 	union {
 		uint32_t rgba;
 		uint8_t c[4];
@@ -545,6 +622,8 @@ void OBS_content::OBS_content_setOutlineColor(void *data, const int64_t id, cons
 
 void OBS_content::OBS_content_setCropOutlineColor(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
+	std::scoped_lock lock(displaysMutex);
+
 	union {
 		uint32_t rgba;
 		uint8_t c[4];
@@ -575,6 +654,8 @@ void OBS_content::OBS_content_setCropOutlineColor(void *data, const int64_t id,
 
 void OBS_content::OBS_content_setShouldDrawUI(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
+	std::scoped_lock lock(displaysMutex);
+
 	// Find Display
 	auto it = displays.find(args[0].value_str);
 	if (it == displays.end()) {
@@ -590,6 +671,8 @@ void OBS_content::OBS_content_setShouldDrawUI(void *data, const int64_t id, cons
 
 void OBS_content::OBS_content_getDisplayPreviewOffset(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
+	std::scoped_lock lock(displaysMutex);
+
 	auto value = displays.find(args[0].value_str);
 	if (value == displays.end()) {
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
@@ -609,6 +692,8 @@ void OBS_content::OBS_content_getDisplayPreviewOffset(void *data, const int64_t
 
 void OBS_content::OBS_content_getDisplayPreviewSize(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
+	std::scoped_lock lock(displaysMutex);
+
 	auto value = displays.find(args[0].value_str);
 	if (value == displays.end()) {
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
@@ -626,8 +711,33 @@ void OBS_content::OBS_content_getDisplayPreviewSize(void *data, const int64_t id
 	AUTO_DEBUG;
 }
 
+void OBS_content::OBS_content_getDisplayOverlayStats(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	std::scoped_lock lock(displaysMutex);
+
+	auto value = displays.find(args[0].value_str);
+	if (value == displays.end()) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Invalid key provided to getDisplayOverlayStats: " + args[0].value_str));
+		return;
+	}
+
+	OBS::Display::OverlayStats stats = value->second->GetOverlayStats();
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(stats.frames));
+	rval.push_back(ipc::value(stats.totalTimeNs));
+	rval.push_back(ipc::value(stats.maxTimeNs));
+	rval.push_back(ipc::value(stats.uploadedBytes));
+	rval.push_back(ipc::value(stats.drawCalls));
+	rval.push_back(ipc::value(stats.cachedFrames));
+	AUTO_DEBUG;
+}
+
 void OBS_content::OBS_content_setDrawGuideLines(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
+	std::scoped_lock lock(displaysMutex);
+
 	// Find Display
 	auto it = displays.find(args[0].value_str);
 	if (it == displays.end()) {
@@ -642,6 +752,8 @@ void OBS_content::OBS_content_setDrawGuideLines(void *data, const int64_t id, co
 
 void OBS_content::OBS_content_setDrawRotationHandle(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
+	std::scoped_lock lock(displaysMutex);
+
 	// Find Display
 	auto it = displays.find(args[0].value_str);
 	if (it == displays.end()) {
@@ -654,8 +766,53 @@ void OBS_content::OBS_content_setDrawRotationHandle(void *data, const int64_t id
 	AUTO_DEBUG;
 }
 
+void OBS_content::OBS_content_setDisplayRenderPolicy(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	std::scoped_lock lock(displaysMutex);
+
+	// Find Display
+	auto it = displays.find(args[0].value_str);
+	if (it == displays.end()) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Display key is not valid!"));
+		return;
+	}
+
+	OBS::Display::RenderPolicy policy;
+	policy.maxFps = args[1].value_union.ui32;
+	policy.renderScale = float(args[2].value_union.fp64);
+	policy.pauseWhenHidden = (bool)args[3].value_union.i32;
+	it->second->SetRenderPolicy(policy);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void OBS_content::OBS_content_getDisplayRenderStats(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	std::scoped_lock lock(displaysMutex);
+
+	// Find Display
+	auto it = displays.find(args[0].value_str);
+	if (it == displays.end()) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Display key is not valid!"));
+		return;
+	}
+
+	OBS::Display::RenderStats stats = it->second->GetRenderStats();
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(stats.renderedFrames));
+	rval.push_back(ipc::value(stats.skippedFrames));
+	rval.push_back(ipc::value((uint32_t)stats.paused));
+	AUTO_DEBUG;
+}
+
 void OBS_content::OBS_content_createIOSurface(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
+	std::scoped_lock lock(displaysMutex);
+
 #ifdef __APPLE__
 	// Find Display
 	auto it = displays.find(args[0].value_str);
@@ -34,6 +34,10 @@ std::vector<std::pair<std::string, std::pair<uint32_t, uint32_t>>> sourcesSize;
 extern std::string currentScene; /* defined in OBS_content.cpp */
 
 static const uint32_t grayPaddingArea = 10ul;
+// Room for 64 glyphs, grown on demand. Only the used part is uploaded each frame.
+static const uint32_t textInitialVertices = 6 * 64;
+// Enough for a handful of selected items, grown on demand.
+static const uint32_t overlayInitialVertices = 1024;
 std::mutex OBS::Display::m_displayMtx;
 bool OBS::Display::m_dayTheme = false;
 
@@ -291,88 +295,31 @@ OBS::Display::Display()
 
 		m_gsSolidEffect = obs_get_base_effect(OBS_EFFECT_SOLID);
 
+		// Overlay shapes, transformed on the CPU and batched every frame.
+		m_overlay = std::make_unique<GS::OverlayBatch>(overlayInitialVertices);
+
+		m_leftSolidOutline.Add(0.0f, 0.0f);
+		m_leftSolidOutline.Add(0.0f, 1.0f);
+		m_topSolidOutline.Add(0.0f, 0.0f);
+		m_topSolidOutline.Add(1.0f, 0.0f);
+		m_rightSolidOutline.Add(1.0f, 0.0f);
+		m_rightSolidOutline.Add(1.0f, 1.0f);
+		m_bottomSolidOutline.Add(0.0f, 1.0f);
+		m_bottomSolidOutline.Add(1.0f, 1.0f);
+
+		m_handleBox.Add(0, 0);
+		m_handleBox.Add(1, 0);
+		m_handleBox.Add(1, 1);
+		m_handleBox.Add(0, 1);
+		m_handleBox.Add(0, 0);
+
+		m_handleSquare.Add(0, 0);
+		m_handleSquare.Add(1, 0);
+		m_handleSquare.Add(0, 1);
+		m_handleSquare.Add(1, 1);
+
+		// Background
 		GS::Vertex v(nullptr, nullptr, nullptr, nullptr, nullptr);
-
-		// Left solid outline
-		m_leftSolidOutline = std::make_unique<GS::VertexBuffer>(2);
-		m_leftSolidOutline->Resize(2);
-		v = m_leftSolidOutline->At(0);
-		vec3_set(v.position, 0.0f, 0.0f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_leftSolidOutline->At(1);
-		vec3_set(v.position, 0.0f, 1.0f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		m_leftSolidOutline->Update();
-
-		// Top solid outline
-		m_topSolidOutline = std::make_unique<GS::VertexBuffer>(2);
-		m_topSolidOutline->Resize(2);
-		v = m_topSolidOutline->At(0);
-		vec3_set(v.position, 0.0f, 0.0f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_topSolidOutline->At(1);
-		vec3_set(v.position, 1.0f, 0.0f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		m_topSolidOutline->Update();
-
-		// Right solid outline
-		m_rightSolidOutline = std::make_unique<GS::VertexBuffer>(2);
-		m_rightSolidOutline->Resize(2);
-		v = m_rightSolidOutline->At(0);
-		vec3_set(v.position, 1.0f, 0.0f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_rightSolidOutline->At(1);
-		vec3_set(v.position, 1.0f, 1.0f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		m_rightSolidOutline->Update();
-
-		// Bottom solid outline
-		m_bottomSolidOutline = std::make_unique<GS::VertexBuffer>(2);
-		m_bottomSolidOutline->Resize(2);
-		v = m_bottomSolidOutline->At(0);
-		vec3_set(v.position, 0.0f, 1.0f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_bottomSolidOutline->At(1);
-		vec3_set(v.position, 1.0f, 1.0f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		m_bottomSolidOutline->Update();
-
-		// Crop effect outline
-		m_cropOutline = std::make_unique<GS::VertexBuffer>(4);
-		m_cropOutline->Resize(4);
-
-		m_boxLine = std::make_unique<GS::VertexBuffer>(6);
-		m_boxLine->Resize(6);
-		v = m_boxLine->At(0);
-		vec3_set(v.position, 0, 0, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_boxLine->At(1);
-		vec3_set(v.position, 1, 0, 0);
-		vec4_set(v.uv[0], 1, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_boxLine->At(2);
-		vec3_set(v.position, 1, 1, 0);
-		vec4_set(v.uv[0], 1, 1, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_boxLine->At(3);
-		vec3_set(v.position, 0, 1, 0);
-		vec4_set(v.uv[0], 0, 1, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_boxLine->At(4);
-		vec3_set(v.position, 0, 0, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		m_boxLine->Update();
-
 		m_boxTris = std::make_unique<GS::VertexBuffer>(4);
 		m_boxTris->Resize(4);
 		v = m_boxTris->At(0);
@@ -394,53 +341,23 @@ OBS::Display::Display()
 		m_boxTris->Update();
 
 		// Rotation handle line
-		m_rotHandleLine = std::make_unique<GS::VertexBuffer>(5);
-		m_rotHandleLine->Resize(5);
-		v = m_rotHandleLine->At(0);
-		vec3_set(v.position, 0.5f - 0.34f / HANDLE_RADIUS, 0.5f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_rotHandleLine->At(1);
-		vec3_set(v.position, 0.5f - 0.34f / HANDLE_RADIUS, -2.0f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_rotHandleLine->At(2);
-		vec3_set(v.position, 0.5f + 0.34f / HANDLE_RADIUS, -2.0f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_rotHandleLine->At(3);
-		vec3_set(v.position, 0.5f + 0.34f / HANDLE_RADIUS, 0.5f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_rotHandleLine->At(4);
-		vec3_set(v.position, 0.5f - 0.34f / HANDLE_RADIUS, 0.5f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		m_rotHandleLine->Update();
+		m_rotHandleLine.Add(0.5f - 0.34f / HANDLE_RADIUS, 0.5f);
+		m_rotHandleLine.Add(0.5f - 0.34f / HANDLE_RADIUS, -2.0f);
+		m_rotHandleLine.Add(0.5f + 0.34f / HANDLE_RADIUS, -2.0f);
+		m_rotHandleLine.Add(0.5f + 0.34f / HANDLE_RADIUS, 0.5f);
+		m_rotHandleLine.Add(0.5f - 0.34f / HANDLE_RADIUS, 0.5f);
 
 		// Rotation handle circle
-		m_rotHandleCircle = std::make_unique<GS::VertexBuffer>(120);
-		m_rotHandleCircle->Resize(120);
 		float angle = 180;
 		for (int i = 0; i < 40; ++i) {
-			v = m_rotHandleCircle->At(i * 3);
-			vec3_set(v.position, sin(RAD(angle)) / 2 + 0.5f, cos(RAD(angle)) / 2 + 0.5f, 0);
-			vec4_set(v.uv[0], 0, 0, 0, 0);
-			*v.color = 0xFFFFFFFF;
+			m_rotHandleCircle.Add(sin(RAD(angle)) / 2 + 0.5f, cos(RAD(angle)) / 2 + 0.5f);
 			angle += 8.75f;
-			v = m_rotHandleCircle->At((i * 3) + 1);
-			vec3_set(v.position, sin(RAD(angle)) / 2 + 0.5f, cos(RAD(angle)) / 2 + 0.5f, 0);
-			vec4_set(v.uv[0], 0, 0, 0, 0);
-			*v.color = 0xFFFFFFFF;
-			v = m_rotHandleCircle->At((i * 3) + 2);
-			vec3_set(v.position, 0.5f, 1.0f, 0);
-			vec4_set(v.uv[0], 0, 0, 0, 0);
-			*v.color = 0xFFFFFFFF;
+			m_rotHandleCircle.Add(sin(RAD(angle)) / 2 + 0.5f, cos(RAD(angle)) / 2 + 0.5f);
+			m_rotHandleCircle.Add(0.5f, 1.0f);
 		}
-		m_rotHandleCircle->Update();
 
 		// Text
-		m_textVertices = new GS::VertexBuffer(65535);
+		m_textVertices = new GS::VertexBuffer(textInitialVertices);
 		m_textEffect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
 		m_textTexture = gs_texture_create_from_file((g_moduleDirectory + "/resources/roboto.png").c_str());
 		if (!m_textTexture) {
@@ -525,6 +442,7 @@ OBS::Display::Display(uint64_t windowHandle, enum obs_video_rendering_mode mode,
 		m_canvas = canvas;
 
 		obs_display_add_draw_callback(m_display, DisplayCallback, this);
+		obs_add_main_rendered_callback(RenderedCallback, this);
 	}
 
 	UpdatePreviewArea();
@@ -545,6 +463,7 @@ OBS::Display::~Display()
 	{
 		std::lock_guard lock(m_displayMtx);
 
+		obs_remove_main_rendered_callback(RenderedCallback, this);
 		obs_display_remove_draw_callback(m_display, DisplayCallback, this);
 
 		if (m_source) {
@@ -577,15 +496,14 @@ OBS::Display::~Display()
 			obs_leave_graphics();
 		}
 
-		m_leftSolidOutline.reset();
-		m_topSolidOutline.reset();
-		m_rightSolidOutline.reset();
-		m_bottomSolidOutline.reset();
-		m_cropOutline.reset();
-		m_boxLine = nullptr;
+		if (m_sourceTexrender) {
+			obs_enter_graphics();
+			gs_texrender_destroy(m_sourceTexrender);
+			obs_leave_graphics();
+		}
+
+		m_overlay.reset();
 		m_boxTris = nullptr;
-		m_rotHandleLine.reset();
-		m_rotHandleCircle.reset();
 
 		if (m_display)
 			obs_display_destroy(m_display);
@@ -883,6 +801,9 @@ static void DrawGlyph(GS::VertexBuffer *vb, float_t x, float_t y, float_t scale,
 
 	GS::Vertex v(nullptr, nullptr, nullptr, nullptr, nullptr);
 	size_t bs = vb->Size();
+	// Skip the glyph rather than fail the frame when the buffer cannot grow.
+	if (bs + 6 > vb->Capacity() && !vb->Reserve(std::max(vb->Capacity() * 2, uint32_t(bs + 6))))
+		return;
 	vb->Resize(uint32_t(bs + 6));
 
 	// Top Left
@@ -923,7 +844,7 @@ inline bool CloseFloat(float a, float b, float epsilon = 0.01)
 	return abs(a - b) <= epsilon;
 }
 
-void OBS::Display::DrawCropOutline(float x1, float y1, float x2, float y2, vec2 scale)
+void OBS::Display::DrawCropOutline(const matrix4 &mtx, float x1, float y1, float x2, float y2, vec2 scale)
 {
 	// This is partially code from OBS Studio. See window-basic-preview.cpp in obs-studio for copyright/license.
 
@@ -934,6 +855,9 @@ void OBS::Display::DrawCropOutline(float x1, float y1, float x2, float y2, vec2
 	float offX = (x2 - x1) / dist;
 	float offY = (y2 - y1) / dist;
 
+	m_cropOutline.x.clear();
+	m_cropOutline.y.clear();
+
 	int l = static_cast<int>(ceil(dist / 15));
 	for (int i = 0; i < l; ++i) {
 		float xx1 = x1 + i * 15 * offX;
@@ -954,87 +878,48 @@ void OBS::Display::DrawCropOutline(float x1, float y1, float x2, float y2, vec2
 			dy = std::max(yy1 + 7.5f * offY, y2);
 		}
 
-		GS::Vertex v(nullptr, nullptr, nullptr, nullptr, nullptr);
-
-		v = m_cropOutline->At(0);
-		vec3_set(v.position, xx1, yy1, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-
-		v = m_cropOutline->At(1);
-		vec3_set(v.position, xx1 + (xSide * (5 / scale.x)), yy1 + (ySide * (5 / scale.y)), 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-
-		v = m_cropOutline->At(2);
-		vec3_set(v.position, dx, dy, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-
-		v = m_cropOutline->At(3);
-		vec3_set(v.position, dx + (xSide * (5 / scale.x)), dy + (ySide * (5 / scale.y)), 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-
-		gs_load_vertexbuffer(m_cropOutline->Update());
-		gs_draw(GS_TRISTRIP, 0, 0);
+		m_cropOutline.Add(xx1, yy1);
+		m_cropOutline.Add(xx1 + (xSide * (5 / scale.x)), yy1 + (ySide * (5 / scale.y)));
+		m_cropOutline.Add(dx, dy);
+		m_cropOutline.Add(dx + (xSide * (5 / scale.x)), dy + (ySide * (5 / scale.y)));
 	}
-}
 
-static void DrawSolidOutline(GS::VertexBuffer *vertexBuffer)
-{
-	gs_load_vertexbuffer(vertexBuffer->Update(false));
-	gs_draw(GS_LINES, 0, 0);
+	m_overlay->AddQuads(mtx, m_cropOutline, m_cropOutlineColor);
 }
 
-inline void DrawBoxAt(OBS::Display *dp, float_t x, float_t y, matrix4 &mtx)
+// Places a unit handle shape centered on (x, y) of the item box, keeping its size in preview pixels.
+inline void GetHandleTransform(OBS::Display *dp, float_t x, float_t y, const matrix4 &mtx, matrix4 &handle)
 {
-	gs_matrix_push();
-
 	vec3 pos = {x, y, 0.0f};
 	vec3_transform(&pos, &pos, &mtx);
 
-	vec3 offset = {-HANDLE_RADIUS, -HANDLE_RADIUS, 0.0f};
-	offset.x *= dp->m_previewToWorldScale.x;
-	offset.y *= dp->m_previewToWorldScale.y;
-
-	gs_matrix_translate(&pos);
-	gs_matrix_translate(&offset);
-	gs_matrix_scale3f(HANDLE_DIAMETER * dp->m_previewToWorldScale.x, HANDLE_DIAMETER * dp->m_previewToWorldScale.y, 1.0f);
-
-	gs_draw(GS_LINESTRIP, 0, 0);
-	gs_matrix_pop();
+	matrix4_identity(&handle);
+	handle.x.x = HANDLE_DIAMETER * dp->m_previewToWorldScale.x;
+	handle.y.y = HANDLE_DIAMETER * dp->m_previewToWorldScale.y;
+	handle.t.x = pos.x - HANDLE_RADIUS * dp->m_previewToWorldScale.x;
+	handle.t.y = pos.y - HANDLE_RADIUS * dp->m_previewToWorldScale.y;
 }
 
-inline void DrawSquareAt(OBS::Display *dp, float_t x, float_t y, matrix4 &mtx)
+inline void DrawBoxAt(OBS::Display *dp, float_t x, float_t y, const matrix4 &mtx, const GS::OverlayBatch::Shape &shape, uint32_t color)
 {
-	gs_matrix_push();
-
-	vec3 pos = {x, y, 0.0f};
-	vec3_transform(&pos, &pos, &mtx);
-
-	vec3 offset = {-HANDLE_RADIUS, -HANDLE_RADIUS, 0.0f};
-	offset.x *= dp->m_previewToWorldScale.x;
-	offset.y *= dp->m_previewToWorldScale.y;
-
-	gs_matrix_translate(&pos);
-	gs_matrix_translate(&offset);
-	gs_matrix_scale3f(HANDLE_DIAMETER * dp->m_previewToWorldScale.x, HANDLE_DIAMETER * dp->m_previewToWorldScale.y, 1.0f);
-
-	gs_draw(GS_TRISTRIP, 0, 0);
-	gs_matrix_pop();
+	matrix4 handle;
+	GetHandleTransform(dp, x, y, mtx, handle);
+	dp->m_overlay->AddLineStrip(handle, shape, color);
 }
 
-inline void DrawGuideline(OBS::Display *dp, bool rot45, float_t x, float_t y, matrix4 &mtx)
+inline void DrawSquareAt(OBS::Display *dp, float_t x, float_t y, const matrix4 &mtx, const GS::OverlayBatch::Shape &shape, uint32_t color)
 {
-	gs_rect rect;
-	rect.x = dp->GetPreviewOffset().first;
-	rect.y = dp->GetPreviewOffset().second;
-	rect.cx = dp->GetPreviewSize().first;
-	rect.cy = dp->GetPreviewSize().second;
+	matrix4 handle;
+	GetHandleTransform(dp, x, y, mtx, handle);
+	dp->m_overlay->AddTriangleStrip(handle, shape, color);
+}
 
-	gs_set_scissor_rect(&rect);
-	gs_matrix_push();
+inline void DrawGuideline(OBS::Display *dp, bool rot45, float_t x, float_t y, const matrix4 &mtx, uint32_t color)
+{
+	// The guide line runs from the edge to the border of the preview. It is
+	// clipped here instead of through a scissor rect so it can share the batch.
+	float_t width = dp->GetPreviewSize().first * dp->m_previewToWorldScale.x;
+	float_t height = dp->GetPreviewSize().second * dp->m_previewToWorldScale.y;
 
 	vec3 center = {0.5, 0.5, 0.0f};
 	vec3_transform(&center, &center, &mtx);
@@ -1046,8 +931,6 @@ inline void DrawGuideline(OBS::Display *dp, bool rot45, float_t x, float_t y, ma
 	vec3_sub(&normal, &center, &pos);
 	vec3_norm(&normal, &normal);
 
-	gs_matrix_translate(&pos);
-
 	vec3 up, dn, lt, rt;
 
 	if (rot45) {
@@ -1062,89 +945,78 @@ inline void DrawGuideline(OBS::Display *dp, bool rot45, float_t x, float_t y, ma
 		rt = {1.0, 0, 0};
 	}
 
+	float_t dirX = 1.0f, dirY = 0.0f;
 	if (vec3_dot(&up, &normal) > 0.707f) {
 		// Dominantly looking up.
-		gs_matrix_rotaa4f(0, 0, 1, RAD(-90.0f));
+		dirX = 0.0f;
+		dirY = -1.0f;
 	} else if (vec3_dot(&dn, &normal) > 0.707f) {
 		// Dominantly looking down.
-		gs_matrix_rotaa4f(0, 0, 1, RAD(90.0f));
-	} else if (vec3_dot(&lt, &normal) > 0.707f) {
-		// Dominantly looking left.
-		gs_matrix_rotaa4f(0, 0, 1, RAD(0.0f));
+		dirX = 0.0f;
+		dirY = 1.0f;
 	} else if (vec3_dot(&rt, &normal) > 0.707f) {
 		// Dominantly looking right.
-		gs_matrix_rotaa4f(0, 0, 1, RAD(180.0f));
+		dirX = -1.0f;
 	}
 
-	gs_matrix_scale3f(65535, 65535, 65535);
-
-	gs_draw(GS_LINES, 0, 2);
-
-	gs_matrix_pop();
-	gs_set_scissor_rect(nullptr);
+	if (dirX != 0.0f) {
+		if (pos.y < 0 || pos.y > height)
+			return;
+		float_t from = std::clamp(pos.x, 0.0f, width);
+		float_t to = (dirX > 0) ? width : 0.0f;
+		if (from != to)
+			dp->m_overlay->AddLine(from, pos.y, to, pos.y, color);
+	} else {
+		if (pos.x < 0 || pos.x > width)
+			return;
+		float_t from = std::clamp(pos.y, 0.0f, height);
+		float_t to = (dirY > 0) ? height : 0.0f;
+		if (from != to)
+			dp->m_overlay->AddLine(pos.x, from, pos.x, to, color);
+	}
 }
 
-void OBS::Display::DrawRotationHandle(float rot, matrix4 &mtx)
+void OBS::Display::DrawRotationHandle(float rot, const matrix4 &mtx)
 {
 	struct vec3 pos;
 	vec3_set(&pos, 0.5f, 0.0f, 0.0f);
 	vec3_transform(&pos, &pos, &mtx);
 
-	gs_load_vertexbuffer(m_rotHandleLine->Update(false));
+	// Same steps the matrix stack used to take, applied to a local matrix.
+	matrix4 handle;
+	matrix4_identity(&handle);
+	matrix4_translate3v_i(&handle, &pos, &handle);
+	matrix4_rotate_aa4f_i(&handle, 0.0f, 0.0f, 1.0f, RAD(rot), &handle);
+	matrix4_translate3f_i(&handle, -HANDLE_RADIUS * 1.5, -HANDLE_RADIUS * 1.5, 0.0f, &handle);
+	matrix4_scale3f_i(&handle, HANDLE_RADIUS * 3, HANDLE_RADIUS * 3, 1.0f, &handle);
 
-	gs_matrix_push();
-	gs_matrix_identity();
-	gs_matrix_translate(&pos);
-
-	gs_matrix_rotaa4f(0.0f, 0.0f, 1.0f, RAD(rot));
-	gs_matrix_translate3f(-HANDLE_RADIUS * 1.5, -HANDLE_RADIUS * 1.5, 0.0f);
-	gs_matrix_scale3f(HANDLE_RADIUS * 3, HANDLE_RADIUS * 3, 1.0f);
-
-	gs_draw(GS_TRISTRIP, 0, 0);
-
-	gs_matrix_translate3f(0.0f, -HANDLE_RADIUS * 0.6, 0.0f);
+	m_overlay->AddTriangleStrip(handle, m_rotHandleLine, m_rotationHandleColor);
 
-	gs_load_vertexbuffer(m_rotHandleCircle->Update(false));
-	gs_draw(GS_TRISTRIP, 0, 0);
-
-	gs_matrix_pop();
+	matrix4_translate3f_i(&handle, 0.0f, -HANDLE_RADIUS * 0.6, 0.0f, &handle);
+	m_overlay->AddTriangleStrip(handle, m_rotHandleCircle, m_rotationHandleColor);
 }
 
-void OBS::Display::DrawOutline(const matrix4 &mtx, const obs_sceneitem_crop &crop, const vec2 &boxScale, gs_eparam_t *color)
+void OBS::Display::DrawOutline(const matrix4 &mtx, const obs_sceneitem_crop &crop, const vec2 &boxScale)
 {
-	gs_matrix_push();
-	gs_matrix_mul(&mtx);
-
-	if (crop.left) {
-		gs_effect_set_vec4(color, &m_cropOutlineColorVec4);
-		DrawCropOutline(0.0f, 0.0f, 0.0f, 1.0f, boxScale);
-	} else {
-		gs_effect_set_vec4(color, &m_outlineColorVec4);
-		DrawSolidOutline(m_leftSolidOutline.get());
-	}
-	if (crop.top) {
-		gs_effect_set_vec4(color, &m_cropOutlineColorVec4);
-		DrawCropOutline(0.0f, 0.0f, 1.0f, 0.0f, boxScale);
-	} else {
-		gs_effect_set_vec4(color, &m_outlineColorVec4);
-		DrawSolidOutline(m_topSolidOutline.get());
-	}
-	if (crop.right) {
-		gs_effect_set_vec4(color, &m_cropOutlineColorVec4);
-		DrawCropOutline(1.0f, 0.0f, 1.0f, 1.0f, boxScale);
-	} else {
-		gs_effect_set_vec4(color, &m_outlineColorVec4);
-		DrawSolidOutline(m_rightSolidOutline.get());
-	}
-	if (crop.bottom) {
-		gs_effect_set_vec4(color, &m_cropOutlineColorVec4);
-		DrawCropOutline(0.0f, 1.0f, 1.0f, 1.0f, boxScale);
-	} else {
-		gs_effect_set_vec4(color, &m_outlineColorVec4);
-		DrawSolidOutline(m_bottomSolidOutline.get());
-	}
-
-	gs_matrix_pop();
+	if (crop.left)
+		DrawCropOutline(mtx, 0.0f, 0.0f, 0.0f, 1.0f, boxScale);
+	else
+		m_overlay->AddLineStrip(mtx, m_leftSolidOutline, m_outlineColor);
+
+	if (crop.top)
+		DrawCropOutline(mtx, 0.0f, 0.0f, 1.0f, 0.0f, boxScale);
+	else
+		m_overlay->AddLineStrip(mtx, m_topSolidOutline, m_outlineColor);
+
+	if (crop.right)
+		DrawCropOutline(mtx, 1.0f, 0.0f, 1.0f, 1.0f, boxScale);
+	else
+		m_overlay->AddLineStrip(mtx, m_rightSolidOutline, m_outlineColor);
+
+	if (crop.bottom)
+		DrawCropOutline(mtx, 0.0f, 1.0f, 1.0f, 1.0f, boxScale);
+	else
+		m_overlay->AddLineStrip(mtx, m_bottomSolidOutline, m_outlineColor);
 }
 
 bool OBS::Display::DrawSelectedSource(obs_scene_t *scene, obs_sceneitem_t *item, void *param)
@@ -1195,10 +1067,6 @@ bool OBS::Display::DrawSelectedSource(obs_scene_t *scene, obs_sceneitem_t *item,
 			return true;
 	}
 
-	vec4 color;
-	gs_effect_t *solid = obs_get_base_effect(OBS_EFFECT_SOLID);
-	gs_eparam_t *solid_color = gs_effect_get_param_by_name(solid, "color");
-
 	float rot = obs_sceneitem_get_rot(item);
 	bool rot45 = (rot == 45.0f || rot == 135.0f || rot == 225.0f || rot == 315.0f);
 
@@ -1215,15 +1083,13 @@ bool OBS::Display::DrawSelectedSource(obs_scene_t *scene, obs_sceneitem_t *item,
 	obs_sceneitem_crop crop;
 	obs_sceneitem_get_crop(item, &crop);
 
-	dp->DrawOutline(boxTransform, crop, boxScale, solid_color);
+	dp->DrawOutline(boxTransform, crop, boxScale);
 
 	if (dp->m_drawGuideLines) {
-		gs_load_vertexbuffer(dp->m_boxLine->Update(false));
-		gs_effect_set_vec4(solid_color, &dp->m_guidelineColorVec4);
-		DrawGuideline(dp, rot45, 0.5, 0, boxTransform);
-		DrawGuideline(dp, rot45, 0.5, 1, boxTransform);
-		DrawGuideline(dp, rot45, 0, 0.5, boxTransform);
-		DrawGuideline(dp, rot45, 1, 0.5, boxTransform);
+		DrawGuideline(dp, rot45, 0.5, 0, boxTransform, dp->m_guidelineColor);
+		DrawGuideline(dp, rot45, 0.5, 1, boxTransform, dp->m_guidelineColor);
+		DrawGuideline(dp, rot45, 0, 0.5, boxTransform, dp->m_guidelineColor);
+		DrawGuideline(dp, rot45, 1, 0.5, boxTransform, dp->m_guidelineColor);
 
 		// TEXT RENDERING
 		// THIS DESPERATELY NEEDS TO BE REWRITTEN INTO SHADER CODE
@@ -1327,36 +1193,97 @@ bool OBS::Display::DrawSelectedSource(obs_scene_t *scene, obs_sceneitem_t *item,
 		}
 	}
 
-	if (dp->m_drawRotationHandle) {
-		gs_effect_set_vec4(solid_color, &dp->m_rotationHandleColorVec4);
+	if (dp->m_drawRotationHandle)
 		dp->DrawRotationHandle(rot, boxTransform);
+
+	const float_t handles[8][2] = {{0, 0}, {1, 0}, {0, 1}, {1, 1}, {0.5, 0}, {0.5, 1}, {0, 0.5}, {1, 0.5}};
+	for (auto &handle : handles)
+		DrawSquareAt(dp, handle[0], handle[1], boxTransform, dp->m_handleSquare, dp->m_resizeInnerColor);
+	for (auto &handle : handles)
+		DrawBoxAt(dp, handle[0], handle[1], boxTransform, dp->m_handleBox, dp->m_resizeOuterColor);
+
+	return true;
+}
+
+// FNV-1a, only used to notice that something the overlay depends on has changed.
+static inline void HashBytes(uint64_t &hash, const void *data, size_t size)
+{
+	const uint8_t *bytes = static_cast<const uint8_t *>(data);
+	for (size_t idx = 0; idx < size; idx++) {
+		hash ^= bytes[idx];
+		hash *= 0x100000001B3ull;
 	}
+}
 
-	gs_load_vertexbuffer(dp->m_boxTris->Update(false));
-	gs_effect_set_vec4(solid_color, &dp->m_resizeInnerColorVec4);
-	DrawSquareAt(dp, 0, 0, boxTransform);
-	DrawSquareAt(dp, 1, 0, boxTransform);
-	DrawSquareAt(dp, 0, 1, boxTransform);
-	DrawSquareAt(dp, 1, 1, boxTransform);
-	DrawSquareAt(dp, 0.5, 0, boxTransform);
-	DrawSquareAt(dp, 0.5, 1, boxTransform);
-	DrawSquareAt(dp, 0, 0.5, boxTransform);
-	DrawSquareAt(dp, 1, 0.5, boxTransform);
-
-	gs_load_vertexbuffer(dp->m_boxLine->Update(false));
-	gs_effect_set_vec4(solid_color, &dp->m_resizeOuterColorVec4);
-	DrawBoxAt(dp, 0, 0, boxTransform);
-	DrawBoxAt(dp, 1, 0, boxTransform);
-	DrawBoxAt(dp, 0, 1, boxTransform);
-	DrawBoxAt(dp, 1, 1, boxTransform);
-	DrawBoxAt(dp, 0.5, 0, boxTransform);
-	DrawBoxAt(dp, 0.5, 1, boxTransform);
-	DrawBoxAt(dp, 0, 0.5, boxTransform);
-	DrawBoxAt(dp, 1, 0.5, boxTransform);
+template<typename T> static inline void HashValue(uint64_t &hash, const T &value)
+{
+	HashBytes(hash, &value, sizeof(T));
+}
 
+struct OverlaySignatureContext {
+	OBS::Display *display;
+	uint64_t hash;
+};
+
+// Hashes everything DrawSelectedSource reads from an item, with the same filtering.
+bool OBS::Display::HashSelectedSource(obs_scene_t *scene, obs_sceneitem_t *item, void *param)
+{
+	OverlaySignatureContext *context = reinterpret_cast<OverlaySignatureContext *>(param);
+
+	if (obs_sceneitem_locked(item) || !obs_sceneitem_selected(item))
+		return true;
+	if (context->display->m_canvas != obs_sceneitem_get_canvas(item))
+		return true;
+
+	obs_source_t *itemSource = obs_sceneitem_get_source(item);
+	if ((obs_source_get_output_flags(itemSource) & OBS_SOURCE_VIDEO) == 0)
+		return true;
+
+	matrix4 boxTransform;
+	obs_sceneitem_get_box_transform(item, &boxTransform);
+	vec2 boxScale;
+	obs_sceneitem_get_box_scale(item, &boxScale);
+	obs_sceneitem_crop crop;
+	obs_sceneitem_get_crop(item, &crop);
+
+	HashValue(context->hash, obs_sceneitem_get_id(item));
+	HashValue(context->hash, obs_source_get_width(itemSource));
+	HashValue(context->hash, obs_source_get_height(itemSource));
+	HashValue(context->hash, obs_sceneitem_get_rot(item));
+	HashValue(context->hash, boxTransform);
+	HashValue(context->hash, boxScale);
+	HashValue(context->hash, crop);
 	return true;
 }
 
+uint64_t OBS::Display::GetOverlaySignature(obs_scene_t *scene, uint32_t cx, uint32_t cy)
+{
+	OverlaySignatureContext context = {this, 0xCBF29CE484222325ull};
+
+	obs_source_t *sceneSource = obs_scene_get_source(scene);
+	matrix4 curTransform;
+	gs_matrix_get(&curTransform);
+
+	HashValue(context.hash, scene);
+	HashValue(context.hash, obs_source_get_width(sceneSource));
+	HashValue(context.hash, obs_source_get_height(sceneSource));
+	HashValue(context.hash, cx);
+	HashValue(context.hash, cy);
+	HashValue(context.hash, curTransform);
+	HashValue(context.hash, m_previewOffset.first);
+	HashValue(context.hash, m_previewOffset.second);
+	HashValue(context.hash, m_previewSize.first);
+	HashValue(context.hash, m_previewSize.second);
+	HashValue(context.hash, m_previewToWorldScale);
+	HashValue(context.hash, m_drawGuideLines);
+	HashValue(context.hash, m_drawRotationHandle);
+	for (uint32_t color : {m_outlineColor, m_cropOutlineColor, m_guidelineColor, m_resizeOuterColor, m_resizeInnerColor, m_rotationHandleColor})
+		HashValue(context.hash, color);
+
+	obs_scene_enum_items(scene, HashSelectedSource, &context);
+	return context.hash;
+}
+
 bool OBS::Display::DrawSelectedOverflow(obs_scene_t *scene, obs_sceneitem_t *item, void *param)
 {
 	if (obs_sceneitem_locked(item))
@@ -1436,11 +1363,18 @@ void OBS::Display::DisplayCallback(void *displayPtr, uint32_t cx, uint32_t cy)
 	gs_effect_t *solid = obs_get_base_effect(OBS_EFFECT_SOLID);
 	gs_eparam_t *solid_color = gs_effect_get_param_by_name(solid, "color");
 	gs_technique_t *solid_tech = gs_effect_get_technique(solid, "Solid");
+	gs_technique_t *solid_colored_tech = gs_effect_get_technique(solid, "SolidColored");
 	vec4 color;
 
 	if (dp->m_canvas)
 		obs_set_video_rendering_canvas(dp->m_canvas);
 
+	dp->m_lastRenderTime = os_gettime_ns();
+	{
+		std::unique_lock<std::mutex> ulock(dp->m_renderPolicyMtx);
+		dp->m_renderStats.renderedFrames++;
+	}
+
 	dp->UpdatePreviewArea();
 
 	// Get proper source/base size.
@@ -1523,22 +1457,13 @@ void OBS::Display::DisplayCallback(void *displayPtr, uint32_t cx, uint32_t cy)
 	//------------------------------------------------------------------------------
 
 	// Source Rendering
-	if (dp->m_source) {
-		/* If the source is a transition it means this display
-		 * is for Studio Mode and that the scene it contains is a
-		 * duplicate of the current scene, apply selective recording
-		 * layer rendering if it is enabled */
-		if (obs_get_multiple_rendering() && obs_source_get_type(dp->m_source) == OBS_SOURCE_TYPE_TRANSITION)
-			obs_set_video_rendering_mode(dp->m_renderingMode);
-		obs_source_video_render(dp->m_source);
-	} else {
-		obs_render_texture(dp->m_canvas, dp->m_renderingMode);
-	}
+	dp->RenderSource(sourceW, sourceH);
 
 	//------------------------------------------------------------------------------
 
 	// The other UI effects
 	if (scene && dp->m_shouldDrawUI) {
+		uint64_t overlayStart = os_gettime_ns();
 
 		// Display-Aligned Drawing
 		vec2 tlCorner = {(float)-dp->m_previewOffset.first, (float)-dp->m_previewOffset.second};
@@ -1549,19 +1474,36 @@ void OBS::Display::DisplayCallback(void *displayPtr, uint32_t cx, uint32_t cy)
 		gs_ortho(tlCorner.x, brCorner.x, tlCorner.y, brCorner.y, -100.0f, 100.0f);
 		gs_reset_viewport();
 
-		dp->m_textVertices->Resize(0);
+		// Reuse last frame's geometry when nothing it depends on has changed.
+		uint64_t signature = dp->GetOverlaySignature(scene, cx, cy);
+		bool cached = dp->m_overlayValid && signature == dp->m_overlaySignature;
+		if (!cached) {
+			dp->m_textVertices->Resize(0);
+			dp->m_overlay->Clear();
 
-		gs_technique_begin(solid_tech);
-		gs_technique_begin_pass(solid_tech, 0);
+			// Collects the geometry of every selected item, nothing is drawn yet.
+			obs_scene_enum_items(scene, DrawSelectedSource, dp);
 
-		obs_scene_enum_items(scene, DrawSelectedSource, dp);
+			dp->m_overlaySignature = signature;
+			dp->m_overlayValid = true;
+		}
 
-		gs_technique_end_pass(solid_tech);
-		gs_technique_end(solid_tech);
+		uint32_t drawCalls = 0;
+		vec4 white;
+		vec4_set(&white, 1.0f, 1.0f, 1.0f, 1.0f);
+		gs_effect_set_vec4(solid_color, &white);
+		gs_technique_begin(solid_colored_tech);
+		gs_technique_begin_pass(solid_colored_tech, 0);
+
+		drawCalls += cached ? dp->m_overlay->Redraw() : dp->m_overlay->Draw();
+
+		gs_technique_end_pass(solid_colored_tech);
+		gs_technique_end(solid_colored_tech);
 
 		// Text Rendering
 		if (dp->m_textVertices->Size() > 0) {
-			gs_vertbuffer_t *vb = dp->m_textVertices->Update();
+			drawCalls++;
+			gs_vertbuffer_t *vb = dp->m_textVertices->Update(!cached);
 			while (gs_effect_loop(dp->m_textEffect, "Draw")) {
 				gs_effect_set_texture(gs_effect_get_param_by_name(dp->m_textEffect, "image"), dp->m_textTexture);
 				gs_load_vertexbuffer(vb);
@@ -1569,6 +1511,16 @@ void OBS::Display::DisplayCallback(void *displayPtr, uint32_t cx, uint32_t cy)
 				gs_draw(GS_TRIS, 0, (uint32_t)dp->m_textVertices->Size());
 			}
 		}
+
+		uint64_t overlayTime = os_gettime_ns() - overlayStart;
+		std::unique_lock<std::mutex> ulock(dp->m_overlayStatsMtx);
+		dp->m_overlayStats.frames++;
+		if (cached)
+			dp->m_overlayStats.cachedFrames++;
+		dp->m_overlayStats.totalTimeNs += overlayTime;
+		dp->m_overlayStats.maxTimeNs = std::max(dp->m_overlayStats.maxTimeNs, overlayTime);
+		dp->m_overlayStats.drawCalls += drawCalls;
+		dp->m_overlayStats.uploadedBytes = dp->m_textVertices->GetUploadedBytes() + dp->m_overlay->GetUploadedBytes();
 	}
 
 	obs_source_release(source);
@@ -1600,6 +1552,150 @@ obs_source_t *OBS::Display::GetSourceForUIEffects()
 	return source;
 }
 
+OBS::Display::OverlayStats OBS::Display::GetOverlayStats()
+{
+	std::unique_lock<std::mutex> ulock(m_overlayStatsMtx);
+	return m_overlayStats;
+}
+
+void OBS::Display::RenderSource(uint32_t sourceW, uint32_t sourceH)
+{
+	if (!m_source) {
+		obs_render_texture(m_canvas, m_renderingMode);
+		return;
+	}
+
+	/* If the source is a transition it means this display
+	 * is for Studio Mode and that the scene it contains is a
+	 * duplicate of the current scene, apply selective recording
+	 * layer rendering if it is enabled */
+	if (obs_get_multiple_rendering() && obs_source_get_type(m_source) == OBS_SOURCE_TYPE_TRANSITION)
+		obs_set_video_rendering_mode(m_renderingMode);
+
+	float renderScale = GetRenderPolicy().renderScale;
+	uint32_t targetW = uint32_t(float(m_previewSize.first) * renderScale);
+	uint32_t targetH = uint32_t(float(m_previewSize.second) * renderScale);
+	if (renderScale >= 1.0f || targetW == 0 || targetH == 0) {
+		obs_source_video_render(m_source);
+		return;
+	}
+
+	// Render the source into a smaller target and stretch it over the preview area.
+	if (!m_sourceTexrender)
+		m_sourceTexrender = gs_texrender_create(GS_BGRA, GS_ZS_NONE);
+
+	gs_texrender_reset(m_sourceTexrender);
+	if (!gs_texrender_begin(m_sourceTexrender, targetW, targetH)) {
+		obs_source_video_render(m_source);
+		return;
+	}
+
+	vec4 clearColor;
+	vec4_zero(&clearColor);
+	gs_clear(GS_CLEAR_COLOR, &clearColor, 0.0f, 0);
+	gs_ortho(0.0f, float(sourceW), 0.0f, float(sourceH), -100.0f, 100.0f);
+
+	gs_blend_state_push();
+	gs_blend_function_separate(GS_BLEND_SRCALPHA, GS_BLEND_INVSRCALPHA, GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+	obs_source_video_render(m_source);
+	gs_blend_state_pop();
+	gs_texrender_end(m_sourceTexrender);
+
+	gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+	gs_texture_t *texture = gs_texrender_get_texture(m_sourceTexrender);
+
+	// The render target holds premultiplied alpha.
+	gs_blend_state_push();
+	gs_blend_function(GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+	gs_effect_set_texture(gs_effect_get_param_by_name(effect, "image"), texture);
+	while (gs_effect_loop(effect, "Draw"))
+		gs_draw_sprite(texture, 0, sourceW, sourceH);
+	gs_blend_state_pop();
+}
+
+void OBS::Display::SetRenderPolicy(const RenderPolicy &policy)
+{
+	std::unique_lock<std::mutex> ulock(m_renderPolicyMtx);
+	m_renderPolicy = policy;
+	if (!(m_renderPolicy.renderScale > 0.0f) || m_renderPolicy.renderScale > 1.0f)
+		m_renderPolicy.renderScale = 1.0f;
+}
+
+OBS::Display::RenderPolicy OBS::Display::GetRenderPolicy()
+{
+	std::unique_lock<std::mutex> ulock(m_renderPolicyMtx);
+	return m_renderPolicy;
+}
+
+OBS::Display::RenderStats OBS::Display::GetRenderStats()
+{
+	std::unique_lock<std::mutex> ulock(m_renderPolicyMtx);
+	return m_renderStats;
+}
+
+void OBS::Display::RenderedCallback(void *displayPtr)
+{
+	static_cast<Display *>(displayPtr)->GovernFrame();
+}
+
+void OBS::Display::GovernFrame()
+{
+	// Runs on the graphics thread after the canvas is rendered and before the
+	// displays are, so enabling or disabling the display decides this frame.
+	RenderPolicy policy = GetRenderPolicy();
+	uint64_t now = os_gettime_ns();
+	uint64_t frameInterval = obs_get_frame_interval_ns();
+
+	// The callback runs once per rendered canvas; only the first one of a frame counts.
+	if (now - m_lastGovernTime < frameInterval / 2)
+		return;
+	m_lastGovernTime = now;
+
+	bool hidden = policy.pauseWhenHidden && IsHidden(now);
+
+	bool due = true;
+	if (policy.maxFps > 0 && m_lastRenderTime > 0) {
+		// Half a canvas frame of slack keeps a 30 FPS cap on a 60 FPS canvas at every other frame.
+		uint64_t interval = 1000000000ULL / policy.maxFps;
+		due = (now - m_lastRenderTime) + frameInterval / 2 >= interval;
+	}
+
+	bool enabled = !hidden && due;
+	if (enabled != m_renderEnabled) {
+		obs_display_set_enabled(m_display, enabled);
+		m_renderEnabled = enabled;
+	}
+
+	std::unique_lock<std::mutex> ulock(m_renderPolicyMtx);
+	m_renderStats.paused = hidden;
+	if (!enabled)
+		m_renderStats.skippedFrames++;
+}
+
+bool OBS::Display::IsHidden(uint64_t now)
+{
+	uint32_t width = 0, height = 0;
+	obs_display_size(m_display, &width, &height);
+	if (width == 0 || height == 0 || m_previewSize.first == 0 || m_previewSize.second == 0)
+		return true;
+
+#if defined(_WIN32)
+	// Window state only changes on user interaction, no need to ask every frame.
+	if (now < m_nextHiddenCheck)
+		return m_hidden;
+	m_nextHiddenCheck = now + 250000000ULL;
+
+	HWND root = GetAncestor(m_ourWindow, GA_ROOT);
+	BOOL cloaked = FALSE;
+	if (FAILED(DwmGetWindowAttribute(root, DWMWA_CLOAKED, &cloaked, sizeof(cloaked))))
+		cloaked = FALSE;
+	m_hidden = !IsWindowVisible(m_ourWindow) || IsIconic(root) || cloaked;
+	return m_hidden;
+#else
+	return false;
+#endif
+}
+
 void OBS::Display::UpdatePreviewArea()
 {
 	int32_t offsetX = 0, offsetY = 0;
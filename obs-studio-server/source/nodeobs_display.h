@@ -20,9 +20,11 @@
 
 #include <algorithm>
 #include <memory>
+#include <mutex>
 #include <system_error>
 #include <thread>
 #include <vector>
+#include "gs-overlaybatch.h"
 #include "gs-vertexbuffer.h"
 #include "obs.h"
 #include "ipc-server.hpp"
@@ -88,18 +90,56 @@ public:
 	void SetDrawRotationHandle(bool drawRotationHandle);
 	void UpdatePreviewArea();
 
+	// Time spent drawing the UI overlay (outlines, guides, size labels).
+	struct OverlayStats {
+		uint64_t frames = 0;
+		uint64_t totalTimeNs = 0;
+		uint64_t maxTimeNs = 0;
+		uint64_t uploadedBytes = 0;
+		uint64_t drawCalls = 0;
+		// Frames that reused the previous frame's overlay geometry.
+		uint64_t cachedFrames = 0;
+	};
+	OverlayStats GetOverlayStats();
+
+	// How often and at which resolution the display renders.
+	struct RenderPolicy {
+		// Frames per second cap, 0 renders every canvas frame.
+		uint32_t maxFps = 0;
+		// Size of the source render target relative to the preview area, in (0, 1].
+		float renderScale = 1.0f;
+		// Stop rendering while the display is zero-sized or its window is minimized or hidden.
+		// Opt-in, window visibility is only known on Windows.
+		bool pauseWhenHidden = false;
+	};
+	struct RenderStats {
+		uint64_t renderedFrames = 0;
+		uint64_t skippedFrames = 0;
+		bool paused = false;
+	};
+	void SetRenderPolicy(const RenderPolicy &policy);
+	RenderPolicy GetRenderPolicy();
+	RenderStats GetRenderStats();
+
 private:
 	static void DisplayCallback(void *displayPtr, uint32_t cx, uint32_t cy);
+	static void RenderedCallback(void *displayPtr);
+	void GovernFrame();
+	bool IsHidden(uint64_t now);
+	void RenderSource(uint32_t sourceW, uint32_t sourceH);
+	uint64_t GetOverlaySignature(obs_scene_t *scene, uint32_t cx, uint32_t cy);
 	static bool DrawSelectedSource(obs_scene_t *scene, obs_sceneitem_t *item, void *param);
 	static bool DrawSelectedOverflow(obs_scene_t *scene, obs_sceneitem_t *item, void *param);
+	static bool HashSelectedSource(obs_scene_t *scene, obs_sceneitem_t *item, void *param);
 	obs_source_t *GetSourceForUIEffects();
-	void DrawCropOutline(float x1, float y1, float x2, float y2, vec2 scale);
-	void DrawOutline(const matrix4 &mtx, const obs_sceneitem_crop &crop, const vec2 &boxScale, gs_eparam_t *color);
-	void DrawRotationHandle(float rot, matrix4 &mtx);
+	void DrawCropOutline(const matrix4 &mtx, float x1, float y1, float x2, float y2, vec2 scale);
+	void DrawOutline(const matrix4 &mtx, const obs_sceneitem_crop &crop, const vec2 &boxScale);
+	void DrawRotationHandle(float rot, const matrix4 &mtx);
 	void setSizeCall(int step);
 
 public: // Rendering code needs it.
 	vec2 m_worldToPreviewScale, m_previewToWorldScale;
+	std::unique_ptr<GS::OverlayBatch> m_overlay;
 
 	gs_init_data m_gsInitData;
 	obs_display_t *m_display;
@@ -131,14 +171,16 @@ private:
 
 	GS::VertexBuffer *m_textVertices;
 
-	std::unique_ptr<GS::VertexBuffer> m_leftSolidOutline;
-	std::unique_ptr<GS::VertexBuffer> m_topSolidOutline;
-	std::unique_ptr<GS::VertexBuffer> m_rightSolidOutline;
-	std::unique_ptr<GS::VertexBuffer> m_bottomSolidOutline;
-	std::unique_ptr<GS::VertexBuffer> m_cropOutline;
+	GS::OverlayBatch::Shape m_leftSolidOutline;
+	GS::OverlayBatch::Shape m_topSolidOutline;
+	GS::OverlayBatch::Shape m_rightSolidOutline;
+	GS::OverlayBatch::Shape m_bottomSolidOutline;
+	GS::OverlayBatch::Shape m_cropOutline;
+
+	GS::OverlayBatch::Shape m_handleBox, m_handleSquare;
+	GS::OverlayBatch::Shape m_rotHandleLine, m_rotHandleCircle;
 
-	std::unique_ptr<GS::VertexBuffer> m_boxLine, m_boxTris;
-	std::unique_ptr<GS::VertexBuffer> m_rotHandleLine, m_rotHandleCircle;
+	std::unique_ptr<GS::VertexBuffer> m_boxTris;
 
 	// Theme/Style
 	/// Padding
@@ -167,6 +209,23 @@ private:
 	bool m_shouldDrawUI = true;
 	bool m_renderAtBottom = false;
 
+	std::mutex m_overlayStatsMtx;
+	OverlayStats m_overlayStats;
+	// Hash of the inputs the cached overlay geometry was built from.
+	uint64_t m_overlaySignature = 0;
+	bool m_overlayValid = false;
+
+	std::mutex m_renderPolicyMtx;
+	RenderPolicy m_renderPolicy;
+	RenderStats m_renderStats;
+	// Only touched from the graphics thread.
+	bool m_renderEnabled = true;
+	bool m_hidden = false;
+	uint64_t m_lastRenderTime = 0;
+	uint64_t m_lastGovernTime = 0;
+	uint64_t m_nextHiddenCheck = 0;
+	gs_texrender_t *m_sourceTexrender = nullptr;
+
 	enum obs_video_rendering_mode m_renderingMode = OBS_MAIN_VIDEO_RENDERING;
 	struct obs_video_info *m_canvas;
 
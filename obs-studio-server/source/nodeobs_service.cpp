@@ -23,6 +23,7 @@
 #include <filesystem>
 #endif
 #include "osn-error.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
 #include <osn-video.hpp>
@@ -115,6 +116,7 @@ void OBS_service::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("OBS_service_stopVirtualWebcan", std::vector<ipc::type>{}, OBS_service_stopVirtualWebcan));
 
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void OBS_service::OBS_service_resetAudioContext(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
@@ -512,6 +514,13 @@ int OBS_service::doResetVideoContext(obs_video_info *ovi)
 		if (!base_canvas)
 			base_canvas = obs_create_video_info();
 
+		// There is no graphics module to load, the canvas keeps its settings without video output.
+		if (utility::IsHeadless()) {
+			blog(LOG_INFO, "Headless mode, the video context is not started");
+			*base_canvas = *ovi;
+			return OBS_VIDEO_SUCCESS;
+		}
+
 		int ret = obs_set_video_info(base_canvas, ovi);
 
 		return ret;
@@ -19,9 +19,11 @@
 #include "nodeobs_settings.h"
 #include "osn-error.hpp"
 #include "nodeobs_api.h"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 #include "memory-manager.h"
 #include "osn-video.hpp"
+#include "osn-shared-memory.hpp"
 
 #ifdef WIN32
 #include <windows.h>
@@ -79,6 +81,7 @@ void OBS_settings::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("OBS_settings_getVideoDevices", std::vector<ipc::type>{}, OBS_settings_getVideoDevices));
 
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void OBS_settings::OBS_settings_getSettings(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
@@ -96,7 +99,7 @@ void OBS_settings::OBS_settings_getSettings(void *data, const int64_t id, const
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value((uint64_t)settings.size()));
 	rval.push_back(ipc::value((uint64_t)binaryValue.size()));
-	rval.push_back(ipc::value(binaryValue));
+	osn::SharedMemory::PushPayload(rval, binaryValue);
 	rval.push_back(ipc::value(type));
 	AUTO_DEBUG;
 }
@@ -3732,7 +3735,8 @@ bool OBS_settings::saveSettings(std::string nameCategory, std::vector<SubCategor
 	} else if (nameCategory.compare("Advanced") == 0) {
 		saveAdvancedSettings(settings);
 
-		if (!OBS_service::isStreamingOutputActive(StreamServiceId::Main) && !OBS_service::isStreamingOutputActive(StreamServiceId::Second)) {
+		if (!utility::IsHeadless() && !OBS_service::isStreamingOutputActive(StreamServiceId::Main) &&
+		    !OBS_service::isStreamingOutputActive(StreamServiceId::Second)) {
 			struct obs_video_info ovi = {0};
 			obs_get_video_info(&ovi);
 			obs_reset_video(&ovi);
@@ -18,6 +18,7 @@
 
 #include "osn-advanced-recording.hpp"
 #include "osn-error.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 #include "osn-audio-track.hpp"
 #include "osn-file-output.hpp"
@@ -66,6 +67,7 @@ void osn::IAdvancedRecording::Register(ipc::server &srv)
 							       SetFileResetTimestamps));
 
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::IAdvancedRecording::Create(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
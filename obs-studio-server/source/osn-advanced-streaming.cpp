@@ -20,6 +20,7 @@
 #include "osn-video-encoder.hpp"
 #include "osn-service.hpp"
 #include "osn-error.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 #include "nodeobs_audio_encoders.h"
 #include "osn-audio-track.hpp"
@@ -66,6 +67,7 @@ void osn::IAdvancedStreaming::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("SetLegacySettings", std::vector<ipc::type>{ipc::type::UInt64}, SetLegacySettings));
 
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::IAdvancedStreaming::Create(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
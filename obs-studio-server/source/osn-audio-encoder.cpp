@@ -18,6 +18,7 @@
 
 #include "osn-audio-encoder.hpp"
 #include "osn-error.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 
 void osn::AudioEncoder::Register(ipc::server &srv)
@@ -31,6 +32,7 @@ void osn::AudioEncoder::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("SetBitrate", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetBitrate));
 
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::AudioEncoder::Create(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
@@ -17,6 +17,7 @@
 ******************************************************************************/
 #include "osn-audio-track.hpp"
 #include "osn-error.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 
 #include "nodeobs_configManager.hpp"
@@ -41,6 +42,7 @@ void osn::IAudioTrack::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("SaveLegacySettings", std::vector<ipc::type>{}, SaveLegacySettings));
 
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::IAudioTrack::Create(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
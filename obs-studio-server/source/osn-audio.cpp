@@ -18,6 +18,7 @@
 
 #include "osn-audio.hpp"
 #include "osn-error.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 
 #ifdef WIN32
@@ -52,6 +53,7 @@ void osn::Audio::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("SetDisableAudioDucking", std::vector<ipc::type>{ipc::type::UInt32}, SetDisableAudioDucking));
 	cls->register_function(std::make_shared<ipc::function>("GetDisableAudioDuckingLegacy", std::vector<ipc::type>{}, GetDisableAudioDuckingLegacy));
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::Audio::GetAudioContext(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
@@ -0,0 +1,168 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-call-capture.hpp"
+#include <ipc-class.hpp>
+#include <ipc-function.hpp>
+#include <cstring>
+#include "osn-error.hpp"
+#include "shared.hpp"
+#include "utility.hpp"
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// Calls are handled on the worker of their connection, so the call between
+// the pre and post callbacks is tracked per thread.
+struct PendingCall {
+	bool recording = false;
+	std::chrono::steady_clock::time_point start;
+	capture::Call call;
+};
+static thread_local PendingCall pending;
+
+static uint64_t to_ns(std::chrono::steady_clock::duration duration)
+{
+	return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
+
+void osn::CallCapture::Register(ipc::server &srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>(CollectionName);
+	cls->register_function(std::make_shared<ipc::function>("Start", std::vector<ipc::type>{ipc::type::String}, Start));
+	cls->register_function(std::make_shared<ipc::function>("Stop", std::vector<ipc::type>{}, Stop));
+	cls->register_function(std::make_shared<ipc::function>("GetCpuTime", std::vector<ipc::type>{}, GetCpuTime));
+	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
+}
+
+void osn::CallCapture::SetHooks(call_hook_t pre, call_hook_t post, void *data)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	m_forward.store(new MethodTable::Hooks{pre, post, data}, std::memory_order_release);
+	UpdateHooks();
+}
+
+void osn::CallCapture::UpdateHooks()
+{
+	// The dispatcher owns the server callbacks and reports every call, by
+	// name or by method id, under the name of the function that ran.
+	bool needed = m_active.load() || m_forward.load();
+	osn::MethodTable::GetInstance().SetHooks(needed ? &m_hooks : nullptr);
+}
+
+void osn::CallCapture::PreCall(const std::string &action, const std::vector<ipc::value> &args, void *data)
+{
+	CallCapture &instance = *static_cast<CallCapture *>(data);
+	const MethodTable::Hooks *forward = instance.m_forward.load(std::memory_order_acquire);
+	if (forward)
+		forward->pre(action, args, forward->data);
+
+	// Starting and stopping captures is left out of the replay.
+	pending.recording = instance.m_active.load(std::memory_order_acquire) && action.rfind(std::string(CollectionName) + "::", 0) != 0;
+	if (!pending.recording)
+		return;
+
+	pending.call.action = action;
+	pending.call.args = args;
+	pending.start = std::chrono::steady_clock::now();
+}
+
+void osn::CallCapture::PostCall(const std::string &action, const std::vector<ipc::value> &rval, void *data)
+{
+	CallCapture &instance = *static_cast<CallCapture *>(data);
+	if (pending.recording) {
+		auto end = std::chrono::steady_clock::now();
+		pending.recording = false;
+		pending.call.duration_ns = to_ns(end - pending.start);
+		pending.call.response_count = uint32_t(rval.size());
+		pending.call.response_size = capture::EncodedSize(rval);
+
+		std::unique_lock<std::mutex> ulock(instance.m_mutex);
+		if (instance.m_writer.IsOpen()) {
+			pending.call.start_ns = pending.start > instance.m_start ? to_ns(pending.start - instance.m_start) : 0;
+			instance.m_writer.Write(pending.call);
+		}
+	}
+
+	const MethodTable::Hooks *forward = instance.m_forward.load(std::memory_order_acquire);
+	if (forward)
+		forward->post(action, rval, forward->data);
+}
+
+void osn::CallCapture::Start(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	CallCapture &instance = GetInstance();
+	std::unique_lock<std::mutex> ulock(instance.m_mutex);
+
+	uint64_t start_time_ns = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+	if (!instance.m_writer.Open(args[0].value_str, start_time_ns)) {
+		instance.m_active = false;
+		instance.UpdateHooks();
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Failed to open the capture file.");
+	}
+	instance.m_start = std::chrono::steady_clock::now();
+	instance.m_active = true;
+	instance.UpdateHooks();
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::CallCapture::Stop(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	CallCapture &instance = GetInstance();
+	std::unique_lock<std::mutex> ulock(instance.m_mutex);
+
+	instance.m_active = false;
+	instance.UpdateHooks();
+	uint64_t count = instance.m_writer.IsOpen() ? instance.m_writer.Count() : 0;
+	instance.m_writer.Close();
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(count));
+	AUTO_DEBUG;
+}
+
+void osn::CallCapture::GetCpuTime(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	double user_ms = 0.0;
+	double kernel_ms = 0.0;
+#ifdef WIN32
+	FILETIME creation, exit, kernel, user;
+	if (GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+		// FILETIME counts 100ns intervals.
+		user_ms = double((uint64_t(user.dwHighDateTime) << 32) | user.dwLowDateTime) / 10000.0;
+		kernel_ms = double((uint64_t(kernel.dwHighDateTime) << 32) | kernel.dwLowDateTime) / 10000.0;
+	}
+#else
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0) {
+		user_ms = usage.ru_utime.tv_sec * 1000.0 + usage.ru_utime.tv_usec / 1000.0;
+		kernel_ms = usage.ru_stime.tv_sec * 1000.0 + usage.ru_stime.tv_usec / 1000.0;
+	}
+#endif
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(user_ms));
+	rval.push_back(ipc::value(kernel_ms));
+	AUTO_DEBUG;
+}
@@ -0,0 +1,80 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <ipc-server.hpp>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "call-capture.hpp"
+#include "osn-method-table.hpp"
+
+namespace osn {
+// Records every call handled by the server, with its arguments and timings,
+// while a capture started by the client runs. The files are replayed by the
+// osn-replay benchmark. Owns the hooks of the dispatcher, which sees every
+// call, anything else that needs them goes through SetHooks. The hooks are
+// only installed while a capture runs or someone else needs them, so the
+// dispatcher does not build action names for nothing.
+class CallCapture {
+public:
+	static constexpr const char *CollectionName = "Capture";
+
+	typedef MethodTable::call_hook_t call_hook_t;
+
+	static CallCapture &GetInstance()
+	{
+		static CallCapture instance;
+		return instance;
+	}
+
+	CallCapture(CallCapture const &) = delete;
+	void operator=(CallCapture const &) = delete;
+
+	// Registered last, after every collection it should see.
+	static void Register(ipc::server &srv);
+	// Called around every call with the name of the function that actually
+	// ran, calls made by method id are reported under their own name. Safe
+	// to call while the server handles calls.
+	void SetHooks(call_hook_t pre, call_hook_t post, void *data);
+
+	static void Start(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void Stop(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void GetCpuTime(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+
+private:
+	CallCapture() {}
+
+	static void PreCall(const std::string &action, const std::vector<ipc::value> &args, void *data);
+	static void PostCall(const std::string &action, const std::vector<ipc::value> &rval, void *data);
+	// Installs or removes the dispatcher hooks. Must hold m_mutex.
+	void UpdateHooks();
+
+	std::mutex m_mutex;
+	capture::Writer m_writer;
+	std::atomic<bool> m_active{false};
+	std::chrono::steady_clock::time_point m_start;
+
+	const MethodTable::Hooks m_hooks = {PreCall, PostCall, this};
+	// Set from SetHooks. Replaced hooks are never freed, a worker may still
+	// be calling them.
+	std::atomic<const MethodTable::Hooks *> m_forward{nullptr};
+};
+} // namespace osn
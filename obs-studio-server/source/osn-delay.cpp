@@ -18,6 +18,7 @@
 
 #include "osn-delay.hpp"
 #include "osn-error.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 
 void osn::IDelay::Register(ipc::server &srv)
@@ -35,6 +36,7 @@ void osn::IDelay::Register(ipc::server &srv)
 		std::make_shared<ipc::function>("SetPreserveDelay", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetPreserveDelay));
 
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::IDelay::Create(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
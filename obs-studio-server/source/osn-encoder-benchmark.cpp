@@ -0,0 +1,273 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-encoder-benchmark.hpp"
+#include <algorithm>
+#include <cstring>
+#include <util/platform.h>
+
+// Horizontal range the pattern pans over, so consecutive frames differ the way
+// a moving picture does instead of repeating one frame.
+static constexpr uint32_t PanRange = 256;
+static constexpr uint32_t PanStep = 4;
+// Longest wait for the encoder to catch up with the last submitted frame.
+static constexpr uint64_t DrainTimeoutNs = 1000000000ULL;
+
+static inline uint32_t xorshift32(uint32_t &state)
+{
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+std::vector<uint8_t> osn::EncoderBenchmark::CreatePattern(const Point &point, uint32_t seed)
+{
+	// NV12 layout with wider rows: a luma plane followed by the interleaved chroma plane.
+	const uint32_t stride = point.width + PanRange;
+	std::vector<uint8_t> pattern(size_t(stride) * point.height + size_t(stride) * (point.height / 2));
+
+	uint32_t state = seed ? seed : 1;
+	uint8_t *luma = pattern.data();
+	for (uint32_t y = 0; y < point.height; y++) {
+		for (uint32_t x = 0; x < stride; x++)
+			luma[size_t(y) * stride + x] = uint8_t((((x ^ y) & 0xFF) >> 1) + (xorshift32(state) & 0x3F) + 16);
+	}
+
+	uint8_t *chroma = luma + size_t(stride) * point.height;
+	for (uint32_t y = 0; y < point.height / 2; y++) {
+		for (uint32_t x = 0; x < stride; x += 2) {
+			chroma[size_t(y) * stride + x] = uint8_t(128 + ((x >> 3) & 0x3F) - 32);
+			chroma[size_t(y) * stride + x + 1] = uint8_t(128 + ((y >> 2) & 0x3F) - 32 + (xorshift32(state) & 0x7));
+		}
+	}
+
+	return pattern;
+}
+
+void osn::EncoderBenchmark::FillFrame(video_frame *frame, const std::vector<uint8_t> &pattern, const Point &point, uint64_t index)
+{
+	const uint32_t stride = point.width + PanRange;
+	const uint32_t offset = uint32_t((index * PanStep) % PanRange) & ~1u;
+
+	const uint8_t *luma = pattern.data();
+	for (uint32_t y = 0; y < point.height; y++)
+		memcpy(frame->data[0] + size_t(y) * frame->linesize[0], luma + size_t(y) * stride + offset, point.width);
+
+	const uint8_t *chroma = luma + size_t(stride) * point.height;
+	for (uint32_t y = 0; y < point.height / 2; y++)
+		memcpy(frame->data[1] + size_t(y) * frame->linesize[1], chroma + size_t(y) * stride + offset, point.width);
+}
+
+osn::EncoderBenchmark::Result osn::EncoderBenchmark::RunPoint(const std::string &encoder, const Point &point, const Options &options)
+{
+	Result result;
+	result.encoder = encoder;
+	result.point = point;
+
+	const uint64_t interval = 1000000000ULL * point.fpsDen / point.fpsNum;
+	const uint64_t frames = std::max<uint64_t>(1, uint64_t(options.secondsPerPoint * point.fpsNum / point.fpsDen + 0.5));
+	result.submittedFrames = frames;
+
+	video_output_info voi = {};
+	voi.name = "encoder_benchmark";
+	voi.format = VIDEO_FORMAT_NV12;
+	voi.fps_num = point.fpsNum;
+	voi.fps_den = point.fpsDen;
+	voi.width = point.width;
+	voi.height = point.height;
+	voi.cache_size = 16;
+	voi.colorspace = VIDEO_CS_709;
+	voi.range = VIDEO_RANGE_PARTIAL;
+
+	video_t *video = nullptr;
+	if (video_output_open(&video, &voi) != VIDEO_OUTPUT_SUCCESS) {
+		blog(LOG_WARNING, "[ENCODER_BENCHMARK] Failed to open a %ux%u video output", point.width, point.height);
+		return result;
+	}
+
+	obs_encoder_t *vencoder = obs_video_encoder_create(encoder.c_str(), "benchmark_video", nullptr, nullptr);
+	obs_encoder_t *aencoder = obs_audio_encoder_create("ffmpeg_aac", "benchmark_aac", nullptr, 0, nullptr);
+	obs_output_t *output = obs_output_create("null_output", "benchmark_null", nullptr, nullptr);
+
+	if (vencoder && aencoder && output) {
+		const bool x264 = encoder == "obs_x264";
+
+		OBSData vencoder_settings = obs_data_create();
+		OBSData aencoder_settings = obs_data_create();
+		obs_data_release(vencoder_settings);
+		obs_data_release(aencoder_settings);
+		obs_data_set_int(aencoder_settings, "bitrate", 32);
+
+		if (options.recording && x264) {
+			obs_data_set_int(vencoder_settings, "crf", 20);
+			obs_data_set_string(vencoder_settings, "rate_control", "CRF");
+			obs_data_set_string(vencoder_settings, "profile", "high");
+		} else {
+			obs_data_set_int(vencoder_settings, "keyint_sec", 2);
+			obs_data_set_int(vencoder_settings, "bitrate", options.bitrate);
+			obs_data_set_string(vencoder_settings, "rate_control", "CBR");
+			obs_data_set_string(vencoder_settings, "profile", "main");
+		}
+		if (x264)
+			obs_data_set_string(vencoder_settings, "preset", "veryfast");
+
+		obs_encoder_update(vencoder, vencoder_settings);
+		obs_encoder_update(aencoder, aencoder_settings);
+		obs_encoder_set_video(vencoder, video);
+		obs_encoder_set_audio(aencoder, obs_get_audio());
+
+		obs_output_set_video_encoder(output, vencoder);
+		obs_output_set_audio_encoder(output, aencoder, 0);
+
+		result.started = obs_output_start(output);
+		if (!result.started)
+			blog(LOG_WARNING, "[ENCODER_BENCHMARK] Failed to start %s at %ux%u", encoder.c_str(), point.width, point.height);
+	}
+
+	if (result.started) {
+		std::vector<uint8_t> pattern = CreatePattern(point, options.seed);
+
+		uint64_t lockFailures = 0;
+		uint64_t maxInFlight = 0;
+		auto sampleInFlight = [&](uint64_t submitted) {
+			uint64_t done = uint64_t(obs_output_get_total_frames(output)) + lockFailures;
+			if (submitted > done)
+				maxInFlight = std::max(maxInFlight, submitted - done);
+		};
+
+		os_cpu_usage_info_t *cpuInfo = os_cpu_usage_info_start();
+		const uint64_t start = os_gettime_ns();
+
+		for (uint64_t index = 0; index < frames; index++) {
+			const uint64_t timestamp = start + index * interval;
+			os_sleepto_ns(timestamp);
+
+			video_frame frame;
+			if (video_output_lock_frame(video, &frame, 1, timestamp)) {
+				FillFrame(&frame, pattern, point, index);
+				video_output_unlock_frame(video);
+			} else {
+				// The frame cache is full: the encoder fell behind.
+				lockFailures++;
+			}
+			sampleInFlight(index + 1);
+		}
+
+		result.cpuUsage = os_cpu_usage_info_query(cpuInfo);
+		os_cpu_usage_info_destroy(cpuInfo);
+
+		const uint64_t drainStart = os_gettime_ns();
+		while (uint64_t(obs_output_get_total_frames(output)) + lockFailures < frames && os_gettime_ns() - drainStart < DrainTimeoutNs) {
+			os_sleep_ms(5);
+			sampleInFlight(frames);
+		}
+
+		const uint64_t encodedInTime = uint64_t(obs_output_get_total_frames(output));
+		const double elapsed = double(os_gettime_ns() - start) / 1000000000.0;
+		result.encodeFps = elapsed > 0.0 ? double(encodedInTime) / elapsed : 0.0;
+		result.lagMs = double(maxInFlight) * double(interval) / 1000000.0;
+
+		obs_output_stop(output);
+		for (int wait = 0; wait < 200 && obs_output_active(output); wait++)
+			os_sleep_ms(10);
+
+		result.encodedFrames = uint64_t(obs_output_get_total_frames(output));
+		result.skippedFrames = lockFailures + video_output_get_skipped_frames(video);
+		result.sustained = double(result.skippedFrames) <= double(frames) * MaxSkippedRatio &&
+				   double(encodedInTime) >= double(frames) * MinEncodedRatio;
+	}
+
+	if (output)
+		obs_output_release(output);
+	if (vencoder)
+		obs_encoder_release(vencoder);
+	if (aencoder)
+		obs_encoder_release(aencoder);
+	video_output_close(video);
+
+	return result;
+}
+
+std::vector<osn::EncoderBenchmark::Result> osn::EncoderBenchmark::Run(const std::vector<std::string> &encoders, const std::vector<Point> &points,
+								      const Options &options, const ProgressCallback &progress)
+{
+	std::vector<Result> results;
+	const size_t total = encoders.size() * points.size();
+
+	for (auto &encoder : encoders) {
+		for (auto &point : points) {
+			Result result = RunPoint(encoder, point, options);
+			blog(LOG_INFO, "[ENCODER_BENCHMARK] %s %ux%u@%u/%u: %.2f fps, %llu/%llu encoded, %llu skipped, lag %.1fms, cpu %.1f%%",
+			     encoder.c_str(), point.width, point.height, point.fpsNum, point.fpsDen, result.encodeFps, (unsigned long long)result.encodedFrames,
+			     (unsigned long long)result.submittedFrames, (unsigned long long)result.skippedFrames, result.lagMs, result.cpuUsage);
+			results.push_back(result);
+
+			if (progress && !progress(int(results.size() * 100 / total)))
+				return results;
+		}
+	}
+
+	return results;
+}
+
+OBSData osn::EncoderBenchmark::ToData(const std::vector<Result> &results, const Options &options)
+{
+	OBSData data = obs_data_create();
+	obs_data_release(data);
+
+	obs_data_set_string(data, "obsVersion", obs_get_version_string());
+#ifdef WIN32
+	obs_data_set_string(data, "platform", "win32");
+#elif __APPLE__
+	obs_data_set_string(data, "platform", "darwin");
+#else
+	obs_data_set_string(data, "platform", "linux");
+#endif
+	obs_data_set_int(data, "physicalCores", os_get_physical_cores());
+	obs_data_set_int(data, "logicalCores", os_get_logical_cores());
+
+	obs_data_set_double(data, "secondsPerPoint", options.secondsPerPoint);
+	obs_data_set_int(data, "bitrate", options.bitrate);
+	obs_data_set_bool(data, "recording", options.recording);
+	obs_data_set_int(data, "seed", options.seed);
+
+	obs_data_array_t *array = obs_data_array_create();
+	for (auto &result : results) {
+		obs_data_t *item = obs_data_create();
+		obs_data_set_string(item, "encoder", result.encoder.c_str());
+		obs_data_set_int(item, "width", result.point.width);
+		obs_data_set_int(item, "height", result.point.height);
+		obs_data_set_int(item, "fpsNum", result.point.fpsNum);
+		obs_data_set_int(item, "fpsDen", result.point.fpsDen);
+		obs_data_set_bool(item, "started", result.started);
+		obs_data_set_int(item, "submittedFrames", result.submittedFrames);
+		obs_data_set_int(item, "encodedFrames", result.encodedFrames);
+		obs_data_set_int(item, "skippedFrames", result.skippedFrames);
+		obs_data_set_double(item, "encodeFps", result.encodeFps);
+		obs_data_set_double(item, "lagMs", result.lagMs);
+		obs_data_set_double(item, "cpuUsage", result.cpuUsage);
+		obs_data_set_bool(item, "sustained", result.sustained);
+		obs_data_array_push_back(array, item);
+		obs_data_release(item);
+	}
+	obs_data_set_array(data, "results", array);
+	obs_data_array_release(array);
+
+	return data;
+}
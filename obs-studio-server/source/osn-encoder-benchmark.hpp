@@ -0,0 +1,87 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+#include <obs.hpp>
+#include <media-io/video-io.h>
+
+namespace osn {
+// Feeds a fixed, seeded sequence of synthetic NV12 frames into an encoder at
+// several resolution and frame rate points and measures how well it keeps up.
+// Frames do not come from the scene, so two runs on the same machine encode
+// exactly the same pictures and can be compared with each other.
+class EncoderBenchmark {
+public:
+	struct Point {
+		uint32_t width;
+		uint32_t height;
+		uint32_t fpsNum;
+		uint32_t fpsDen;
+	};
+
+	struct Options {
+		double secondsPerPoint = 3.0;
+		uint64_t bitrate = 2500;
+		bool recording = false;
+		uint32_t seed = 0x4F534E42; // 'OSNB'
+	};
+
+	struct Result {
+		std::string encoder;
+		Point point;
+		bool started = false;
+
+		uint64_t submittedFrames = 0;
+		uint64_t encodedFrames = 0;
+		uint64_t skippedFrames = 0;
+
+		double encodeFps = 0.0;
+		// Longest time a frame spent queued between submission and the output.
+		double lagMs = 0.0;
+		// Process CPU usage during the run, across all cores.
+		double cpuUsage = 0.0;
+
+		// Kept up with the frame rate without skipping frames.
+		bool sustained = false;
+	};
+
+	// Allowed share of skipped frames and minimum share of encoded frames for a
+	// point to count as sustained.
+	static constexpr double MaxSkippedRatio = 0.02;
+	static constexpr double MinEncodedRatio = 0.95;
+
+	// Called after every point with the overall progress (0-100). Returning
+	// false cancels the remaining points.
+	using ProgressCallback = std::function<bool(int percentage)>;
+
+	static std::vector<Result> Run(const std::vector<std::string> &encoders, const std::vector<Point> &points, const Options &options,
+				       const ProgressCallback &progress);
+
+	// Serializes results with the machine description so runs from different
+	// machines can be compared.
+	static OBSData ToData(const std::vector<Result> &results, const Options &options);
+
+private:
+	static Result RunPoint(const std::string &encoder, const Point &point, const Options &options);
+	static void FillFrame(video_frame *frame, const std::vector<uint8_t> &pattern, const Point &point, uint64_t index);
+	static std::vector<uint8_t> CreatePattern(const Point &point, uint32_t seed);
+};
+} // namespace osn
@@ -20,6 +20,7 @@
 #include "osn-error.hpp"
 #include "obs.h"
 #include "osn-source.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
 
@@ -43,6 +44,7 @@ void osn::Fader::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("Attach", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, Attach));
 	cls->register_function(std::make_shared<ipc::function>("Detach", std::vector<ipc::type>{ipc::type::UInt64}, Detach));
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::Fader::ClearFaders()
@@ -22,6 +22,7 @@
 #include <obs.h>
 #include "osn-error.hpp"
 #include "osn-source.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 
 void osn::Filter::Register(ipc::server &srv)
@@ -32,6 +33,7 @@ void osn::Filter::Register(ipc::server &srv)
 	cls->register_function(
 		std::make_shared<ipc::function>("Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String}, Create));
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::Filter::Types(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
@@ -20,6 +20,7 @@
 #include <osn-error.hpp>
 #include <obs.h>
 #include "osn-source.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 
 void osn::Global::Register(ipc::server &srv)
@@ -39,6 +40,7 @@ void osn::Global::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("GetMultipleRendering", std::vector<ipc::type>{}, GetMultipleRendering));
 	cls->register_function(std::make_shared<ipc::function>("SetMultipleRendering", std::vector<ipc::type>{ipc::type::Int32}, SetMultipleRendering));
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::Global::GetOutputSource(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
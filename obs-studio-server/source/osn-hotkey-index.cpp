@@ -0,0 +1,248 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-hotkey-index.hpp"
+#include <algorithm>
+#include <obs.hpp>
+
+constexpr size_t osn::HotkeyIndex::MaxTombstones;
+
+// Resolves everything the frontend shows for a hotkey. Returns false for
+// hotkeys the frontend does not list (frontend-owned or orphaned ones).
+static bool FillEntry(obs_hotkey_t *key, osn::HotkeyIndex::Entry &entry)
+{
+	// Make sure every word has an initial capital letter
+	auto ToTitle = [](std::string s) {
+		bool last = true;
+		for (char &c : s) {
+			int full_c = (uint8_t)c;
+			full_c = last ? ::toupper(full_c) : ::tolower(full_c);
+			last = ::isspace(full_c);
+		}
+		return s;
+	};
+
+	auto registerer_type = obs_hotkey_get_registerer_type(key);
+	void *registerer = obs_hotkey_get_registerer(key);
+	if (registerer == nullptr)
+		return false;
+
+	// Discover the type of object registered with this hotkey
+	switch (registerer_type) {
+	case OBS_HOTKEY_REGISTERER_SOURCE: {
+		auto key_source = OBSGetStrongRef(static_cast<obs_weak_source_t *>(registerer));
+		if (key_source == nullptr)
+			return false;
+		entry.objectName = obs_source_get_name(key_source);
+		break;
+	}
+	case OBS_HOTKEY_REGISTERER_OUTPUT: {
+		auto key_output = OBSGetStrongRef(static_cast<obs_weak_output_t *>(registerer));
+		if (key_output == nullptr)
+			return false;
+		entry.objectName = obs_output_get_name(key_output);
+		break;
+	}
+	case OBS_HOTKEY_REGISTERER_ENCODER: {
+		auto key_encoder = OBSGetStrongRef(static_cast<obs_weak_encoder_t *>(registerer));
+		if (key_encoder == nullptr)
+			return false;
+		entry.objectName = obs_encoder_get_name(key_encoder);
+		break;
+	}
+	case OBS_HOTKEY_REGISTERER_SERVICE: {
+		auto key_service = OBSGetStrongRef(static_cast<obs_weak_service_t *>(registerer));
+		if (key_service == nullptr)
+			return false;
+		entry.objectName = obs_service_get_name(key_service);
+		break;
+	}
+	default:
+		// Ignore any frontend hotkey
+		return false;
+	}
+
+	// Key defs
+	const char *_key_name = obs_hotkey_get_name(key);
+	const char *_desc = obs_hotkey_get_description(key);
+	if (!_key_name)
+		return false;
+	if (!_desc)
+		_desc = "";
+
+	auto key_name = std::string(_key_name);
+	auto desc = std::string(_desc);
+
+	// Parse the key name and the description
+	key_name = key_name.substr(key_name.find_first_of(".") + 1);
+	std::replace(key_name.begin(), key_name.end(), '-', '_');
+	std::transform(key_name.begin(), key_name.end(), key_name.begin(), ::toupper);
+	std::replace(desc.begin(), desc.end(), '-', ' ');
+
+	entry.objectType = registerer_type;
+	entry.hotkeyName = key_name;
+	entry.hotkeyDesc = ToTitle(desc);
+	entry.hotkeyId = obs_hotkey_get_id(key);
+	entry.registerer = registerer;
+	return true;
+}
+
+void osn::HotkeyIndex::Initialize()
+{
+	signal_handler_t *sh = obs_get_signal_handler();
+	signal_handler_connect(sh, "hotkey_register", hotkey_register_cb, this);
+	signal_handler_connect(sh, "hotkey_unregister", hotkey_unregister_cb, this);
+	signal_handler_connect(sh, "source_rename", source_rename_cb, this);
+
+	// Pick up anything registered before the signals were connected.
+	obs_enum_hotkeys(
+		[](void *data, obs_hotkey_id id, obs_hotkey_t *key) {
+			static_cast<HotkeyIndex *>(data)->Add(key);
+			return true;
+		},
+		this);
+}
+
+void osn::HotkeyIndex::Finalize()
+{
+	signal_handler_t *sh = obs_get_signal_handler();
+	signal_handler_disconnect(sh, "source_rename", source_rename_cb, this);
+	signal_handler_disconnect(sh, "hotkey_unregister", hotkey_unregister_cb, this);
+	signal_handler_disconnect(sh, "hotkey_register", hotkey_register_cb, this);
+
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	m_entries.clear();
+	m_changes.clear();
+	m_tombstones = 0;
+	// Anyone holding an older generation has to start over.
+	m_horizon = ++m_generation;
+}
+
+uint64_t osn::HotkeyIndex::Query(uint64_t since, std::vector<Entry> &changed, bool &reset)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+
+	reset = since == 0 || since < m_horizon || since > m_generation;
+	if (reset) {
+		changed.reserve(m_entries.size());
+		for (auto &kv : m_entries) {
+			if (!kv.second.removed)
+				changed.push_back(kv.second);
+		}
+	} else {
+		for (auto iter = m_changes.upper_bound(since); iter != m_changes.end(); iter++)
+			changed.push_back(m_entries[iter->second]);
+	}
+
+	return m_generation;
+}
+
+void osn::HotkeyIndex::hotkey_register_cb(void *ptr, calldata_t *cd)
+{
+	obs_hotkey_t *key = nullptr;
+	if (!calldata_get_ptr(cd, "key", &key) || !key)
+		return;
+	static_cast<HotkeyIndex *>(ptr)->Add(key);
+}
+
+void osn::HotkeyIndex::hotkey_unregister_cb(void *ptr, calldata_t *cd)
+{
+	obs_hotkey_t *key = nullptr;
+	if (!calldata_get_ptr(cd, "key", &key) || !key)
+		return;
+	static_cast<HotkeyIndex *>(ptr)->Remove(key);
+}
+
+void osn::HotkeyIndex::source_rename_cb(void *ptr, calldata_t *cd)
+{
+	obs_source_t *source = nullptr;
+	if (!calldata_get_ptr(cd, "source", &source) || !source)
+		return;
+	static_cast<HotkeyIndex *>(ptr)->Rename(source, calldata_string(cd, "new_name"));
+}
+
+void osn::HotkeyIndex::Add(obs_hotkey_t *key)
+{
+	Entry entry;
+	if (!FillEntry(key, entry))
+		return;
+
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	auto iter = m_entries.find(entry.hotkeyId);
+	if (iter != m_entries.end()) {
+		if (iter->second.removed)
+			m_tombstones--;
+		m_changes.erase(iter->second.generation);
+		iter->second = entry;
+	} else {
+		iter = m_entries.emplace(entry.hotkeyId, entry).first;
+	}
+	Touch(iter->second);
+}
+
+void osn::HotkeyIndex::Remove(obs_hotkey_t *key)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	auto iter = m_entries.find(obs_hotkey_get_id(key));
+	if (iter == m_entries.end() || iter->second.removed)
+		return;
+
+	m_changes.erase(iter->second.generation);
+	iter->second.removed = true;
+	iter->second.registerer = nullptr;
+	Touch(iter->second);
+	m_tombstones++;
+
+	// Forget the oldest removals, callers older than that get a full snapshot.
+	for (auto change = m_changes.begin(); m_tombstones > MaxTombstones && change != m_changes.end();) {
+		auto entry = m_entries.find(change->second);
+		if (entry->second.removed) {
+			m_horizon = change->first;
+			m_entries.erase(entry);
+			change = m_changes.erase(change);
+			m_tombstones--;
+		} else {
+			change++;
+		}
+	}
+}
+
+void osn::HotkeyIndex::Rename(obs_source_t *source, const char *name)
+{
+	obs_weak_source_t *weak = obs_source_get_weak_source(source);
+
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	for (auto &kv : m_entries) {
+		Entry &entry = kv.second;
+		if (entry.removed || entry.objectType != OBS_HOTKEY_REGISTERER_SOURCE || entry.registerer != weak)
+			continue;
+
+		m_changes.erase(entry.generation);
+		entry.objectName = name ? name : "";
+		Touch(entry);
+	}
+	ulock.unlock();
+
+	obs_weak_source_release(weak);
+}
+
+void osn::HotkeyIndex::Touch(Entry &entry)
+{
+	entry.generation = ++m_generation;
+	m_changes[entry.generation] = entry.hotkeyId;
+}
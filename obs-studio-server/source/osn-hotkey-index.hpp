@@ -0,0 +1,84 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <obs.h>
+
+namespace osn {
+// Mirror of the libobs hotkey registry, kept up to date from the hotkey
+// register/unregister and source rename signals. Every change bumps a
+// generation counter so callers can ask for what changed since their last query.
+class HotkeyIndex {
+public:
+	struct Entry {
+		std::string objectName;
+		obs_hotkey_registerer_type objectType;
+		std::string hotkeyName;
+		std::string hotkeyDesc;
+		obs_hotkey_id hotkeyId;
+
+		void *registerer = nullptr;
+		uint64_t generation = 0;
+		bool removed = false;
+	};
+
+	// Removed hotkeys are remembered this long so they can be reported as removed.
+	static constexpr size_t MaxTombstones = 1024;
+
+	static HotkeyIndex &GetInstance()
+	{
+		static HotkeyIndex instance;
+		return instance;
+	}
+
+	HotkeyIndex(HotkeyIndex const &) = delete;
+	void operator=(HotkeyIndex const &) = delete;
+
+	void Initialize();
+	void Finalize();
+
+	// Copies every entry changed after `since`, removed ones included, and returns
+	// the current generation. If `since` is 0 or too old to be answered with a
+	// difference, `reset` is set and `changed` holds every live hotkey instead.
+	uint64_t Query(uint64_t since, std::vector<Entry> &changed, bool &reset);
+
+private:
+	HotkeyIndex() {}
+
+	static void hotkey_register_cb(void *ptr, calldata_t *cd);
+	static void hotkey_unregister_cb(void *ptr, calldata_t *cd);
+	static void source_rename_cb(void *ptr, calldata_t *cd);
+
+	void Add(obs_hotkey_t *key);
+	void Remove(obs_hotkey_t *key);
+	void Rename(obs_source_t *source, const char *name);
+	void Touch(Entry &entry);
+
+	std::mutex m_mutex;
+	std::map<obs_hotkey_id, Entry> m_entries;
+	// Generation of the last change -> hotkey, used to answer Query() without a full scan.
+	std::map<uint64_t, obs_hotkey_id> m_changes;
+	uint64_t m_generation = 0;
+	uint64_t m_horizon = 0;
+	size_t m_tombstones = 0;
+};
+} // namespace osn
@@ -23,6 +23,7 @@
 #include <obs.h>
 #include "osn-error.hpp"
 #include "osn-source.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 
 void osn::Input::Register(ipc::server &srv)
@@ -38,6 +39,7 @@ void osn::Input::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("CreatePrivate", std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String},
 							       CreatePrivate));
 	cls->register_function(std::make_shared<ipc::function>("FromName", std::vector<ipc::type>{ipc::type::String}, FromName));
+	cls->register_function(std::make_shared<ipc::function>("FromNames", std::vector<ipc::type>{ipc::type::Binary}, FromNames));
 	cls->register_function(std::make_shared<ipc::function>("GetPublicSources", std::vector<ipc::type>{}, GetPublicSources));
 
 	cls->register_function(std::make_shared<ipc::function>("Duplicate", std::vector<ipc::type>{ipc::type::UInt64}, Duplicate));
@@ -83,6 +85,7 @@ void osn::Input::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("GetMediaState", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int64}, GetMediaState));
 
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::Input::Types(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
@@ -202,20 +205,31 @@ void osn::Input::Duplicate(void *data, const int64_t id, const std::vector<ipc::
 
 void osn::Input::FromName(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	obs_source_t *source = obs_get_source_by_name(args[0].value_str.c_str());
-	if (!source) {
+	uint64_t uid = osn::Source::Manager::GetInstance().find_by_name(args[0].value_str);
+	if (uid == UINT64_MAX) {
 		PRETTY_ERROR_RETURN(ErrorCode::NotFound, "Named input could not be found.");
 	}
 
-	uint64_t uid = osn::Source::Manager::GetInstance().find(source);
-	if (uid == UINT64_MAX) {
-		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Source found but not indexed.");
-	}
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(uid));
+	AUTO_DEBUG;
+}
 
-	obs_source_release(source);
+void osn::Input::FromNames(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	// Names are packed back to back, each one terminated by a null character.
+	const std::vector<char> &names = args[0].value_bin;
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-	rval.push_back(ipc::value(uid));
+	size_t start = 0;
+	for (size_t idx = 0; idx < names.size(); idx++) {
+		if (names[idx] != '\0')
+			continue;
+
+		std::string name(names.data() + start, idx - start);
+		rval.push_back(ipc::value(osn::Source::Manager::GetInstance().find_by_name(name)));
+		start = idx + 1;
+	}
 	AUTO_DEBUG;
 }
 
@@ -0,0 +1,220 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-media-events.hpp"
+#include <ipc-class.hpp>
+#include <ipc-function.hpp>
+#include <algorithm>
+#include <util/platform.h>
+#include "osn-error.hpp"
+#include "osn-method-table.hpp"
+#include "osn-source.hpp"
+#include "shared.hpp"
+#include "utility.hpp"
+
+void osn::MediaEvents::Register(ipc::server &srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("MediaEvents");
+	cls->register_function(std::make_shared<ipc::function>("Subscribe", std::vector<ipc::type>{ipc::type::UInt64}, Subscribe));
+	cls->register_function(std::make_shared<ipc::function>("Unsubscribe", std::vector<ipc::type>{ipc::type::UInt64}, Unsubscribe));
+	cls->register_function(std::make_shared<ipc::function>("SetInterval", std::vector<ipc::type>{ipc::type::UInt32}, SetInterval));
+	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
+}
+
+void osn::MediaEvents::ConnectSignals(obs_source_t *source, bool connect)
+{
+	signal_handler_t *sh = obs_source_get_signal_handler(source);
+	if (!sh)
+		return;
+
+	auto fn = connect ? signal_handler_connect : signal_handler_disconnect;
+	fn(sh, "media_started", OnStarted, nullptr);
+	fn(sh, "media_ended", OnEnded, nullptr);
+	fn(sh, "media_pause", OnPause, nullptr);
+	fn(sh, "media_play", OnPlay, nullptr);
+	fn(sh, "media_restart", OnRestart, nullptr);
+	fn(sh, "media_stopped", OnStopped, nullptr);
+}
+
+void osn::MediaEvents::Mark(calldata_t *cd, media::Reason reason)
+{
+	obs_source_t *source = nullptr;
+	if (!calldata_get_ptr(cd, "source", &source))
+		return;
+
+	uint64_t uid = osn::Source::Manager::GetInstance().find(source);
+
+	MediaEvents &instance = GetInstance();
+	std::unique_lock<std::mutex> ulock(instance.m_mutex);
+	auto found = instance.m_subscriptions.find(uid);
+	if (found == instance.m_subscriptions.end())
+		return;
+
+	found->second.pending = true;
+	found->second.reason = reason;
+}
+
+void osn::MediaEvents::Subscribe(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	uint64_t uid = args[0].value_union.ui64;
+	obs_source_t *source = osn::Source::Manager::GetInstance().find(uid);
+	if (!source) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not valid.");
+	}
+
+	MediaEvents &instance = GetInstance();
+	std::unique_lock<std::mutex> clock(instance.m_connect_mutex);
+	{
+		std::unique_lock<std::mutex> ulock(instance.m_mutex);
+		if (instance.m_subscriptions.count(uid)) {
+			rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+			return;
+		}
+
+		// The first query always reports the current state.
+		Subscription subscription;
+		subscription.weak = obs_source_get_weak_source(source);
+		subscription.pending = true;
+		instance.m_subscriptions.emplace(uid, subscription);
+	}
+	// Signal callbacks take m_mutex while libobs holds the signal lock, so
+	// (dis)connecting happens outside of it, under m_connect_mutex instead.
+	ConnectSignals(source, true);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::MediaEvents::Unsubscribe(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	MediaEvents &instance = GetInstance();
+	std::unique_lock<std::mutex> clock(instance.m_connect_mutex);
+	obs_weak_source_t *weak = nullptr;
+	{
+		std::unique_lock<std::mutex> ulock(instance.m_mutex);
+		auto found = instance.m_subscriptions.find(args[0].value_union.ui64);
+		if (found != instance.m_subscriptions.end()) {
+			weak = found->second.weak;
+			instance.m_subscriptions.erase(found);
+		}
+	}
+
+	if (weak) {
+		obs_source_t *source = obs_weak_source_get_source(weak);
+		if (source) {
+			ConnectSignals(source, false);
+			obs_source_release(source);
+		}
+		obs_weak_source_release(weak);
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::MediaEvents::SetInterval(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	uint32_t interval = std::min(std::max(args[0].value_union.ui32, media::MinIntervalMs), media::MaxIntervalMs);
+
+	MediaEvents &instance = GetInstance();
+	std::unique_lock<std::mutex> ulock(instance.m_mutex);
+	instance.m_interval_ns = uint64_t(interval) * 1000000;
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+std::vector<char> osn::MediaEvents::Collect()
+{
+	struct Snapshot {
+		uint64_t uid;
+		obs_weak_source_t *weak;
+		Subscription sub;
+	};
+	std::vector<Snapshot> snapshots;
+	uint64_t interval_ns;
+
+	// Media sources may hold their own lock while signaling, which then
+	// waits for m_mutex in Mark. libobs is only called once it's released.
+	{
+		std::unique_lock<std::mutex> ulock(m_mutex);
+		interval_ns = m_interval_ns;
+		snapshots.reserve(m_subscriptions.size());
+		for (auto &kv : m_subscriptions) {
+			obs_weak_source_addref(kv.second.weak);
+			snapshots.push_back({kv.first, kv.second.weak, kv.second});
+			kv.second.pending = false;
+			kv.second.reason = media::Reason::Position;
+		}
+	}
+
+	std::vector<char> packed;
+	uint64_t now = os_gettime_ns();
+	for (auto &snapshot : snapshots) {
+		Subscription &sub = snapshot.sub;
+
+		obs_source_t *source = obs_weak_source_get_source(snapshot.weak);
+		if (!source) {
+			// The source is gone, so is the subscription.
+			std::unique_lock<std::mutex> ulock(m_mutex);
+			auto found = m_subscriptions.find(snapshot.uid);
+			if (found != m_subscriptions.end() && found->second.weak == snapshot.weak) {
+				obs_weak_source_release(found->second.weak);
+				m_subscriptions.erase(found);
+			}
+		}
+		obs_weak_source_release(snapshot.weak);
+		if (!source)
+			continue;
+
+		// Positions are only sent while playing and at most once per interval,
+		// state changes go out with the next query.
+		int32_t state = int32_t(obs_source_media_get_state(source));
+		bool due = state == OBS_MEDIA_STATE_PLAYING && now - sub.sent_ns >= interval_ns;
+		if (!sub.pending && state == sub.state && !due) {
+			obs_source_release(source);
+			continue;
+		}
+
+		media::Event event;
+		event.uid = snapshot.uid;
+		event.time_ms = obs_source_media_get_time(source);
+		event.duration_ms = obs_source_media_get_duration(source);
+		event.state = state;
+		event.reason = uint32_t(sub.pending ? sub.reason : media::Reason::Position);
+		obs_source_release(source);
+
+		bool sent = sub.pending || state != sub.state || event.time_ms != sub.time_ms;
+		if (sent) {
+			const char *bytes = reinterpret_cast<const char *>(&event);
+			packed.insert(packed.end(), bytes, bytes + sizeof(event));
+		}
+
+		std::unique_lock<std::mutex> ulock(m_mutex);
+		auto found = m_subscriptions.find(snapshot.uid);
+		if (found != m_subscriptions.end()) {
+			found->second.state = state;
+			found->second.time_ms = event.time_ms;
+			if (sent)
+				found->second.sent_ns = now;
+		}
+	}
+
+	return packed;
+}
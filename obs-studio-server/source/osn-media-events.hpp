@@ -0,0 +1,80 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <ipc-server.hpp>
+#include <map>
+#include <mutex>
+#include <obs.h>
+#include <vector>
+#include "media-events.hpp"
+
+namespace osn {
+// Follows the media signals of the sources the client subscribed to and
+// hands out the changes through CallbackManager::GlobalQuery, so the client
+// gets playback state and position without polling every source.
+class MediaEvents {
+public:
+	static MediaEvents &GetInstance()
+	{
+		static MediaEvents instance;
+		return instance;
+	}
+
+	MediaEvents(MediaEvents const &) = delete;
+	void operator=(MediaEvents const &) = delete;
+
+	static void Register(ipc::server &srv);
+
+	static void Subscribe(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void Unsubscribe(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void SetInterval(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+
+	// Packed media::Event array of the sources that changed since the last call.
+	std::vector<char> Collect();
+
+private:
+	MediaEvents() {}
+
+	struct Subscription {
+		obs_weak_source_t *weak = nullptr;
+		int32_t state = OBS_MEDIA_STATE_NONE;
+		int64_t time_ms = -1;
+		uint64_t sent_ns = 0;
+		bool pending = false;
+		media::Reason reason = media::Reason::Position;
+	};
+
+	static void ConnectSignals(obs_source_t *source, bool connect);
+	static void Mark(calldata_t *cd, media::Reason reason);
+
+	static void OnStarted(void *data, calldata_t *cd) { Mark(cd, media::Reason::Started); }
+	static void OnEnded(void *data, calldata_t *cd) { Mark(cd, media::Reason::Ended); }
+	static void OnPause(void *data, calldata_t *cd) { Mark(cd, media::Reason::Paused); }
+	static void OnPlay(void *data, calldata_t *cd) { Mark(cd, media::Reason::Played); }
+	static void OnRestart(void *data, calldata_t *cd) { Mark(cd, media::Reason::Restarted); }
+	static void OnStopped(void *data, calldata_t *cd) { Mark(cd, media::Reason::Stopped); }
+
+	// Held across Subscribe and Unsubscribe, so the signals of a source are
+	// (dis)connected in the same order as its subscription changes.
+	std::mutex m_connect_mutex;
+	std::mutex m_mutex;
+	std::map<uint64_t, Subscription> m_subscriptions;
+	uint64_t m_interval_ns = uint64_t(media::DefaultIntervalMs) * 1000000;
+};
+} // namespace osn
@@ -0,0 +1,186 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-method-table.hpp"
+#include <ipc-class.hpp>
+#include <ipc-function.hpp>
+#include "osn-error.hpp"
+#include "packed-args.hpp"
+#include "shared.hpp"
+#include "utility.hpp"
+
+void osn::MethodTable::Add(const std::shared_ptr<ipc::collection> &cls)
+{
+	std::string cname = cls->get_name();
+	for (size_t idx = 0; idx < cls->count_functions(); idx++) {
+		std::shared_ptr<ipc::function> function = cls->get_function(idx);
+		if (!function)
+			continue;
+
+		Method method;
+		method.name = cname + "." + function->get_name();
+		method.action = cname + "::" + function->get_name();
+		method.function = function;
+		for (size_t param = 0; param < function->count_parameters(); param++)
+			method.params.push_back(function->get_parameter_type(param));
+		method.concurrent = IsConcurrent(cname, function->get_name());
+		m_methods.push_back(std::move(method));
+	}
+}
+
+void osn::MethodTable::SetHooks(const Hooks *hooks)
+{
+	m_hooks.store(hooks, std::memory_order_release);
+}
+
+bool osn::MethodTable::IsConcurrent(const std::string &cname, const std::string &fname)
+{
+	// The calls of the realtime lane. Each of these only touches state that
+	// is guarded by its own mutex (output signals, autoconfig events, the
+	// source size map, media events, volmeters, the object managers and the
+	// displays). Dispatch.Call locks around the function it forwards to instead.
+	static const std::pair<const char *, const char *> concurrent[] = {
+		{CollectionName, "GetMethods"},
+		{CollectionName, "Ping"},
+		{CollectionName, "Call"},
+		{"CallbackManager", "GlobalQuery"},
+		{"NodeOBS_Service", "Query"},
+		{"AutoConfig", "Query"},
+		{"Display", "OBS_content_resizeDisplay"},
+		{"Display", "OBS_content_moveDisplay"},
+	};
+	for (auto &entry : concurrent) {
+		if (cname == entry.first && fname == entry.second)
+			return true;
+	}
+	return false;
+}
+
+// The call lock held between the pre and post callbacks of this thread's
+// connection. Being a guard, it is also released if the worker thread ends.
+static thread_local std::unique_lock<std::mutex> call_lock;
+
+static void release_call_lock()
+{
+	if (call_lock.owns_lock())
+		call_lock.unlock();
+}
+
+void osn::MethodTable::Lock(const std::string &cname, const std::string &fname)
+{
+	// A handler that threw skipped its post callback, drop the lock it left behind.
+	release_call_lock();
+	if (IsConcurrent(cname, fname))
+		return;
+	call_lock = std::unique_lock<std::mutex>(m_callLock);
+}
+
+void osn::MethodTable::Unlock()
+{
+	release_call_lock();
+}
+
+void osn::MethodTable::Register(ipc::server &srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>(CollectionName);
+	cls->register_function(std::make_shared<ipc::function>("GetMethods", std::vector<ipc::type>{}, GetMethods));
+	cls->register_function(std::make_shared<ipc::function>("Call", std::vector<ipc::type>{ipc::type::UInt32, ipc::type::Binary}, Call));
+	cls->register_function(std::make_shared<ipc::function>("Ping", std::vector<ipc::type>{ipc::type::UInt64}, Ping));
+	srv.register_collection(cls);
+	GetInstance().Add(cls);
+
+	srv.set_pre_callback(
+		[](std::string cname, std::string fname, const std::vector<ipc::value> &args, void *data) {
+			MethodTable &table = *static_cast<MethodTable *>(data);
+			// Calls made by method id are locked and reported by Call under their own name.
+			if (cname == CollectionName && fname == "Call")
+				return;
+			table.Lock(cname, fname);
+			const Hooks *hooks = table.m_hooks.load(std::memory_order_acquire);
+			if (hooks)
+				hooks->pre(cname + "::" + fname, args, hooks->data);
+		},
+		&GetInstance());
+	srv.set_post_callback(
+		[](std::string cname, std::string fname, const std::vector<ipc::value> &args, void *data) {
+			MethodTable &table = *static_cast<MethodTable *>(data);
+			if (cname == CollectionName && fname == "Call")
+				return;
+			const Hooks *hooks = table.m_hooks.load(std::memory_order_acquire);
+			if (hooks)
+				hooks->post(cname + "::" + fname, args, hooks->data);
+			table.Unlock();
+		},
+		&GetInstance());
+}
+
+void osn::MethodTable::GetMethods(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	MethodTable &table = GetInstance();
+
+	// "Collection.Function" names separated by '\0', the index is the id.
+	std::vector<char> names;
+	for (const Method &method : table.m_methods) {
+		names.insert(names.end(), method.name.begin(), method.name.end());
+		names.push_back('\0');
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value((uint32_t)table.m_methods.size()));
+	rval.push_back(ipc::value(names));
+	AUTO_DEBUG;
+}
+
+void osn::MethodTable::Call(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	MethodTable &table = GetInstance();
+
+	uint32_t method_id = args[0].value_union.ui32;
+	if (method_id >= table.m_methods.size()) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid method id.");
+	}
+	const Method &method = table.m_methods[method_id];
+
+	std::vector<ipc::value> method_args;
+	method_args.reserve(method.params.size());
+	if (!packed::Unpack(args[1].value_bin, method_args)) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Invalid packed arguments.");
+	}
+	if (!packed::Matches(method_args, method.params)) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Arguments do not match " + method.name + ".");
+	}
+	// Scoped, so a throwing handler cannot leave it locked.
+	release_call_lock();
+	std::unique_lock<std::mutex> ulock(table.m_callLock, std::defer_lock);
+	if (!method.concurrent)
+		ulock.lock();
+	const Hooks *hooks = table.m_hooks.load(std::memory_order_acquire);
+	if (hooks)
+		hooks->pre(method.action, method_args, hooks->data);
+	method.function->call(id, method_args, rval);
+	hooks = table.m_hooks.load(std::memory_order_acquire);
+	if (hooks)
+		hooks->post(method.action, rval, hooks->data);
+}
+
+void osn::MethodTable::Ping(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(args[0].value_union.ui64));
+	AUTO_DEBUG;
+}
@@ -0,0 +1,102 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <ipc-server.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace osn {
+// Flat table of every registered IPC function. The client fetches the names
+// once after connecting and from then on calls Dispatch.Call with the index
+// of the function instead of its collection and function names. The
+// arguments of the function are packed into one Binary value (packed-args.hpp)
+// so a single Dispatch.Call signature fits every function.
+//
+// The table also owns the pre and post callbacks of the server, which hold
+// the call lock around each handler. The client's realtime lane is a second
+// connection, so the server runs two handlers at once, while most handlers
+// were written for a single worker and share libobs objects and globals
+// without a lock of their own. Every call therefore takes the call lock,
+// except the few the realtime lane makes (see IsConcurrent), which keep
+// their state under their own mutex.
+class MethodTable {
+public:
+	static constexpr const char *CollectionName = "Dispatch";
+
+	typedef void (*call_hook_t)(const std::string &action, const std::vector<ipc::value> &args, void *data);
+
+	struct Hooks {
+		call_hook_t pre;
+		call_hook_t post;
+		void *data;
+	};
+
+	static MethodTable &GetInstance()
+	{
+		static MethodTable instance;
+		return instance;
+	}
+
+	MethodTable(MethodTable const &) = delete;
+	void operator=(MethodTable const &) = delete;
+
+	// Appends every function of the collection. Only called while registering,
+	// before the server accepts connections, so the table needs no lock.
+	void Add(const std::shared_ptr<ipc::collection> &cls);
+	// Same as the pre and post callbacks of ipc::server, with the action name
+	// ("Collection::Function") already built. Called with the call lock held.
+	// Can be swapped while calls run, so `hooks` must stay valid for as long
+	// as the server does. nullptr removes them, and the action name is then
+	// not built at all.
+	void SetHooks(const Hooks *hooks);
+
+	// Whether the function runs without the call lock.
+	static bool IsConcurrent(const std::string &cname, const std::string &fname);
+
+	static void Register(ipc::server &srv);
+
+	static void GetMethods(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void Call(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void Ping(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+
+private:
+	MethodTable() {}
+
+	struct Method {
+		std::string name;
+		std::string action;
+		std::shared_ptr<ipc::function> function;
+		// Checked by Call, which bypasses the ipc library's own type match.
+		std::vector<ipc::type> params;
+		bool concurrent;
+	};
+
+	// Taken in the server's pre callback and released in its post callback,
+	// both run on the worker of the connection.
+	void Lock(const std::string &cname, const std::string &fname);
+	void Unlock();
+
+	std::vector<Method> m_methods;
+	std::mutex m_callLock;
+	std::atomic<const Hooks *> m_hooks{nullptr};
+};
+} // namespace osn
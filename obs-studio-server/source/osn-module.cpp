@@ -18,6 +18,7 @@
 
 #include "osn-module.hpp"
 #include "osn-error.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 
 void osn::Module::Register(ipc::server &srv)
@@ -36,6 +37,7 @@ void osn::Module::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("GetDataPath", std::vector<ipc::type>{ipc::type::UInt64}, GetDataPath));
 
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::Module::Open(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
@@ -17,6 +17,7 @@
 ******************************************************************************/
 #include "osn-network.hpp"
 #include "osn-error.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 
 void osn::INetwork::Register(ipc::server &srv)
@@ -39,6 +40,7 @@ void osn::INetwork::Register(ipc::server &srv)
 		std::make_shared<ipc::function>("SetEnableLowLatency", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetEnableLowLatency));
 
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::INetwork::Create(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
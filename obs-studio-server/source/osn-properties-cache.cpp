@@ -0,0 +1,167 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-properties-cache.hpp"
+#include <cstring>
+#include "utility.hpp"
+
+constexpr size_t osn::PropertiesCache::MaxEntries;
+constexpr std::chrono::seconds osn::PropertiesCache::MaxAge;
+
+static uint64_t hash_settings(obs_data_t *settings)
+{
+	// FNV-1a over the settings JSON, which only contains user-set values.
+	uint64_t hash = 14695981039346656037ULL;
+	const char *json = settings ? obs_data_get_json(settings) : nullptr;
+	if (!json)
+		return hash;
+
+	for (const char *ptr = json; *ptr; ptr++) {
+		hash ^= uint8_t(*ptr);
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+static bool lists_system_state(obs_source_t *source)
+{
+	// Their lists are enumerated from the system (windows, capture and audio
+	// devices, monitors) and change while the settings stay the same.
+	static const char *types[] = {
+		"window_capture", "game_capture", "monitor_capture", "display_capture", "screen_capture", "dshow_input", "av_capture_input",
+		"av_capture_input_v2", "macos_avcapture", "decklink-input", "wasapi_input_capture", "wasapi_output_capture",
+		"wasapi_process_output_capture", "coreaudio_input_capture", "coreaudio_output_capture", "sck_audio_capture",
+	};
+	const char *id = obs_source_get_id(source);
+	if (!id)
+		return false;
+	for (const char *type : types) {
+		if (strcmp(id, type) == 0)
+			return true;
+	}
+	return false;
+}
+
+osn::PropertiesCache::Entry osn::PropertiesCache::Get(obs_source_t *source)
+{
+	obs_data_t *settings = obs_source_get_settings(source);
+	uint64_t settingsHash = hash_settings(settings);
+	auto now = std::chrono::steady_clock::now();
+	bool cacheable = !lists_system_state(source);
+	uint64_t invalidations;
+
+	{
+		std::unique_lock<std::mutex> ulock(m_mutex);
+		invalidations = m_invalidations;
+		auto iter = m_items.find(source);
+		if (iter != m_items.end()) {
+			if (cacheable && iter->second.settingsHash == settingsHash && now - iter->second.built < MaxAge) {
+				iter->second.used = now;
+				obs_data_release(settings);
+				return iter->second.entry;
+			}
+			m_items.erase(iter);
+		}
+	}
+
+	// Build outside of the lock, property callbacks can take a while.
+	obs_properties_t *prp = obs_source_properties(source);
+	std::shared_ptr<std::vector<char>> packed = std::make_shared<std::vector<char>>();
+	utility::PackProperties(prp, settings, *packed);
+	obs_properties_destroy(prp);
+
+	// Building the properties may have filled in settings, push them back to the source.
+	obs_source_update(source, settings);
+	obs_data_release(settings);
+
+	// Key the entry by the settings the source ends up with.
+	settings = obs_source_get_settings(source);
+	settingsHash = hash_settings(settings);
+	obs_data_release(settings);
+
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	if (!cacheable || m_invalidations != invalidations) {
+		// Not kept, or something was invalidated while building and this
+		// tree may already be stale.
+		Entry entry;
+		entry.version = ++m_version;
+		entry.packed = packed;
+		return entry;
+	}
+
+	Item &item = Emplace(source);
+	item.entry.version = ++m_version;
+	item.entry.packed = packed;
+	item.settingsHash = settingsHash;
+	item.built = now;
+	item.used = now;
+	return item.entry;
+}
+
+std::shared_ptr<const std::vector<char>> osn::PropertiesCache::Find(obs_source_t *source, uint64_t version)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	auto iter = m_items.find(source);
+	if (version == 0 || iter == m_items.end() || iter->second.entry.version != version)
+		return nullptr;
+	return iter->second.entry.packed;
+}
+
+uint64_t osn::PropertiesCache::Store(obs_source_t *source, obs_data_t *settings, std::shared_ptr<const std::vector<char>> packed)
+{
+	uint64_t settingsHash = hash_settings(settings);
+
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	// Builds that started before this must not replace it.
+	m_invalidations++;
+
+	Item &item = Emplace(source);
+	item.entry.version = ++m_version;
+	item.entry.packed = packed;
+	item.settingsHash = settingsHash;
+	item.built = std::chrono::steady_clock::now();
+	item.used = item.built;
+	return item.entry.version;
+}
+
+void osn::PropertiesCache::Invalidate(obs_source_t *source)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	m_items.erase(source);
+	m_invalidations++;
+}
+
+void osn::PropertiesCache::Clear()
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+	m_items.clear();
+	m_invalidations++;
+}
+
+osn::PropertiesCache::Item &osn::PropertiesCache::Emplace(obs_source_t *source)
+{
+	if (m_items.size() >= MaxEntries && m_items.find(source) == m_items.end()) {
+		auto oldest = m_items.begin();
+		for (auto iter = m_items.begin(); iter != m_items.end(); iter++) {
+			if (iter->second.used < oldest->second.used)
+				oldest = iter;
+		}
+		m_items.erase(oldest);
+	}
+	return m_items[source];
+}
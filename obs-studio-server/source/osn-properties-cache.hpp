@@ -0,0 +1,92 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <obs.h>
+
+namespace osn {
+// Serialized property tree of each source. get_properties depends on the
+// instance (its parent, its size, what it found on the system when it was
+// built), so trees are never shared between sources. An entry is dropped
+// when the source is updated, when a property callback or button ran, and
+// when the source is destroyed. It is also rebuilt if the settings changed
+// behind our back, and after MaxAge, since some lists come from the system
+// (devices, windows) and change without the settings. Sources that are made
+// of such lists are never cached. Each blob gets a new version so the client
+// can tell whether the tree it already holds is still current.
+//
+// A hit does not update the source. The build pushes the defaults filled in
+// by get_properties back to the source, and the entry is keyed by the
+// settings it ended up with, so a hit has nothing left to push.
+class PropertiesCache {
+public:
+	struct Entry {
+		uint64_t version = 0;
+		std::shared_ptr<const std::vector<char>> packed;
+	};
+
+	static constexpr size_t MaxEntries = 128;
+	static constexpr std::chrono::seconds MaxAge{5};
+
+	static PropertiesCache &GetInstance()
+	{
+		static PropertiesCache instance;
+		return instance;
+	}
+
+	PropertiesCache(PropertiesCache const &) = delete;
+	void operator=(PropertiesCache const &) = delete;
+
+	Entry Get(obs_source_t *source);
+	// The cached tree of the source if it still has this version, nullptr
+	// otherwise. Never builds one.
+	std::shared_ptr<const std::vector<char>> Find(obs_source_t *source, uint64_t version);
+	// Replaces the entry with a tree built from `settings`, e.g. after a
+	// modified callback ran, and returns its new version.
+	uint64_t Store(obs_source_t *source, obs_data_t *settings, std::shared_ptr<const std::vector<char>> packed);
+	// Drops the entry of the source, e.g. after an update, a property
+	// callback or a button may have changed what the properties look like.
+	void Invalidate(obs_source_t *source);
+	void Clear();
+
+private:
+	PropertiesCache() {}
+
+	struct Item {
+		Entry entry;
+		uint64_t settingsHash;
+		std::chrono::steady_clock::time_point built;
+		std::chrono::steady_clock::time_point used;
+	};
+
+	// Entry of the source, evicting the least recently used one if full.
+	// Must hold m_mutex.
+	Item &Emplace(obs_source_t *source);
+
+	std::mutex m_mutex;
+	// Entries are dropped in the destroy signal, before the pointer can be reused.
+	std::map<obs_source_t *, Item> m_items;
+	uint64_t m_version = 0;
+	uint64_t m_invalidations = 0;
+};
+} // namespace osn
@@ -19,16 +19,24 @@
 #include "osn-Properties.hpp"
 #include "osn-error.hpp"
 #include "obs.h"
+#include "obs-property-flat.hpp"
+#include "osn-properties-cache.hpp"
+#include "osn-shared-memory.hpp"
 #include "osn-source.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
+#include "utility.hpp"
 
 void osn::Properties::Register(ipc::server &srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Properties");
 	cls->register_function(
 		std::make_shared<ipc::function>("Modified", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String, ipc::type::String}, Modified));
+	cls->register_function(std::make_shared<ipc::function>(
+		"ModifiedAndDiff", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String, ipc::type::String, ipc::type::UInt64}, ModifiedAndDiff));
 	cls->register_function(std::make_shared<ipc::function>("Clicked", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, Clicked));
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::Properties::Modified(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
@@ -52,12 +60,86 @@ void osn::Properties::Modified(void *data, const int64_t id, const std::vector<i
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 		rval.push_back(ipc::value((int32_t)obs_property_modified(prop, settings)));
 	}
+	osn::PropertiesCache::GetInstance().Invalidate(source);
 	obs_properties_destroy(props);
 	obs_data_release(settings);
 
 	AUTO_DEBUG;
 }
 
+void osn::Properties::ModifiedAndDiff(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	uint64_t sourceId = args[0].value_union.ui64;
+	std::string name = args[1].value_str;
+
+	obs_source_t *source = osn::Source::Manager::GetInstance().find(sourceId);
+	if (!source) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid reference.");
+	}
+
+	obs_properties_t *props = obs_source_properties(source);
+	obs_property_t *prop = obs_properties_get(props, name.c_str());
+	if (!prop) {
+		obs_properties_destroy(props);
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Failed to find property in source.");
+	}
+	obs_data_t *settings = obs_data_create_from_json(args[2].value_str.c_str());
+	uint64_t knownVersion = args[3].value_union.ui64;
+
+	bool modified = obs_property_modified(prop, settings);
+	if (!modified) {
+		osn::PropertiesCache::GetInstance().Invalidate(source);
+		obs_properties_destroy(props);
+		obs_data_release(settings);
+
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+		rval.push_back(ipc::value((int32_t) false));
+		AUTO_DEBUG;
+		return;
+	}
+
+	// The diff is taken against the tree the client holds, so changed values
+	// show up as well as what the callback changed. The new tree replaces it
+	// in the cache, keyed by the settings it was built with.
+	std::shared_ptr<std::vector<char>> after = std::make_shared<std::vector<char>>();
+	utility::PackProperties(props, settings, *after);
+	std::shared_ptr<const std::vector<char>> before = osn::PropertiesCache::GetInstance().Find(source, knownVersion);
+	uint64_t version = osn::PropertiesCache::GetInstance().Store(source, settings, after);
+	obs_properties_destroy(props);
+	obs_data_release(settings);
+
+	obs::flat::View viewBefore, viewAfter;
+	if (!viewAfter.Open(after->data(), after->size()) || (before && !viewBefore.Open(before->data(), before->size()))) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Failed to serialize properties.");
+	}
+
+	// Names of every property in their new order, followed by the records
+	// that are new or differ from what the client had. Without a known tree
+	// that is all of them.
+	std::vector<char> layout;
+	obs::flat::Writer writer;
+	for (uint32_t idx = 0; idx < viewAfter.Count(); idx++) {
+		const obs::flat::Record &record = viewAfter.Get(idx);
+		std::string_view recordName = viewAfter.Str(record.name);
+		layout.insert(layout.end(), recordName.begin(), recordName.end());
+		layout.push_back('\0');
+
+		uint32_t found = before ? viewBefore.Find(recordName) : viewBefore.Count();
+		if (found == viewBefore.Count() || !obs::flat::View::Equal(viewBefore, viewBefore.Get(found), viewAfter, record))
+			writer.Copy(viewAfter, record);
+	}
+
+	std::vector<char> changed;
+	writer.Finish(changed);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value((int32_t) true));
+	rval.push_back(ipc::value(version));
+	rval.push_back(ipc::value(layout));
+	osn::SharedMemory::PushPayload(rval, changed);
+	AUTO_DEBUG;
+}
+
 void osn::Properties::Clicked(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
 	uint64_t sourceId = args[0].value_union.ui64;
@@ -77,6 +159,7 @@ void osn::Properties::Clicked(void *data, const int64_t id, const std::vector<ip
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 		rval.push_back(ipc::value((int32_t)obs_property_button_clicked(prop, source)));
 	}
+	osn::PropertiesCache::GetInstance().Invalidate(source);
 	obs_properties_destroy(props);
 
 	AUTO_DEBUG;
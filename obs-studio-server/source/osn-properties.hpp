@@ -25,6 +25,7 @@ public:
 	static void Register(ipc::server &srv);
 
 	static void Modified(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void ModifiedAndDiff(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 	static void Clicked(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 };
 } // namespace osn
\ No newline at end of file
@@ -18,6 +18,7 @@
 
 #include "osn-reconnect.hpp"
 #include "osn-error.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 
 void osn::IReconnect::Register(ipc::server &srv)
@@ -34,6 +35,7 @@ void osn::IReconnect::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("SetMaxRetries", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetMaxRetries));
 
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::IReconnect::Create(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
@@ -0,0 +1,574 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-rtmp-loopback.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <util/base.h>
+#include <util/platform.h>
+
+#ifdef WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef SOCKET socket_t;
+#define close_socket closesocket
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+typedef int socket_t;
+#define close_socket close
+#endif
+
+static constexpr size_t HandshakeSize = 1536;
+static constexpr uint32_t DefaultChunkSize = 128;
+static constexpr uint32_t MaxMessageSize = 16 * 1024 * 1024;
+static constexpr uint32_t WindowAckSize = 2500000;
+// Small receive buffer so a capped rate pushes back on the sender quickly.
+static constexpr int ShapedReceiveBuffer = 64 * 1024;
+static constexpr int PollIntervalMs = 100;
+static constexpr int PacingSliceMs = 10;
+static constexpr size_t MinPacingSlice = 1460;
+
+enum MessageType : uint8_t {
+	SetChunkSize = 1,
+	WindowAcknowledgementSize = 5,
+	SetPeerBandwidth = 6,
+	CommandAmf3 = 17,
+	CommandAmf0 = 20,
+};
+
+// Balances the WSAStartup of a successful or failed Start.
+static void socket_cleanup()
+{
+#ifdef WIN32
+	WSACleanup();
+#endif
+}
+
+static bool wait_readable(socket_t sock, int timeoutMs)
+{
+	fd_set set;
+	FD_ZERO(&set);
+	FD_SET(sock, &set);
+
+	timeval timeout;
+	timeout.tv_sec = timeoutMs / 1000;
+	timeout.tv_usec = (timeoutMs % 1000) * 1000;
+	return select(int(sock + 1), &set, nullptr, nullptr, &timeout) > 0;
+}
+
+static inline uint32_t read_be24(const uint8_t *data)
+{
+	return (uint32_t(data[0]) << 16) | (uint32_t(data[1]) << 8) | uint32_t(data[2]);
+}
+
+static inline uint32_t read_be32(const uint8_t *data)
+{
+	return (uint32_t(data[0]) << 24) | read_be24(data + 1);
+}
+
+static inline uint32_t read_le32(const uint8_t *data)
+{
+	return uint32_t(data[0]) | (uint32_t(data[1]) << 8) | (uint32_t(data[2]) << 16) | (uint32_t(data[3]) << 24);
+}
+
+// Just enough AMF0 to answer the commands of a publishing client.
+class Amf0Writer {
+public:
+	void Number(double value)
+	{
+		uint64_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		m_data.push_back(0x00);
+		for (int shift = 56; shift >= 0; shift -= 8)
+			m_data.push_back(uint8_t(bits >> shift));
+	}
+
+	void String(const char *value)
+	{
+		m_data.push_back(0x02);
+		Key(value);
+	}
+
+	void Null() { m_data.push_back(0x05); }
+
+	void ObjectBegin() { m_data.push_back(0x03); }
+
+	void Key(const char *key)
+	{
+		size_t length = strlen(key);
+		m_data.push_back(uint8_t(length >> 8));
+		m_data.push_back(uint8_t(length));
+		m_data.insert(m_data.end(), key, key + length);
+	}
+
+	void ObjectEnd()
+	{
+		m_data.push_back(0x00);
+		m_data.push_back(0x00);
+		m_data.push_back(0x09);
+	}
+
+	const std::vector<uint8_t> &Data() const { return m_data; }
+
+private:
+	std::vector<uint8_t> m_data;
+};
+
+class RtmpSession {
+public:
+	RtmpSession(socket_t sock, osn::RtmpLoopback &owner) : m_socket(sock), m_owner(owner) {}
+
+	void Run()
+	{
+		if (Handshake()) {
+			while (ReadChunk())
+				;
+		}
+		close_socket(m_socket);
+	}
+
+private:
+	struct ChunkStream {
+		uint32_t length = 0;
+		uint8_t type = 0;
+		uint32_t streamId = 0;
+		bool extended = false;
+		std::vector<uint8_t> payload;
+	};
+
+	bool Fill(size_t needed)
+	{
+		while (m_buffer.size() - m_offset < needed) {
+			if (!m_owner.IsRunning())
+				return false;
+			if (!wait_readable(m_socket, PollIntervalMs))
+				continue;
+
+			if (m_offset > 0) {
+				m_buffer.erase(m_buffer.begin(), m_buffer.begin() + m_offset);
+				m_offset = 0;
+			}
+
+			size_t allowed = m_owner.Acquire(sizeof(m_receive));
+			int received = recv(m_socket, reinterpret_cast<char *>(m_receive), int(allowed), 0);
+			if (received <= 0) {
+				m_owner.Refund(allowed);
+				return false;
+			}
+
+			m_owner.Refund(allowed - size_t(received));
+			m_owner.CountBytes(size_t(received));
+			m_buffer.insert(m_buffer.end(), m_receive, m_receive + received);
+		}
+		return true;
+	}
+
+	bool Read(uint8_t *out, size_t size)
+	{
+		if (!Fill(size))
+			return false;
+		if (out)
+			memcpy(out, m_buffer.data() + m_offset, size);
+		m_offset += size;
+		return true;
+	}
+
+	bool Write(const std::vector<uint8_t> &data)
+	{
+		size_t sent = 0;
+		while (sent < data.size()) {
+			int result = send(m_socket, reinterpret_cast<const char *>(data.data() + sent), int(data.size() - sent), 0);
+			if (result <= 0)
+				return false;
+			sent += size_t(result);
+		}
+		return true;
+	}
+
+	bool Handshake()
+	{
+		uint8_t c0c1[1 + HandshakeSize];
+		if (!Read(c0c1, sizeof(c0c1)))
+			return false;
+
+		// Only plain RTMP, encrypted handshakes are not supported.
+		if (c0c1[0] != 3)
+			return false;
+
+		m_owner.Delay();
+
+		std::vector<uint8_t> reply(1 + 2 * HandshakeSize, 0);
+		reply[0] = 3;
+		for (size_t idx = 8; idx < HandshakeSize; idx++)
+			reply[1 + idx] = uint8_t(idx * 31);
+		memcpy(reply.data() + 1 + HandshakeSize, c0c1 + 1, HandshakeSize);
+		if (!Write(reply))
+			return false;
+
+		return Read(nullptr, HandshakeSize);
+	}
+
+	bool ReadChunk()
+	{
+		uint8_t basic;
+		if (!Read(&basic, 1))
+			return false;
+
+		uint8_t fmt = basic >> 6;
+		uint32_t csid = basic & 0x3F;
+		if (csid == 0) {
+			uint8_t ext;
+			if (!Read(&ext, 1))
+				return false;
+			csid = 64 + ext;
+		} else if (csid == 1) {
+			uint8_t ext[2];
+			if (!Read(ext, 2))
+				return false;
+			csid = 64 + ext[0] + ext[1] * 256;
+		}
+
+		static const size_t headerSizes[] = {11, 7, 3, 0};
+		uint8_t header[11];
+		if (!Read(header, headerSizes[fmt]))
+			return false;
+
+		ChunkStream &stream = m_streams[csid];
+		if (fmt <= 2)
+			stream.extended = read_be24(header) == 0xFFFFFF;
+		if (fmt <= 1) {
+			stream.length = read_be24(header + 3);
+			stream.type = header[6];
+		}
+		if (fmt == 0)
+			stream.streamId = read_le32(header + 7);
+		if (stream.extended && !Read(nullptr, 4))
+			return false;
+
+		if (stream.length > MaxMessageSize)
+			return false;
+
+		size_t have = stream.payload.size();
+		size_t take = std::min<size_t>(stream.length - have, m_chunkSize);
+		stream.payload.resize(have + take);
+		if (take && !Read(stream.payload.data() + have, take))
+			return false;
+
+		if (stream.payload.size() < stream.length)
+			return true;
+
+		bool result = HandleMessage(stream);
+		stream.payload.clear();
+		return result;
+	}
+
+	bool HandleMessage(const ChunkStream &stream)
+	{
+		const std::vector<uint8_t> &payload = stream.payload;
+		switch (stream.type) {
+		case SetChunkSize:
+			if (payload.size() >= 4)
+				m_chunkSize = std::max<uint32_t>(1, read_be32(payload.data()) & 0x7FFFFFFF);
+			return true;
+		case CommandAmf0:
+			return HandleCommand(payload.data(), payload.size());
+		case CommandAmf3:
+			// AMF3 commands start with a format byte followed by AMF0 values.
+			return payload.empty() || HandleCommand(payload.data() + 1, payload.size() - 1);
+		default:
+			// Audio, video and metadata are only counted.
+			return true;
+		}
+	}
+
+	bool HandleCommand(const uint8_t *data, size_t size)
+	{
+		if (size < 3 || data[0] != 0x02)
+			return true;
+
+		size_t length = (size_t(data[1]) << 8) | data[2];
+		if (3 + length + 9 > size)
+			return true;
+
+		std::string name(reinterpret_cast<const char *>(data + 3), length);
+		const uint8_t *number = data + 3 + length;
+		if (number[0] != 0x00)
+			return true;
+
+		uint64_t bits = 0;
+		for (int idx = 1; idx <= 8; idx++)
+			bits = (bits << 8) | number[idx];
+		double transaction;
+		memcpy(&transaction, &bits, sizeof(transaction));
+
+		if (name == "connect") {
+			m_owner.Delay();
+			m_owner.CountConnection();
+
+			std::vector<uint8_t> ack = {uint8_t(WindowAckSize >> 24), uint8_t(WindowAckSize >> 16), uint8_t(WindowAckSize >> 8),
+						    uint8_t(WindowAckSize)};
+			if (!SendMessage(2, WindowAcknowledgementSize, 0, ack))
+				return false;
+			std::vector<uint8_t> peer = ack;
+			peer.push_back(2);
+			if (!SendMessage(2, SetPeerBandwidth, 0, peer))
+				return false;
+
+			Amf0Writer amf;
+			amf.String("_result");
+			amf.Number(transaction);
+			amf.ObjectBegin();
+			amf.Key("fmsVer");
+			amf.String("FMS/3,0,1,123");
+			amf.Key("capabilities");
+			amf.Number(31);
+			amf.ObjectEnd();
+			amf.ObjectBegin();
+			amf.Key("level");
+			amf.String("status");
+			amf.Key("code");
+			amf.String("NetConnection.Connect.Success");
+			amf.Key("description");
+			amf.String("Connection succeeded.");
+			amf.Key("objectEncoding");
+			amf.Number(0);
+			amf.ObjectEnd();
+			return SendMessage(3, CommandAmf0, 0, amf.Data());
+		}
+
+		if (name == "createStream") {
+			m_owner.Delay();
+
+			Amf0Writer amf;
+			amf.String("_result");
+			amf.Number(transaction);
+			amf.Null();
+			amf.Number(1);
+			return SendMessage(3, CommandAmf0, 0, amf.Data());
+		}
+
+		if (name == "publish") {
+			m_owner.Delay();
+			m_owner.CountPublish();
+
+			Amf0Writer amf;
+			amf.String("onStatus");
+			amf.Number(0);
+			amf.Null();
+			amf.ObjectBegin();
+			amf.Key("level");
+			amf.String("status");
+			amf.Key("code");
+			amf.String("NetStream.Publish.Start");
+			amf.Key("description");
+			amf.String("Publishing to the loopback sink.");
+			amf.ObjectEnd();
+			return SendMessage(5, CommandAmf0, 1, amf.Data());
+		}
+
+		// releaseStream, FCPublish, deleteStream and the like need no answer.
+		return true;
+	}
+
+	bool SendMessage(uint8_t csid, uint8_t type, uint32_t streamId, const std::vector<uint8_t> &payload)
+	{
+		std::vector<uint8_t> out;
+		out.reserve(12 + payload.size() + payload.size() / DefaultChunkSize);
+
+		const uint32_t length = uint32_t(payload.size());
+		out.push_back(csid);
+		out.insert(out.end(), {0, 0, 0});
+		out.insert(out.end(), {uint8_t(length >> 16), uint8_t(length >> 8), uint8_t(length)});
+		out.push_back(type);
+		out.insert(out.end(), {uint8_t(streamId), uint8_t(streamId >> 8), uint8_t(streamId >> 16), uint8_t(streamId >> 24)});
+
+		for (size_t offset = 0; offset < payload.size(); offset += DefaultChunkSize) {
+			if (offset)
+				out.push_back(uint8_t(0xC0 | csid));
+			size_t take = std::min<size_t>(DefaultChunkSize, payload.size() - offset);
+			out.insert(out.end(), payload.begin() + offset, payload.begin() + offset + take);
+		}
+
+		return Write(out);
+	}
+
+	socket_t m_socket;
+	osn::RtmpLoopback &m_owner;
+
+	std::vector<uint8_t> m_buffer;
+	size_t m_offset = 0;
+	uint8_t m_receive[16 * 1024];
+
+	uint32_t m_chunkSize = DefaultChunkSize;
+	std::map<uint32_t, ChunkStream> m_streams;
+};
+
+osn::RtmpLoopback::~RtmpLoopback()
+{
+	Stop();
+}
+
+bool osn::RtmpLoopback::Start(const Shaping &shaping)
+{
+	Stop();
+
+#ifdef WIN32
+	WSADATA wsa;
+	if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0)
+		return false;
+#endif
+
+	socket_t sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (sock == socket_t(-1)) {
+		blog(LOG_ERROR, "[RTMP_LOOPBACK] Failed to create the listening socket");
+		socket_cleanup();
+		return false;
+	}
+
+	if (shaping.throughputKbps) {
+		int size = ShapedReceiveBuffer;
+		setsockopt(sock, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char *>(&size), sizeof(size));
+	}
+
+	sockaddr_in address = {};
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	address.sin_port = 0;
+
+	socklen_t addressSize = sizeof(address);
+	if (bind(sock, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 || listen(sock, 8) != 0 ||
+	    getsockname(sock, reinterpret_cast<sockaddr *>(&address), &addressSize) != 0) {
+		blog(LOG_ERROR, "[RTMP_LOOPBACK] Failed to listen on the loopback interface");
+		close_socket(sock);
+		socket_cleanup();
+		return false;
+	}
+
+	m_shaping = shaping;
+	m_listen = intptr_t(sock);
+	m_port = ntohs(address.sin_port);
+	m_paceNs = 0;
+	m_connections = 0;
+	m_publishes = 0;
+	m_bytesReceived = 0;
+
+	m_running = true;
+	m_acceptThread = std::thread(&RtmpLoopback::AcceptThread, this);
+
+	blog(LOG_INFO, "[RTMP_LOOPBACK] Listening on %s (%u kbps, %u ms)", GetUrl().c_str(), shaping.throughputKbps, shaping.latencyMs);
+	return true;
+}
+
+void osn::RtmpLoopback::Stop()
+{
+	if (!m_running)
+		return;
+
+	m_running = false;
+	if (m_acceptThread.joinable())
+		m_acceptThread.join();
+
+	close_socket(socket_t(m_listen));
+	m_listen = -1;
+	m_port = 0;
+
+	socket_cleanup();
+}
+
+std::string osn::RtmpLoopback::GetUrl() const
+{
+	return "rtmp://127.0.0.1:" + std::to_string(m_port) + "/loopback";
+}
+
+osn::RtmpLoopback::Stats osn::RtmpLoopback::GetStats() const
+{
+	Stats stats;
+	stats.connections = m_connections;
+	stats.publishes = m_publishes;
+	stats.bytesReceived = m_bytesReceived;
+	return stats;
+}
+
+size_t osn::RtmpLoopback::Acquire(size_t wanted)
+{
+	if (!m_shaping.throughputKbps)
+		return wanted;
+
+	std::unique_lock<std::mutex> lock(m_bucketMutex);
+
+	// Reads follow a fixed schedule rather than a bucket refilled by however
+	// long the last sleep took, so the rate does not depend on the timer
+	// resolution. An idle sink banks at most one slice.
+	const double rate = double(m_shaping.throughputKbps) * 1000.0 / 8.0;
+	const size_t slice = std::max(size_t(rate * PacingSliceMs / 1000.0), MinPacingSlice);
+	const uint64_t sliceNs = uint64_t(PacingSliceMs) * 1000000;
+
+	uint64_t now = os_gettime_ns();
+	m_paceNs = std::max(m_paceNs, now > sliceNs ? now - sliceNs : 0);
+	if (m_paceNs > now)
+		os_sleepto_ns(m_paceNs);
+
+	size_t granted = std::min(wanted, slice);
+	m_paceNs += uint64_t(double(granted) * 1000000000.0 / rate);
+	return granted;
+}
+
+void osn::RtmpLoopback::Refund(size_t unused)
+{
+	if (!m_shaping.throughputKbps || !unused)
+		return;
+
+	std::unique_lock<std::mutex> lock(m_bucketMutex);
+	const double rate = double(m_shaping.throughputKbps) * 1000.0 / 8.0;
+	m_paceNs -= std::min(m_paceNs, uint64_t(double(unused) * 1000000000.0 / rate));
+}
+
+void osn::RtmpLoopback::Delay() const
+{
+	if (m_shaping.latencyMs)
+		std::this_thread::sleep_for(std::chrono::milliseconds(m_shaping.latencyMs));
+}
+
+void osn::RtmpLoopback::AcceptThread()
+{
+	socket_t listener = socket_t(m_listen);
+	std::vector<std::thread> sessions;
+
+	while (m_running) {
+		if (!wait_readable(listener, PollIntervalMs))
+			continue;
+
+		socket_t sock = accept(listener, nullptr, nullptr);
+		if (sock == socket_t(-1))
+			continue;
+
+		sessions.emplace_back([this, sock]() {
+			RtmpSession session(sock, *this);
+			session.Run();
+		});
+	}
+
+	for (auto &session : sessions)
+		session.join();
+}
@@ -0,0 +1,86 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <inttypes.h>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace osn {
+// Minimal RTMP ingest listening on the loopback interface. It accepts a publish
+// the way a real ingest server does and discards the media, so the autoconfig
+// bandwidth test can run without network access. The receive rate can be capped
+// and every reply delayed to emulate a slower or more distant server.
+class RtmpLoopback {
+public:
+	struct Shaping {
+		// 0 means unlimited. The cap is shared by every connection, like an uplink.
+		uint32_t throughputKbps = 0;
+		// Added before every handshake and command reply.
+		uint32_t latencyMs = 0;
+	};
+
+	struct Stats {
+		uint64_t connections = 0;
+		uint64_t publishes = 0;
+		uint64_t bytesReceived = 0;
+	};
+
+	RtmpLoopback() {}
+	~RtmpLoopback();
+
+	RtmpLoopback(RtmpLoopback const &) = delete;
+	void operator=(RtmpLoopback const &) = delete;
+
+	bool Start(const Shaping &shaping);
+	void Stop();
+
+	bool IsRunning() const { return m_running; }
+	// rtmp:// address of the listening socket, valid while running.
+	std::string GetUrl() const;
+	Stats GetStats() const;
+
+	// Used by the connections.
+	size_t Acquire(size_t wanted);
+	void Refund(size_t unused);
+	void Delay() const;
+	void CountConnection() { m_connections++; }
+	void CountPublish() { m_publishes++; }
+	void CountBytes(size_t bytes) { m_bytesReceived += bytes; }
+
+private:
+	void AcceptThread();
+
+	Shaping m_shaping;
+	std::atomic<bool> m_running{false};
+	intptr_t m_listen = -1;
+	uint16_t m_port = 0;
+	std::thread m_acceptThread;
+
+	std::mutex m_bucketMutex;
+	// When the next read may start.
+	uint64_t m_paceNs = 0;
+
+	std::atomic<uint64_t> m_connections{0};
+	std::atomic<uint64_t> m_publishes{0};
+	std::atomic<uint64_t> m_bytesReceived{0};
+};
+} // namespace osn
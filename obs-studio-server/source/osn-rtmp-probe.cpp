@@ -0,0 +1,237 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-rtmp-probe.hpp"
+#include <cstring>
+#include <future>
+#include <util/platform.h>
+
+#ifdef WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef SOCKET socket_t;
+#define close_socket closesocket
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+typedef int socket_t;
+#define close_socket close
+#endif
+
+static constexpr size_t HandshakeSize = 1536;
+
+static inline int elapsed_ms(uint64_t since)
+{
+	return int((os_gettime_ns() - since) / 1000000);
+}
+
+// Waits for the socket to become readable or writable, false on timeout or error.
+static bool wait_socket(socket_t sock, bool write, uint64_t deadline)
+{
+	uint64_t now = os_gettime_ns();
+	if (now >= deadline)
+		return false;
+
+	fd_set set, errors;
+	FD_ZERO(&set);
+	FD_ZERO(&errors);
+	FD_SET(sock, &set);
+	FD_SET(sock, &errors);
+
+	uint64_t remaining = (deadline - now) / 1000;
+	timeval timeout;
+	timeout.tv_sec = long(remaining / 1000000);
+	timeout.tv_usec = long(remaining % 1000000);
+
+	int result = select(int(sock + 1), write ? nullptr : &set, write ? &set : nullptr, &errors, &timeout);
+	return result > 0 && !FD_ISSET(sock, &errors);
+}
+
+static bool set_non_blocking(socket_t sock)
+{
+#ifdef WIN32
+	u_long mode = 1;
+	return ioctlsocket(sock, FIONBIO, &mode) == 0;
+#else
+	int flags = fcntl(sock, F_GETFL, 0);
+	return flags >= 0 && fcntl(sock, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+}
+
+static bool connect_pending()
+{
+#ifdef WIN32
+	return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+	return errno == EINPROGRESS;
+#endif
+}
+
+bool osn::RtmpProbe::ParseUrl(const std::string &url, std::string &host, uint16_t &port, bool &secure)
+{
+	size_t scheme = url.find("://");
+	if (scheme == std::string::npos)
+		return false;
+
+	std::string protocol = url.substr(0, scheme);
+	if (protocol == "rtmp") {
+		secure = false;
+		port = 1935;
+	} else if (protocol == "rtmps") {
+		secure = true;
+		port = 443;
+	} else {
+		return false;
+	}
+
+	size_t start = scheme + 3;
+	size_t end = url.find('/', start);
+	std::string authority = url.substr(start, end == std::string::npos ? std::string::npos : end - start);
+
+	size_t colon;
+	if (!authority.empty() && authority[0] == '[') {
+		size_t bracket = authority.find(']');
+		if (bracket == std::string::npos)
+			return false;
+		host = authority.substr(1, bracket - 1);
+		colon = authority.find(':', bracket);
+	} else {
+		colon = authority.find(':');
+		host = authority.substr(0, colon);
+	}
+
+	if (colon != std::string::npos) {
+		int value = atoi(authority.c_str() + colon + 1);
+		if (value <= 0 || value > 65535)
+			return false;
+		port = uint16_t(value);
+	}
+
+	return !host.empty();
+}
+
+osn::RtmpProbe::Result osn::RtmpProbe::Probe(const std::string &url, int timeoutMs)
+{
+	Result result;
+
+	std::string host;
+	uint16_t port;
+	bool secure;
+	if (!ParseUrl(url, host, port, secure))
+		return result;
+
+#ifdef WIN32
+	WSADATA wsa;
+	if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0)
+		return result;
+#endif
+
+	const uint64_t start = os_gettime_ns();
+	const uint64_t deadline = start + uint64_t(timeoutMs) * 1000000;
+
+	addrinfo hints = {};
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_protocol = IPPROTO_TCP;
+
+	addrinfo *addresses = nullptr;
+	socket_t sock = socket_t(-1);
+	if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addresses) != 0 || !addresses)
+		goto done;
+
+	sock = socket(addresses->ai_family, addresses->ai_socktype, addresses->ai_protocol);
+	if (sock == socket_t(-1) || !set_non_blocking(sock))
+		goto done;
+
+	{
+		// Name resolution is not part of the round trip.
+		const uint64_t connectStart = os_gettime_ns();
+		if (connect(sock, addresses->ai_addr, int(addresses->ai_addrlen)) != 0 && !connect_pending())
+			goto done;
+		if (!wait_socket(sock, true, deadline))
+			goto done;
+
+		int error = 0;
+		socklen_t length = sizeof(error);
+		if (getsockopt(sock, SOL_SOCKET, SO_ERROR, reinterpret_cast<char *>(&error), &length) != 0 || error != 0)
+			goto done;
+
+		result.connectMs = elapsed_ms(connectStart);
+		result.reachable = true;
+	}
+
+	if (!secure) {
+		std::vector<char> c0c1(1 + HandshakeSize, 0);
+		c0c1[0] = 3;
+
+		const uint64_t handshakeStart = os_gettime_ns();
+		size_t sent = 0;
+		while (sent < c0c1.size()) {
+			if (!wait_socket(sock, true, deadline))
+				goto done;
+			int count = send(sock, c0c1.data() + sent, int(c0c1.size() - sent), 0);
+			if (count <= 0)
+				goto done;
+			sent += size_t(count);
+		}
+
+		char s0s1[1 + HandshakeSize];
+		size_t received = 0;
+		while (received < sizeof(s0s1)) {
+			if (!wait_socket(sock, false, deadline))
+				goto done;
+			int count = recv(sock, s0s1 + received, int(sizeof(s0s1) - received), 0);
+			if (count <= 0)
+				goto done;
+			received += size_t(count);
+		}
+
+		if (s0s1[0] == 3)
+			result.handshakeMs = elapsed_ms(handshakeStart);
+		else
+			result.reachable = false;
+	}
+
+done:
+	if (sock != socket_t(-1))
+		close_socket(sock);
+	if (addresses)
+		freeaddrinfo(addresses);
+#ifdef WIN32
+	WSACleanup();
+#endif
+	return result;
+}
+
+std::vector<osn::RtmpProbe::Result> osn::RtmpProbe::ProbeAll(const std::vector<std::string> &urls, int timeoutMs)
+{
+	std::vector<std::future<Result>> probes;
+	probes.reserve(urls.size());
+	for (auto &url : urls)
+		probes.push_back(std::async(std::launch::async, Probe, url, timeoutMs));
+
+	std::vector<Result> results;
+	results.reserve(urls.size());
+	for (auto &probe : probes)
+		results.push_back(probe.get());
+	return results;
+}
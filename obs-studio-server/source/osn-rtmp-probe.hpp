@@ -0,0 +1,45 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+#include <string>
+#include <vector>
+
+namespace osn {
+// Lightweight check of an RTMP server: a TCP connect followed by the plain RTMP
+// handshake, without publishing anything. Much cheaper than streaming to the
+// server, so every candidate can be probed before the throughput test.
+class RtmpProbe {
+public:
+	struct Result {
+		bool reachable = false;
+		// TCP connect, roughly one round trip.
+		int connectMs = -1;
+		// C0/C1 sent until S0/S1 received. Stays -1 for rtmps:// where the
+		// handshake happens inside TLS.
+		int handshakeMs = -1;
+	};
+
+	static Result Probe(const std::string &url, int timeoutMs);
+	// Probes every url at the same time, results are in the same order.
+	static std::vector<Result> ProbeAll(const std::vector<std::string> &urls, int timeoutMs);
+
+	static bool ParseUrl(const std::string &url, std::string &host, uint16_t &port, bool &secure);
+};
+} // namespace osn
@@ -21,6 +21,7 @@
 #include "osn-error.hpp"
 #include "osn-sceneitem.hpp"
 #include "osn-video.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 
 void osn::Scene::Register(ipc::server &srv)
@@ -61,6 +62,7 @@ void osn::Scene::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("Connect", std::vector<ipc::type>{ipc::type::UInt64}, Connect));
 	cls->register_function(std::make_shared<ipc::function>("Disconnect", std::vector<ipc::type>{ipc::type::UInt64}, Disconnect));
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::Scene::Create(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
@@ -113,17 +115,9 @@ void osn::Scene::CreatePrivate(void *data, const int64_t id, const std::vector<i
 
 void osn::Scene::FromName(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	obs_source_t *source = obs_get_source_by_name(args[0].value_str.c_str());
-	if (!source) {
-		PRETTY_ERROR_RETURN(ErrorCode::Error, "Failed to get source from scene.");
-	}
-
-	uint64_t uid = osn::Source::Manager::GetInstance().find(source);
-	obs_source_release(source);
-
+	uint64_t uid = osn::Source::Manager::GetInstance().find_by_name(args[0].value_str);
 	if (uid == UINT64_MAX) {
-
-		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Source found but not indexed.");
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Failed to get source from scene.");
 	}
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
@@ -19,6 +19,7 @@
 #include "osn-sceneitem.hpp"
 #include <osn-error.hpp>
 #include "osn-source.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 #include <osn-video.hpp>
 
@@ -88,6 +89,7 @@ void osn::SceneItem::Register(ipc::server &srv)
 	cls->register_function(
 		std::make_shared<ipc::function>("SetBlendingMode", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetBlendingMode));
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::SceneItem::GetSource(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
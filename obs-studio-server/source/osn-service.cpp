@@ -18,7 +18,9 @@
 
 #include "osn-service.hpp"
 #include <osn-error.hpp>
+#include "osn-method-table.hpp"
 #include "shared.hpp"
+#include "osn-shared-memory.hpp"
 #include "nodeobs_service.h"
 
 #include "nodeobs_configManager.hpp"
@@ -43,6 +45,7 @@ void osn::Service::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("SetLegacySettings", std::vector<ipc::type>{}, SetLegacySettings));
 
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::Service::GetTypes(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
@@ -150,7 +153,9 @@ void osn::Service::GetProperties(void *data, const int64_t id, const std::vector
 	obs_properties_t *prp = obs_service_properties(service);
 	obs_data *settings = obs_service_get_settings(service);
 
-	utility::ProcessProperties(prp, settings, rval);
+	std::vector<char> packed;
+	utility::PackProperties(prp, settings, packed);
+	osn::SharedMemory::PushPayload(rval, packed);
 
 	obs_properties_destroy(prp);
 
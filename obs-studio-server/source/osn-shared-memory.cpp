@@ -0,0 +1,149 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-shared-memory.hpp"
+#include <atomic>
+#include <cstring>
+#include <ipc-class.hpp>
+#include <ipc-function.hpp>
+#include <mutex>
+#include <obs.h>
+#include "osn-error.hpp"
+#include "osn-method-table.hpp"
+#include "shared.hpp"
+#include "utility.hpp"
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+static std::mutex arena_mtx;
+static std::unique_ptr<shm::Arena> arena;
+static std::atomic<bool> arena_enabled = false;
+
+static std::string ArenaName()
+{
+#ifdef WIN32
+	return "Local\\osn-shm-" + std::to_string(GetCurrentProcessId());
+#else
+	// macOS limits POSIX shared memory names to 31 characters.
+	return "/osn-shm-" + std::to_string(getpid());
+#endif
+}
+
+void osn::SharedMemory::Register(ipc::server &srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("SharedMemory");
+	cls->register_function(std::make_shared<ipc::function>("Negotiate", std::vector<ipc::type>{}, Negotiate));
+	cls->register_function(std::make_shared<ipc::function>("SetEnabled", std::vector<ipc::type>{ipc::type::Int32}, SetEnabled));
+	cls->register_function(std::make_shared<ipc::function>("Echo", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, Echo));
+	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
+}
+
+void osn::SharedMemory::Finalize()
+{
+	std::unique_lock<std::mutex> ulock(arena_mtx);
+	arena_enabled = false;
+	arena.reset();
+}
+
+void osn::SharedMemory::PushPayload(std::vector<ipc::value> &rval, const std::vector<char> &payload)
+{
+	if (arena_enabled && payload.size() >= shm::DefaultThreshold) {
+		std::unique_lock<std::mutex> ulock(arena_mtx);
+		char *dst = nullptr;
+		uint32_t slot = arena ? arena->Allocate(payload.size(), &dst) : shm::InvalidSlot;
+		if (slot != shm::InvalidSlot) {
+			memcpy(dst, payload.data(), payload.size());
+			rval.push_back(ipc::value(slot));
+			rval.push_back(ipc::value(std::vector<char>()));
+			rval.push_back(ipc::value((uint64_t)payload.size()));
+			return;
+		}
+		blog(LOG_DEBUG, "Shared memory arena is full, sending %zu bytes inline.", payload.size());
+	}
+
+	rval.push_back(ipc::value(shm::InvalidSlot));
+	rval.push_back(ipc::value(payload));
+	rval.push_back(ipc::value((uint64_t)payload.size()));
+}
+
+void osn::SharedMemory::Negotiate(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	std::unique_lock<std::mutex> ulock(arena_mtx);
+	if (!arena) {
+		arena = shm::Arena::Create(ArenaName(), shm::DefaultCapacity);
+	} else {
+		// A client negotiating again dropped every payload it was sent before.
+		uint32_t reclaimed = arena->ReclaimAll();
+		if (reclaimed)
+			blog(LOG_DEBUG, "Reclaimed %u shared memory slots after the client reconnected.", reclaimed);
+	}
+
+	if (!arena) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Failed to create shared memory arena.");
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(arena->Name()));
+	rval.push_back(ipc::value(arena->Capacity()));
+	rval.push_back(ipc::value(shm::DefaultThreshold));
+	AUTO_DEBUG;
+}
+
+void osn::SharedMemory::SetEnabled(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	std::unique_lock<std::mutex> ulock(arena_mtx);
+	arena_enabled = arena && !!args[0].value_union.i32;
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value((int32_t)arena_enabled.load()));
+	AUTO_DEBUG;
+}
+
+void osn::SharedMemory::Echo(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	static std::mutex payload_mtx;
+	static std::vector<char> payload;
+	uint64_t size = args[0].value_union.ui64;
+	bool allowShared = !!args[1].value_union.i32;
+
+	if (size > shm::DefaultCapacity) {
+		PRETTY_ERROR_RETURN(ErrorCode::OutOfBounds, "Payload is larger than the shared memory arena.");
+	}
+
+	std::unique_lock<std::mutex> ulock(payload_mtx);
+	if (payload.size() != size) {
+		payload.resize(size);
+		for (size_t idx = 0; idx < size; idx++)
+			payload[idx] = char(idx & 0xFF);
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	if (allowShared) {
+		PushPayload(rval, payload);
+	} else {
+		rval.push_back(ipc::value(shm::InvalidSlot));
+		rval.push_back(ipc::value(payload));
+		rval.push_back(ipc::value((uint64_t)payload.size()));
+	}
+	AUTO_DEBUG;
+}
@@ -0,0 +1,41 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <ipc-server.hpp>
+#include <vector>
+#include "shared-memory-arena.hpp"
+
+namespace osn {
+class SharedMemory {
+public:
+	static void Register(ipc::server &);
+	static void Finalize();
+
+	// Appends a payload to rval as three values: [UInt32 ticket, Binary data, UInt64 size].
+	// Large payloads are written into the shared arena and the Binary value is left
+	// empty, everything else (or when no arena was negotiated) is sent inline with
+	// the ticket set to shm::InvalidSlot. A slot the client never releases is taken
+	// back after shm::LeaseTimeoutNs or when the client negotiates again.
+	static void PushPayload(std::vector<ipc::value> &rval, const std::vector<char> &payload);
+
+	static void Negotiate(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void SetEnabled(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void Echo(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+};
+} // namespace osn
@@ -20,6 +20,7 @@
 #include "osn-audio-encoder.hpp"
 #include "osn-service.hpp"
 #include "osn-error.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 #include "nodeobs_audio_encoders.h"
 #include "osn-file-output.hpp"
@@ -61,6 +62,7 @@ void osn::ISimpleRecording::Register(ipc::server &srv)
 							       SetFileResetTimestamps));
 
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::ISimpleRecording::Create(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
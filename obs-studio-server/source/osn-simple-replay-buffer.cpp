@@ -19,6 +19,7 @@
 #include "osn-simple-replay-buffer.hpp"
 #include "osn-audio-encoder.hpp"
 #include "osn-error.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 #include "nodeobs_audio_encoders.h"
 
@@ -47,6 +48,7 @@ void osn::ISimpleReplayBuffer::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("SetRecording", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, SetRecording));
 
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::ISimpleReplayBuffer::Create(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
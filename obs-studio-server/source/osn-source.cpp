@@ -28,9 +28,13 @@
 #include <obs.hpp>
 #include "osn-error.hpp"
 #include "osn-common.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 #include "callback-manager.h"
 #include "memory-manager.h"
+#include "osn-properties-cache.hpp"
+#include "osn-shared-memory.hpp"
+#include "source-states.hpp"
 
 void osn::Source::initialize_global_signals()
 {
@@ -38,11 +42,13 @@ void osn::Source::initialize_global_signals()
 	signal_handler_connect(sh, "source_create", osn::Source::global_source_create_cb, nullptr);
 	signal_handler_connect(sh, "source_activate", osn::Source::global_source_activate_cb, nullptr);
 	signal_handler_connect(sh, "source_deactivate", osn::Source::global_source_deactivate_cb, nullptr);
+	signal_handler_connect(sh, "source_rename", osn::Source::global_source_rename_cb, nullptr);
 }
 
 void osn::Source::finalize_global_signals()
 {
 	signal_handler_t *sh = obs_get_signal_handler();
+	signal_handler_disconnect(sh, "source_rename", osn::Source::global_source_rename_cb, nullptr);
 	signal_handler_disconnect(sh, "source_create", osn::Source::global_source_create_cb, nullptr);
 }
 
@@ -72,6 +78,7 @@ void osn::Source::global_source_create_cb(void *ptr, calldata_t *cd)
 	}
 
 	osn::Source::Manager::GetInstance().allocate(source);
+	osn::Source::Manager::GetInstance().set_name(source, obs_source_get_name(source));
 	osn::Source::attach_source_signals(source);
 	CallbackManager::addSource(source);
 	MemoryManager::GetInstance().registerSource(source);
@@ -104,6 +111,7 @@ void osn::Source::global_source_destroy_cb(void *ptr, calldata_t *cd)
 
 	CallbackManager::removeSource(source);
 	detach_source_signals(source);
+	osn::PropertiesCache::GetInstance().Invalidate(source);
 	osn::Source::Manager::GetInstance().free(source);
 }
 
@@ -115,9 +123,20 @@ void osn::Source::global_source_remove_cb(void *ptr, calldata_t *cd)
 	}
 
 	MemoryManager::GetInstance().unregisterSource(source);
+	osn::Source::Manager::GetInstance().clear_name(source);
 	obs_source_release(source);
 }
 
+void osn::Source::global_source_rename_cb(void *ptr, calldata_t *cd)
+{
+	obs_source_t *source = nullptr;
+	if (!calldata_get_ptr(cd, "source", &source)) {
+		throw std::runtime_error("calldata did not contain source pointer");
+	}
+
+	osn::Source::Manager::GetInstance().set_name(source, calldata_string(cd, "new_name"));
+}
+
 void osn::Source::Register(ipc::server &srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Source");
@@ -127,7 +146,7 @@ void osn::Source::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("Remove", std::vector<ipc::type>{ipc::type::UInt64}, Remove));
 	cls->register_function(std::make_shared<ipc::function>("Release", std::vector<ipc::type>{ipc::type::UInt64}, Release));
 	cls->register_function(std::make_shared<ipc::function>("IsConfigurable", std::vector<ipc::type>{ipc::type::UInt64}, IsConfigurable));
-	cls->register_function(std::make_shared<ipc::function>("GetProperties", std::vector<ipc::type>{ipc::type::UInt64}, GetProperties));
+	cls->register_function(std::make_shared<ipc::function>("GetProperties", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, GetProperties));
 	cls->register_function(std::make_shared<ipc::function>("GetSettings", std::vector<ipc::type>{ipc::type::UInt64}, GetSettings));
 	cls->register_function(std::make_shared<ipc::function>("Load", std::vector<ipc::type>{ipc::type::UInt64}, Load));
 	cls->register_function(std::make_shared<ipc::function>("Save", std::vector<ipc::type>{ipc::type::UInt64}, Save));
@@ -140,6 +159,7 @@ void osn::Source::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("SetFlags", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetFlags));
 	cls->register_function(std::make_shared<ipc::function>("GetStatus", std::vector<ipc::type>{ipc::type::UInt64}, GetStatus));
 	cls->register_function(std::make_shared<ipc::function>("GetId", std::vector<ipc::type>{ipc::type::UInt64}, GetId));
+	cls->register_function(std::make_shared<ipc::function>("GetStates", std::vector<ipc::type>{ipc::type::Binary, ipc::type::UInt32}, GetStates));
 	cls->register_function(std::make_shared<ipc::function>("GetMuted", std::vector<ipc::type>{ipc::type::UInt64}, GetMuted));
 	cls->register_function(std::make_shared<ipc::function>("SetMuted", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetMuted));
 	cls->register_function(std::make_shared<ipc::function>("GetEnabled", std::vector<ipc::type>{ipc::type::UInt64}, GetEnabled));
@@ -165,6 +185,7 @@ void osn::Source::Register(ipc::server &srv)
 						SendKeyClick));
 
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::Source::GetTypeDefaults(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
@@ -254,19 +275,19 @@ void osn::Source::GetProperties(void *data, const int64_t id, const std::vector<
 	if (src == nullptr) {
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not valid.");
 	}
+	uint64_t knownVersion = args[1].value_union.ui64;
 
-	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-
-	obs_properties_t *prp = obs_source_properties(src);
-	obs_data *settings = obs_source_get_settings(src);
-
-	utility::ProcessProperties(prp, settings, rval);
-
-	obs_properties_destroy(prp);
+	osn::PropertiesCache::Entry entry = osn::PropertiesCache::GetInstance().Get(src);
 
-	obs_source_update(src, settings);
-
-	obs_data_release(settings);
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(entry.version));
+	if (knownVersion != 0 && knownVersion == entry.version) {
+		// The client already holds this exact tree.
+		rval.push_back(ipc::value((int32_t) true));
+	} else {
+		rval.push_back(ipc::value((int32_t) false));
+		osn::SharedMemory::PushPayload(rval, *entry.packed);
+	}
 	AUTO_DEBUG;
 }
 
@@ -347,6 +368,7 @@ void osn::Source::Update(void *data, const int64_t id, const std::vector<ipc::va
 	}
 
 	obs_source_update(src, sets);
+	osn::PropertiesCache::GetInstance().Invalidate(src);
 	MemoryManager::GetInstance().updateSourceCache(src);
 	obs_data_release(sets);
 
@@ -495,6 +517,54 @@ void osn::Source::GetId(void *data, const int64_t id, const std::vector<ipc::val
 	AUTO_DEBUG;
 }
 
+void osn::Source::GetStates(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	// Uids are packed as uint64_t, the reply layout is described in source-states.hpp.
+	const std::vector<char> &uids = args[0].value_bin;
+	states::Layout layout(uint32_t(uids.size() / sizeof(uint64_t)), args[1].value_union.ui32);
+	std::vector<char> packed(layout.Size(), 0);
+
+	for (uint32_t idx = 0; idx < layout.Count(); idx++) {
+		uint64_t uid;
+		memcpy(&uid, uids.data() + idx * sizeof(uint64_t), sizeof(uint64_t));
+
+		// Held until the row is filled, the source can be removed meanwhile.
+		obs_source_t *src = osn::Source::Manager::GetInstance().get_ref(uid);
+		if (!src)
+			continue;
+
+		layout.SetValid(packed, idx);
+		if (layout.Has(states::Field::Muted))
+			layout.Set<uint8_t>(packed, states::Field::Muted, idx, obs_source_muted(src));
+		if (layout.Has(states::Field::Volume))
+			layout.Set<float>(packed, states::Field::Volume, idx, obs_source_get_volume(src));
+		if (layout.Has(states::Field::SyncOffset))
+			layout.Set<double>(packed, states::Field::SyncOffset, idx, double(obs_source_get_sync_offset(src)));
+		if (layout.Has(states::Field::AudioMixers))
+			layout.Set<uint32_t>(packed, states::Field::AudioMixers, idx, obs_source_get_audio_mixers(src));
+		if (layout.Has(states::Field::MonitoringType))
+			layout.Set<int32_t>(packed, states::Field::MonitoringType, idx, int32_t(obs_source_get_monitoring_type(src)));
+		if (layout.Has(states::Field::Width))
+			layout.Set<uint32_t>(packed, states::Field::Width, idx, obs_source_get_width(src));
+		if (layout.Has(states::Field::Height))
+			layout.Set<uint32_t>(packed, states::Field::Height, idx, obs_source_get_height(src));
+		if (layout.Has(states::Field::Active))
+			layout.Set<uint8_t>(packed, states::Field::Active, idx, obs_source_active(src));
+		if (layout.Has(states::Field::Showing))
+			layout.Set<uint8_t>(packed, states::Field::Showing, idx, obs_source_showing(src));
+		if (layout.Has(states::Field::Flags))
+			layout.Set<uint32_t>(packed, states::Field::Flags, idx, obs_source_get_flags(src));
+
+		obs_source_release(src);
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(layout.Count()));
+	rval.push_back(ipc::value(layout.Mask()));
+	rval.push_back(ipc::value(packed));
+	AUTO_DEBUG;
+}
+
 void osn::Source::GetMuted(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
 	// Attempt to find the source asked to load.
@@ -657,3 +727,126 @@ osn::Source::Manager &osn::Source::Manager::GetInstance()
 	static osn::Source::Manager _inst;
 	return _inst;
 }
+
+utility::unique_id::id_t osn::Source::Manager::allocate(obs_source_t *source)
+{
+	std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+
+	// Public sources are indexed from source_create already, a second
+	// allocate (Duplicate does this) returns the same uid.
+	auto found = pointer_index.find(source);
+	if (found != pointer_index.end())
+		return found->second.uid;
+
+	utility::unique_id::id_t uid = utility::unique_object_manager<obs_source_t>::allocate(source);
+	if (uid != std::numeric_limits<utility::unique_id::id_t>::max())
+		pointer_index.insert({source, Entry{uid, std::string()}});
+	return uid;
+}
+
+utility::unique_id::id_t osn::Source::Manager::find(obs_source_t *source)
+{
+	std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+
+	auto found = pointer_index.find(source);
+	if (found == pointer_index.end())
+		return std::numeric_limits<utility::unique_id::id_t>::max();
+	return found->second.uid;
+}
+
+utility::unique_id::id_t osn::Source::Manager::free(obs_source_t *source)
+{
+	std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+
+	auto found = pointer_index.find(source);
+	if (found == pointer_index.end())
+		return std::numeric_limits<utility::unique_id::id_t>::max();
+
+	utility::unique_id::id_t uid = found->second.uid;
+	clear_name(source);
+	pointer_index.erase(found);
+	object_map.erase(uid);
+	return uid;
+}
+
+obs_source_t *osn::Source::Manager::free(utility::unique_id::id_t uid)
+{
+	std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+
+	obs_source_t *source = utility::unique_object_manager<obs_source_t>::free(uid);
+	if (source) {
+		clear_name(source);
+		pointer_index.erase(source);
+	}
+	return source;
+}
+
+void osn::Source::Manager::clear()
+{
+	std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+
+	name_index.clear();
+	pointer_index.clear();
+	utility::unique_object_manager<obs_source_t>::clear();
+}
+
+obs_source_t *osn::Source::Manager::get_ref(utility::unique_id::id_t uid)
+{
+	// The destroy signal frees the uid under this lock before libobs frees
+	// the source, so the pointer is still valid while it is held.
+	std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+
+	obs_source_t *source = utility::unique_object_manager<obs_source_t>::find(uid);
+	return source ? obs_source_get_ref(source) : nullptr;
+}
+
+void osn::Source::Manager::set_name(obs_source_t *source, const char *name)
+{
+	std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+
+	auto found = pointer_index.find(source);
+	if (found == pointer_index.end() || !name)
+		return;
+
+	clear_name(source);
+	found->second.name = name;
+	// libobs does not enforce unique names and returns the newest source
+	// for a name, so the newest one takes over the entry.
+	name_index[found->second.name] = source;
+}
+
+void osn::Source::Manager::clear_name(obs_source_t *source)
+{
+	std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+
+	auto found = pointer_index.find(source);
+	if (found == pointer_index.end() || found->second.name.empty())
+		return;
+
+	auto named = name_index.find(found->second.name);
+	if (named != name_index.end() && named->second == source)
+		name_index.erase(named);
+	found->second.name.clear();
+}
+
+utility::unique_id::id_t osn::Source::Manager::find_by_name(const std::string &name)
+{
+	// Held for the fallback too, so a rename or destroy can't slip in between
+	// the libobs lookup and the uid lookup. The lock is recursive for the
+	// destroy signal a last release can raise.
+	std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+
+	auto named = name_index.find(name);
+	if (named != name_index.end())
+		return pointer_index[named->second].uid;
+
+	// A source whose name was taken over by a newer duplicate is no longer
+	// in the index, libobs still knows about it once the newer one is gone.
+	obs_source_t *source = obs_get_source_by_name(name.c_str());
+	if (!source)
+		return std::numeric_limits<utility::unique_id::id_t>::max();
+
+	utility::unique_id::id_t uid = find(source);
+	obs_source_release(source);
+	return uid;
+}
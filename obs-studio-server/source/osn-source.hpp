@@ -19,6 +19,8 @@
 #pragma once
 #include <ipc-server.hpp>
 #include <obs.h>
+#include <string>
+#include <unordered_map>
 #include "utility.hpp"
 #undef strtoll
 #include "nlohmann/json.hpp"
@@ -39,6 +41,36 @@ public:
 
 	public:
 		static Manager &GetInstance();
+
+		// Same as the base class but also keeps the source pointers and the
+		// names of public sources indexed, so reverse lookups don't have to
+		// scan every source.
+		using utility::unique_object_manager<obs_source_t>::find;
+		using utility::unique_object_manager<obs_source_t>::free;
+		utility::unique_id::id_t allocate(obs_source_t *source);
+		utility::unique_id::id_t find(obs_source_t *source);
+		utility::unique_id::id_t free(obs_source_t *source);
+		obs_source_t *free(utility::unique_id::id_t uid);
+		void clear();
+		// A new reference to the source, nullptr if it is unknown or already
+		// being destroyed. For threads that can run while another releases
+		// the source, the caller releases the reference.
+		obs_source_t *get_ref(utility::unique_id::id_t uid);
+
+		// Kept up to date from the global source_create and source_rename
+		// signals, which libobs only emits for public sources.
+		void set_name(obs_source_t *source, const char *name);
+		void clear_name(obs_source_t *source);
+		// Resolves names the way obs_get_source_by_name does.
+		utility::unique_id::id_t find_by_name(const std::string &name);
+
+	private:
+		struct Entry {
+			utility::unique_id::id_t uid;
+			std::string name;
+		};
+		std::unordered_map<obs_source_t *, Entry> pointer_index;
+		std::unordered_map<std::string, obs_source_t *> name_index;
 	};
 
 	static void initialize_global_signals();
@@ -48,6 +80,7 @@ public:
 	static void global_source_deactivate_cb(void *ptr, calldata_t *cd);
 	static void global_source_destroy_cb(void *ptr, calldata_t *cd);
 	static void global_source_remove_cb(void *ptr, calldata_t *cd);
+	static void global_source_rename_cb(void *ptr, calldata_t *cd);
 
 	static void attach_source_signals(obs_source_t *src);
 	static void detach_source_signals(obs_source_t *src);
@@ -80,6 +113,7 @@ public:
 	static void SetFlags(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 	static void GetStatus(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 	static void GetId(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void GetStates(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 
 	// Flags
 	static void GetMuted(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
@@ -22,6 +22,7 @@
 #include <obs.h>
 #include "osn-error.hpp"
 #include "osn-source.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 
 void osn::Transition::Register(ipc::server &srv)
@@ -43,6 +44,7 @@ void osn::Transition::Register(ipc::server &srv)
 	cls->register_function(
 		std::make_shared<ipc::function>("Start", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32, ipc::type::UInt64}, Start));
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::Transition::Types(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
@@ -122,18 +124,11 @@ void osn::Transition::CreatePrivate(void *data, const int64_t id, const std::vec
 
 void osn::Transition::FromName(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	obs_source_t *source = obs_get_source_by_name(args[0].value_str.c_str());
-	if (!source) {
-		PRETTY_ERROR_RETURN(ErrorCode::NotFound, "Named transition could not be found.");
-	}
-
-	uint64_t uid = osn::Source::Manager::GetInstance().find(source);
+	uint64_t uid = osn::Source::Manager::GetInstance().find_by_name(args[0].value_str);
 	if (uid == UINT64_MAX) {
-		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Source found but not indexed.");
+		PRETTY_ERROR_RETURN(ErrorCode::NotFound, "Named transition could not be found.");
 	}
 
-	obs_source_release(source);
-
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(uid));
 	AUTO_DEBUG;
@@ -18,7 +18,9 @@
 
 #include "osn-video-encoder.hpp"
 #include "osn-error.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
+#include "osn-shared-memory.hpp"
 
 void osn::VideoEncoder::Register(ipc::server &srv)
 {
@@ -37,6 +39,7 @@ void osn::VideoEncoder::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("GetProperties", std::vector<ipc::type>{ipc::type::UInt64}, GetProperties));
 	cls->register_function(std::make_shared<ipc::function>("GetSettings", std::vector<ipc::type>{ipc::type::UInt64}, GetSettings));
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::VideoEncoder::Create(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
@@ -193,7 +196,9 @@ void osn::VideoEncoder::GetProperties(void *data, const int64_t id, const std::v
 	obs_properties_t *prp = obs_encoder_properties(encoder);
 	obs_data *settings = obs_encoder_get_settings(encoder);
 
-	utility::ProcessProperties(prp, settings, rval);
+	std::vector<char> packed;
+	utility::PackProperties(prp, settings, packed);
+	osn::SharedMemory::PushPayload(rval, packed);
 
 	obs_properties_destroy(prp);
 
@@ -20,6 +20,7 @@
 #include <ipc-server.hpp>
 #include <obs.h>
 #include "osn-error.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 
 // DELETE ME WHEN REMOVING NODEOBS
@@ -48,6 +49,7 @@ void osn::Video::Register(ipc::server &srv)
 				       ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32},
 		SetLegacySettings));
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::Video::GetSkippedFrames(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
@@ -304,7 +306,13 @@ void osn::Video::SetVideoContext(void *data, const int64_t id, const std::vector
 	try {
 		// Cannot disrupt video ptr inside obs while outputs are connecting
 		OBS_service::stopConnectingOutputs();
-		ret = obs_set_video_info(canvas, &video);
+		if (utility::IsHeadless()) {
+			// Nothing is rendered, the canvas only keeps the settings so they are reported back
+			*canvas = video;
+			ret = OBS_VIDEO_SUCCESS;
+		} else {
+			ret = obs_set_video_info(canvas, &video);
+		}
 	} catch (const char *error) {
 		blog(LOG_ERROR, error);
 	}
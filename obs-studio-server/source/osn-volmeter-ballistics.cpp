@@ -0,0 +1,116 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-volmeter-ballistics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <util/sse-intrin.h>
+
+static_assert(MAX_AUDIO_CHANNELS % 4 == 0, "Channels are processed four at a time.");
+
+// 10^(dB / 10) == e^(dB * ln(10) / 10)
+static constexpr float DbToPowerScale = 0.23025850929940458f;
+static constexpr float PowerToDbScale = 4.3429448190325175f;
+// Anything below this is silence, keeps log() away from zero.
+static constexpr float MinPower = 1e-12f;
+
+osn::VolmeterBallistics::VolmeterBallistics(const Settings &settings, uint32_t updateIntervalMs) : m_settings(settings)
+{
+	size_t window = updateIntervalMs ? (settings.rmsWindowMs + updateIntervalMs - 1) / updateIntervalMs : 1;
+	m_powers.resize(std::max<size_t>(window, 1));
+	Reset();
+}
+
+void osn::VolmeterBallistics::Reset()
+{
+	m_peak.value.fill(Floor);
+	m_peak.age.fill(0.0f);
+	m_inputPeak.value.fill(Floor);
+	m_inputPeak.age.fill(0.0f);
+
+	for (auto &powers : m_powers)
+		powers.fill(0.0f);
+	m_next = 0;
+	m_filled = 0;
+	m_powerSum.fill(0.0f);
+	m_rms.fill(Floor);
+}
+
+void osn::VolmeterBallistics::Process(const Channels &magnitude, const Channels &peak, const Channels &inputPeak, float elapsedMs)
+{
+	HoldAndDecay(m_peak, peak, elapsedMs);
+	HoldAndDecay(m_inputPeak, inputPeak, elapsedMs);
+	UpdateRms(magnitude);
+}
+
+// Four channels per step. The selects are done with masks, compilers won't
+// if-convert the float comparisons on their own without fast-math.
+void osn::VolmeterBallistics::HoldAndDecay(Hold &hold, const Channels &input, float elapsedMs)
+{
+	const __m128 holdMs = _mm_set1_ps(float(m_settings.peakHoldMs));
+	const __m128 fall = _mm_set1_ps(m_settings.decayRate * elapsedMs / 1000.0f);
+	const __m128 elapsed = _mm_set1_ps(elapsedMs);
+	const __m128 floor = _mm_set1_ps(Floor);
+
+	for (size_t ch = 0; ch < MAX_AUDIO_CHANNELS; ch += 4) {
+		const __m128 in = _mm_loadu_ps(&input[ch]);
+		const __m128 held = _mm_loadu_ps(&hold.value[ch]);
+
+		// A new maximum restarts the hold time.
+		const __m128 rising = _mm_cmpge_ps(in, held);
+		const __m128 age = _mm_andnot_ps(rising, _mm_add_ps(_mm_loadu_ps(&hold.age[ch]), elapsed));
+
+		// Past the hold time the value falls, but never below the input.
+		const __m128 decayed = _mm_sub_ps(held, _mm_and_ps(_mm_cmpgt_ps(age, holdMs), fall));
+		const __m128 value = _mm_max_ps(_mm_max_ps(decayed, in), floor);
+
+		_mm_storeu_ps(&hold.age[ch], age);
+		_mm_storeu_ps(&hold.value[ch], value);
+	}
+}
+
+void osn::VolmeterBallistics::UpdateRms(const Channels &magnitude)
+{
+	Channels power;
+	for (size_t ch = 0; ch < MAX_AUDIO_CHANNELS; ch++)
+		power[ch] = std::exp(magnitude[ch] * DbToPowerScale);
+
+	// Sliding window: add the newest update, drop the one that falls out.
+	Channels &oldest = m_powers[m_next];
+	for (size_t ch = 0; ch < MAX_AUDIO_CHANNELS; ch++) {
+		m_powerSum[ch] = std::max(m_powerSum[ch] + power[ch] - oldest[ch], 0.0f);
+		oldest[ch] = power[ch];
+	}
+	m_next = (m_next + 1) % m_powers.size();
+	m_filled = std::min(m_filled + 1, m_powers.size());
+
+	// Resum once per lap so float rounding can't pile up.
+	if (m_next == 0) {
+		m_powerSum.fill(0.0f);
+		for (const auto &powers : m_powers) {
+			for (size_t ch = 0; ch < MAX_AUDIO_CHANNELS; ch++)
+				m_powerSum[ch] += powers[ch];
+		}
+	}
+
+	const float scale = 1.0f / float(m_filled);
+	for (size_t ch = 0; ch < MAX_AUDIO_CHANNELS; ch++) {
+		const float mean = m_powerSum[ch] * scale;
+		m_rms[ch] = mean > MinPower ? std::log(mean) * PowerToDbScale : Floor;
+	}
+}
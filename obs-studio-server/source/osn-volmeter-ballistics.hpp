@@ -0,0 +1,77 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <array>
+#include <inttypes.h>
+#include <vector>
+#include "obs.h"
+
+namespace osn {
+// Meter ballistics computed on the server, so a client polling at a low rate
+// still sees every peak. Peaks are held for a while and then fall at a fixed
+// rate, the magnitude is averaged over a sliding RMS window.
+//
+// All kernels run over the full MAX_AUDIO_CHANNELS lanes without branches so
+// the compiler can vectorize them; unused channels just carry the floor value.
+class VolmeterBallistics {
+public:
+	typedef std::array<float, MAX_AUDIO_CHANNELS> Channels;
+
+	struct Settings {
+		uint32_t peakHoldMs = 1000;
+		// dB per second once the hold time is over.
+		float decayRate = 20.0f;
+		uint32_t rmsWindowMs = 300;
+	};
+
+	static constexpr float Floor = -65535.0f;
+
+	VolmeterBallistics(const Settings &settings, uint32_t updateIntervalMs);
+
+	// Inputs are in dB as reported by libobs, already sanitized.
+	void Process(const Channels &magnitude, const Channels &peak, const Channels &inputPeak, float elapsedMs);
+	void Reset();
+
+	const Channels &GetMagnitude() const { return m_rms; }
+	const Channels &GetPeak() const { return m_peak.value; }
+	const Channels &GetInputPeak() const { return m_inputPeak.value; }
+	const Settings &GetSettings() const { return m_settings; }
+
+private:
+	struct Hold {
+		Channels value;
+		Channels age;
+	};
+
+	void HoldAndDecay(Hold &hold, const Channels &input, float elapsedMs);
+	void UpdateRms(const Channels &magnitude);
+
+	Settings m_settings;
+
+	Hold m_peak;
+	Hold m_inputPeak;
+
+	// Linear power of the last few updates and their running sum.
+	std::vector<Channels> m_powers;
+	size_t m_next = 0;
+	size_t m_filled = 0;
+	Channels m_powerSum;
+	Channels m_rms;
+};
+} // namespace osn
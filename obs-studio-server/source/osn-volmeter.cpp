@@ -20,9 +20,11 @@
 #include "osn-error.hpp"
 #include "obs.h"
 #include "osn-source.hpp"
+#include "osn-method-table.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
 #include <cmath>
+#include <util/platform.h>
 
 std::mutex mtx;
 
@@ -51,7 +53,11 @@ void osn::Volmeter::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("Destroy", std::vector<ipc::type>{ipc::type::UInt64}, Destroy));
 	cls->register_function(std::make_shared<ipc::function>("Attach", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, Attach));
 	cls->register_function(std::make_shared<ipc::function>("Detach", std::vector<ipc::type>{ipc::type::UInt64}, Detach));
+	cls->register_function(std::make_shared<ipc::function>(
+		"SetBallistics", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32, ipc::type::UInt32, ipc::type::Double, ipc::type::UInt32},
+		SetBallistics));
 	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
 }
 
 void osn::Volmeter::ClearVolmeters()
@@ -149,6 +155,37 @@ void osn::Volmeter::Detach(void *data, const int64_t id, const std::vector<ipc::
 	AUTO_DEBUG;
 }
 
+void osn::Volmeter::SetBallistics(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	auto uid = args[0].value_union.ui64;
+	bool enabled = args[1].value_union.i32 != 0;
+
+	std::unique_lock<std::mutex> ulock(mtx);
+	auto meter = Manager::GetInstance().find(uid);
+	if (!meter) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid Meter reference.");
+	}
+
+	VolmeterBallistics::Settings settings;
+	settings.peakHoldMs = args[2].value_union.ui32;
+	settings.decayRate = float(args[3].value_union.fp64);
+	settings.rmsWindowMs = args[4].value_union.ui32;
+	if (enabled && settings.decayRate <= 0.0f) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Decay rate must be positive.");
+	}
+
+	std::unique_lock<std::mutex> ulock_data(meter->current_data_mtx);
+	if (enabled) {
+		meter->ballistics = std::make_unique<VolmeterBallistics>(settings, obs_volmeter_get_update_interval(meter->self));
+	} else {
+		meter->ballistics.reset();
+	}
+	meter->last_process_ns = 0;
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
 void osn::Volmeter::OBSCallback(void *param, const float magnitude[MAX_AUDIO_CHANNELS], const float peak[MAX_AUDIO_CHANNELS],
 				const float input_peak[MAX_AUDIO_CHANNELS])
 {
@@ -176,6 +213,29 @@ void osn::Volmeter::OBSCallback(void *param, const float magnitude[MAX_AUDIO_CHA
 #define MAKE_FLOAT_SANE(db) (std::isfinite(db) ? db : (db > 0 ? 0.0f : -65535.0f))
 #define PREVIOUS_FRAME_WEIGHT
 
+	if (meter->ballistics) {
+		VolmeterBallistics::Channels raw_magnitude, raw_peak, raw_input_peak;
+		raw_magnitude.fill(VolmeterBallistics::Floor);
+		raw_peak.fill(VolmeterBallistics::Floor);
+		raw_input_peak.fill(VolmeterBallistics::Floor);
+		for (size_t ch = 0; ch < meter->current_data.ch; ch++) {
+			raw_magnitude[ch] = MAKE_FLOAT_SANE(magnitude[ch]);
+			raw_peak[ch] = MAKE_FLOAT_SANE(peak[ch]);
+			raw_input_peak[ch] = MAKE_FLOAT_SANE(input_peak[ch]);
+		}
+
+		uint64_t now = os_gettime_ns();
+		float elapsed_ms = meter->last_process_ns ? float(now - meter->last_process_ns) / 1000000.0f
+							  : float(obs_volmeter_get_update_interval(meter->self));
+		meter->last_process_ns = now;
+
+		meter->ballistics->Process(raw_magnitude, raw_peak, raw_input_peak, elapsed_ms);
+		meter->current_data.magnitude = meter->ballistics->GetMagnitude();
+		meter->current_data.peak = meter->ballistics->GetPeak();
+		meter->current_data.input_peak = meter->ballistics->GetInputPeak();
+		return;
+	}
+
 	for (size_t ch = 0; ch < meter->current_data.ch; ch++) {
 		meter->current_data.magnitude[ch] = MAKE_FLOAT_SANE(magnitude[ch]);
 		meter->current_data.peak[ch] = MAKE_FLOAT_SANE(peak[ch]);
@@ -214,7 +274,8 @@ void osn::Volmeter::getAudioData(uint64_t id, std::vector<ipc::value> &rval)
 
 	std::unique_lock<std::mutex> ulock(meter->current_data_mtx);
 
-	const auto source = osn::Source::Manager::GetInstance().find(meter->uid_source);
+	// Polled from the realtime lane, while the standard lane may release the source.
+	obs_source_t *source = osn::Source::Manager::GetInstance().get_ref(meter->uid_source);
 	if (!source) {
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Volmeter source not found.");
 	}
@@ -224,6 +285,10 @@ void osn::Volmeter::getAudioData(uint64_t id, std::vector<ipc::value> &rval)
 	if (CheckIdle(GetTime(), meter->current_data.lastUpdateTime)) {
 		meter->current_data.resetData();
 		meter->current_data.lastUpdateTime = GetTime();
+		if (meter->ballistics) {
+			meter->ballistics->Reset();
+			meter->last_process_ns = 0;
+		}
 
 		// isMuted flag only tells UI if it needs process and visualize volmeters bars.
 		// It does not responsible for any audio processing or source elements state.
@@ -237,12 +302,16 @@ void osn::Volmeter::getAudioData(uint64_t id, std::vector<ipc::value> &rval)
 	rval.push_back(ipc::value(meter->current_data.ch));
 	rval.push_back(ipc::value(isMuted));
 
-	if (isMuted)
-		return;
-
-	for (size_t ch = 0; ch < meter->current_data.ch; ch++) {
-		rval.push_back(ipc::value(meter->current_data.magnitude[ch]));
-		rval.push_back(ipc::value(meter->current_data.peak[ch]));
-		rval.push_back(ipc::value(meter->current_data.input_peak[ch]));
+	if (!isMuted) {
+		for (size_t ch = 0; ch < meter->current_data.ch; ch++) {
+			rval.push_back(ipc::value(meter->current_data.magnitude[ch]));
+			rval.push_back(ipc::value(meter->current_data.peak[ch]));
+			rval.push_back(ipc::value(meter->current_data.input_peak[ch]));
+		}
 	}
+
+	// Ours may be the last reference, its destroy callbacks must not run under the meter locks.
+	ulock.unlock();
+	ulockMutex.unlock();
+	obs_source_release(source);
 }
\ No newline at end of file
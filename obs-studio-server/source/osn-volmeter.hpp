@@ -22,6 +22,7 @@
 #include <queue>
 #include <array>
 #include "obs.h"
+#include "osn-volmeter-ballistics.hpp"
 #include "utility.hpp"
 
 extern std::mutex mtx;
@@ -71,6 +72,11 @@ private:
 	AudioData current_data;
 	std::mutex current_data_mtx;
 
+	// When set, current_data holds the smoothed values instead of the last
+	// raw update. Guarded by current_data_mtx.
+	std::unique_ptr<VolmeterBallistics> ballistics;
+	uint64_t last_process_ns = 0;
+
 public:
 	Volmeter(obs_fader_type type);
 	~Volmeter();
@@ -86,6 +92,7 @@ public:
 
 	static void Attach(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 	static void Detach(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void SetBallistics(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 
 	static void OBSCallback(void *param, const float magnitude[MAX_AUDIO_CHANNELS], const float peak[MAX_AUDIO_CHANNELS],
 				const float input_peak[MAX_AUDIO_CHANNELS]);
@@ -0,0 +1,97 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-write-batch.hpp"
+#include <ipc-class.hpp>
+#include <ipc-function.hpp>
+#include <obs.h>
+#include "osn-error.hpp"
+#include "osn-fader.hpp"
+#include "osn-input.hpp"
+#include "osn-sceneitem.hpp"
+#include "osn-source.hpp"
+#include "osn-method-table.hpp"
+#include "shared.hpp"
+#include "utility.hpp"
+#include "write-batch.hpp"
+
+typedef void (*setter_handler_t)(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+
+// Indexed by batch::Setter, must be kept in the same order.
+static const setter_handler_t setter_handlers[] = {
+	osn::Source::SetMuted,
+	osn::Source::SetEnabled,
+	osn::Input::SetVolume,
+	osn::Input::SetSyncOffset,
+	osn::Fader::SetDeziBel,
+	osn::Fader::SetDeflection,
+	osn::Fader::SetMultiplier,
+	osn::SceneItem::SetVisible,
+	osn::SceneItem::SetSelected,
+	osn::SceneItem::SetPosition,
+	osn::SceneItem::SetRotation,
+	osn::SceneItem::SetScale,
+	osn::SceneItem::SetCrop,
+};
+static_assert(sizeof(setter_handlers) / sizeof(setter_handlers[0]) == size_t(batch::Setter::Count), "Every setter needs a handler.");
+
+void osn::WriteBatch::Register(ipc::server &srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("WriteBatch");
+	cls->register_function(std::make_shared<ipc::function>("Apply", std::vector<ipc::type>{ipc::type::Binary}, Apply));
+	srv.register_collection(cls);
+	osn::MethodTable::GetInstance().Add(cls);
+}
+
+void osn::WriteBatch::Apply(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	batch::Reader reader;
+	if (!reader.Open(args[0].value_bin.data(), args[0].value_bin.size())) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid write batch.");
+	}
+
+	uint32_t applied = 0;
+	uint32_t failed = 0;
+	batch::Setter setter;
+	std::vector<ipc::value> setter_args;
+	std::vector<ipc::value> setter_rval;
+	while (reader.Next(setter, setter_args)) {
+		setter_rval.clear();
+		// Handlers index their arguments without checking, like for any call
+		// the ipc library already matched.
+		if (!batch::Matches(setter, setter_args)) {
+			failed++;
+			blog(LOG_DEBUG, "Write batch: setter %d has invalid arguments.", int(setter));
+			continue;
+		}
+		setter_handlers[size_t(setter)](data, id, setter_args, setter_rval);
+
+		// Handlers report errors in their first value, like any other call.
+		if (setter_rval.size() && ErrorCode(setter_rval[0].value_union.ui64) == ErrorCode::Ok) {
+			applied++;
+		} else {
+			failed++;
+			blog(LOG_DEBUG, "Write batch: setter %d failed.", int(setter));
+		}
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(applied));
+	rval.push_back(ipc::value(failed));
+	AUTO_DEBUG;
+}
@@ -1294,10 +1294,8 @@ std::string util::CrashManager::getAppState()
 	return appState;
 }
 
-void util::CrashManager::ProcessPreServerCall(const std::string &cname, const std::string &fname, const std::vector<ipc::value> &args)
+void util::CrashManager::ProcessPreServerCall(const std::string &action, const std::vector<ipc::value> &args)
 {
-	std::string jsonEntry = cname + std::string("::") + fname;
-
 	// Perform this only if this user have a high crash rate (TODO: this check must be implemented)
 	/*
 	nlohmann::json ipcValues = nlohmann::json::array();
@@ -1305,16 +1303,15 @@ void util::CrashManager::ProcessPreServerCall(const std::string &cname, const st
 	jsonEntry["ipc values"] = ipcValues;
 	*/
 
-	RegisterAction(jsonEntry);
+	RegisterAction(action);
 }
 
-void util::CrashManager::ProcessPostServerCall(const std::string &cname, const std::string &fname, const std::vector<ipc::value> &args)
+void util::CrashManager::ProcessPostServerCall(const std::string &action, const std::vector<ipc::value> &args)
 {
 	if (args.size() == 0) {
-		AddWarning(std::string("No return params on method ") + fname + std::string(" for class ") + cname);
+		AddWarning(std::string("No return params on method ") + action);
 	} else if ((ErrorCode)args[0].value_union.ui64 != ErrorCode::Ok) {
-		AddWarning(std::string("Server call returned error number ") + std::to_string(args[0].value_union.ui64) + " on method " + fname +
-			   std::string(" for class ") + cname);
+		AddWarning(std::string("Server call returned error number ") + std::to_string(args[0].value_union.ui64) + " on method " + action);
 	}
 }
 
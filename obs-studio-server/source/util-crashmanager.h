@@ -61,8 +61,9 @@ public:
 	// Return our global instance of the metrics provider, it's always valid
 	static MetricsProvider *const GetMetricsProvider();
 
-	static void ProcessPreServerCall(const std::string &cname, const std::string &fname, const std::vector<ipc::value> &args);
-	static void ProcessPostServerCall(const std::string &cname, const std::string &fname, const std::vector<ipc::value> &args);
+	// `action` is "Collection::Function", also for calls dispatched by method id.
+	static void ProcessPreServerCall(const std::string &action, const std::vector<ipc::value> &args);
+	static void ProcessPostServerCall(const std::string &action, const std::vector<ipc::value> &args);
 
 	static void SetVersionName(const std::string &name);
 	static void SetReportServerUrl(const std::string &url);
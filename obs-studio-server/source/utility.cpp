@@ -17,7 +17,10 @@
 ******************************************************************************/
 
 #include "utility.hpp"
-#include "obs-property.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <util/dstr.h>
+#include "obs-property-flat.hpp"
 
 std::string utility::osn_current_version(const std::string &_version)
 {
@@ -28,362 +31,229 @@ std::string utility::osn_current_version(const std::string &_version)
 	return current_version;
 }
 
-utility::unique_id::unique_id() {}
-
-utility::unique_id::~unique_id() {}
-
-utility::unique_id::id_t utility::unique_id::allocate()
-{
-	if (allocated.size() > 0) {
-		for (auto &v : allocated) {
-			if (v.first > 0) {
-				utility::unique_id::id_t v2 = v.first - 1;
-				mark_used(v2);
-				return v2;
-			} else if (v.second < std::numeric_limits<utility::unique_id::id_t>::max()) {
-				utility::unique_id::id_t v2 = v.second + 1;
-				mark_used(v2);
-				return v2;
-			}
-		}
-	} else {
-		mark_used(0);
-		return 0;
-	}
-
-	// No more free indexes. However that has happened.
-	return std::numeric_limits<utility::unique_id::id_t>::max();
-}
-
-void utility::unique_id::free(utility::unique_id::id_t v)
+bool utility::IsHeadless()
 {
-	mark_free(v);
+	static const bool headless = [] {
+		const char *value = getenv("OSN_HEADLESS");
+		return value != nullptr && (strcmp(value, "1") == 0 || astrcmpi(value, "true") == 0);
+	}();
+	return headless;
 }
 
-bool utility::unique_id::is_allocated(utility::unique_id::id_t v)
+static void CollectProperties(obs_properties_t *prp, obs_data *settings, obs::flat::Writer &writer)
 {
-	for (auto &v2 : allocated) {
-		if ((v >= v2.first) && (v <= v2.second))
-			return true;
-	}
-	return false;
-}
-
-utility::unique_id::id_t utility::unique_id::count(bool count_free)
-{
-	id_t count = 0;
-	for (auto &v : allocated) {
-		count += (v.second - v.first);
-	}
-	return count_free ? (std::numeric_limits<id_t>::max() - count) : count;
-}
-
-bool utility::unique_id::mark_used(utility::unique_id::id_t v)
-{
-	// If no elements have been assigned, simply insert v as used.
-	if (allocated.size() == 0) {
-		range_t r;
-		r.first = r.second = v;
-		allocated.push_back(r);
-		return true;
-	}
-
-	// Otherwise, attempt to find the best fitting element.
-	bool lastWasSmaller = false;
-	for (auto iter = allocated.begin(); iter != allocated.end(); iter++) {
-		auto fiter = std::list<range_t>::iterator(iter);
-		auto riter = std::list<range_t>::reverse_iterator(iter);
-		if ((iter->first > 0) && (v == (iter->first - 1))) {
-			// If the minimum of the selected element is > 0 and v is equal to
-			//  (minimum - 1), decrease the minimum.
-			iter->first--;
-
-			// Then test if the previous elements maximum is equal to (v - 1),
-			//  if so merge the two since they are now continuous.
-			riter--;
-			if ((riter != allocated.rend()) && (riter->second == (v - 1))) {
-				riter->second = iter->second;
-				allocated.erase(iter);
-			}
-
-			return true;
-		} else if ((iter->second < std::numeric_limits<utility::unique_id::id_t>::max()) && (v == (iter->second + 1))) {
-			// If the maximum of the selected element is < UINT_MAX and v is
-			//  equal to (maximum + 1), increase the maximum.
-			iter->second++;
-
-			// Then test if the next elements minimum is equal to (v + 1),
-			//  if so merge the two since they are now continuous.
-			fiter++;
-			if ((fiter != allocated.end()) && (fiter->first == (v + 1))) {
-				iter->second = fiter->second;
-				allocated.erase(fiter);
-			}
+	for (obs_property_t *p = obs_properties_first(prp); (p != nullptr); obs_property_next(&p)) {
+		const char *name = obs_property_name(p);
+		obs_property_type type = obs_property_get_type(p);
 
-			return true;
-		} else if (lastWasSmaller && (v < iter->first)) {
-			// If we are between two ranges that are smaller and larger than v
-			//  insert a new element before the larger range containing only v.
-			allocated.insert(iter, {v, v});
-			return true;
-		} else if ((fiter++) == allocated.end()) {
-			// Otherwise if we reached the end of the list, append v.
-			allocated.insert(fiter, {v, v});
-			return true;
+		if (type == OBS_PROPERTY_GROUP) {
+			CollectProperties(obs_property_group_content(p), settings, writer);
+			continue;
 		}
-		lastWasSmaller = (v > iter->second);
-	}
-	return false;
-}
 
-void utility::unique_id::mark_used_range(utility::unique_id::id_t min, utility::unique_id::id_t max)
-{
-	for (utility::unique_id::id_t v = min; v < max; v++) {
-		mark_used(v);
-	}
-}
-
-bool utility::unique_id::mark_free(utility::unique_id::id_t v)
-{
-	for (auto iter = allocated.begin(); iter != allocated.end(); iter++) {
-		// Is v inside this range?
-		if ((v >= iter->first) && (v <= iter->second)) {
-			if (v == iter->first) {
-				// If v is simply the beginning of the range, increase the
-				//  minimum and test if the range is now no longer valid.
-				iter->first++;
-				if (iter->first > iter->second) {
-					// If the range is no longer valid, just erase it.
-					allocated.erase(iter);
-				}
-				return true;
-			} else if (v == iter->second) {
-				// If v is simply the end of the range, decrease the maximum
-				//  and test if the range is now no longer valid.
-				iter->second--;
-				if (iter->second < iter->first) {
-					// If the range is no longer valid, just erase it.
-					allocated.erase(iter);
-				}
-				return true;
-			} else {
-				// Otherwise, since v is inside the range, split the range at
-				// v and insert a new element.
-				range_t x;
-				x.first = iter->first;
-				x.second = v - 1;
-				iter->first = v + 1;
-				allocated.insert(iter, x);
-				return true;
-			}
+		obs::Property::Type flat_type;
+		switch (type) {
+		case OBS_PROPERTY_BOOL:
+			flat_type = obs::Property::Type::Boolean;
+			break;
+		case OBS_PROPERTY_INT:
+			flat_type = obs::Property::Type::Integer;
+			break;
+		case OBS_PROPERTY_FLOAT:
+			flat_type = obs::Property::Type::Float;
+			break;
+		case OBS_PROPERTY_TEXT:
+			flat_type = obs::Property::Type::Text;
+			break;
+		case OBS_PROPERTY_PATH:
+			flat_type = obs::Property::Type::Path;
+			break;
+		case OBS_PROPERTY_LIST:
+			flat_type = obs::Property::Type::List;
+			break;
+		case OBS_PROPERTY_COLOR_ALPHA:
+		case OBS_PROPERTY_COLOR:
+			flat_type = obs::Property::Type::Color;
+			break;
+		case OBS_PROPERTY_CAPTURE:
+			flat_type = obs::Property::Type::Capture;
+			break;
+		case OBS_PROPERTY_BUTTON:
+			flat_type = obs::Property::Type::Button;
+			break;
+		case OBS_PROPERTY_FONT:
+			flat_type = obs::Property::Type::Font;
+			break;
+		case OBS_PROPERTY_EDITABLE_LIST:
+			flat_type = obs::Property::Type::EditableList;
+			break;
+		case OBS_PROPERTY_FRAME_RATE:
+			flat_type = obs::Property::Type::FrameRate;
+			break;
+		default:
+			continue;
 		}
-	}
-	return false;
-}
 
-void utility::unique_id::mark_free_range(utility::unique_id::id_t min, utility::unique_id::id_t max)
-{
-	for (utility::unique_id::id_t v = min; v < max; v++) {
-		mark_free(v);
-	}
-}
+		uint32_t idx = writer.Begin(flat_type, utility::GetSafeString(name), utility::GetSafeString(obs_property_description(p)),
+					    utility::GetSafeString(obs_property_long_description(p)), obs_property_enabled(p), obs_property_visible(p));
 
-void utility::ProcessProperties(obs_properties_t *prp, obs_data *settings, std::vector<ipc::value> &rval)
-{
-	const char *buf = nullptr;
-	for (obs_property_t *p = obs_properties_first(prp); (p != nullptr); obs_property_next(&p)) {
-		std::shared_ptr<obs::Property> prop;
-		const char *name = obs_property_name(p);
-
-		switch (obs_property_get_type(p)) {
+		switch (type) {
 		case OBS_PROPERTY_BOOL: {
-			auto prop2 = std::make_shared<obs::BooleanProperty>();
-			prop2->value = obs_data_get_bool(settings, name);
-			prop = prop2;
+			writer.At(idx).ints[0] = obs_data_get_bool(settings, name);
 			break;
 		}
 		case OBS_PROPERTY_INT: {
-			auto prop2 = std::make_shared<obs::IntegerProperty>();
-			prop2->field_type = obs::NumberProperty::NumberType(obs_property_int_type(p));
-			prop2->minimum = obs_property_int_min(p);
-			prop2->maximum = obs_property_int_max(p);
-			prop2->step = obs_property_int_step(p);
-			prop2->value = (int)obs_data_get_int(settings, name);
-			prop = prop2;
+			obs::flat::Record &record = writer.At(idx);
+			record.field_type = uint8_t(obs_property_int_type(p));
+			record.ints[0] = obs_property_int_min(p);
+			record.ints[1] = obs_property_int_max(p);
+			record.ints[2] = obs_property_int_step(p);
+			record.ints[3] = (int)obs_data_get_int(settings, name);
 			break;
 		}
 		case OBS_PROPERTY_FLOAT: {
-			auto prop2 = std::make_shared<obs::FloatProperty>();
-			prop2->field_type = obs::NumberProperty::NumberType(obs_property_float_type(p));
-			prop2->minimum = obs_property_float_min(p);
-			prop2->maximum = obs_property_float_max(p);
-			prop2->step = obs_property_float_step(p);
-			prop2->value = obs_data_get_double(settings, name);
-			prop = prop2;
+			obs::flat::Record &record = writer.At(idx);
+			record.field_type = uint8_t(obs_property_float_type(p));
+			record.floats[0] = obs_property_float_min(p);
+			record.floats[1] = obs_property_float_max(p);
+			record.floats[2] = obs_property_float_step(p);
+			record.floats[3] = obs_data_get_double(settings, name);
 			break;
 		}
 		case OBS_PROPERTY_TEXT: {
-			auto prop2 = std::make_shared<obs::TextProperty>();
-			prop2->field_type = obs::TextProperty::TextType(obs_property_text_type(p));
-			prop2->info_type = obs::TextProperty::InfoType(obs_property_text_info_type(p));
-			prop2->value = (buf = obs_data_get_string(settings, name)) != nullptr ? buf : "";
-			prop = prop2;
+			obs::flat::String value = writer.Intern(utility::GetSafeString(obs_data_get_string(settings, name)));
+			obs::flat::Record &record = writer.At(idx);
+			record.field_type = uint8_t(obs_property_text_type(p));
+			record.format = uint8_t(obs_property_text_info_type(p));
+			record.text[0] = value;
 			break;
 		}
 		case OBS_PROPERTY_PATH: {
-			auto prop2 = std::make_shared<obs::PathProperty>();
-			prop2->field_type = obs::PathProperty::PathType(obs_property_path_type(p));
-			prop2->filter = (buf = obs_property_path_filter(p)) != nullptr ? buf : "";
-			prop2->default_path = (buf = obs_property_path_default_path(p)) != nullptr ? buf : "";
-			prop2->value = (buf = obs_data_get_string(settings, name)) != nullptr ? buf : "";
-			prop = prop2;
+			obs::flat::String filter = writer.Intern(utility::GetSafeString(obs_property_path_filter(p)));
+			obs::flat::String default_path = writer.Intern(utility::GetSafeString(obs_property_path_default_path(p)));
+			obs::flat::String value = writer.Intern(utility::GetSafeString(obs_data_get_string(settings, name)));
+			obs::flat::Record &record = writer.At(idx);
+			record.field_type = uint8_t(obs_property_path_type(p));
+			record.text[0] = filter;
+			record.text[1] = default_path;
+			record.text[2] = value;
 			break;
 		}
 		case OBS_PROPERTY_LIST: {
-			auto prop2 = std::make_shared<obs::ListProperty>();
-			prop2->field_type = obs::ListProperty::ListType(obs_property_list_type(p));
-			prop2->format = obs::ListProperty::Format(obs_property_list_format(p));
+			obs_combo_format format = obs_property_list_format(p);
+			obs::flat::String current = {};
+			if (format == OBS_COMBO_FORMAT_STRING)
+				current = writer.Intern(utility::GetSafeString(obs_data_get_string(settings, name)));
+
+			obs::flat::Record &record = writer.At(idx);
+			record.field_type = uint8_t(obs_property_list_type(p));
+			record.format = uint8_t(format);
+			record.text[0] = current;
+			if (format == OBS_COMBO_FORMAT_INT)
+				record.ints[0] = (int)obs_data_get_int(settings, name);
+			else if (format == OBS_COMBO_FORMAT_FLOAT)
+				record.floats[0] = obs_data_get_double(settings, name);
+
 			size_t items = obs_property_list_item_count(p);
-			for (size_t idx = 0; idx < items; ++idx) {
-				obs::ListProperty::Item entry;
-				entry.name = (buf = obs_property_list_item_name(p, idx)) != nullptr ? buf : "";
-				entry.enabled = !obs_property_list_item_disabled(p, idx);
-				switch (prop2->format) {
-				case obs::ListProperty::Format::Integer:
-					entry.value_int = obs_property_list_item_int(p, idx);
-					break;
-				case obs::ListProperty::Format::Float:
-					entry.value_float = obs_property_list_item_float(p, idx);
-					break;
-				case obs::ListProperty::Format::String:
-					entry.value_string = (buf = obs_property_list_item_string(p, idx)) != nullptr ? buf : "";
-					break;
-				}
-				prop2->items.push_back(std::move(entry));
-			}
-			switch (prop2->format) {
-			case obs::ListProperty::Format::Integer: {
-				prop2->current_value_int = (int)obs_data_get_int(settings, name);
-				break;
-			}
-			case obs::ListProperty::Format::Float: {
-				prop2->current_value_float = obs_data_get_double(settings, name);
-				break;
-			}
-			case obs::ListProperty::Format::String: {
-				prop2->current_value_str = (buf = obs_data_get_string(settings, name)) != nullptr ? buf : "";
-				break;
-			}
+			for (size_t item_idx = 0; item_idx < items; ++item_idx) {
+				obs::flat::String item_name = writer.Intern(utility::GetSafeString(obs_property_list_item_name(p, item_idx)));
+				obs::flat::String item_value = {};
+				if (format == OBS_COMBO_FORMAT_STRING)
+					item_value = writer.Intern(utility::GetSafeString(obs_property_list_item_string(p, item_idx)));
+
+				obs::flat::Item &item = writer.AddItem(idx, obs::flat::ItemKind::ListEntry);
+				item.name = item_name;
+				item.value = item_value;
+				item.enabled = !obs_property_list_item_disabled(p, item_idx);
+				if (format == OBS_COMBO_FORMAT_INT)
+					item.value_int = obs_property_list_item_int(p, item_idx);
+				else if (format == OBS_COMBO_FORMAT_FLOAT)
+					item.value_float = obs_property_list_item_float(p, item_idx);
 			}
-			prop = prop2;
 			break;
 		}
 		case OBS_PROPERTY_COLOR_ALPHA:
-		case OBS_PROPERTY_COLOR: {
-			auto prop2 = std::make_shared<obs::ColorProperty>();
-			prop2->field_type = obs::NumberProperty::NumberType(obs_property_int_type(p));
-			prop2->value = (int)obs_data_get_int(settings, name);
-			prop = prop2;
-			break;
-		}
+		case OBS_PROPERTY_COLOR:
 		case OBS_PROPERTY_CAPTURE: {
-			auto prop2 = std::make_shared<obs::CaptureProperty>();
-			prop2->field_type = obs::NumberProperty::NumberType(obs_property_int_type(p));
-			prop2->value = (int)obs_data_get_int(settings, name);
-			prop = prop2;
+			obs::flat::Record &record = writer.At(idx);
+			record.field_type = uint8_t(obs_property_int_type(p));
+			record.ints[0] = (int)obs_data_get_int(settings, name);
 			break;
 		}
-		case OBS_PROPERTY_BUTTON:
-			prop = std::make_shared<obs::ButtonProperty>();
-			break;
 		case OBS_PROPERTY_FONT: {
-			auto prop2 = std::make_shared<obs::FontProperty>();
 			obs_data_t *font_obj = obs_data_get_obj(settings, name);
-			prop2->face = (buf = obs_data_get_string(font_obj, "face")) != nullptr ? buf : "";
-			prop2->style = (buf = obs_data_get_string(font_obj, "style")) != nullptr ? buf : "";
-			prop2->path = (buf = obs_data_get_string(font_obj, "path")) != nullptr ? buf : "";
-			prop2->sizeF = (int)obs_data_get_int(font_obj, "size");
-			prop2->flags = (uint32_t)obs_data_get_int(font_obj, "flags");
-			prop = prop2;
+			obs::flat::String face = writer.Intern(utility::GetSafeString(obs_data_get_string(font_obj, "face")));
+			obs::flat::String style = writer.Intern(utility::GetSafeString(obs_data_get_string(font_obj, "style")));
+			obs::flat::String path = writer.Intern(utility::GetSafeString(obs_data_get_string(font_obj, "path")));
+			obs::flat::Record &record = writer.At(idx);
+			record.text[0] = face;
+			record.text[1] = style;
+			record.text[2] = path;
+			record.ints[0] = (int)obs_data_get_int(font_obj, "size");
+			record.ints[1] = (uint32_t)obs_data_get_int(font_obj, "flags");
+			obs_data_release(font_obj);
 			break;
 		}
 		case OBS_PROPERTY_EDITABLE_LIST: {
-			auto prop2 = std::make_shared<obs::EditableListProperty>();
-			prop2->field_type = obs::EditableListProperty::ListType(obs_property_editable_list_type(p));
-			prop2->filter = (buf = obs_property_editable_list_filter(p)) != nullptr ? buf : "";
-			prop2->default_path = (buf = obs_property_editable_list_default_path(p)) != nullptr ? buf : "";
+			obs::flat::String filter = writer.Intern(utility::GetSafeString(obs_property_editable_list_filter(p)));
+			obs::flat::String default_path = writer.Intern(utility::GetSafeString(obs_property_editable_list_default_path(p)));
+			obs::flat::Record &record = writer.At(idx);
+			record.field_type = uint8_t(obs_property_editable_list_type(p));
+			record.text[0] = filter;
+			record.text[1] = default_path;
 
 			obs_data_array_t *array = obs_data_get_array(settings, name);
 			size_t count = obs_data_array_count(array);
-
-			for (size_t idx = 0; idx < count; ++idx) {
-				obs_data_t *item = obs_data_array_item(array, idx);
-				prop2->values.push_back((buf = obs_data_get_string(item, "value")) != nullptr ? buf : "");
+			for (size_t item_idx = 0; item_idx < count; ++item_idx) {
+				obs_data_t *item = obs_data_array_item(array, item_idx);
+				obs::flat::String value = writer.Intern(utility::GetSafeString(obs_data_get_string(item, "value")));
+				writer.AddItem(idx, obs::flat::ItemKind::EditableListValue).value = value;
+				obs_data_release(item);
 			}
-
-			prop = prop2;
+			obs_data_array_release(array);
 			break;
 		}
 		case OBS_PROPERTY_FRAME_RATE: {
-			auto prop2 = std::make_shared<obs::FrameRateProperty>();
-			size_t num_ranges = obs_property_frame_rate_fps_ranges_count(p);
-			for (size_t idx = 0; idx < num_ranges; idx++) {
-				auto min = obs_property_frame_rate_fps_range_min(p, idx), max = obs_property_frame_rate_fps_range_max(p, idx);
-
-				obs::FrameRateProperty::Range range;
-				range.minimum.first = min.numerator;
-				range.minimum.second = min.denominator;
-				range.maximum.first = max.numerator;
-				range.maximum.second = max.denominator;
-
-				prop2->ranges.push_back(std::move(range));
+			media_frames_per_second fps = {};
+			if (obs_data_get_frames_per_second(settings, name, &fps, nullptr)) {
+				writer.At(idx).ints[0] = fps.numerator;
+				writer.At(idx).ints[1] = fps.denominator;
 			}
 
-			size_t num_options = obs_property_frame_rate_options_count(p);
-			for (size_t idx = 0; idx < num_options; idx++) {
-				auto min = obs_property_frame_rate_fps_range_min(p, idx), max = obs_property_frame_rate_fps_range_max(p, idx);
-
-				obs::FrameRateProperty::Option option;
-				option.name = (buf = obs_property_frame_rate_option_name(p, idx)) != nullptr ? buf : "";
-				option.description = (buf = obs_property_frame_rate_option_description(p, idx)) != nullptr ? buf : "";
+			size_t num_ranges = obs_property_frame_rate_fps_ranges_count(p);
+			for (size_t item_idx = 0; item_idx < num_ranges; item_idx++) {
+				auto min = obs_property_frame_rate_fps_range_min(p, item_idx), max = obs_property_frame_rate_fps_range_max(p, item_idx);
 
-				prop2->options.push_back(std::move(option));
+				obs::flat::Item &item = writer.AddItem(idx, obs::flat::ItemKind::FrameRateRange);
+				item.value_int = (int64_t(min.numerator) << 32) | min.denominator;
+				item.value_int2 = (int64_t(max.numerator) << 32) | max.denominator;
 			}
 
-			media_frames_per_second fps = {};
-			if (obs_data_get_frames_per_second(settings, name, &fps, nullptr)) {
-				prop2->current_numerator = fps.numerator;
-				prop2->current_denominator = fps.denominator;
+			size_t num_options = obs_property_frame_rate_options_count(p);
+			for (size_t item_idx = 0; item_idx < num_options; item_idx++) {
+				obs::flat::String option_name = writer.Intern(utility::GetSafeString(obs_property_frame_rate_option_name(p, item_idx)));
+				obs::flat::String option_description =
+					writer.Intern(utility::GetSafeString(obs_property_frame_rate_option_description(p, item_idx)));
+
+				obs::flat::Item &item = writer.AddItem(idx, obs::flat::ItemKind::FrameRateOption);
+				item.name = option_name;
+				item.value = option_description;
 			}
-
-			prop = prop2;
 			break;
 		}
-		case OBS_PROPERTY_GROUP: {
-			auto grp = obs_property_group_content(p);
-			ProcessProperties(grp, settings, rval);
-			prop = nullptr;
+		default:
 			break;
 		}
-		}
-
-		if (!prop) {
-			continue;
-		}
-
-		prop->name = obs_property_name(p);
-		prop->description = obs_property_description(p) ? obs_property_description(p) : "";
-		prop->long_description = obs_property_long_description(p) ? obs_property_long_description(p) : "";
-		prop->enabled = obs_property_enabled(p);
-		prop->visible = obs_property_visible(p);
-
-		std::vector<char> buf(prop->size());
-		if (prop->serialize(buf)) {
-			rval.push_back(ipc::value(buf));
-		}
 	}
 }
 
+void utility::PackProperties(obs_properties_t *prp, obs_data *settings, std::vector<char> &packed)
+{
+	obs::flat::Writer writer;
+	CollectProperties(prp, settings, writer);
+	writer.Finish(packed);
+}
+
 const char *utility::GetSafeString(const char *str)
 {
 	return str ? str : "";
@@ -24,6 +24,7 @@
 #include <mutex>
 #include <obs.h>
 #include <ipc-server.hpp>
+#include "unique-id.hpp"
 
 #if defined(_MSC_VER)
 #define __PRETTY_FUNCTION__ __FUNCSIG__
@@ -53,197 +54,13 @@
 namespace utility {
 std::string osn_current_version(const std::string &_version = "");
 
-class unique_id {
-public:
-	typedef uint64_t id_t;
-	typedef std::pair<id_t, id_t> range_t;
+// Set by starting the server with OSN_HEADLESS=1 in its environment: no video
+// context, no displays and no audio monitoring device, so it runs on machines
+// without a GPU or audio hardware. Sources, scenes and settings still work.
+bool IsHeadless();
 
-public:
-	unique_id();
-	virtual ~unique_id();
-
-	id_t allocate();
-	void free(id_t);
-
-	bool is_allocated(id_t);
-	id_t count(bool count_free);
-
-protected:
-	bool mark_used(id_t);
-	void mark_used_range(id_t, id_t);
-	bool mark_free(id_t);
-	void mark_free_range(id_t, id_t);
-
-private:
-	std::list<range_t> allocated;
-};
-
-template<typename T> class unique_object_manager {
-protected:
-	utility::unique_id id_generator;
-	std::map<utility::unique_id::id_t, T *> object_map;
-	std::recursive_mutex internal_mutex;
-
-public:
-	unique_object_manager() {}
-	~unique_object_manager() { clear(); }
-
-	utility::unique_id::id_t allocate(T *obj)
-	{
-		std::lock_guard<std::recursive_mutex> lock(internal_mutex);
-
-		utility::unique_id::id_t uid = id_generator.allocate();
-		if (uid == std::numeric_limits<utility::unique_id::id_t>::max()) {
-			return uid;
-		}
-		object_map.insert_or_assign(uid, obj);
-		return uid;
-	}
-
-	utility::unique_id::id_t find(T *obj)
-	{
-		std::lock_guard<std::recursive_mutex> lock(internal_mutex);
-
-		for (auto kv : object_map) {
-			if (kv.second == obj) {
-				return kv.first;
-			}
-		}
-		return std::numeric_limits<utility::unique_id::id_t>::max();
-	}
-	T *find(utility::unique_id::id_t id)
-	{
-		std::lock_guard<std::recursive_mutex> lock(internal_mutex);
-
-		auto iter = object_map.find(id);
-		if (iter != object_map.end()) {
-			return iter->second;
-		}
-		return nullptr;
-	}
-
-	utility::unique_id::id_t free(T *obj)
-	{
-		std::lock_guard<std::recursive_mutex> lock(internal_mutex);
-
-		utility::unique_id::id_t uid = std::numeric_limits<utility::unique_id::id_t>::max();
-		for (auto kv : object_map) {
-			if (kv.second == obj) {
-				uid = kv.first;
-				object_map.erase(kv.first);
-				break;
-			}
-		}
-		return uid;
-	}
-	T *free(utility::unique_id::id_t id)
-	{
-		std::lock_guard<std::recursive_mutex> lock(internal_mutex);
-
-		auto iter = object_map.find(id);
-		if (iter == object_map.end()) {
-			return nullptr;
-		}
-		T *obj = iter->second;
-		object_map.erase(iter);
-		return obj;
-	}
-
-	void for_each(std::function<void(T *)> for_each_method)
-	{
-		for (auto it = object_map.begin(); it != object_map.end(); ++it) {
-			for_each_method(it->second);
-		}
-	}
-
-	size_t size() { return object_map.size(); }
-
-	void clear() { object_map.clear(); }
-};
-
-template<typename T> class generic_object_manager {
-protected:
-	utility::unique_id id_generator;
-	std::map<utility::unique_id::id_t, T> object_map;
-	std::recursive_mutex internal_mutex;
-
-public:
-	generic_object_manager() {}
-	~generic_object_manager() { clear(); }
-
-	utility::unique_id::id_t allocate(T obj)
-	{
-		std::lock_guard<std::recursive_mutex> lock(internal_mutex);
-
-		utility::unique_id::id_t uid = id_generator.allocate();
-		if (uid == std::numeric_limits<utility::unique_id::id_t>::max()) {
-			return uid;
-		}
-		object_map.insert_or_assign(uid, obj);
-		return uid;
-	}
-
-	utility::unique_id::id_t find(T obj)
-	{
-		std::lock_guard<std::recursive_mutex> lock(internal_mutex);
-
-		for (auto kv : object_map) {
-			if (kv.second == obj) {
-				return kv.first;
-			}
-		}
-		return std::numeric_limits<utility::unique_id::id_t>::max();
-	}
-	T find(utility::unique_id::id_t id)
-	{
-		std::lock_guard<std::recursive_mutex> lock(internal_mutex);
-
-		auto iter = object_map.find(id);
-		if (iter != object_map.end()) {
-			return iter->second;
-		}
-		return nullptr;
-	}
-
-	utility::unique_id::id_t free(T obj)
-	{
-		std::lock_guard<std::recursive_mutex> lock(internal_mutex);
-
-		utility::unique_id::id_t uid = std::numeric_limits<utility::unique_id::id_t>::max();
-		for (auto kv : object_map) {
-			if (kv.second == obj) {
-				uid = kv.first;
-				object_map.erase(kv.first);
-				break;
-			}
-		}
-		return uid;
-	}
-	T free(utility::unique_id::id_t id)
-	{
-		std::lock_guard<std::recursive_mutex> lock(internal_mutex);
-
-		auto iter = object_map.find(id);
-		if (iter == object_map.end()) {
-			return nullptr;
-		}
-		T obj = iter->second;
-		object_map.erase(iter);
-		return obj;
-	}
-
-	void for_each(std::function<void(T &)> for_each_method)
-	{
-		for (auto it = object_map.begin(); it != object_map.end(); ++it) {
-			for_each_method(it->second);
-		}
-	}
-
-	size_t size() { return object_map.size(); }
-
-	void clear() { object_map.clear(); }
-};
-
-void ProcessProperties(obs_properties_t *prp, obs_data *settings, std::vector<ipc::value> &rval);
+// Packs every property, with groups flattened, into one buffer using the
+// encoding described in obs-property-flat.hpp.
+void PackProperties(obs_properties_t *prp, obs_data *settings, std::vector<char> &packed);
 const char *GetSafeString(const char *str);
 } // namespace utility
@@ -0,0 +1,186 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "call-capture.hpp"
+#include <cstring>
+#include "packed-args.hpp"
+
+static bool is_sized(ipc::type type)
+{
+	return type == ipc::type::String || type == ipc::type::Binary;
+}
+
+static void append(std::vector<char> &buffer, const void *data, size_t size)
+{
+	buffer.insert(buffer.end(), reinterpret_cast<const char *>(data), reinterpret_cast<const char *>(data) + size);
+}
+
+static bool decode(FILE *file, ipc::value &value)
+{
+	uint8_t type;
+	if (fread(&type, sizeof(type), 1, file) != 1 || type > uint8_t(ipc::type::Binary))
+		return false;
+
+	value = ipc::value();
+	value.type = ipc::type(type);
+	if (is_sized(value.type)) {
+		uint32_t size;
+		if (fread(&size, sizeof(size), 1, file) != 1)
+			return false;
+		if (value.type == ipc::type::String) {
+			value.value_str.resize(size);
+			return size == 0 || fread(&value.value_str[0], size, 1, file) == 1;
+		}
+		value.value_bin.resize(size);
+		return size == 0 || fread(value.value_bin.data(), size, 1, file) == 1;
+	}
+
+	size_t size = packed::NumberSize(value.type);
+	return size == 0 || fread(&value.value_union, size, 1, file) == 1;
+}
+
+uint64_t capture::EncodedSize(const std::vector<ipc::value> &values)
+{
+	uint64_t size = 0;
+	for (auto &value : values) {
+		size += 1;
+		if (value.type == ipc::type::String)
+			size += sizeof(uint32_t) + value.value_str.size();
+		else if (value.type == ipc::type::Binary)
+			size += sizeof(uint32_t) + value.value_bin.size();
+		else
+			size += packed::NumberSize(value.type);
+	}
+	return size;
+}
+
+bool capture::SplitAction(const std::string &action, std::string &cname, std::string &fname)
+{
+	size_t separator = action.find("::");
+	if (separator == std::string::npos)
+		return false;
+
+	cname = action.substr(0, separator);
+	fname = action.substr(separator + 2);
+	return true;
+}
+
+capture::Writer::~Writer()
+{
+	Close();
+}
+
+bool capture::Writer::Open(const std::string &path, uint64_t start_time_ns)
+{
+	Close();
+	m_file = fopen(path.c_str(), "wb");
+	if (!m_file)
+		return false;
+
+	FileHeader header = {};
+	header.magic = Magic;
+	header.version = Version;
+	header.start_time_ns = start_time_ns;
+	if (fwrite(&header, sizeof(header), 1, m_file) != 1) {
+		Close();
+		return false;
+	}
+	m_count = 0;
+	return true;
+}
+
+void capture::Writer::Write(const Call &call)
+{
+	if (!m_file)
+		return;
+
+	m_buffer.resize(sizeof(Record));
+	Record *record = reinterpret_cast<Record *>(m_buffer.data());
+	memset(record, 0, sizeof(Record));
+	record->start_ns = call.start_ns;
+	record->duration_ns = call.duration_ns;
+	record->response_size = call.response_size;
+	record->response_count = call.response_count;
+	record->action_size = uint16_t(call.action.size());
+	record->arg_count = uint16_t(call.args.size());
+
+	append(m_buffer, call.action.data(), record->action_size);
+	for (size_t idx = 0; idx < record->arg_count; idx++)
+		packed::Append(m_buffer, call.args[idx]);
+
+	fwrite(m_buffer.data(), m_buffer.size(), 1, m_file);
+	m_count++;
+}
+
+void capture::Writer::Close()
+{
+	if (m_file)
+		fclose(m_file);
+	m_file = nullptr;
+}
+
+capture::Reader::~Reader()
+{
+	Close();
+}
+
+bool capture::Reader::Open(const std::string &path)
+{
+	Close();
+	m_file = fopen(path.c_str(), "rb");
+	if (!m_file)
+		return false;
+
+	if (fread(&m_header, sizeof(m_header), 1, m_file) != 1 || m_header.magic != Magic || m_header.version != Version) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+bool capture::Reader::Next(Call &call)
+{
+	if (!m_file)
+		return false;
+
+	Record record;
+	if (fread(&record, sizeof(record), 1, m_file) != 1)
+		return false;
+
+	call.start_ns = record.start_ns;
+	call.duration_ns = record.duration_ns;
+	call.response_size = record.response_size;
+	call.response_count = record.response_count;
+	call.action.resize(record.action_size);
+	if (record.action_size && fread(&call.action[0], record.action_size, 1, m_file) != 1)
+		return false;
+
+	call.args.resize(record.arg_count);
+	for (auto &arg : call.args) {
+		if (!decode(m_file, arg))
+			return false;
+	}
+	return true;
+}
+
+void capture::Reader::Close()
+{
+	if (m_file)
+		fclose(m_file);
+	m_file = nullptr;
+}
@@ -0,0 +1,100 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <cstdio>
+#include <inttypes.h>
+#include <string>
+#include <vector>
+#include "ipc-value.hpp"
+
+// File written by the server while a capture runs and read back by the
+// osn-replay benchmark:
+//
+//   FileHeader | Record, action, Value[arg_count] | Record, ... | ...
+//
+// Values are encoded as in packed-args.hpp.
+namespace capture {
+constexpr uint32_t Magic = 0x434E534F; // 'OSNC'
+constexpr uint32_t Version = 1;
+
+struct FileHeader {
+	uint32_t magic;
+	uint32_t version;
+	// Wall clock time the capture started at, in ns since the epoch.
+	uint64_t start_time_ns;
+};
+
+struct Record {
+	// Relative to the start of the capture.
+	uint64_t start_ns;
+	// Time spent by the server in the handler.
+	uint64_t duration_ns;
+	uint64_t response_size;
+	uint32_t response_count;
+	uint16_t action_size;
+	uint16_t arg_count;
+};
+
+struct Call {
+	uint64_t start_ns = 0;
+	uint64_t duration_ns = 0;
+	uint64_t response_size = 0;
+	uint32_t response_count = 0;
+	// "Collection::Function"
+	std::string action;
+	std::vector<ipc::value> args;
+};
+
+// Bytes taken by the values once encoded, used as the size of a response.
+uint64_t EncodedSize(const std::vector<ipc::value> &values);
+
+// Splits an action into its collection and function names.
+bool SplitAction(const std::string &action, std::string &cname, std::string &fname);
+
+class Writer {
+public:
+	~Writer();
+
+	bool Open(const std::string &path, uint64_t start_time_ns);
+	bool IsOpen() { return m_file != nullptr; }
+	void Write(const Call &call);
+	void Close();
+	uint64_t Count() { return m_count; }
+
+private:
+	FILE *m_file = nullptr;
+	std::vector<char> m_buffer;
+	uint64_t m_count = 0;
+};
+
+class Reader {
+public:
+	~Reader();
+
+	bool Open(const std::string &path);
+	const FileHeader &Header() { return m_header; }
+	// Returns false at the end of the file or on a truncated record.
+	bool Next(Call &call);
+	void Close();
+
+private:
+	FILE *m_file = nullptr;
+	FileHeader m_header = {};
+};
+} // namespace capture
@@ -0,0 +1,51 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+
+// Media playback events carried by CallbackManager::GlobalQuery. The reply
+// holds one Binary value right after the source sizes, an array of Event
+// for the subscribed media sources that changed since the previous query.
+// A source shows up at most once per query with its latest state: several
+// signals in between collapse into the last one.
+namespace media {
+enum class Reason : uint32_t {
+	// Periodic update while playing, rate limited by the server.
+	Position,
+	Started,
+	Ended,
+	Paused,
+	Played,
+	Restarted,
+	Stopped,
+};
+
+struct Event {
+	uint64_t uid;
+	int64_t time_ms;
+	int64_t duration_ms;
+	// enum obs_media_state
+	int32_t state;
+	uint32_t reason;
+};
+
+constexpr uint32_t DefaultIntervalMs = 250;
+constexpr uint32_t MinIntervalMs = 50;
+constexpr uint32_t MaxIntervalMs = 5000;
+} // namespace media
@@ -0,0 +1,327 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "obs-property-flat.hpp"
+#include <cstring>
+
+uint32_t obs::flat::Writer::Begin(Property::Type type, std::string_view name, std::string_view description, std::string_view long_description,
+				  bool enabled, bool visible)
+{
+	Record record = {};
+	record.type = uint8_t(type);
+	record.flags = (enabled ? RecordFlags::Enabled : 0) | (visible ? RecordFlags::Visible : 0);
+	record.item_first = uint32_t(m_items.size());
+	record.name = Intern(name);
+	record.description = Intern(description);
+	record.long_description = Intern(long_description);
+
+	m_records.push_back(record);
+	return uint32_t(m_records.size() - 1);
+}
+
+obs::flat::String obs::flat::Writer::Intern(std::string_view str)
+{
+	String ref = {uint32_t(m_strings.size()), uint32_t(str.size())};
+	m_strings.insert(m_strings.end(), str.begin(), str.end());
+	return ref;
+}
+
+obs::flat::Item &obs::flat::Writer::AddItem(uint32_t record, ItemKind kind)
+{
+	Record &owner = m_records[record];
+	if (owner.item_count == 0)
+		owner.item_first = uint32_t(m_items.size());
+	owner.item_count++;
+
+	Item item = {};
+	item.kind = kind;
+	item.enabled = 1;
+	m_items.push_back(item);
+	return m_items.back();
+}
+
+void obs::flat::Writer::Add(Property &prop)
+{
+	uint32_t idx = Begin(prop.type(), prop.name, prop.description, prop.long_description, prop.enabled, prop.visible);
+
+	switch (prop.type()) {
+	case Property::Type::Boolean: {
+		auto &cast = static_cast<BooleanProperty &>(prop);
+		At(idx).ints[0] = cast.value;
+		break;
+	}
+	case Property::Type::Integer: {
+		auto &cast = static_cast<IntegerProperty &>(prop);
+		Record &record = At(idx);
+		record.field_type = uint8_t(cast.field_type);
+		record.ints[0] = cast.minimum;
+		record.ints[1] = cast.maximum;
+		record.ints[2] = cast.step;
+		record.ints[3] = cast.value;
+		break;
+	}
+	case Property::Type::Float: {
+		auto &cast = static_cast<FloatProperty &>(prop);
+		Record &record = At(idx);
+		record.field_type = uint8_t(cast.field_type);
+		record.floats[0] = cast.minimum;
+		record.floats[1] = cast.maximum;
+		record.floats[2] = cast.step;
+		record.floats[3] = cast.value;
+		break;
+	}
+	case Property::Type::Color: {
+		auto &cast = static_cast<ColorProperty &>(prop);
+		At(idx).field_type = uint8_t(cast.field_type);
+		At(idx).ints[0] = cast.value;
+		break;
+	}
+	case Property::Type::Capture: {
+		auto &cast = static_cast<CaptureProperty &>(prop);
+		At(idx).field_type = uint8_t(cast.field_type);
+		At(idx).ints[0] = cast.value;
+		break;
+	}
+	case Property::Type::Text: {
+		auto &cast = static_cast<TextProperty &>(prop);
+		String value = Intern(cast.value);
+		Record &record = At(idx);
+		record.field_type = uint8_t(cast.field_type);
+		record.format = uint8_t(cast.info_type);
+		record.text[0] = value;
+		break;
+	}
+	case Property::Type::Path: {
+		auto &cast = static_cast<PathProperty &>(prop);
+		String filter = Intern(cast.filter);
+		String default_path = Intern(cast.default_path);
+		String value = Intern(cast.value);
+		Record &record = At(idx);
+		record.field_type = uint8_t(cast.field_type);
+		record.text[0] = filter;
+		record.text[1] = default_path;
+		record.text[2] = value;
+		break;
+	}
+	case Property::Type::List: {
+		auto &cast = static_cast<ListProperty &>(prop);
+		String current = Intern(cast.format == ListProperty::Format::String ? std::string_view(cast.current_value_str) : std::string_view());
+		Record &record = At(idx);
+		record.field_type = uint8_t(cast.field_type);
+		record.format = uint8_t(cast.format);
+		record.ints[0] = cast.format == ListProperty::Format::Integer ? cast.current_value_int : 0;
+		record.floats[0] = cast.format == ListProperty::Format::Float ? cast.current_value_float : 0;
+		record.text[0] = current;
+
+		for (auto &entry : cast.items) {
+			String name = Intern(entry.name);
+			String value = Intern(cast.format == ListProperty::Format::String ? std::string_view(entry.value_string) : std::string_view());
+			Item &item = AddItem(idx, ItemKind::ListEntry);
+			item.name = name;
+			item.value = value;
+			item.enabled = entry.enabled;
+			item.value_int = cast.format == ListProperty::Format::Integer ? entry.value_int : 0;
+			item.value_float = cast.format == ListProperty::Format::Float ? entry.value_float : 0;
+		}
+		break;
+	}
+	case Property::Type::Font: {
+		auto &cast = static_cast<FontProperty &>(prop);
+		String face = Intern(cast.face);
+		String style = Intern(cast.style);
+		String path = Intern(cast.path);
+		Record &record = At(idx);
+		record.text[0] = face;
+		record.text[1] = style;
+		record.text[2] = path;
+		record.ints[0] = cast.sizeF;
+		record.ints[1] = cast.flags;
+		break;
+	}
+	case Property::Type::EditableList: {
+		auto &cast = static_cast<EditableListProperty &>(prop);
+		String filter = Intern(cast.filter);
+		String default_path = Intern(cast.default_path);
+		Record &record = At(idx);
+		record.field_type = uint8_t(cast.field_type);
+		record.text[0] = filter;
+		record.text[1] = default_path;
+
+		for (auto &entry : cast.values) {
+			String value = Intern(entry);
+			AddItem(idx, ItemKind::EditableListValue).value = value;
+		}
+		break;
+	}
+	case Property::Type::FrameRate: {
+		auto &cast = static_cast<FrameRateProperty &>(prop);
+		At(idx).ints[0] = cast.current_numerator;
+		At(idx).ints[1] = cast.current_denominator;
+
+		for (auto &range : cast.ranges) {
+			Item &item = AddItem(idx, ItemKind::FrameRateRange);
+			item.value_int = (int64_t(range.minimum.first) << 32) | range.minimum.second;
+			item.value_int2 = (int64_t(range.maximum.first) << 32) | range.maximum.second;
+		}
+		for (auto &option : cast.options) {
+			String name = Intern(option.name);
+			String description = Intern(option.description);
+			Item &item = AddItem(idx, ItemKind::FrameRateOption);
+			item.name = name;
+			item.value = description;
+		}
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+void obs::flat::Writer::Copy(const View &view, const Record &record)
+{
+	Record copy = record;
+	copy.name = Intern(view.Str(record.name));
+	copy.description = Intern(view.Str(record.description));
+	copy.long_description = Intern(view.Str(record.long_description));
+	for (size_t idx = 0; idx < 3; idx++)
+		copy.text[idx] = Intern(view.Str(record.text[idx]));
+	copy.item_first = uint32_t(m_items.size());
+
+	for (uint32_t idx = 0; idx < record.item_count; idx++) {
+		Item item = view.GetItem(record, idx);
+		item.name = Intern(view.Str(item.name));
+		item.value = Intern(view.Str(item.value));
+		m_items.push_back(item);
+	}
+	m_records.push_back(copy);
+}
+
+void obs::flat::Writer::Finish(std::vector<char> &out)
+{
+	size_t records_size = m_records.size() * sizeof(Record);
+	size_t items_size = m_items.size() * sizeof(Item);
+
+	Header header = {};
+	header.magic = Magic;
+	header.version = Version;
+	header.property_count = uint32_t(m_records.size());
+	header.item_count = uint32_t(m_items.size());
+	header.strings_offset = uint32_t(sizeof(Header) + records_size + items_size);
+	header.strings_size = uint32_t(m_strings.size());
+
+	out.resize(header.strings_offset + m_strings.size());
+	char *ptr = out.data();
+	memcpy(ptr, &header, sizeof(Header));
+	ptr += sizeof(Header);
+	if (records_size)
+		memcpy(ptr, m_records.data(), records_size);
+	ptr += records_size;
+	if (items_size)
+		memcpy(ptr, m_items.data(), items_size);
+	ptr += items_size;
+	if (!m_strings.empty())
+		memcpy(ptr, m_strings.data(), m_strings.size());
+}
+
+void obs::flat::Writer::Clear()
+{
+	m_records.clear();
+	m_items.clear();
+	m_strings.clear();
+}
+
+static inline bool string_valid(const obs::flat::String &str, uint32_t strings_size)
+{
+	return uint64_t(str.offset) + str.length <= strings_size;
+}
+
+bool obs::flat::View::Open(const char *data, size_t size)
+{
+	m_header = nullptr;
+	if (!data || size < sizeof(Header))
+		return false;
+
+	const Header *header = reinterpret_cast<const Header *>(data);
+	if (header->magic != Magic || header->version != Version)
+		return false;
+
+	uint64_t expected = sizeof(Header) + uint64_t(header->property_count) * sizeof(Record) + uint64_t(header->item_count) * sizeof(Item);
+	if (header->strings_offset != expected || uint64_t(header->strings_offset) + header->strings_size > size)
+		return false;
+
+	const Record *records = reinterpret_cast<const Record *>(data + sizeof(Header));
+	const Item *items = reinterpret_cast<const Item *>(data + sizeof(Header) + header->property_count * sizeof(Record));
+
+	for (uint32_t idx = 0; idx < header->property_count; idx++) {
+		const Record &record = records[idx];
+		if (uint64_t(record.item_first) + record.item_count > header->item_count)
+			return false;
+		if (!string_valid(record.name, header->strings_size) || !string_valid(record.description, header->strings_size) ||
+		    !string_valid(record.long_description, header->strings_size))
+			return false;
+		for (const String &str : record.text) {
+			if (!string_valid(str, header->strings_size))
+				return false;
+		}
+	}
+	for (uint32_t idx = 0; idx < header->item_count; idx++) {
+		if (!string_valid(items[idx].name, header->strings_size) || !string_valid(items[idx].value, header->strings_size))
+			return false;
+	}
+
+	m_header = header;
+	m_records = records;
+	m_items = items;
+	m_strings = data + header->strings_offset;
+	return true;
+}
+
+uint32_t obs::flat::View::Find(std::string_view name) const
+{
+	for (uint32_t idx = 0; idx < Count(); idx++) {
+		if (Str(m_records[idx].name) == name)
+			return idx;
+	}
+	return Count();
+}
+
+bool obs::flat::View::Equal(const View &a, const Record &ra, const View &b, const Record &rb)
+{
+	if (ra.type != rb.type || ra.field_type != rb.field_type || ra.format != rb.format || ra.flags != rb.flags || ra.item_count != rb.item_count)
+		return false;
+	if (memcmp(ra.ints, rb.ints, sizeof(ra.ints)) != 0 || memcmp(ra.floats, rb.floats, sizeof(ra.floats)) != 0)
+		return false;
+	if (a.Str(ra.name) != b.Str(rb.name) || a.Str(ra.description) != b.Str(rb.description) ||
+	    a.Str(ra.long_description) != b.Str(rb.long_description))
+		return false;
+	for (size_t idx = 0; idx < 3; idx++) {
+		if (a.Str(ra.text[idx]) != b.Str(rb.text[idx]))
+			return false;
+	}
+
+	for (uint32_t idx = 0; idx < ra.item_count; idx++) {
+		const Item &ia = a.GetItem(ra, idx);
+		const Item &ib = b.GetItem(rb, idx);
+		if (ia.kind != ib.kind || ia.enabled != ib.enabled || ia.value_int != ib.value_int || ia.value_int2 != ib.value_int2 ||
+		    memcmp(&ia.value_float, &ib.value_float, sizeof(double)) != 0)
+			return false;
+		if (a.Str(ia.name) != b.Str(ib.name) || a.Str(ia.value) != b.Str(ib.value))
+			return false;
+	}
+	return true;
+}
@@ -0,0 +1,156 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "obs-property.hpp"
+
+// Flat encoding of a whole set of properties in a single buffer:
+//
+//   Header | Record[property_count] | Item[item_count] | string table
+//
+// Records and items have a fixed size and refer to strings by offset into the
+// string table, so a reader can walk the buffer in place without allocating.
+// Which fields of a record are used depends on its type:
+//
+//   Boolean           ints[0] = value
+//   Integer           field_type, ints = {min, max, step, value}
+//   Float             field_type, floats = {min, max, step, value}
+//   Color, Capture    field_type, ints[0] = value
+//   Text              field_type, format = info type, text[0] = value
+//   Path              field_type, text = {filter, default path, value}
+//   List              field_type, format, current value in ints[0], floats[0]
+//                     or text[0], one item per entry
+//   Font              text = {face, style, path}, ints = {size, flags}
+//   EditableList      field_type, text = {filter, default path}, one item per value
+//   FrameRate         ints = {numerator, denominator}, one item per range
+//                     followed by one item per option
+namespace obs {
+namespace flat {
+constexpr uint32_t Magic = 0x50464C54; // 'TLFP'
+constexpr uint32_t Version = 1;
+
+struct String {
+	uint32_t offset;
+	uint32_t length;
+};
+
+struct Header {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t property_count;
+	uint32_t item_count;
+	uint32_t strings_offset;
+	uint32_t strings_size;
+};
+
+enum RecordFlags : uint8_t {
+	Enabled = 1 << 0,
+	Visible = 1 << 1,
+};
+
+struct Record {
+	uint8_t type;
+	uint8_t field_type;
+	uint8_t format;
+	uint8_t flags;
+	uint32_t item_first;
+	uint32_t item_count;
+	uint32_t reserved;
+
+	String name;
+	String description;
+	String long_description;
+	String text[3];
+
+	int64_t ints[4];
+	double floats[4];
+};
+
+enum class ItemKind : uint32_t {
+	ListEntry,
+	EditableListValue,
+	FrameRateRange,
+	FrameRateOption,
+};
+
+struct Item {
+	String name;
+	String value;
+	// FrameRateRange packs numerator << 32 | denominator of the minimum into
+	// value_int and of the maximum into value_int2.
+	int64_t value_int;
+	int64_t value_int2;
+	double value_float;
+	uint32_t enabled;
+	ItemKind kind;
+};
+
+class Writer {
+public:
+	// Starts a new record. Items added afterwards belong to it until the next call.
+	uint32_t Begin(Property::Type type, std::string_view name, std::string_view description, std::string_view long_description, bool enabled,
+		       bool visible);
+	Record &At(uint32_t record) { return m_records[record]; }
+	String Intern(std::string_view str);
+	Item &AddItem(uint32_t record, ItemKind kind);
+
+	// Converts an already built obs::Property.
+	void Add(Property &prop);
+	// Copies a record and its items from another buffer.
+	void Copy(const class View &view, const Record &record);
+
+	void Finish(std::vector<char> &out);
+	void Clear();
+
+	size_t Count() { return m_records.size(); }
+
+private:
+	std::vector<Record> m_records;
+	std::vector<Item> m_items;
+	std::vector<char> m_strings;
+};
+
+class View {
+public:
+	// Validates the buffer once, every accessor after that is unchecked.
+	bool Open(const char *data, size_t size);
+
+	uint32_t Count() const { return m_header ? m_header->property_count : 0; }
+	const Record &Get(uint32_t index) const { return m_records[index]; }
+	const Item &GetItem(const Record &record, uint32_t index) const { return m_items[record.item_first + index]; }
+	std::string_view Str(const String &str) const { return std::string_view(m_strings + str.offset, str.length); }
+
+	// Returns Count() if no property has that name.
+	uint32_t Find(std::string_view name) const;
+
+	// Everything the client can observe is the same: flags, values, limits,
+	// strings and list items.
+	static bool Equal(const View &a, const Record &ra, const View &b, const Record &rb);
+
+private:
+	const Header *m_header = nullptr;
+	const Record *m_records = nullptr;
+	const Item *m_items = nullptr;
+	const char *m_strings = nullptr;
+};
+} // namespace flat
+} // namespace obs
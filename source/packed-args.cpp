@@ -0,0 +1,112 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "packed-args.hpp"
+#include <cstring>
+
+size_t packed::NumberSize(ipc::type type)
+{
+	switch (type) {
+	case ipc::type::Int32:
+	case ipc::type::UInt32:
+	case ipc::type::Float:
+		return 4;
+	case ipc::type::Int64:
+	case ipc::type::UInt64:
+	case ipc::type::Double:
+		return 8;
+	default:
+		return 0;
+	}
+}
+
+static void append(std::vector<char> &buffer, const void *data, size_t size)
+{
+	buffer.insert(buffer.end(), reinterpret_cast<const char *>(data), reinterpret_cast<const char *>(data) + size);
+}
+
+void packed::Append(std::vector<char> &buffer, const ipc::value &value)
+{
+	buffer.push_back(char(value.type));
+	if (value.type == ipc::type::String) {
+		uint32_t size = uint32_t(value.value_str.size());
+		append(buffer, &size, sizeof(size));
+		append(buffer, value.value_str.data(), size);
+	} else if (value.type == ipc::type::Binary) {
+		uint32_t size = uint32_t(value.value_bin.size());
+		append(buffer, &size, sizeof(size));
+		append(buffer, value.value_bin.data(), size);
+	} else {
+		// Every number sits at the start of the union.
+		append(buffer, &value.value_union, NumberSize(value.type));
+	}
+}
+
+std::vector<char> packed::Pack(const std::vector<ipc::value> &values)
+{
+	std::vector<char> buffer;
+	for (auto &value : values)
+		Append(buffer, value);
+	return buffer;
+}
+
+bool packed::Unpack(const std::vector<char> &buffer, std::vector<ipc::value> &values)
+{
+	size_t offset = 0;
+	while (offset < buffer.size()) {
+		uint8_t type = uint8_t(buffer[offset++]);
+		if (type > uint8_t(ipc::type::Binary))
+			return false;
+
+		ipc::value value;
+		value.type = ipc::type(type);
+		if (value.type == ipc::type::String || value.type == ipc::type::Binary) {
+			uint32_t size;
+			if (offset + sizeof(size) > buffer.size())
+				return false;
+			memcpy(&size, buffer.data() + offset, sizeof(size));
+			offset += sizeof(size);
+			if (size > buffer.size() - offset)
+				return false;
+			if (value.type == ipc::type::String)
+				value.value_str.assign(buffer.data() + offset, size);
+			else
+				value.value_bin.assign(buffer.data() + offset, buffer.data() + offset + size);
+			offset += size;
+		} else {
+			size_t size = NumberSize(value.type);
+			if (offset + size > buffer.size())
+				return false;
+			memcpy(&value.value_union, buffer.data() + offset, size);
+			offset += size;
+		}
+		values.push_back(std::move(value));
+	}
+	return true;
+}
+
+bool packed::Matches(const std::vector<ipc::value> &values, const std::vector<ipc::type> &types)
+{
+	if (values.size() != types.size())
+		return false;
+	for (size_t idx = 0; idx < types.size(); idx++) {
+		if (values[idx].type != types[idx])
+			return false;
+	}
+	return true;
+}
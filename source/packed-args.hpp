@@ -0,0 +1,40 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+#include <vector>
+#include "ipc-value.hpp"
+
+// Several ipc::value packed into a single Binary value. Used where one IPC
+// function forwards the arguments of another, since the ipc library matches
+// functions by their argument types and cannot take a variable list.
+//
+// A value is its ipc::type as one byte followed by the raw number, or by a
+// uint32_t length and the bytes for strings and binaries.
+namespace packed {
+size_t NumberSize(ipc::type type);
+
+void Append(std::vector<char> &buffer, const ipc::value &value);
+std::vector<char> Pack(const std::vector<ipc::value> &values);
+// Returns false if the buffer is truncated or holds an unknown type.
+bool Unpack(const std::vector<char> &buffer, std::vector<ipc::value> &values);
+// Whether the values have exactly the given types, in order. The ipc library
+// only calls a function when this holds, forwarded calls have to check it too.
+bool Matches(const std::vector<ipc::value> &values, const std::vector<ipc::type> &types);
+} // namespace packed
@@ -0,0 +1,292 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "shared-memory-arena.hpp"
+#include <chrono>
+#include <cstring>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static constexpr uint64_t SlotAlignment = 64;
+
+static inline uint64_t align_up(uint64_t v)
+{
+	return (v + SlotAlignment - 1) & ~(SlotAlignment - 1);
+}
+
+std::unique_ptr<shm::Arena> shm::Arena::Create(const std::string &name, uint64_t capacity)
+{
+	std::unique_ptr<Arena> arena(new Arena());
+	arena->m_name = name;
+	arena->m_owner = true;
+
+	if (!arena->Map(sizeof(Header) + capacity, true))
+		return nullptr;
+
+	Header *header = arena->m_header;
+	header->magic = ArenaMagic;
+	header->version = ArenaVersion;
+	header->capacity = capacity;
+	for (uint32_t idx = 0; idx < SlotCount; idx++) {
+		header->slots[idx].state.store(SlotFree);
+		header->slots[idx].generation = 0;
+		header->slots[idx].offset = 0;
+		header->slots[idx].size = 0;
+	}
+
+	return arena;
+}
+
+std::unique_ptr<shm::Arena> shm::Arena::Open(const std::string &name)
+{
+	std::unique_ptr<Arena> arena(new Arena());
+	arena->m_name = name;
+	arena->m_owner = false;
+
+	// Map the header first to learn the real size of the arena.
+	if (!arena->Map(sizeof(Header), false))
+		return nullptr;
+
+	if (arena->m_header->magic != ArenaMagic || arena->m_header->version != ArenaVersion)
+		return nullptr;
+
+	uint64_t total = sizeof(Header) + arena->m_header->capacity;
+	arena->Unmap();
+	if (!arena->Map(total, false))
+		return nullptr;
+
+	return arena;
+}
+
+shm::Arena::~Arena()
+{
+	Unmap();
+}
+
+#ifdef WIN32
+bool shm::Arena::Map(uint64_t total, bool create)
+{
+	std::wstring wname(m_name.begin(), m_name.end());
+	if (create) {
+		m_handle = CreateFileMappingW(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, DWORD(total >> 32), DWORD(total & 0xFFFFFFFF), wname.c_str());
+	} else {
+		m_handle = OpenFileMappingW(FILE_MAP_ALL_ACCESS, FALSE, wname.c_str());
+	}
+	if (!m_handle)
+		return false;
+
+	m_header = reinterpret_cast<Header *>(MapViewOfFile(m_handle, FILE_MAP_ALL_ACCESS, 0, 0, SIZE_T(total)));
+	if (!m_header) {
+		CloseHandle(m_handle);
+		m_handle = nullptr;
+		return false;
+	}
+	m_mapped = total;
+	return true;
+}
+
+void shm::Arena::Unmap()
+{
+	if (m_header)
+		UnmapViewOfFile(m_header);
+	if (m_handle)
+		CloseHandle(m_handle);
+	m_header = nullptr;
+	m_handle = nullptr;
+	m_mapped = 0;
+}
+#else
+bool shm::Arena::Map(uint64_t total, bool create)
+{
+	if (create) {
+		shm_unlink(m_name.c_str());
+		m_fd = shm_open(m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+		if (m_fd >= 0 && ftruncate(m_fd, off_t(total)) != 0) {
+			close(m_fd);
+			shm_unlink(m_name.c_str());
+			m_fd = -1;
+		}
+	} else {
+		m_fd = shm_open(m_name.c_str(), O_RDWR, S_IRUSR | S_IWUSR);
+	}
+	if (m_fd < 0)
+		return false;
+
+	void *ptr = mmap(nullptr, size_t(total), PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+	if (ptr == MAP_FAILED) {
+		close(m_fd);
+		m_fd = -1;
+		return false;
+	}
+	m_header = reinterpret_cast<Header *>(ptr);
+	m_mapped = total;
+	return true;
+}
+
+void shm::Arena::Unmap()
+{
+	if (m_header)
+		munmap(m_header, size_t(m_mapped));
+	if (m_fd >= 0) {
+		close(m_fd);
+		if (m_owner)
+			shm_unlink(m_name.c_str());
+	}
+	m_header = nullptr;
+	m_fd = -1;
+	m_mapped = 0;
+}
+#endif
+
+static uint64_t now_ns()
+{
+	return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+uint32_t shm::Arena::Allocate(uint64_t size, char **data)
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+
+	uint64_t capacity = m_header->capacity;
+	size = align_up(size);
+	if (size == 0 || size > capacity)
+		return InvalidSlot;
+
+	uint64_t now = now_ns();
+	ReclaimExpired(now);
+
+	uint32_t free_slot = InvalidSlot;
+	for (uint32_t idx = 0; idx < SlotCount; idx++) {
+		if (m_header->slots[idx].state.load(std::memory_order_acquire) == SlotFree) {
+			free_slot = idx;
+			break;
+		}
+	}
+	if (free_slot == InvalidSlot)
+		return InvalidSlot;
+
+	// Ring allocation: start at the cursor and skip past any region that the
+	// client still holds. Every skip jumps over one live slot, so the loop is
+	// bounded by the number of slots (plus one wrap-around).
+	uint64_t offset = m_cursor;
+	for (uint32_t attempt = 0; attempt <= SlotCount + 1; attempt++) {
+		if (offset + size > capacity)
+			offset = 0;
+
+		bool overlaps = false;
+		for (uint32_t idx = 0; idx < SlotCount; idx++) {
+			Slot &slot = m_header->slots[idx];
+			if (slot.state.load(std::memory_order_acquire) == SlotFree)
+				continue;
+			if (offset < slot.offset + slot.size && slot.offset < offset + size) {
+				offset = align_up(slot.offset + slot.size);
+				overlaps = true;
+				break;
+			}
+		}
+
+		if (!overlaps) {
+			Slot &slot = m_header->slots[free_slot];
+			// Generation 0 would read as a free slot.
+			slot.generation = (slot.generation + 1) & TicketGenerationMask;
+			if (slot.generation == SlotFree)
+				slot.generation = 1;
+			slot.offset = offset;
+			slot.size = size;
+			slot.state.store(slot.generation, std::memory_order_release);
+			m_leased_ns[free_slot] = now;
+
+			m_cursor = offset + size;
+			*data = Base() + offset;
+			return MakeTicket(free_slot, slot.generation);
+		}
+	}
+
+	return InvalidSlot;
+}
+
+uint32_t shm::Arena::ReclaimExpired(uint64_t now_ns)
+{
+	uint32_t count = 0;
+	for (uint32_t idx = 0; idx < SlotCount; idx++) {
+		Slot &slot = m_header->slots[idx];
+		uint32_t generation = slot.state.load(std::memory_order_acquire);
+		if (generation == SlotFree || now_ns - m_leased_ns[idx] < LeaseTimeoutNs)
+			continue;
+		// Fails if the client released it meanwhile, which is just as good.
+		if (slot.state.compare_exchange_strong(generation, SlotFree, std::memory_order_acq_rel))
+			count++;
+	}
+	return count;
+}
+
+uint32_t shm::Arena::ReclaimAll()
+{
+	std::unique_lock<std::mutex> ulock(m_mutex);
+
+	uint32_t count = 0;
+	for (uint32_t idx = 0; idx < SlotCount; idx++) {
+		if (m_header->slots[idx].state.exchange(SlotFree, std::memory_order_acq_rel) != SlotFree)
+			count++;
+	}
+	m_cursor = 0;
+	return count;
+}
+
+const char *shm::Arena::Data(uint32_t ticket, uint64_t &size)
+{
+	uint32_t slot = TicketSlot(ticket);
+	if (slot >= SlotCount)
+		return nullptr;
+
+	Slot &entry = m_header->slots[slot];
+	if (entry.state.load(std::memory_order_acquire) != TicketGeneration(ticket))
+		return nullptr;
+	if (entry.offset + entry.size > m_header->capacity)
+		return nullptr;
+
+	size = entry.size;
+	return Base() + entry.offset;
+}
+
+void shm::Arena::Release(uint32_t ticket)
+{
+	uint32_t slot = TicketSlot(ticket);
+	if (slot >= SlotCount)
+		return;
+
+	uint32_t generation = TicketGeneration(ticket);
+	m_header->slots[slot].state.compare_exchange_strong(generation, SlotFree, std::memory_order_acq_rel);
+}
+
+uint32_t shm::Arena::SlotsInUse()
+{
+	uint32_t count = 0;
+	for (uint32_t idx = 0; idx < SlotCount; idx++) {
+		if (m_header->slots[idx].state.load(std::memory_order_acquire) != SlotFree)
+			count++;
+	}
+	return count;
+}
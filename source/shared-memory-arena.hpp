@@ -0,0 +1,128 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <inttypes.h>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace shm {
+// Payloads smaller than this are cheaper to send through the socket.
+constexpr uint64_t DefaultThreshold = 64 * 1024;
+constexpr uint64_t DefaultCapacity = 32 * 1024 * 1024;
+constexpr uint32_t SlotCount = 64;
+constexpr uint32_t InvalidSlot = UINT32_MAX;
+// A slot the client has not released after this long is taken back by the
+// server, the client never keeps a payload around for more than one call.
+constexpr uint64_t LeaseTimeoutNs = 10ull * 1000 * 1000 * 1000;
+
+constexpr uint32_t ArenaMagic = 0x4D4E534F; // 'OSNM'
+constexpr uint32_t ArenaVersion = 2;
+
+// The slot value sent to the client is a ticket: the slot index in the low
+// byte and the generation of the allocation above it. A ticket only refers
+// to the allocation it was handed out for, so releasing a slot the server
+// already took back (and maybe reused) does nothing.
+constexpr uint32_t TicketSlotBits = 8;
+constexpr uint32_t TicketGenerationMask = (1u << (32 - TicketSlotBits)) - 1;
+constexpr uint32_t SlotFree = 0;
+
+constexpr uint32_t MakeTicket(uint32_t slot, uint32_t generation)
+{
+	return (generation << TicketSlotBits) | slot;
+}
+constexpr uint32_t TicketSlot(uint32_t ticket)
+{
+	return ticket & ((1u << TicketSlotBits) - 1);
+}
+constexpr uint32_t TicketGeneration(uint32_t ticket)
+{
+	return ticket >> TicketSlotBits;
+}
+
+// Everything below lives inside the mapping and is shared by both processes.
+// The server is the only writer of offset/size. state is 0 while the slot is
+// free and holds the generation of the allocation while it is in use, the
+// client only swaps its own generation back to 0 once it is done reading.
+struct Slot {
+	std::atomic<uint32_t> state;
+	uint32_t generation;
+	uint64_t offset;
+	uint64_t size;
+};
+
+struct Header {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t capacity;
+	Slot slots[SlotCount];
+};
+
+class Arena {
+public:
+	// Server side: creates and owns the named mapping.
+	static std::unique_ptr<Arena> Create(const std::string &name, uint64_t capacity);
+	// Client side: attaches to a mapping created by the server.
+	static std::unique_ptr<Arena> Open(const std::string &name);
+
+	~Arena();
+
+	Arena(Arena const &) = delete;
+	void operator=(Arena const &) = delete;
+
+	// Reserves a slot holding `size` bytes and returns its ticket, or
+	// InvalidSlot if the arena is too fragmented or too small. Slots whose
+	// lease expired are taken back first.
+	uint32_t Allocate(uint64_t size, char **data);
+	// Both return nothing for a ticket of an allocation that is gone.
+	const char *Data(uint32_t ticket, uint64_t &size);
+	void Release(uint32_t ticket);
+	// Server side: frees every slot, for a client that reconnected and can
+	// no longer release the slots it was sent before.
+	uint32_t ReclaimAll();
+
+	const std::string &Name() { return m_name; }
+	uint64_t Capacity() { return m_header->capacity; }
+	uint32_t SlotsInUse();
+
+private:
+	Arena() {}
+
+	bool Map(uint64_t total, bool create);
+	void Unmap();
+	char *Base() { return reinterpret_cast<char *>(m_header) + sizeof(Header); }
+	uint32_t ReclaimExpired(uint64_t now_ns);
+
+	std::string m_name;
+	bool m_owner = false;
+	Header *m_header = nullptr;
+	uint64_t m_mapped = 0;
+	uint64_t m_cursor = 0;
+	std::mutex m_mutex;
+	// Server side only: when each slot was handed out.
+	uint64_t m_leased_ns[SlotCount] = {};
+
+#ifdef WIN32
+	void *m_handle = nullptr;
+#else
+	int m_fd = -1;
+#endif
+};
+} // namespace shm
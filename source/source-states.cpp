@@ -0,0 +1,90 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "source-states.hpp"
+
+static inline size_t align_up(size_t v)
+{
+	return (v + 7) & ~size_t(7);
+}
+
+states::Layout::Layout(uint32_t count, uint32_t mask) : m_count(count), m_mask(mask & AllFields)
+{
+	// valid[] always comes first.
+	size_t offset = align_up(count);
+	for (uint32_t idx = 0; idx < uint32_t(Field::Count); idx++) {
+		m_offsets[idx] = 0;
+		if (!Has(Field(idx)))
+			continue;
+
+		m_offsets[idx] = offset;
+		offset = align_up(offset + ElementSize(Field(idx)) * count);
+	}
+	m_size = offset;
+}
+
+size_t states::Layout::ElementSize(Field field)
+{
+	switch (field) {
+	case Field::Muted:
+	case Field::Active:
+	case Field::Showing:
+		return sizeof(uint8_t);
+	case Field::Volume:
+		return sizeof(float);
+	case Field::SyncOffset:
+		return sizeof(double);
+	case Field::AudioMixers:
+	case Field::Width:
+	case Field::Height:
+	case Field::Flags:
+		return sizeof(uint32_t);
+	case Field::MonitoringType:
+		return sizeof(int32_t);
+	default:
+		return 0;
+	}
+}
+
+const char *states::Layout::Name(Field field)
+{
+	switch (field) {
+	case Field::Muted:
+		return "muted";
+	case Field::Volume:
+		return "volume";
+	case Field::SyncOffset:
+		return "syncOffset";
+	case Field::AudioMixers:
+		return "audioMixers";
+	case Field::MonitoringType:
+		return "monitoringType";
+	case Field::Width:
+		return "width";
+	case Field::Height:
+		return "height";
+	case Field::Active:
+		return "active";
+	case Field::Showing:
+		return "showing";
+	case Field::Flags:
+		return "flags";
+	default:
+		return "";
+	}
+}
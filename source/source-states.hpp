@@ -0,0 +1,83 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <cstring>
+#include <inttypes.h>
+#include <vector>
+
+// Reply of Source::GetStates. It is a struct of arrays with one array per
+// requested field, so the client can expose each field as a typed array
+// over a single buffer:
+//
+//   valid[count] | field[count] | field[count] | ...
+//
+// Fields are laid out in the order of their bit in the mask. Every array
+// starts on an 8 byte boundary so Float64Array views can be made directly
+// on top of the buffer. valid is 0 for uids that do not name a source, and
+// every other field of such a source is left at 0.
+namespace states {
+enum class Field : uint32_t {
+	Muted,          // uint8_t
+	Volume,         // float
+	SyncOffset,     // double, nanoseconds
+	AudioMixers,    // uint32_t
+	MonitoringType, // int32_t
+	Width,          // uint32_t
+	Height,         // uint32_t
+	Active,         // uint8_t
+	Showing,        // uint8_t
+	Flags,          // uint32_t
+
+	Count
+};
+
+constexpr uint32_t AllFields = (1u << uint32_t(Field::Count)) - 1;
+
+inline uint32_t Bit(Field field)
+{
+	return 1u << uint32_t(field);
+}
+
+class Layout {
+public:
+	Layout(uint32_t count, uint32_t mask);
+
+	static size_t ElementSize(Field field);
+	// Property name of the field on the object returned to JS.
+	static const char *Name(Field field);
+
+	uint32_t Count() const { return m_count; }
+	uint32_t Mask() const { return m_mask; }
+	bool Has(Field field) const { return (m_mask & Bit(field)) != 0; }
+	size_t Offset(Field field) const { return m_offsets[uint32_t(field)]; }
+	size_t Size() const { return m_size; }
+
+	void SetValid(std::vector<char> &buf, uint32_t idx) const { buf[idx] = 1; }
+	template<typename T> void Set(std::vector<char> &buf, Field field, uint32_t idx, T value) const
+	{
+		memcpy(buf.data() + Offset(field) + idx * sizeof(T), &value, sizeof(T));
+	}
+
+private:
+	uint32_t m_count;
+	uint32_t m_mask;
+	size_t m_offsets[uint32_t(Field::Count)];
+	size_t m_size;
+};
+} // namespace states
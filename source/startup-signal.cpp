@@ -0,0 +1,154 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "startup-signal.hpp"
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __APPLE__
+#include <sys/event.h>
+#endif
+#endif
+
+#ifdef WIN32
+std::unique_ptr<startup::ReadySignal> startup::ReadySignal::Create(const std::string &path)
+{
+	std::unique_ptr<ReadySignal> signal(new ReadySignal());
+	signal->m_path = path;
+
+	// Kernel object names may not contain backslashes outside the namespace.
+	std::wstring name = L"Local\\osn-ready-";
+	for (char c : path)
+		name.push_back(c == '\\' ? L'_' : wchar_t(c));
+
+	signal->m_event = CreateEventW(NULL, TRUE, FALSE, name.c_str());
+	if (!signal->m_event)
+		return nullptr;
+
+	return signal;
+}
+
+startup::ReadySignal::~ReadySignal()
+{
+	if (m_event)
+		CloseHandle(m_event);
+}
+
+void startup::ReadySignal::Set()
+{
+	SetEvent(m_event);
+}
+
+void startup::ReadySignal::Reset()
+{
+	ResetEvent(m_event);
+}
+
+startup::ReadySignal::WaitResult startup::ReadySignal::Wait(uint32_t timeoutMs, uint64_t process)
+{
+	HANDLE handles[2] = {m_event, reinterpret_cast<HANDLE>(process)};
+	DWORD count = process ? 2 : 1;
+
+	switch (WaitForMultipleObjects(count, handles, FALSE, timeoutMs)) {
+	case WAIT_OBJECT_0:
+		return WaitResult::Ready;
+	case WAIT_OBJECT_0 + 1:
+		return WaitResult::ProcessExited;
+	default:
+		return WaitResult::Timeout;
+	}
+}
+#else
+std::unique_ptr<startup::ReadySignal> startup::ReadySignal::Create(const std::string &path)
+{
+	std::unique_ptr<ReadySignal> signal(new ReadySignal());
+	signal->m_path = path;
+	signal->m_marker = path + ".ready";
+	return signal;
+}
+
+startup::ReadySignal::~ReadySignal()
+{
+	if (m_directory >= 0)
+		close(m_directory);
+	if (m_queue >= 0)
+		close(m_queue);
+}
+
+void startup::ReadySignal::Set()
+{
+	// Creating the marker is what wakes up the watchers of the directory.
+	int fd = open(m_marker.c_str(), O_CREAT | O_WRONLY, S_IRUSR | S_IWUSR);
+	if (fd >= 0)
+		close(fd);
+}
+
+void startup::ReadySignal::Reset()
+{
+	unlink(m_marker.c_str());
+}
+
+startup::ReadySignal::WaitResult startup::ReadySignal::Wait(uint32_t timeoutMs, uint64_t process)
+{
+	if (m_queue < 0) {
+		size_t slash = m_marker.find_last_of('/');
+		std::string directory = slash == std::string::npos ? "." : m_marker.substr(0, slash + 1);
+
+#ifdef __APPLE__
+		m_queue = kqueue();
+		m_directory = open(directory.c_str(), O_EVTONLY);
+		if (m_queue >= 0 && m_directory >= 0) {
+			struct kevent change;
+			EV_SET(&change, m_directory, EVFILT_VNODE, EV_ADD | EV_CLEAR, NOTE_WRITE, 0, nullptr);
+			kevent(m_queue, &change, 1, nullptr, 0, nullptr);
+		}
+#endif
+	}
+
+	// Checked after the watch is in place so a marker created in between is
+	// not missed.
+	struct stat st;
+	if (stat(m_marker.c_str(), &st) == 0)
+		return WaitResult::Ready;
+
+	if (m_queue < 0 || m_directory < 0) {
+		// No directory watch on this platform, poll the marker instead.
+		for (uint32_t waited = 0; waited < timeoutMs; waited += PollIntervalMs) {
+			usleep(PollIntervalMs * 1000);
+			if (stat(m_marker.c_str(), &st) == 0)
+				return WaitResult::Ready;
+		}
+		return WaitResult::Timeout;
+	}
+
+	// Any file created in the directory wakes us up, only the marker counts.
+#ifdef __APPLE__
+	struct timespec timeout = {time_t(timeoutMs / 1000), long(timeoutMs % 1000) * 1000000L};
+	struct kevent event;
+	kevent(m_queue, nullptr, 0, &event, 1, &timeout);
+#endif
+
+	if (stat(m_marker.c_str(), &st) == 0)
+		return WaitResult::Ready;
+	return WaitResult::Timeout;
+}
+#endif
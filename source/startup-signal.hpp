@@ -0,0 +1,71 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+#include <memory>
+#include <string>
+
+namespace startup {
+// Lets a client block until the server listens on its socket instead of
+// retrying the connection on a timer. On Windows this is a named event next to
+// the pipe, elsewhere a marker file next to the socket whose directory is
+// watched with kqueue on macOS and polled anywhere else.
+class ReadySignal {
+public:
+	enum class WaitResult {
+		Ready,
+		Timeout,
+		ProcessExited,
+	};
+
+	// `path` is the socket path both sides pass to ipc, which makes the name
+	// unique per server instance.
+	static std::unique_ptr<ReadySignal> Create(const std::string &path);
+
+	~ReadySignal();
+
+	ReadySignal(ReadySignal const &) = delete;
+	void operator=(ReadySignal const &) = delete;
+
+	// Server side, once the socket accepts connections.
+	void Set();
+	// Server side, before the socket goes away.
+	void Reset();
+
+	// Client side. `process` is the server process handle on Windows (0 if
+	// the client did not spawn it), the wait also ends when it exits.
+	WaitResult Wait(uint32_t timeoutMs, uint64_t process = 0);
+
+private:
+	ReadySignal() {}
+
+	std::string m_path;
+#ifdef WIN32
+	void *m_event = nullptr;
+#else
+	static constexpr uint32_t PollIntervalMs = 10;
+
+	std::string m_marker;
+	// kqueue descriptor.
+	int m_queue = -1;
+	// Descriptor of the watched directory.
+	int m_directory = -1;
+#endif
+};
+} // namespace startup
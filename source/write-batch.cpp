@@ -0,0 +1,238 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "write-batch.hpp"
+#include <cstring>
+
+static bool is_numeric(ipc::type type)
+{
+	switch (type) {
+	case ipc::type::Int32:
+	case ipc::type::UInt32:
+	case ipc::type::Int64:
+	case ipc::type::UInt64:
+	case ipc::type::Float:
+	case ipc::type::Double:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static ipc::value to_value(const batch::Arg &arg)
+{
+	ipc::value value;
+	switch (ipc::type(arg.type)) {
+	case ipc::type::Int32:
+		value = ipc::value(int32_t(arg.bits));
+		break;
+	case ipc::type::UInt32:
+		value = ipc::value(uint32_t(arg.bits));
+		break;
+	case ipc::type::Int64:
+		value = ipc::value(int64_t(arg.bits));
+		break;
+	case ipc::type::UInt64:
+		value = ipc::value(uint64_t(arg.bits));
+		break;
+	case ipc::type::Float: {
+		float fp32;
+		uint32_t bits = uint32_t(arg.bits);
+		memcpy(&fp32, &bits, sizeof(fp32));
+		value = ipc::value(fp32);
+		break;
+	}
+	case ipc::type::Double: {
+		double fp64;
+		memcpy(&fp64, &arg.bits, sizeof(fp64));
+		value = ipc::value(fp64);
+		break;
+	}
+	default:
+		break;
+	}
+	return value;
+}
+
+static uint64_t to_bits(const ipc::value &value)
+{
+	switch (value.type) {
+	case ipc::type::Int32:
+		return uint64_t(int64_t(value.value_union.i32));
+	case ipc::type::UInt32:
+		return value.value_union.ui32;
+	case ipc::type::Int64:
+		return uint64_t(value.value_union.i64);
+	case ipc::type::UInt64:
+		return value.value_union.ui64;
+	case ipc::type::Float: {
+		uint32_t bits;
+		memcpy(&bits, &value.value_union.fp32, sizeof(bits));
+		return bits;
+	}
+	case ipc::type::Double: {
+		uint64_t bits;
+		memcpy(&bits, &value.value_union.fp64, sizeof(bits));
+		return bits;
+	}
+	default:
+		return 0;
+	}
+}
+
+struct SetterInfo {
+	const char *collection;
+	const char *function;
+	// The types the server function is registered with.
+	std::vector<ipc::type> types;
+};
+
+// Indexed by batch::Setter, must be kept in the same order.
+static const SetterInfo setters[] = {
+	{"Source", "SetMuted", {ipc::type::UInt64, ipc::type::Int32}},
+	{"Source", "SetEnabled", {ipc::type::UInt64, ipc::type::Int32}},
+	{"Input", "SetVolume", {ipc::type::UInt64, ipc::type::Float}},
+	{"Input", "SetSyncOffset", {ipc::type::UInt64, ipc::type::Int64}},
+	{"Fader", "SetDeziBel", {ipc::type::UInt64, ipc::type::Float}},
+	{"Fader", "SetDeflection", {ipc::type::UInt64, ipc::type::Float}},
+	{"Fader", "SetMultiplier", {ipc::type::UInt64, ipc::type::Float}},
+	{"SceneItem", "SetVisible", {ipc::type::UInt64, ipc::type::Int32}},
+	{"SceneItem", "SetSelected", {ipc::type::UInt64, ipc::type::Int32}},
+	{"SceneItem", "SetPosition", {ipc::type::UInt64, ipc::type::Float, ipc::type::Float}},
+	{"SceneItem", "SetRotation", {ipc::type::UInt64, ipc::type::Float}},
+	{"SceneItem", "SetScale", {ipc::type::UInt64, ipc::type::Float, ipc::type::Float}},
+	{"SceneItem", "SetCrop", {ipc::type::UInt64, ipc::type::Int32, ipc::type::Int32, ipc::type::Int32, ipc::type::Int32}},
+};
+static_assert(sizeof(setters) / sizeof(setters[0]) == size_t(batch::Setter::Count), "Every setter needs a name.");
+
+const char *batch::CollectionName(Setter setter)
+{
+	return size_t(setter) < size_t(Setter::Count) ? setters[size_t(setter)].collection : nullptr;
+}
+
+const char *batch::FunctionName(Setter setter)
+{
+	return size_t(setter) < size_t(Setter::Count) ? setters[size_t(setter)].function : nullptr;
+}
+
+bool batch::Matches(Setter setter, const std::vector<ipc::value> &args)
+{
+	if (size_t(setter) >= size_t(Setter::Count))
+		return false;
+
+	const std::vector<ipc::type> &types = setters[size_t(setter)].types;
+	if (args.size() != types.size())
+		return false;
+	for (size_t idx = 0; idx < types.size(); idx++) {
+		if (args[idx].type != types[idx])
+			return false;
+	}
+	return true;
+}
+
+batch::Writer::Writer()
+{
+	Clear();
+}
+
+bool batch::Writer::Add(Setter setter, const std::vector<ipc::value> &args)
+{
+	if (args.size() > MaxArgs || !Matches(setter, args))
+		return false;
+	for (auto &arg : args) {
+		if (!is_numeric(arg.type))
+			return false;
+	}
+
+	size_t offset = m_buffer.size();
+	m_buffer.resize(offset + sizeof(Write) + sizeof(Arg) * args.size());
+
+	Write *write = reinterpret_cast<Write *>(m_buffer.data() + offset);
+	memset(write, 0, sizeof(Write));
+	write->setter = uint16_t(setter);
+	write->arg_count = uint8_t(args.size());
+
+	Arg *out = reinterpret_cast<Arg *>(write + 1);
+	for (size_t idx = 0; idx < args.size(); idx++) {
+		memset(&out[idx], 0, sizeof(Arg));
+		out[idx].type = uint8_t(args[idx].type);
+		out[idx].bits = to_bits(args[idx]);
+	}
+
+	m_count++;
+	return true;
+}
+
+const std::vector<char> &batch::Writer::Finish()
+{
+	Header *header = reinterpret_cast<Header *>(m_buffer.data());
+	header->count = m_count;
+	return m_buffer;
+}
+
+void batch::Writer::Clear()
+{
+	m_buffer.assign(sizeof(Header), 0);
+	m_count = 0;
+
+	Header *header = reinterpret_cast<Header *>(m_buffer.data());
+	header->magic = Magic;
+	header->version = Version;
+}
+
+bool batch::Reader::Open(const char *data, size_t size)
+{
+	if (!data || size < sizeof(Header))
+		return false;
+
+	const Header *header = reinterpret_cast<const Header *>(data);
+	if (header->magic != Magic || header->version != Version)
+		return false;
+
+	m_data = data;
+	m_size = size;
+	m_offset = sizeof(Header);
+	m_count = header->count;
+	m_index = 0;
+	return true;
+}
+
+bool batch::Reader::Next(Setter &setter, std::vector<ipc::value> &args)
+{
+	if (m_index >= m_count || m_offset + sizeof(Write) > m_size)
+		return false;
+
+	const Write *write = reinterpret_cast<const Write *>(m_data + m_offset);
+	size_t length = sizeof(Write) + sizeof(Arg) * write->arg_count;
+	if (write->setter >= uint16_t(Setter::Count) || write->arg_count > MaxArgs || m_offset + length > m_size)
+		return false;
+
+	setter = Setter(write->setter);
+	args.clear();
+
+	const Arg *in = reinterpret_cast<const Arg *>(write + 1);
+	for (uint8_t idx = 0; idx < write->arg_count; idx++) {
+		if (!is_numeric(ipc::type(in[idx].type)))
+			return false;
+		args.push_back(to_value(in[idx]));
+	}
+
+	m_offset += length;
+	m_index++;
+	return true;
+}
@@ -0,0 +1,111 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+#include <vector>
+#include "ipc-value.hpp"
+
+// Encoding of a batch of setter calls sent by the client write-behind queue
+// as a single Binary value:
+//
+//   Header | Write, Arg[arg_count] | Write, Arg[arg_count] | ...
+//
+// Only numeric arguments are supported, which covers every setter that can be
+// coalesced. The first argument is always the id of the object being written.
+namespace batch {
+constexpr uint32_t Magic = 0x48544257; // 'WBTH'
+constexpr uint32_t Version = 1;
+constexpr uint8_t MaxArgs = 16;
+
+enum class Setter : uint16_t {
+	SourceSetMuted,
+	SourceSetEnabled,
+	InputSetVolume,
+	InputSetSyncOffset,
+	FaderSetDeziBel,
+	FaderSetDeflection,
+	FaderSetMultiplier,
+	SceneItemSetVisible,
+	SceneItemSetSelected,
+	SceneItemSetPosition,
+	SceneItemSetRotation,
+	SceneItemSetScale,
+	SceneItemSetCrop,
+
+	Count
+};
+
+// IPC collection and function a setter stands for, used to send a write that
+// cannot be encoded on its own.
+const char *CollectionName(Setter setter);
+const char *FunctionName(Setter setter);
+// Whether the arguments have the count and types the setter's server
+// function is registered with. A write that does not match fails on its own.
+bool Matches(Setter setter, const std::vector<ipc::value> &args);
+
+struct Header {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t count;
+	uint32_t reserved;
+};
+
+struct Write {
+	uint16_t setter;
+	uint8_t arg_count;
+	uint8_t reserved[5];
+};
+
+struct Arg {
+	uint8_t type;
+	uint8_t reserved[7];
+	uint64_t bits;
+};
+
+class Writer {
+public:
+	Writer();
+
+	// Returns false if the values do not match the setter (see Matches).
+	bool Add(Setter setter, const std::vector<ipc::value> &args);
+	uint32_t Count() { return m_count; }
+	// Patches the header and returns the encoded batch.
+	const std::vector<char> &Finish();
+	void Clear();
+
+private:
+	std::vector<char> m_buffer;
+	uint32_t m_count = 0;
+};
+
+class Reader {
+public:
+	bool Open(const char *data, size_t size);
+	uint32_t Count() { return m_count; }
+	// Decodes the next write, returns false at the end or on a malformed buffer.
+	bool Next(Setter &setter, std::vector<ipc::value> &args);
+
+private:
+	const char *m_data = nullptr;
+	size_t m_size = 0;
+	size_t m_offset = 0;
+	uint32_t m_count = 0;
+	uint32_t m_index = 0;
+};
+} // namespace batch
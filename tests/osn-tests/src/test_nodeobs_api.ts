@@ -3,6 +3,7 @@ import { expect } from 'chai';
 import * as osn from '../osn';
 import { logInfo, logEmptyLine } from '../util/logger';
 import { ETestErrorMsg, GetErrorMessage } from '../util/error_messages';
+import { EOBSInputTypes } from '../util/obs_enums';
 import { OBSHandler, IPerformanceState, TOBSHotkey } from '../util/obs_handler';
 import { showHideInputHotkeys, slideshowHotkeys, ffmpeg_sourceHotkeys,
     game_captureHotkeys, dshow_wasapitHotkeys,coreaudioHotkeys,  deleteConfigFiles } from '../util/general';
@@ -154,6 +155,45 @@ describe(testName, function() {
         scene.release();
     });
 
+    it('Get hotkey changes since a generation', function() {
+        // Getting the full list and the generation it matches
+        const snapshot = osn.NodeObs.OBS_API_QueryHotkeysSince(0);
+        expect(snapshot.reset).to.equal(true);
+        expect(snapshot.generation).to.be.above(0);
+
+        // Adding a scene item registers its show/hide hotkeys on the scene
+        const sceneName = 'hotkeys_since_scene';
+        const scene = osn.SceneFactory.create(sceneName);
+        const input = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'hotkeys_since_input');
+        const sceneItem = scene.add(input);
+
+        const added = osn.NodeObs.OBS_API_QueryHotkeysSince(snapshot.generation);
+        expect(added.reset).to.equal(false);
+        expect(added.generation).to.be.above(snapshot.generation);
+
+        const sceneHotkeys = added.hotkeys.filter((hotkey: TOBSHotkey) => hotkey.ObjectName == sceneName);
+        expect(sceneHotkeys.length).to.be.above(0);
+        sceneHotkeys.forEach((hotkey: TOBSHotkey) => {
+            expect(hotkey.HotkeyName).to.be.oneOf(showHideInputHotkeys, GetErrorMessage(ETestErrorMsg.ShowHideInputHotkeys));
+        });
+
+        // Nothing changed since the last query
+        const unchanged = osn.NodeObs.OBS_API_QueryHotkeysSince(added.generation);
+        expect(unchanged.generation).to.equal(added.generation);
+        expect(unchanged.hotkeys.length).to.equal(0);
+        expect(unchanged.removed.length).to.equal(0);
+
+        // Removing the item reports its hotkeys as removed
+        sceneItem.remove();
+        const removed = osn.NodeObs.OBS_API_QueryHotkeysSince(added.generation);
+        sceneHotkeys.forEach((hotkey: TOBSHotkey) => {
+            expect(removed.removed).to.include(hotkey.HotkeyId);
+        });
+
+        input.release();
+        scene.release();
+    });
+
     it('Get and set the browser source acceleration', function() {
         expect(osn.NodeObs.GetBrowserAcceleration()).
             to.equal(true, 'Invalid browser source acceleration default value');
@@ -178,6 +218,18 @@ describe(testName, function() {
             to.equal('High', 'Invalid process priority value');
     });
 
+    it('Get startup metrics', function() {
+        const metrics = osn.IPC.getStartupMetrics();
+
+        expect(metrics.attempts).to.be.at.least(1, 'Invalid connection attempt count');
+        expect(metrics.connectMs).to.be.at.least(0, 'Invalid connect time');
+        expect(metrics.serverInitMs).to.be.above(0, 'Invalid server initialization time');
+        expect(metrics.serverFirstConnectMs).to.be.above(0, 'Invalid server first connection time');
+
+        logInfo(testName, 'Spawn ' + metrics.spawnMs.toFixed(1) + 'ms, connect ' + metrics.connectMs.toFixed(1) + 'ms in ' +
+            metrics.attempts + ' attempts, server listening after ' + metrics.serverInitMs.toFixed(1) + 'ms');
+    });
+
     it('Stop crash handler', function() {
         // Stopping crash handler as a last test case
         expect(function() {
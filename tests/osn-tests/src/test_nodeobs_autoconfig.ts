@@ -158,4 +158,38 @@ describe(testName, function() {
 
 	osn.NodeObs.TerminateAutoConfig();
     });
+
+    it('Run encoder benchmark', async function() {
+        let progressInfo: IConfigProgress;
+
+        obs.startAutoconfig();
+
+        // Short points keep the test fast, the ladder still covers every resolution
+        osn.NodeObs.StartEncoderBenchmark(0.5);
+
+        progressInfo = await obs.getNextProgressInfo('Encoder benchmark');
+        expect(progressInfo.event).to.equal('stopping_step', GetErrorMessage(ETestErrorMsg.EncoderBenchmark));
+        expect(progressInfo.description).to.equal('encoder_benchmark', GetErrorMessage(ETestErrorMsg.EncoderBenchmark));
+        expect(progressInfo.percentage).to.equal(100, GetErrorMessage(ETestErrorMsg.EncoderBenchmark));
+
+        const report = JSON.parse(osn.NodeObs.GetEncoderBenchmarkResults());
+        expect(report.results).to.be.an('array', GetErrorMessage(ETestErrorMsg.EncoderBenchmark));
+
+        const x264 = report.results.filter((result: any) => result.encoder == 'obs_x264');
+        expect(x264.length).to.equal(10, GetErrorMessage(ETestErrorMsg.EncoderBenchmark));
+
+        // Every point gets the same number of deterministic frames
+        for (const result of x264) {
+            expect(result.submittedFrames).to.equal(Math.round(0.5 * result.fpsNum / result.fpsDen), GetErrorMessage(ETestErrorMsg.EncoderBenchmark));
+            logInfo(testName, result.width + 'x' + result.height + '@' + result.fpsNum + ': ' + result.encodeFps.toFixed(1) + 'fps, lag ' +
+                result.lagMs.toFixed(1) + 'ms, cpu ' + result.cpuUsage.toFixed(1) + '%');
+        }
+
+        if (report.recommendation) {
+            expect(report.recommendation.width).to.be.above(0, GetErrorMessage(ETestErrorMsg.EncoderBenchmark));
+            expect(report.recommendation.fpsNum).to.be.above(0, GetErrorMessage(ETestErrorMsg.EncoderBenchmark));
+        }
+
+        osn.NodeObs.TerminateAutoConfig();
+    });
 });
@@ -0,0 +1,125 @@
+import 'mocha';
+import { expect } from 'chai';
+import * as osn from '../osn';
+import { logInfo, logEmptyLine } from '../util/logger';
+import { ETestErrorMsg, GetErrorMessage } from '../util/error_messages';
+import { OBSHandler, IConfigProgress } from '../util/obs_handler';
+import { deleteConfigFiles } from '../util/general';
+
+const testName = 'nodeobs_autoconfig_bandwidth';
+
+// Runs the whole bandwidth test against the built-in loopback sink, so the
+// results only depend on the shaping applied to the sink.
+describe(testName, function() {
+    let obs: OBSHandler;
+    let hasTestFailed: boolean = false;
+
+    // Initialize OBS process
+    before(function() {
+        logInfo(testName, 'Starting ' + testName + ' tests');
+        deleteConfigFiles();
+        obs = new OBSHandler(testName);
+    });
+
+    // Shutdown OBS process
+    after(async function() {
+        osn.NodeObs.SetBandwidthTestTarget('service');
+        osn.NodeObs.SetBandwidthTestOptions({});
+
+        obs.shutdown();
+
+        if (hasTestFailed === true) {
+            logInfo(testName, 'One or more test cases failed. Uploading cache');
+            await obs.uploadTestCache();
+        }
+
+        obs = null;
+        deleteConfigFiles();
+        logInfo(testName, 'Finished ' + testName + ' tests');
+        logEmptyLine();
+    });
+
+    afterEach(function() {
+        if (this.currentTest.state == 'failed') {
+            hasTestFailed = true;
+        }
+    });
+
+    async function runBandwidthTest(shaping: any): Promise<any> {
+        let progressInfo: IConfigProgress;
+
+        osn.NodeObs.SetBandwidthTestTarget('loopback', shaping);
+        obs.startAutoconfig();
+
+        osn.NodeObs.StartBandwidthTest();
+
+        progressInfo = await obs.getNextProgressInfo('Bandwidth test');
+        expect(progressInfo.event).to.equal('stopping_step', GetErrorMessage(ETestErrorMsg.BandwidthTest));
+        expect(progressInfo.description).to.equal('bandwidth_test', GetErrorMessage(ETestErrorMsg.BandwidthTest));
+        expect(progressInfo.percentage).to.equal(100, GetErrorMessage(ETestErrorMsg.BandwidthTest));
+
+        osn.NodeObs.TerminateAutoConfig();
+
+        const results = JSON.parse(osn.NodeObs.GetBandwidthTestResults());
+        expect(results.target).to.equal('loopback', GetErrorMessage(ETestErrorMsg.BandwidthTest));
+        expect(results.success).to.equal(true, GetErrorMessage(ETestErrorMsg.BandwidthTest));
+        expect(results.servers.length).to.equal(shaping.servers || 1, GetErrorMessage(ETestErrorMsg.BandwidthTest));
+
+        const tested = results.servers.filter((server: any) => server.tested);
+        expect(results.publishes).to.equal(tested.length, GetErrorMessage(ETestErrorMsg.BandwidthTest));
+
+        for (const server of tested) {
+            logInfo(testName, server.name + ' ' + JSON.stringify(shaping) + ': ' + server.bitrate + 'kbps, ' + server.handshakeMs +
+                'ms handshake, ' + server.ms + 'ms connect, ' + server.durationMs + 'ms test, converged: ' + server.converged);
+        }
+        logInfo(testName, 'Phases: ' + JSON.stringify(results.phases));
+        return results;
+    }
+
+    it('Keep the starting bitrate on an unlimited loopback', async function() {
+        const results = await runBandwidthTest({});
+
+        expect(results.bitrate).to.equal(results.startingBitrate, GetErrorMessage(ETestErrorMsg.BandwidthTest));
+    });
+
+    it('Stop early once the bitrate estimate settles', async function() {
+        const results = await runBandwidthTest({ throughputKbps: 4000 });
+
+        // The sink reads at a steady pace, the old fixed-length test always ran for 10 seconds
+        expect(results.servers[0].converged).to.equal(true, GetErrorMessage(ETestErrorMsg.BandwidthTest));
+        expect(results.servers[0].durationMs).to.be.below(10000, GetErrorMessage(ETestErrorMsg.BandwidthTest));
+    });
+
+    it('Lower the bitrate on a throttled loopback', async function() {
+        const results = await runBandwidthTest({ throughputKbps: 2000 });
+
+        // Socket buffers on the sending side make the early samples optimistic
+        expect(results.bitrate).to.be.above(0, GetErrorMessage(ETestErrorMsg.BandwidthTest));
+        expect(results.bitrate).to.be.below(results.startingBitrate * 0.75, GetErrorMessage(ETestErrorMsg.BandwidthTest));
+        expect(results.bitrate).to.be.at.most(2000 * 2, GetErrorMessage(ETestErrorMsg.BandwidthTest));
+    });
+
+    it('Report the loopback latency as connect time', async function() {
+        const results = await runBandwidthTest({ latencyMs: 200 });
+
+        expect(results.servers[0].ms).to.be.at.least(200, GetErrorMessage(ETestErrorMsg.BandwidthTest));
+    });
+
+    it('Only test the throughput of the servers that answer fastest', async function() {
+        osn.NodeObs.SetBandwidthTestOptions({ maxThroughputTests: 2, parallel: true });
+        const results = await runBandwidthTest({ latencyMs: 50, servers: 5 });
+        osn.NodeObs.SetBandwidthTestOptions({});
+
+        // Every server is probed, the probe ranks them by handshake time
+        for (const server of results.servers) {
+            expect(server.reachable).to.equal(true, GetErrorMessage(ETestErrorMsg.BandwidthTest));
+            expect(server.handshakeMs).to.be.at.least(0, GetErrorMessage(ETestErrorMsg.BandwidthTest));
+        }
+
+        const tested = results.servers.filter((server: any) => server.tested).map((server: any) => server.name);
+        expect(tested).to.have.members(['Loopback 1', 'Loopback 2'], GetErrorMessage(ETestErrorMsg.BandwidthTest));
+        expect(results.parallel).to.equal(true, GetErrorMessage(ETestErrorMsg.BandwidthTest));
+        expect(results.phases.probeMs).to.be.below(results.phases.throughputMs, GetErrorMessage(ETestErrorMsg.BandwidthTest));
+        expect(results.phases.totalMs).to.be.at.least(results.phases.probeMs + results.phases.throughputMs, GetErrorMessage(ETestErrorMsg.BandwidthTest));
+    });
+});
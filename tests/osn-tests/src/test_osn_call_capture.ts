@@ -0,0 +1,60 @@
+import 'mocha';
+import { expect } from 'chai';
+import * as osn from '../osn';
+import { logInfo, logEmptyLine } from '../util/logger';
+import { OBSHandler } from '../util/obs_handler';
+import { deleteConfigFiles } from '../util/general';
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+
+const testName = 'osn-call-capture';
+
+describe(testName, () => {
+    let obs: OBSHandler;
+    let hasTestFailed: boolean = false;
+
+    // Initialize OBS process
+    before(function() {
+        logInfo(testName, 'Starting ' + testName + ' tests');
+        deleteConfigFiles();
+        obs = new OBSHandler(testName);
+    });
+
+    // Shutdown OBS process
+    after(async function() {
+        obs.shutdown();
+
+        if (hasTestFailed === true) {
+            logInfo(testName, 'One or more test cases failed. Uploading cache');
+            await obs.uploadTestCache();
+        }
+
+        obs = null;
+        deleteConfigFiles();
+        logInfo(testName, 'Finished ' + testName + ' tests');
+        logEmptyLine();
+    });
+
+    afterEach(function() {
+        if (this.currentTest.state == 'failed') {
+            hasTestFailed = true;
+        }
+    });
+
+    it('Capture the calls handled by the server', () => {
+        const capturePath = path.join(os.tmpdir(), 'osn-call-capture.capture');
+
+        osn.IPC.startCapture(capturePath);
+        const input = osn.InputFactory.create('image_source', 'test_osn_capture_source');
+        expect(input).to.not.equal(undefined);
+        input.release();
+        const count = osn.IPC.stopCapture();
+
+        expect(count).to.be.above(0, 'No call was captured');
+        expect(fs.existsSync(capturePath)).to.equal(true, 'Capture file was not written');
+        expect(fs.statSync(capturePath).size).to.be.above(16, 'Capture file only holds its header');
+
+        fs.unlinkSync(capturePath);
+    });
+});
@@ -0,0 +1,52 @@
+import 'mocha';
+import { expect } from 'chai';
+import * as osn from '../osn';
+import { logInfo, logEmptyLine } from '../util/logger';
+import { OBSHandler } from '../util/obs_handler';
+import { deleteConfigFiles } from '../util/general';
+
+const testName = 'osn-dispatch';
+
+describe(testName, () => {
+    let obs: OBSHandler;
+    let hasTestFailed: boolean = false;
+
+    // Initialize OBS process
+    before(function() {
+        logInfo(testName, 'Starting ' + testName + ' tests');
+        deleteConfigFiles();
+        obs = new OBSHandler(testName);
+    });
+
+    // Shutdown OBS process
+    after(async function() {
+        obs.shutdown();
+
+        if (hasTestFailed === true) {
+            logInfo(testName, 'One or more test cases failed. Uploading cache');
+            await obs.uploadTestCache();
+        }
+
+        obs = null;
+        deleteConfigFiles();
+        logInfo(testName, 'Finished ' + testName + ' tests');
+        logEmptyLine();
+    });
+
+    afterEach(function() {
+        if (this.currentTest.state == 'failed') {
+            hasTestFailed = true;
+        }
+    });
+
+    it('Call small functions by method id', () => {
+        const result = osn.IPC.benchmarkDispatch(2000);
+
+        expect(result.iterations).to.equal(2000);
+        expect(result.methodCount).to.be.above(0, 'Method table was not loaded');
+        expect(result.dispatchById).to.equal(true, 'Calls by id fell back to names');
+
+        logInfo(testName, 'By name: ' + result.byName.callMs.toFixed(4) + 'ms/call, ' + result.byName.callsPerSecond.toFixed(0) + ' calls/s');
+        logInfo(testName, 'By id: ' + result.byId.callMs.toFixed(4) + 'ms/call, ' + result.byId.callsPerSecond.toFixed(0) + ' calls/s');
+    });
+});
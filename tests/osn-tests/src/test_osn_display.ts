@@ -0,0 +1,228 @@
+import 'mocha';
+import { expect } from 'chai';
+import { BrowserWindow } from 'electron';
+import * as osn from '../osn';
+import { logInfo, logEmptyLine } from '../util/logger';
+import { OBSHandler } from '../util/obs_handler';
+import { EOBSInputTypes } from '../util/obs_enums';
+import { deleteConfigFiles, isHeadless, sleep } from '../util/general';
+
+const testName = 'osn-display';
+
+// Size of the text vertex buffer each display used to upload every frame:
+// 65535 vertices of position, normal, tangent, color and one vec4 UV.
+const fullTextBufferBytes = 65535 * (12 * 3 + 4 + 16);
+
+// Displays need a video context, which the headless server does not have.
+(isHeadless() ? describe.skip : describe)(testName, () => {
+    let obs: OBSHandler;
+    let hasTestFailed: boolean = false;
+    const sceneName = 'test_display_scene';
+    const sourceName = 'test_display_source';
+
+    // Initialize OBS process
+    before(function() {
+        logInfo(testName, 'Starting ' + testName + ' tests');
+        deleteConfigFiles();
+        obs = new OBSHandler(testName);
+
+        // A selected item away from the canvas borders makes every display
+        // draw its outline, guide lines and four size labels.
+        const scene = osn.SceneFactory.create(sceneName);
+        const source = osn.InputFactory.create(EOBSInputTypes.ColorSource, sourceName, { width: 400, height: 300 });
+        const sceneItem = scene.add(source);
+        sceneItem.position = { x: 200, y: 150 };
+        sceneItem.selected = true;
+        osn.Global.setOutputSource(0, scene);
+    });
+
+    // Shutdown OBS process
+    after(async function() {
+        osn.SceneFactory.fromName(sceneName).release();
+        osn.InputFactory.fromName(sourceName).release();
+        obs.shutdown();
+
+        if (hasTestFailed === true) {
+            logInfo(testName, 'One or more test cases failed. Uploading cache');
+            await obs.uploadTestCache();
+        }
+
+        obs = null;
+        deleteConfigFiles();
+        logInfo(testName, 'Finished ' + testName + ' tests');
+        logEmptyLine();
+    });
+
+    afterEach(function() {
+        if (this.currentTest.state == 'failed') {
+            hasTestFailed = true;
+        }
+    });
+
+    [1, 4, 8].forEach(function(displayCount) {
+        it('Overlay frame time with ' + displayCount + ' display(s)', async () => {
+            const windows: BrowserWindow[] = [];
+            const keys: string[] = [];
+
+            for (let idx = 0; idx < displayCount; idx++) {
+                const window = new BrowserWindow({ width: 640, height: 360, show: false });
+                const key = 'test_display_' + displayCount + '_' + idx;
+                osn.NodeObs.OBS_content_createDisplay(window.getNativeWindowHandle(), key, 0);
+                osn.NodeObs.OBS_content_resizeDisplay(key, 640, 360);
+                // The windows are never shown, keep rendering anyway.
+                osn.NodeObs.OBS_content_setDisplayRenderPolicy(key, { pauseWhenHidden: false });
+                windows.push(window);
+                keys.push(key);
+            }
+
+            await sleep(2000);
+
+            let frames = 0;
+            let totalMs = 0;
+            let maxMs = 0;
+            let uploadedBytes = 0;
+            keys.forEach(function(key) {
+                const stats = osn.NodeObs.OBS_content_getDisplayOverlayStats(key);
+                expect(stats.frames).to.be.above(0, 'Display ' + key + ' did not draw its overlay');
+                frames += stats.frames;
+                totalMs += stats.averageMs * stats.frames;
+                maxMs = Math.max(maxMs, stats.maxMs);
+                uploadedBytes += stats.uploadedBytes;
+            });
+
+            const bytesPerFrame = uploadedBytes / frames;
+            logInfo(testName, displayCount + ' display(s): ' + (totalMs / frames).toFixed(3) + 'ms average, ' +
+                maxMs.toFixed(3) + 'ms max, ' + Math.round(bytesPerFrame) + ' bytes uploaded per frame');
+
+            // Only the glyphs in use are uploaded, not the whole text buffer.
+            expect(bytesPerFrame).to.be.below(fullTextBufferBytes);
+
+            keys.forEach(function(key) {
+                osn.NodeObs.OBS_content_destroyDisplay(key);
+            });
+            windows.forEach(function(window) {
+                window.destroy();
+            });
+        });
+    });
+
+    it('Draw the overlay of 100 selected items in a few calls', async () => {
+        const scene = osn.SceneFactory.fromName(sceneName);
+        const source = osn.InputFactory.fromName(sourceName);
+        const sceneItems: osn.ISceneItem[] = [];
+
+        for (let idx = 0; idx < 100; idx++) {
+            const sceneItem = scene.add(source);
+            sceneItem.position = { x: 10 + (idx % 10) * 100, y: 10 + Math.floor(idx / 10) * 60 };
+            sceneItem.scale = { x: 0.2, y: 0.2 };
+            sceneItem.selected = true;
+            sceneItems.push(sceneItem);
+        }
+
+        const window = new BrowserWindow({ width: 640, height: 360, show: false });
+        const key = 'test_display_batch';
+        osn.NodeObs.OBS_content_createDisplay(window.getNativeWindowHandle(), key, 0);
+        osn.NodeObs.OBS_content_resizeDisplay(key, 640, 360);
+        osn.NodeObs.OBS_content_setDisplayRenderPolicy(key, { pauseWhenHidden: false });
+
+        await sleep(2000);
+
+        const stats = osn.NodeObs.OBS_content_getDisplayOverlayStats(key);
+        expect(stats.frames).to.be.above(0, 'Display did not draw its overlay');
+        logInfo(testName, '100 selected items: ' + stats.averageMs.toFixed(3) + 'ms average, ' +
+            stats.drawCalls.toFixed(2) + ' draw calls per frame');
+
+        // Triangles, lines and size labels, no matter how many items are selected.
+        expect(stats.drawCalls).to.be.at.most(3);
+
+        osn.NodeObs.OBS_content_destroyDisplay(key);
+        window.destroy();
+        sceneItems.forEach(function(sceneItem) {
+            sceneItem.remove();
+        });
+    });
+
+    it('Reuse overlay geometry while nothing changes', async () => {
+        const window = new BrowserWindow({ width: 640, height: 360, show: false });
+        const key = 'test_display_cached';
+        osn.NodeObs.OBS_content_createDisplay(window.getNativeWindowHandle(), key, 0);
+        osn.NodeObs.OBS_content_resizeDisplay(key, 640, 360);
+        osn.NodeObs.OBS_content_setDisplayRenderPolicy(key, { pauseWhenHidden: false });
+
+        await sleep(1000);
+        const still = osn.NodeObs.OBS_content_getDisplayOverlayStats(key);
+        logInfo(testName, 'Static scene: ' + still.cachedFrames + ' of ' + still.frames + ' overlay frames reused');
+        expect(still.cachedFrames).to.be.above(0, 'Overlay of a static scene was never reused');
+        expect(still.frames - still.cachedFrames).to.be.below(still.frames / 2, 'Overlay of a static scene was rebuilt too often');
+
+        // Moving the selected item must rebuild the overlay every frame it moves.
+        const sceneItem = osn.SceneFactory.fromName(sceneName).getItems()[0];
+        const position = sceneItem.position;
+        for (let step = 0; step < 10; step++) {
+            sceneItem.position = { x: position.x + step * 5, y: position.y };
+            await sleep(50);
+        }
+        sceneItem.position = position;
+        await sleep(200);
+
+        const moved = osn.NodeObs.OBS_content_getDisplayOverlayStats(key);
+        const rebuilt = (moved.frames - moved.cachedFrames) - (still.frames - still.cachedFrames);
+        expect(rebuilt).to.be.above(1, 'Overlay was not rebuilt after the item moved');
+
+        osn.NodeObs.OBS_content_destroyDisplay(key);
+        window.destroy();
+    });
+
+    it('Cap the frame rate of a display', async () => {
+        const window = new BrowserWindow({ width: 160, height: 90, show: false });
+        const key = 'test_display_capped';
+        osn.NodeObs.OBS_content_createDisplay(window.getNativeWindowHandle(), key, 0);
+        osn.NodeObs.OBS_content_resizeDisplay(key, 160, 90);
+        osn.NodeObs.OBS_content_setDisplayRenderPolicy(key, { maxFps: 10, renderScale: 0.5, pauseWhenHidden: false });
+
+        await sleep(500);
+        const before = osn.NodeObs.OBS_content_getDisplayRenderStats(key);
+        await sleep(2000);
+        const after = osn.NodeObs.OBS_content_getDisplayRenderStats(key);
+
+        const rendered = after.renderedFrames - before.renderedFrames;
+        const skipped = after.skippedFrames - before.skippedFrames;
+        logInfo(testName, 'Capped display: ' + rendered + ' frames rendered, ' + skipped + ' skipped in 2s');
+
+        expect(after.paused).to.equal(false);
+        expect(rendered).to.be.above(0, 'Capped display stopped rendering');
+        expect(rendered).to.be.at.most(25, 'Capped display rendered more than 10 FPS');
+        expect(skipped).to.be.above(0, 'Capped display did not skip any frame');
+
+        osn.NodeObs.OBS_content_destroyDisplay(key);
+        window.destroy();
+    });
+
+    it('Pause a display while its window is hidden', async function() {
+        if (process.platform !== 'win32') {
+            // Only the window state on Windows is tracked.
+            this.skip();
+        }
+
+        const window = new BrowserWindow({ width: 160, height: 90, show: false });
+        const key = 'test_display_hidden';
+        osn.NodeObs.OBS_content_createDisplay(window.getNativeWindowHandle(), key, 0);
+        osn.NodeObs.OBS_content_resizeDisplay(key, 160, 90);
+
+        // Displays only pause when asked to
+        await sleep(1000);
+        expect(osn.NodeObs.OBS_content_getDisplayRenderStats(key).paused).to.equal(false, 'Display paused without opting in');
+
+        osn.NodeObs.OBS_content_setDisplayRenderPolicy(key, { pauseWhenHidden: true });
+        await sleep(1000);
+        const before = osn.NodeObs.OBS_content_getDisplayRenderStats(key);
+        await sleep(1000);
+        const after = osn.NodeObs.OBS_content_getDisplayRenderStats(key);
+
+        expect(after.paused).to.equal(true, 'Display of a hidden window is not paused');
+        expect(after.renderedFrames - before.renderedFrames).to.equal(0, 'Paused display kept rendering');
+
+        osn.NodeObs.OBS_content_destroyDisplay(key);
+        window.destroy();
+    });
+});
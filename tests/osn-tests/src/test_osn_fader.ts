@@ -158,4 +158,61 @@ describe(testName, () => {
             expect(multiplier).to.equal(1, GetErrorMessage(ETestErrorMsg.Multiplier, faderTypeStr));
         });
     });
+
+    it('Coalesce repeated fader writes', () => {
+        const fader = osn.FaderFactory.create(osn.EFaderType.Cubic);
+        expect(fader).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateFader, 'cubic'));
+
+        const before = osn.IPC.getWriteStats();
+
+        // A slider drag sets the same field many times within one tick
+        for (let step = 0; step <= 100; step++) {
+            fader.deflection = step / 100;
+        }
+        fader.db = -6;
+
+        // Reading goes after the pending writes, the last one wins
+        expect(fader.db).to.be.closeTo(-6, 0.01, GetErrorMessage(ETestErrorMsg.Decibel, 'cubic'));
+
+        const after = osn.IPC.getWriteStats();
+        expect(after.queued - before.queued).to.equal(102);
+        expect(after.coalesced - before.coalesced).to.equal(100);
+        expect(after.sent - before.sent).to.equal(2);
+        expect(after.batches - before.batches).to.equal(1);
+    });
+
+    it('Keep aliasing fader writes in order', () => {
+        const fader = osn.FaderFactory.create(osn.EFaderType.Cubic);
+        expect(fader).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateFader, 'cubic'));
+
+        const before = osn.IPC.getWriteStats();
+
+        // dB and deflection set the same value, the last write has to win
+        fader.deflection = 0.5;
+        fader.db = -6;
+        fader.deflection = 1;
+        expect(fader.deflection).to.be.closeTo(1, 0.01, GetErrorMessage(ETestErrorMsg.Deflection, 'cubic'));
+
+        const after = osn.IPC.getWriteStats();
+        expect(after.coalesced - before.coalesced).to.equal(0);
+        expect(after.sent - before.sent).to.equal(3);
+        fader.destroy();
+    });
+
+    it('Read the volume of an input after a pending fader write', () => {
+        const input = osn.InputFactory.create(EOBSInputTypes.FFMPEGSource, 'fader_write_input');
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.FFMPEGSource));
+
+        const fader = osn.FaderFactory.create(osn.EFaderType.Cubic);
+        expect(fader).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateFader, 'cubic'));
+        fader.attach(input);
+
+        // The write is still queued when the input volume is read
+        fader.mul = 0.25;
+        expect(input.volume).to.be.closeTo(0.25, 0.001);
+
+        fader.detach();
+        fader.destroy();
+        input.release();
+    });
 });
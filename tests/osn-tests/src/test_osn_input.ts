@@ -6,14 +6,17 @@ import { IInput, ISettings, ITimeSpec } from '../osn';
 import { ETestErrorMsg, GetErrorMessage } from '../util/error_messages';
 import { EOBSInputTypes, EOBSFilterTypes } from '../util/obs_enums';
 import { OBSHandler } from '../util/obs_handler';
-import { getTimeSpec, deleteConfigFiles} from '../util/general';
+import { getTimeSpec, deleteConfigFiles, sleep } from '../util/general';
 import * as inputSettings from '../util/input_settings';
 
+import path = require('path');
+
 const testName = 'osn-input';
 
 describe(testName, () => {
     let obs: OBSHandler;
     let hasTestFailed: boolean = false;
+    const media_path = path.join(path.normalize(__dirname), '..', 'media');
 
     // Initialize OBS process
     before(function() {
@@ -259,6 +262,107 @@ describe(testName, () => {
         });
     });
 
+    it('Get several inputs by name in one call', () => {
+        const first = osn.InputFactory.create('image_source', 'from_names_first');
+        const second = osn.InputFactory.create('image_source', 'from_names_second');
+        expect(first).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, 'image_source'));
+        expect(second).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, 'image_source'));
+
+        // The server keeps its name index up to date when a source is renamed
+        second.name = 'from_names_renamed';
+
+        const inputs = osn.InputFactory.fromNames(['from_names_first', 'from_names_renamed', 'from_names_second', 'doesNotExist']);
+        expect(inputs.length).to.equal(4);
+        expect(inputs[0].name).to.equal('from_names_first', GetErrorMessage(ETestErrorMsg.FromNameInputName, 'from_names_first'));
+        expect(inputs[1].name).to.equal('from_names_renamed', GetErrorMessage(ETestErrorMsg.FromNameInputName, 'from_names_renamed'));
+        expect(inputs[2]).to.equal(undefined, 'Input was found by its previous name');
+        expect(inputs[3]).to.equal(undefined, 'Input that does not exist was found');
+
+        first.release();
+        second.release();
+    });
+
+    it('Get the state of several inputs in one call', () => {
+        const inputs: IInput[] = [];
+        for (let idx = 0; idx < 3; idx++) {
+            const input = osn.InputFactory.create('image_source', 'get_states_' + idx);
+            expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, 'image_source'));
+            inputs.push(input);
+        }
+
+        inputs[1].muted = true;
+        inputs[2].volume = 0.5;
+        inputs[2].audioMixers = 5;
+
+        const states = osn.InputFactory.getStates(inputs);
+        expect(states.count).to.equal(3);
+        expect(Array.from(states.valid)).to.eql([1, 1, 1]);
+        expect(Array.from(states.muted)).to.eql([0, 1, 0]);
+        expect(states.volume[2]).to.equal(0.5);
+        expect(states.audioMixers[2]).to.equal(5);
+        expect(states.width[0]).to.equal(inputs[0].width);
+
+        // Only the requested fields are returned
+        const sizes = osn.InputFactory.getStates(inputs, osn.ESourceStateField.Width | osn.ESourceStateField.Height);
+        expect(sizes.width).to.not.equal(undefined);
+        expect(sizes.height).to.not.equal(undefined);
+        expect(sizes.muted).to.equal(undefined);
+
+        inputs.forEach(function(input) {
+            input.release();
+        });
+    });
+
+    it('Receive media events of a subscribed input', async function() {
+        let settings: ISettings = Object.assign({}, inputSettings.ffmpegSource);
+        settings['local_file'] = path.join(media_path, 'sleek.mp3');
+        settings['looping'] = true;
+        // Start playing right away, the input is never shown
+        settings['restart_on_activate'] = false;
+
+        const input = osn.InputFactory.create(EOBSInputTypes.FFMPEGSource, 'media_events_input', settings);
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.FFMPEGSource));
+
+        const handle = input.subscribeMediaEvents();
+        expect(handle).to.not.equal(undefined);
+
+        const events: osn.IMediaEvent[] = [];
+        osn.NodeObs.RegisterMediaCallback((data: osn.IMediaEvent[]) => {
+            events.push(...data.filter((item) => item.handle === handle));
+        }, 100);
+        osn.NodeObs.RegisterSourceCallback(() => {});
+
+        // Each step waits a few query ticks, only the last reason of a tick is kept
+        await sleep(1500);
+        input.pause();
+        await sleep(500);
+        input.play();
+        await sleep(500);
+        input.restart();
+        await sleep(1500);
+
+        osn.NodeObs.RemoveSourceCallback();
+        osn.NodeObs.RemoveMediaCallback();
+        input.unsubscribeMediaEvents();
+        input.release();
+
+        const reasons = events.map((item) => item.reason);
+        expect(reasons).to.include(osn.EMediaEventReason.Paused);
+        expect(reasons).to.include(osn.EMediaEventReason.Played);
+        expect(reasons.some((reason) => reason === osn.EMediaEventReason.Restarted || reason === osn.EMediaEventReason.Started)).to.equal(true,
+            'No restart event received');
+
+        const paused = events.find((item) => item.reason === osn.EMediaEventReason.Paused);
+        expect(paused.state).to.equal(osn.EMediaState.Paused);
+
+        // Positions are reported while the first play runs
+        const positions = events.slice(0, events.indexOf(paused)).filter((item) =>
+            item.reason === osn.EMediaEventReason.Position && item.state === osn.EMediaState.Playing);
+        expect(positions.length).to.be.at.least(2, 'Not enough position events received');
+        expect(positions[positions.length - 1].time).to.be.above(positions[0].time, 'Play position did not advance');
+        expect(positions[0].duration).to.be.above(0);
+    });
+
     it('Get volume value from input source', () => {
         let volume: number = undefined;
 
@@ -0,0 +1,56 @@
+import 'mocha';
+import { expect } from 'chai';
+import * as osn from '../osn';
+import { logInfo, logEmptyLine } from '../util/logger';
+import { OBSHandler } from '../util/obs_handler';
+import { deleteConfigFiles } from '../util/general';
+
+const testName = 'osn-lanes';
+
+describe(testName, () => {
+    let obs: OBSHandler;
+    let hasTestFailed: boolean = false;
+
+    // Initialize OBS process
+    before(function() {
+        logInfo(testName, 'Starting ' + testName + ' tests');
+        deleteConfigFiles();
+        obs = new OBSHandler(testName);
+    });
+
+    // Shutdown OBS process
+    after(async function() {
+        obs.shutdown();
+
+        if (hasTestFailed === true) {
+            logInfo(testName, 'One or more test cases failed. Uploading cache');
+            await obs.uploadTestCache();
+        }
+
+        obs = null;
+        deleteConfigFiles();
+        logInfo(testName, 'Finished ' + testName + ' tests');
+        logEmptyLine();
+    });
+
+    afterEach(function() {
+        if (this.currentTest.state == 'failed') {
+            hasTestFailed = true;
+        }
+    });
+
+    it('Ping the server on each lane while the standard lane is busy', () => {
+        const result = osn.IPC.benchmarkLanes(100);
+
+        expect(result.iterations).to.equal(100);
+        expect(result.standard.calls).to.equal(100);
+        expect(result.realtime.calls).to.equal(100);
+        expect(result.realtimeConnected).to.equal(true, 'Realtime lane has no connection of its own');
+
+        const stats = osn.IPC.getLaneStats();
+        expect(stats.realtime.calls).to.be.at.least(100, 'Realtime pings were not recorded');
+
+        logInfo(testName, 'Standard: p50 ' + result.standard.p50Ms.toFixed(3) + 'ms, p99 ' + result.standard.p99Ms.toFixed(3) + 'ms');
+        logInfo(testName, 'Realtime: p50 ' + result.realtime.p50Ms.toFixed(3) + 'ms, p99 ' + result.realtime.p99Ms.toFixed(3) + 'ms');
+    });
+});
@@ -399,4 +399,40 @@ describe(testName, () => {
         sceneItem.source.release();
         sceneItem.remove();
     });
+
+    it('Get scene item transform through the async API', async () => {
+        // Getting scene
+        const scene = osn.SceneFactory.fromName(sceneName);
+
+        // Getting source
+        const source = osn.InputFactory.fromName(sourceName);
+
+        // Adding input source to scene to create scene item
+        const sceneItem = scene.add(source);
+        expect(sceneItem).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.AddSourceToScene, EOBSInputTypes.ImageSource, sceneName));
+
+        sceneItem.position = {x: 10, y: 20};
+        const before = osn.IPC.getAsyncStats();
+
+        // Several requests are in flight at the same time
+        const [info, position, settings] = await Promise.all([
+            sceneItem.getTransformInfoAsync(),
+            sceneItem.getPositionAsync(),
+            source.getSettingsAsync(),
+        ]);
+
+        expect(info.pos.x).to.equal(10, GetErrorMessage(ETestErrorMsg.PositionX));
+        expect(info.pos.y).to.equal(20, GetErrorMessage(ETestErrorMsg.PositionY));
+        expect(info).to.deep.equal(sceneItem.transformInfo);
+        expect(position.x).to.equal(sceneItem.position.x, GetErrorMessage(ETestErrorMsg.PositionX));
+        expect(position.y).to.equal(sceneItem.position.y, GetErrorMessage(ETestErrorMsg.PositionY));
+        expect(settings).to.deep.equal(source.settings);
+
+        const after = osn.IPC.getAsyncStats();
+        expect(after.failed).to.equal(before.failed);
+        expect(after.completed).to.be.above(before.completed);
+
+        sceneItem.source.release();
+        sceneItem.remove();
+    });
 });
@@ -0,0 +1,71 @@
+import 'mocha';
+import { expect } from 'chai';
+import * as osn from '../osn';
+import { logInfo, logEmptyLine } from '../util/logger';
+import { OBSHandler } from '../util/obs_handler';
+import { deleteConfigFiles } from '../util/general';
+
+const testName = 'osn-shared-memory';
+
+describe(testName, () => {
+    let obs: OBSHandler;
+    let hasTestFailed: boolean = false;
+
+    // Initialize OBS process
+    before(function() {
+        logInfo(testName, 'Starting ' + testName + ' tests');
+        deleteConfigFiles();
+        obs = new OBSHandler(testName);
+    });
+
+    // Shutdown OBS process
+    after(async function() {
+        obs.shutdown();
+
+        if (hasTestFailed === true) {
+            logInfo(testName, 'One or more test cases failed. Uploading cache');
+            await obs.uploadTestCache();
+        }
+
+        obs = null;
+        deleteConfigFiles();
+        logInfo(testName, 'Finished ' + testName + ' tests');
+        logEmptyLine();
+    });
+
+    afterEach(function() {
+        if (this.currentTest.state == 'failed') {
+            hasTestFailed = true;
+        }
+    });
+
+    it('Transfer 1MB payload through socket and shared memory', () => {
+        const payloadSize = 1024 * 1024;
+        const result = osn.IPC.benchmarkTransport(payloadSize, 50);
+
+        expect(result.payloadSize).to.equal(payloadSize);
+        expect(result.inline.sharedCalls).to.equal(0, 'Inline transport used the shared memory arena');
+
+        if (result.sharedMemory) {
+            expect(result.shared.sharedCalls).to.equal(50, 'Not every 1MB payload went through the shared memory arena');
+        }
+
+        // Both transports must deliver exactly the same bytes
+        expect(result.shared.checksum).to.equal(result.inline.checksum, 'Payload differs between transports');
+
+        logInfo(testName, 'Inline: ' + result.inline.callMs.toFixed(3) + 'ms/call, ' + result.inline.megabytesPerSecond.toFixed(1) + 'MB/s');
+        logInfo(testName, 'Shared: ' + result.shared.callMs.toFixed(3) + 'ms/call, ' + result.shared.megabytesPerSecond.toFixed(1) + 'MB/s');
+    });
+
+    it('Get properties of a source through shared memory', () => {
+        const input = osn.InputFactory.create('image_source', 'test_osn_shared_memory_source');
+        expect(input).to.not.equal(undefined);
+
+        // Properties are large enough for some sources to take the arena path
+        const properties = input.properties;
+        expect(properties).to.not.equal(undefined);
+        expect(properties.first()).to.not.equal(undefined);
+
+        input.release();
+    });
+});
@@ -614,4 +614,117 @@ describe(testName, () => {
             filter.release();
         });
     });
+
+    it('Get properties of inputs sharing type and settings', () => {
+        // Creating two inputs with identical settings
+        const firstInput = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'first_input');
+        const secondInput = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'second_input');
+        expect(firstInput).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ColorSource));
+        expect(secondInput).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ColorSource));
+
+        // Each input gets its own tree, with the same layout
+        const firstProperties = firstInput.properties;
+        const secondProperties = secondInput.properties;
+        expect(firstProperties).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.Properties, EOBSInputTypes.ColorSource));
+        expect(secondProperties).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.Properties, EOBSInputTypes.ColorSource));
+        expect(secondProperties.first().name).to.equal(firstProperties.first().name);
+
+        // Changing settings must give back a tree holding the new value
+        let settings: ISettings = firstInput.settings;
+        settings['width'] = 123;
+        firstInput.update(settings);
+        expect(firstInput.properties.get('width').value).to.equal(123);
+        expect(secondInput.properties.get('width').value).to.not.equal(123);
+
+        firstInput.release();
+        secondInput.release();
+    });
+
+    it('Get properties that depend on the filter instance', () => {
+        if (obs.os != 'win32') {
+            return;
+        }
+
+        // The sidechain list of a compressor leaves out its own parent
+        const firstInput = osn.InputFactory.create(EOBSInputTypes.WASAPIInput, 'sidechain_first');
+        const secondInput = osn.InputFactory.create(EOBSInputTypes.WASAPIInput, 'sidechain_second');
+        expect(firstInput).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.WASAPIInput));
+        expect(secondInput).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.WASAPIInput));
+
+        const firstFilter = osn.FilterFactory.create(EOBSFilterTypes.Compressor, 'compressor');
+        const secondFilter = osn.FilterFactory.create(EOBSFilterTypes.Compressor, 'compressor');
+        firstInput.addFilter(firstFilter);
+        secondInput.addFilter(secondFilter);
+
+        const sidechains = (filter: osn.IFilter) =>
+            (filter.properties.get('sidechain_source') as osn.IListProperty).details.items.map(item => item.name);
+
+        const firstList = sidechains(firstFilter);
+        const secondList = sidechains(secondFilter);
+        expect(firstList).to.include('sidechain_second');
+        expect(firstList).to.not.include('sidechain_first');
+        expect(secondList).to.include('sidechain_first');
+        expect(secondList).to.not.include('sidechain_second');
+
+        firstInput.removeFilter(firstFilter);
+        secondInput.removeFilter(secondFilter);
+        firstFilter.release();
+        secondFilter.release();
+        firstInput.release();
+        secondInput.release();
+    });
+
+    it('Get only the properties changed by a modified callback', () => {
+        const input = osn.InputFactory.create(EOBSInputTypes.TextGDI, 'modified_and_diff_input');
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.TextGDI));
+
+        const properties = input.properties;
+        expect(properties).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.Properties, EOBSInputTypes.TextGDI));
+        const count = properties.count();
+        expect(properties.get('file').visible).to.equal(false);
+
+        // Reading from a file hides the text box and shows the file picker
+        let settings: ISettings = input.settings;
+        settings['read_from_file'] = true;
+        const diff = properties.get('read_from_file').modifiedAndDiff(settings);
+
+        expect(diff.modified).to.equal(true);
+        expect(diff.changed).to.include('file');
+        expect(diff.changed).to.include('text');
+        expect(diff.changed.length).to.be.lessThan(count);
+        expect(diff.properties.count()).to.equal(count);
+        expect(diff.properties.get('file').visible).to.equal(true);
+        expect(diff.properties.get('text').visible).to.equal(false);
+
+        // The tree held by the source is the merged one
+        expect(input.properties.get('file').visible).to.equal(true);
+
+        input.release();
+    });
+
+    it('Get the values changed since the properties were read', () => {
+        const input = osn.InputFactory.create(EOBSInputTypes.TextGDI, 'modified_and_diff_value_input');
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.TextGDI));
+
+        const properties = input.properties;
+        expect(properties).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.Properties, EOBSInputTypes.TextGDI));
+
+        // Only the text changes, the callback leaves the visibility as it was
+        let settings: ISettings = input.settings;
+        settings['text'] = 'modified and diff';
+        const diff = properties.get('read_from_file').modifiedAndDiff(settings);
+
+        expect(diff.modified).to.equal(true);
+        expect(diff.changed).to.include('text');
+        expect(diff.changed).to.not.include('file');
+        expect(diff.properties.get('text').value).to.equal('modified and diff');
+
+        // A second change is diffed against the merged tree
+        settings['text'] = 'modified again';
+        const next = diff.properties.get('read_from_file').modifiedAndDiff(settings);
+        expect(next.changed).to.deep.equal(['text']);
+        expect(next.properties.get('text').value).to.equal('modified again');
+
+        input.release();
+    });
 });
@@ -0,0 +1,139 @@
+import 'mocha';
+import { expect } from 'chai';
+import * as osn from '../osn';
+import { logInfo, logEmptyLine } from '../util/logger';
+import { OBSHandler } from '../util/obs_handler';
+import { EOBSInputTypes } from '../util/obs_enums';
+import { deleteConfigFiles, isHeadless } from '../util/general';
+
+const testName = 'osn-throughput';
+
+// Rough operations per second of the common paths. Only the colour source is
+// used so that the suite also runs on a headless server.
+function logRate(name: string, count: number, start: number) {
+    const elapsed = Date.now() - start;
+    const rate = elapsed > 0 ? (count / elapsed) * 1000 : count;
+    logInfo(testName, name + ': ' + count + ' in ' + elapsed + 'ms, ' + rate.toFixed(0) + ' ops/s');
+}
+
+describe(testName, () => {
+    let obs: OBSHandler;
+    let hasTestFailed: boolean = false;
+
+    // Initialize OBS process
+    before(function() {
+        logInfo(testName, 'Starting ' + testName + ' tests');
+        deleteConfigFiles();
+        obs = new OBSHandler(testName);
+    });
+
+    // Shutdown OBS process
+    after(async function() {
+        obs.shutdown();
+
+        if (hasTestFailed === true) {
+            logInfo(testName, 'One or more test cases failed. Uploading cache');
+            await obs.uploadTestCache();
+        }
+
+        obs = null;
+        deleteConfigFiles();
+        logInfo(testName, 'Finished ' + testName + ' tests');
+        logEmptyLine();
+    });
+
+    afterEach(function() {
+        if (this.currentTest.state == 'failed') {
+            hasTestFailed = true;
+        }
+    });
+
+    it('Refuse displays in headless mode', function() {
+        if (!isHeadless()) {
+            this.skip();
+        }
+
+        const key = 'throughput_display';
+        osn.NodeObs.OBS_content_createDisplay(Buffer.alloc(8), key, 0);
+        expect(() => osn.NodeObs.OBS_content_getDisplayPreviewOffset(key)).to.throw();
+    });
+
+    it('Keep video settings in headless mode', function() {
+        if (!isHeadless()) {
+            this.skip();
+        }
+
+        const context = osn.VideoFactory.create();
+        context.video = {
+            fpsNum: 60,
+            fpsDen: 1,
+            baseWidth: 1280,
+            baseHeight: 720,
+            outputWidth: 1280,
+            outputHeight: 720,
+            outputFormat: osn.EVideoFormat.NV12,
+            colorspace: osn.EColorSpace.CS709,
+            range: osn.ERangeType.Partial,
+            scaleType: osn.EScaleType.Bilinear,
+            fpsType: osn.EFPSType.Integer
+        };
+
+        const currentVideo = context.video;
+        expect(currentVideo.baseWidth).to.equal(1280);
+        expect(currentVideo.baseHeight).to.equal(720);
+        expect(currentVideo.fpsNum).to.equal(60);
+        // Nothing is rendered without a video context
+        expect(context.encodedFrames).to.equal(0);
+        context.destroy();
+    });
+
+    it('Create and release sources', () => {
+        const count = 200;
+        const start = Date.now();
+        for (let idx = 0; idx < count; idx++) {
+            const input = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'throughput_source_' + idx);
+            expect(input).to.not.equal(undefined);
+            input.release();
+        }
+        logRate('sources', count, start);
+    });
+
+    it('Add and remove scene items', () => {
+        const count = 100;
+        const scene = osn.SceneFactory.create('throughput_scene');
+        const input = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'throughput_item_source');
+
+        const start = Date.now();
+        const items: osn.ISceneItem[] = [];
+        for (let idx = 0; idx < count; idx++) {
+            items.push(scene.add(input));
+        }
+        expect(scene.getItems().length).to.equal(count);
+        items.forEach(item => item.remove());
+        logRate('scene items', count * 2, start);
+
+        input.release();
+        scene.release();
+    });
+
+    it('Read settings categories', () => {
+        const categories = osn.NodeObs.OBS_settings_getListCategories();
+        expect(categories.length).to.be.above(0);
+
+        const rounds = 10;
+        const start = Date.now();
+        for (let round = 0; round < rounds; round++) {
+            categories.forEach(category => {
+                const settings = osn.NodeObs.OBS_settings_getSettings(category);
+                expect(settings).to.not.equal(undefined);
+            });
+        }
+        logRate('settings categories', rounds * categories.length, start);
+    });
+
+    it('Round trip small calls', () => {
+        const result = osn.IPC.benchmarkDispatch(5000);
+        expect(result.iterations).to.equal(5000);
+        logInfo(testName, 'calls: ' + result.byId.callsPerSecond.toFixed(0) + ' calls/s');
+    });
+});
@@ -79,4 +79,81 @@ describe(testName, () => {
 
         input.release();
     });
+
+    it('Receive volmeter values as typed arrays', async function() {
+        const input = osn.InputFactory.create(EOBSInputTypes.WASAPIInput, 'typed_input');
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.WASAPIInput));
+
+        const volmeter = osn.VolmeterFactory.create(osn.EFaderType.IEC);
+        expect(volmeter).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateVolmeter));
+        volmeter.attach(input);
+        expect(volmeter.index).to.be.at.least(0, GetErrorMessage(ETestErrorMsg.VolmeterCallback));
+
+        // Values arrive in the preallocated arrays, the callback only gets the dirty slots
+        const frame = await new Promise<any>((resolve, reject) => {
+            const timeout = setTimeout(() => reject(new Error('No typed volmeter update received')), 5000);
+            osn.NodeObs.RegisterVolmeterCallback((values: Float32Array, channels: Uint8Array, first: number, count: number) => {
+                clearTimeout(timeout);
+                resolve({ values, channels, first, count });
+            }, true);
+            osn.NodeObs.RegisterSourceCallback(() => {});
+        });
+
+        osn.NodeObs.RemoveSourceCallback();
+        osn.NodeObs.RemoveVolmeterCallback();
+
+        expect(frame.values).to.be.an.instanceof(Float32Array, GetErrorMessage(ETestErrorMsg.VolmeterCallback));
+        expect(frame.channels).to.be.an.instanceof(Uint8Array, GetErrorMessage(ETestErrorMsg.VolmeterCallback));
+        expect(frame.values.length).to.equal(frame.channels.length * 24, GetErrorMessage(ETestErrorMsg.VolmeterCallback));
+        expect(frame.count).to.be.above(0, GetErrorMessage(ETestErrorMsg.VolmeterCallback));
+        expect(frame.first + frame.count).to.be.at.most(frame.channels.length, GetErrorMessage(ETestErrorMsg.VolmeterCallback));
+
+        const table = osn.NodeObs.GetVolmeterIndexTable();
+        const entry = table.find((item: any) => item.index === volmeter.index);
+        expect(entry).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.VolmeterCallback));
+
+        volmeter.destroy();
+        input.release();
+    });
+
+    it('Receive held peaks with server-side ballistics', async function() {
+        const input = osn.InputFactory.create(EOBSInputTypes.WASAPIInput, 'ballistics_input');
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.WASAPIInput));
+
+        const volmeter = osn.VolmeterFactory.create(osn.EFaderType.IEC);
+        volmeter.attach(input);
+
+        expect(function() {
+            volmeter.setBallistics({ peakHoldMs: 1500, decayRate: 12, rmsWindowMs: 300 });
+        }).to.not.throw();
+
+        // Polling at 10 Hz is enough once the server holds the peaks
+        osn.NodeObs.SetCallbackInterval(100);
+        const meters = await new Promise<IVolmeter[]>((resolve, reject) => {
+            const timeout = setTimeout(() => reject(new Error('No volmeter update received')), 5000);
+            osn.NodeObs.RegisterVolmeterCallback((data: IVolmeter[]) => {
+                clearTimeout(timeout);
+                resolve(data);
+            });
+            osn.NodeObs.RegisterSourceCallback(() => {});
+        });
+
+        osn.NodeObs.RemoveSourceCallback();
+        osn.NodeObs.RemoveVolmeterCallback();
+        osn.NodeObs.SetCallbackInterval(50);
+
+        // Held peaks never drop below the RMS level of the same channel
+        for (const meter of meters) {
+            for (let ch = 0; ch < meter.peak.length; ch++) {
+                expect(meter.peak[ch]).to.be.at.least(meter.magnitude[ch] - 0.001, GetErrorMessage(ETestErrorMsg.VolmeterCallback));
+            }
+        }
+
+        expect(function() {
+            volmeter.setBallistics(null);
+        }).to.not.throw();
+
+        volmeter.destroy();
+        input.release();
+    });
 });
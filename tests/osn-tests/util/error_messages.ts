@@ -20,6 +20,7 @@ export const enum ETestErrorMsg {
     SaveStreamSettings = 'Save stream settings',
     SaveSettingsStep = 'Save settings',
     SetDefaultSettings = 'Set default settings',
+    EncoderBenchmark = 'Encoder benchmark',
     DefaultOutputMode = 'Applied default settings does not have the expected value for output mode',
     DefaultVBitrate = 'Applied default settings does not have the expected value for vbitrate',
     DefaultStreamEncoder = 'Applied default settings does not have the expected value for stream encoder',
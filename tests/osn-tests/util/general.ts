@@ -99,4 +99,10 @@ export function getRandomValue(list: any) {
 
 export function sleep(ms) {
     return new Promise(resolve => setTimeout(resolve, ms));
-}
\ No newline at end of file
+}
+
+// Set when the server runs without a video context or displays, see README.md.
+export function isHeadless(): boolean {
+    const value = process.env.OSN_HEADLESS;
+    return value === '1' || (value !== undefined && value.toLowerCase() === 'true');
+}